@@ -24,6 +24,7 @@
 
 #include "OTBGdalAdaptersExport.h"
 
+#include <cstddef>
 #include <memory>
 #include <tuple>
 
@@ -119,6 +120,16 @@ public:
    */
   std::tuple<double, double> Transform(const std::tuple<double, double>& in) const;
 
+  /**
+   * Transform count points in place from source to target spatial
+   * reference, with a single call to OGR
+   * \param count number of points
+   * \param x, y coordinates of the points
+   * \param z altitudes of the points, may be null for 2D points
+   * \throws TransformFailureException if the transform of a point failed
+   */
+  void Transform(std::size_t count, double* x, double* y, double* z = nullptr) const;
+
 
 private:
   // unique ptr to the internal OGRCoordinateTransformation
@@ -163,4 +163,21 @@ std::tuple<double, double> CoordinateTransformation::Transform(const std::tuple<
 
   return std::make_tuple(outX, outY);
 }
+
+// Transform of arrays of points
+void CoordinateTransformation::Transform(std::size_t count, double* x, double* y, double* z) const
+{
+  if (count == 0)
+    return;
+
+  bool success(m_Transform->Transform(static_cast<int>(count), x, y, z) != 0);
+
+  if (!success)
+  {
+    std::ostringstream oss;
+    oss << "(TransformFailureException) "
+        << "Transform: " << this << ", Parameters: " << count << " points";
+    throw std::runtime_error(oss.str());
+  }
+}
 }
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplication.h"
+#include "otbWrapperApplicationFactory.h"
+
+#include "otbAtmosphericRadiativeTermsLUT.h"
+#include "otbImageMetadataCorrectionParameters.h"
+
+#include <sstream>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+class ComputeAtmosphericLUT : public Application
+{
+public:
+  /** Standard class typedefs. */
+  typedef ComputeAtmosphericLUT         Self;
+  typedef Application                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Standard macro */
+  itkNewMacro(Self);
+
+  itkTypeMacro(ComputeAtmosphericLUT, Application);
+
+  typedef AtmosphericRadiativeTermsLUT                     LUTType;
+  typedef AtmosphericCorrectionParameters::AerosolModelType AerosolModelType;
+  typedef ImageMetadataCorrectionParameters                AcquiCorrectionParametersType;
+
+private:
+  void DoInit() override
+  {
+    SetName("ComputeAtmosphericLUT");
+    SetDescription("Precompute the 6S atmospheric radiative terms of a sensor on a grid of atmospheric and geometric conditions.");
+
+    SetDocLongDescription(
+        "Top of canopy calibration (OpticalCalibration application, level toc) runs the 6S radiative transfer code for each band of each image. "
+        "This application runs 6S once for all on a grid of solar and viewing zenithal angles, relative azimuth, atmospheric pressure, water vapor "
+        "amount, ozone amount and aerosol optical thickness, for each band of a sensor and an aerosol model. The resulting table can then be given to "
+        "OpticalCalibration (atmo.lut parameter), which interpolates the radiative terms multilinearly instead of running 6S.\n\n"
+        "The nodes of each axis are given as a list of increasing values separated by spaces; an axis with a single value is constant. "
+        "The number of 6S runs is the product of the number of nodes of all the axes, for each band: keep the grid of the parameters that "
+        "do not vary for the processed images small.\n\n"
+        "An existing table can be extended with new bands or aerosol models: its grid is then kept and the grid parameters are ignored.");
+    SetDocLimitations("Parameters outside of the grid are clamped to its bounds during the interpolation.");
+    SetDocAuthors("OTB-Team");
+    SetDocSeeAlso("OpticalCalibration");
+
+    AddDocTag(Tags::Calibration);
+
+    AddParameter(ParameterType_InputImage, "in", "Input image");
+    SetParameterDescription("in", "Image whose metadata contains the relative spectral responses of the bands");
+    MandatoryOff("in");
+
+    AddParameter(ParameterType_InputFilename, "rsr", "Relative Spectral Response File");
+    SetParameterDescription("rsr", "Sensor relative spectral response file, used instead of the metadata of the input image");
+    MandatoryOff("rsr");
+
+    AddParameter(ParameterType_Choice, "aerosol", "Aerosol Model");
+    AddChoice("aerosol.noaersol", "No Aerosol Model");
+    AddChoice("aerosol.continental", "Continental");
+    AddChoice("aerosol.maritime", "Maritime");
+    AddChoice("aerosol.urban", "Urban");
+    AddChoice("aerosol.desertic", "Desertic");
+    SetParameterString("aerosol", "continental");
+
+    AddParameter(ParameterType_Group, "grid", "Grid");
+    SetParameterDescription("grid", "Nodes of the axes of the grid, separated by spaces");
+    AddGridParameter("grid.sunzen", "Solar zenithal angles (degrees)", "0 10 20 30 40 50 60 70");
+    AddGridParameter("grid.viewzen", "Viewing zenithal angles (degrees)", "0 10 20 30 40");
+    AddGridParameter("grid.relaz", "Relative azimuths between sun and view (degrees, from 0 to 180)", "0 30 60 90 120 150 180");
+    AddGridParameter("grid.pressure", "Atmospheric pressures (hPa)", "1013");
+    AddGridParameter("grid.wa", "Water vapor amounts (g/cm2)", "0.5 1.5 3 5");
+    AddGridParameter("grid.oz", "Ozone amounts (cm-atm)", "0.3");
+    AddGridParameter("grid.opt", "Aerosol optical thicknesses", "0.05 0.1 0.2 0.4 0.8");
+
+    AddParameter(ParameterType_InputFilename, "inlut", "Input LUT");
+    SetParameterDescription("inlut", "Existing table to extend with the bands of this sensor and this aerosol model");
+    MandatoryOff("inlut");
+
+    AddParameter(ParameterType_OutputFilename, "out", "Output LUT");
+    SetParameterDescription("out", "Output table of atmospheric radiative terms");
+
+    // Doc example parameter settings
+    SetDocExampleParameterValue("rsr", "rep6S.dat");
+    SetDocExampleParameterValue("aerosol", "maritime");
+    SetDocExampleParameterValue("grid.opt", "0.1 0.3");
+    SetDocExampleParameterValue("out", "atmo_lut.txt");
+
+    SetOfficialDocLink();
+  }
+
+  void DoUpdateParameters() override
+  {
+    // Nothing to do here : all parameters are independent
+  }
+
+  void DoExecute() override
+  {
+    AcquiCorrectionParametersType::Pointer paramAcqui = AcquiCorrectionParametersType::New();
+    if (IsParameterEnabled("rsr") && HasValue("rsr"))
+    {
+      paramAcqui->LoadFilterFunctionValue(GetParameterString("rsr"));
+    }
+    else if (HasValue("in"))
+    {
+      const ImageMetadata& metadata = GetParameterImage("in")->GetImageMetadata();
+      if (!metadata.HasBandMetadata(MDL1D::SpectralSensitivity))
+      {
+        otbAppLogFATAL("The input image has no relative spectral response, please set a relative spectral response file.");
+      }
+      auto spectralSensitivity = AcquiCorrectionParametersType::InternalWavelengthSpectralBandVectorType::New();
+      for (const auto& band : metadata.Bands)
+      {
+        const auto& spectralSensitivityLUT = band[MDL1D::SpectralSensitivity];
+        const auto& axis                   = spectralSensitivityLUT.Axis[0];
+        auto        filterFunction         = FilterFunctionValues::New();
+        // LUT1D stores a double vector whereas FilterFunctionValues stores a float vector
+        std::vector<float> vec(spectralSensitivityLUT.Array.begin(), spectralSensitivityLUT.Array.end());
+        filterFunction->SetFilterFunctionValues(vec);
+        filterFunction->SetMinSpectralValue(axis.Origin);
+        filterFunction->SetMaxSpectralValue(axis.Origin + axis.Spacing * (axis.Size - 1));
+        filterFunction->SetUserStep(axis.Spacing);
+        spectralSensitivity->PushBack(filterFunction);
+      }
+      paramAcqui->SetWavelengthSpectralBand(spectralSensitivity);
+    }
+    else
+    {
+      otbAppLogFATAL("Please set an input image or a relative spectral response file.");
+    }
+
+    // Desertic is known as model 5 by 6S (see OpticalCalibration)
+    const AerosolModelType aerosolModel =
+        GetParameterString("aerosol") == "desertic" ? static_cast<AerosolModelType>(5) : static_cast<AerosolModelType>(GetParameterInt("aerosol"));
+
+    LUTType::Pointer lut = LUTType::New();
+    if (IsParameterEnabled("inlut") && HasValue("inlut"))
+    {
+      lut->Load(GetParameterString("inlut"));
+      otbAppLogINFO(<< "Extending the table " << GetParameterString("inlut") << ", which has " << lut->GetNumberOfTables() << " tables");
+    }
+    else
+    {
+      lut->SetAxis(LUTType::SOLAR_ZENITH, GetGridParameter("grid.sunzen"));
+      lut->SetAxis(LUTType::VIEWING_ZENITH, GetGridParameter("grid.viewzen"));
+      lut->SetAxis(LUTType::RELATIVE_AZIMUTH, GetGridParameter("grid.relaz"));
+      lut->SetAxis(LUTType::ATMOSPHERIC_PRESSURE, GetGridParameter("grid.pressure"));
+      lut->SetAxis(LUTType::WATER_VAPOR, GetGridParameter("grid.wa"));
+      lut->SetAxis(LUTType::OZONE, GetGridParameter("grid.oz"));
+      lut->SetAxis(LUTType::AEROSOL_OPTICAL, GetGridParameter("grid.opt"));
+    }
+
+    const auto bands = paramAcqui->GetWavelengthSpectralBand();
+    otbAppLogINFO(<< "Running 6S on " << lut->GetNumberOfNodes() << " nodes for each of the " << bands->Size() << " bands");
+    for (unsigned int i = 0; i < bands->Size(); ++i)
+    {
+      lut->Build(bands->GetNthElement(i), aerosolModel);
+      otbAppLogINFO(<< "Band " << i + 1 << " done");
+    }
+
+    lut->Save(GetParameterString("out"));
+  }
+
+  void AddGridParameter(const std::string& key, const std::string& name, const std::string& defaultNodes)
+  {
+    AddParameter(ParameterType_String, key, name);
+    SetParameterDescription(key, name + ", separated by spaces");
+    SetParameterString(key, defaultNodes);
+    MandatoryOff(key);
+  }
+
+  LUTType::AxisNodesType GetGridParameter(const std::string& key)
+  {
+    std::istringstream     iss(GetParameterString(key));
+    LUTType::AxisNodesType nodes;
+    double                 node;
+    while (iss >> node)
+    {
+      nodes.push_back(node);
+    }
+    if (!iss.eof() || nodes.empty())
+    {
+      otbAppLogFATAL(<< "Invalid list of values for " << key << ": " << GetParameterString(key));
+    }
+    return nodes;
+  }
+};
+
+} // namespace Wrapper
+} // namespace otb
+
+OTB_APPLICATION_EXPORT(otb::Wrapper::ComputeAtmosphericLUT)
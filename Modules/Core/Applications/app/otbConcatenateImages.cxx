@@ -24,6 +24,7 @@
 #include "otbImageListToVectorImageFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageList.h"
+#include "otbBandStackImageSource.h"
 
 namespace otb
 {
@@ -50,6 +51,7 @@ public:
   typedef ImageListToVectorImageFilter<ImageListType, FloatVectorImageType>                                ListConcatenerFilterType;
   typedef MultiToMonoChannelExtractROI<FloatVectorImageType::InternalPixelType, FloatImageType::PixelType> ExtractROIFilterType;
   typedef ObjectList<ExtractROIFilterType> ExtractROIFilterListType;
+  typedef BandStackImageSource<FloatVectorImageType> BandStackType;
 
 private:
   void DoInit() override
@@ -61,8 +63,12 @@ private:
     SetDocLongDescription(
         "Concatenate a list of images of the same size into a single multi-channel image. "
         "It reads the input image list (single or multi-channel) "
-        "and generates a single multi-channel image. The channel order is the same as the list.");
-    SetDocLimitations("All input images must have the same size.");
+        "and generates a single multi-channel image. The channel order is the same as the list.\n\n"
+        "When all the inputs are files read through GDAL, the bands of each file are read "
+        "directly into the output image, and the stack can also be written as a GDAL VRT "
+        "referencing the input bands, without reading any pixel.");
+    SetDocLimitations("All input images must have the same size. The VRT output is only available "
+                      "when all the inputs are files read through GDAL, without color table.");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso("Rescale application, DynamicConvert, SplitImage");
 
@@ -75,6 +81,11 @@ private:
 
     AddParameter(ParameterType_OutputImage, "out", "Output Image");
     SetParameterDescription("out", "The concatenated output image.");
+    MandatoryOff("out");
+
+    AddParameter(ParameterType_OutputFilename, "vrt", "Output VRT");
+    SetParameterDescription("vrt", "Stack of the input bands written as a GDAL VRT, without reading any pixel.");
+    MandatoryOff("vrt");
 
     AddRAMParameter();
 
@@ -92,9 +103,11 @@ private:
 
   void DoExecute() override
   {
-    ListConcatenerFilterType::Pointer m_Concatener    = ListConcatenerFilterType::New();
-    ExtractROIFilterListType::Pointer m_ExtractorList = ExtractROIFilterListType::New();
-    ImageListType::Pointer            m_ImageList     = ImageListType::New();
+    if (!HasValue("out") && !HasValue("vrt"))
+    {
+      itkExceptionMacro("No output set: at least one of out and vrt is needed");
+    }
+
     // Get the input image list
     FloatVectorImageListType::Pointer inList = this->GetParameterImageList("il");
 
@@ -106,8 +119,9 @@ private:
     inList->GetNthElement(0)->UpdateOutputInformation();
     FloatVectorImageType::SizeType size = inList->GetNthElement(0)->GetLargestPossibleRegion().GetSize();
 
-    // Split each input vector image into image
-    // and generate an mono channel image list
+    // The bands of the inputs read from files with GDAL are read
+    // directly into the output buffer
+    bool directRead = true;
     for (unsigned int i = 0; i < inList->Size(); i++)
     {
       FloatVectorImageType::Pointer vectIm = inList->GetNthElement(i);
@@ -117,6 +131,46 @@ private:
         itkExceptionMacro("Input Image size mismatch...");
       }
 
+      BandStackType::ReaderType* reader = dynamic_cast<BandStackType::ReaderType*>(vectIm->GetSource().GetPointer());
+      directRead = directRead && reader != nullptr && !std::string(reader->GetFileName()).empty() && BandStackType::CanStack(reader);
+    }
+
+    if (directRead)
+    {
+      std::vector<std::string> fileNames = GetParameterStringList("il");
+      BandStackType::Pointer   stack     = BandStackType::New();
+      for (const auto& fileName : fileNames)
+      {
+        stack->AddImage(fileName);
+      }
+
+      if (HasValue("vrt"))
+      {
+        stack->WriteVRT(GetParameterString("vrt"));
+        otbAppLogINFO("Stack of " << stack->GetNumberOfBands() << " bands written to " << GetParameterString("vrt"));
+      }
+      if (HasValue("out"))
+      {
+        SetParameterOutputImage("out", stack->GetOutput());
+      }
+      RegisterPipeline();
+      return;
+    }
+
+    if (HasValue("vrt"))
+    {
+      itkExceptionMacro("A VRT can only be written when all the inputs are files read through GDAL, without color table");
+    }
+
+    ListConcatenerFilterType::Pointer m_Concatener    = ListConcatenerFilterType::New();
+    ExtractROIFilterListType::Pointer m_ExtractorList = ExtractROIFilterListType::New();
+    ImageListType::Pointer            m_ImageList     = ImageListType::New();
+
+    // Split each input vector image into image
+    // and generate an mono channel image list
+    for (unsigned int i = 0; i < inList->Size(); i++)
+    {
+      FloatVectorImageType::Pointer vectIm = inList->GetNthElement(i);
       for (unsigned int j = 0; j < vectIm->GetNumberOfComponentsPerPixel(); j++)
       {
         ExtractROIFilterType::Pointer extractor = ExtractROIFilterType::New();
@@ -26,12 +26,14 @@
 #include "otbStreamingShrinkImageFilter.h"
 #include "itkListSample.h"
 #include "otbListSampleToHistogramListGenerator.h"
+#include "otbStreamingMultiAccumulatorImageFilter.h"
 #include "itkImageRegionConstIterator.h"
 
 #include "otbImageListToVectorImageFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageList.h"
 
+#include <limits>
 #include <numeric>
 
 namespace otb
@@ -63,6 +65,9 @@ public:
 
   typedef StreamingShrinkImageFilter<UInt8ImageType, UInt8ImageType> UInt8ShrinkFilterType;
 
+  typedef StreamingMultiAccumulatorImageFilter<FloatVectorImageType> AccumulatorFilterType;
+  typedef QuantileSketchAccumulator<>                                QuantileAccumulatorType;
+
 private:
   void DoInit() override
   {
@@ -137,6 +142,15 @@ private:
     SetDefaultParameterFloat("quantile.low", 2.0);
     DisableParameter("quantile.low");
 
+    AddParameter(ParameterType_Float, "quantile.error", "Quantile rank error");
+    SetParameterDescription("quantile.error",
+                            "If set, the quantiles are computed on the full resolution image, in a single streamed pass, "
+                            "with a rank error lower than this value (in percent). By default, they are estimated "
+                            "from the histogram of a quicklook of the image.");
+    MandatoryOff("quantile.error");
+    SetMinimumParameterFloatValue("quantile.error", 0.001);
+    DisableParameter("quantile.error");
+
     AddParameter(ParameterType_Choice, "channels", "Channels selection");
     SetParameterDescription("channels",
                             "It's possible to select the channels "
@@ -225,19 +239,7 @@ private:
 
     const unsigned int nbComp(tempImage->GetNumberOfComponentsPerPixel());
 
-    // We need to subsample the input image in order to estimate its histogram
-    // Shrink factor is computed so as to load a quicklook of 1000
-    // pixels square at most
-    auto         imageSize    = tempImage->GetLargestPossibleRegion().GetSize();
-    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
-    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
-
-    otbAppLogDEBUG(<< "Shrink starts...");
-    typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactor(shrinkFactor);
-    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
-    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
-
+    FloatVectorImageType* statsInput = tempImage;
     if (rescaleType == "log2")
     {
       // define lambda function that applies a log to all bands of the input pixel
@@ -259,22 +261,82 @@ private:
       transferLogFilter->SetInputs(tempImage);
       transferLogFilter->UpdateOutputInformation();
 
-      shrinkFilter->SetInput(transferLogFilter->GetOutput());
-      rescaler->SetInput(transferLogFilter->GetOutput());
-      shrinkFilter->Update();
+      statsInput = transferLogFilter->GetOutput();
+    }
+    rescaler->SetInput(statsInput);
+
+    typename FloatVectorImageType::PixelType inputMin(nbComp), inputMax(nbComp);
+    if (IsParameterEnabled("quantile.error") && HasValue("quantile.error"))
+    {
+      ComputeQuantilesWithSketches(statsInput, inputMin, inputMax);
     }
     else
     {
-      shrinkFilter->SetInput(tempImage);
-      rescaler->SetInput(tempImage);
-      shrinkFilter->Update();
+      ComputeQuantilesWithHistograms(statsInput, inputMin, inputMax);
+    }
+
+    otbAppLogDEBUG(<< std::setprecision(5) << "Min/Max computation done : min=" << inputMin << " max=" << inputMax);
+
+    rescaler->AutomaticInputMinMaxComputationOff();
+    rescaler->SetInputMinimum(inputMin);
+    rescaler->SetInputMaximum(inputMax);
+
+    if (rescaleType == "linear")
+    {
+      rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
     }
 
+    typename TImageType::PixelType minimum(nbComp);
+    typename TImageType::PixelType maximum(nbComp);
+
+    /*
+    float outminvalue = std::numeric_limits<typename TImageType::InternalPixelType>::min();
+    float outmaxvalue = std::numeric_limits<typename TImageType::InternalPixelType>::max();
+    // TODO test outmin/outmax values
+    if (outminvalue > GetParameterFloat("outmin"))
+      itkExceptionMacro("The outmin value at " << GetParameterFloat("outmin") <<
+                        " is too low, select a value in "<< outminvalue <<" min.");
+    if ( outmaxvalue < GetParameterFloat("outmax") )
+      itkExceptionMacro("The outmax value at " << GetParameterFloat("outmax") <<
+                        " is too high, select a value in "<< outmaxvalue <<" max.");
+    */
+
+    maximum.Fill(GetParameterFloat("outmax"));
+    minimum.Fill(GetParameterFloat("outmin"));
+
+    rescaler->SetOutputMinimum(minimum);
+    rescaler->SetOutputMaximum(maximum);
+
+    m_Filters.push_back(rescaler.GetPointer());
+    SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+  }
+
+  /** Estimate the quantiles from the histogram of a quicklook of the image */
+  void ComputeQuantilesWithHistograms(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp = image->GetNumberOfComponentsPerPixel();
+
+    // We need to subsample the input image in order to estimate its histogram
+    // Shrink factor is computed so as to load a quicklook of 1000
+    // pixels square at most
+    auto         imageSize    = image->GetLargestPossibleRegion().GetSize();
+    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
+    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
+
+    otbAppLogDEBUG(<< "Shrink starts...");
+    ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetShrinkFactor(shrinkFactor);
+    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
+
+    shrinkFilter->SetInput(image);
+    shrinkFilter->Update();
+
     otbAppLogDEBUG(<< "Evaluating input Min/Max...");
     itk::ImageRegionConstIterator<FloatVectorImageType> it(shrinkFilter->GetOutput(), shrinkFilter->GetOutput()->GetLargestPossibleRegion());
 
-    typename ListSampleType::Pointer listSample = ListSampleType::New();
-    listSample->SetMeasurementVectorSize(tempImage->GetNumberOfComponentsPerPixel());
+    ListSampleType::Pointer listSample = ListSampleType::New();
+    listSample->SetMeasurementVectorSize(image->GetNumberOfComponentsPerPixel());
 
     // Now we generate the list of samples
     if (IsParameterEnabled("mask"))
@@ -317,7 +379,7 @@ private:
     }
 
     // And then the histogram
-    typename HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
+    HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
     histogramsGenerator->SetListSample(listSample);
     histogramsGenerator->SetNumberOfBins(255);
     // Samples with nodata values are ignored
@@ -327,7 +389,6 @@ private:
     assert(histOutput);
 
     // And extract the lower and upper quantile
-    typename FloatVectorImageType::PixelType inputMin(nbComp), inputMax(nbComp);
     for (unsigned int i = 0; i < nbComp; ++i)
     {
       auto&& elm = histOutput->GetNthElement(i);
@@ -335,41 +396,59 @@ private:
       inputMin[i] = elm->Quantile(0, 0.01 * GetParameterFloat("quantile.low"));
       inputMax[i] = elm->Quantile(0, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
     }
+  }
 
-    otbAppLogDEBUG(<< std::setprecision(5) << "Min/Max computation done : min=" << inputMin << " max=" << inputMax);
-
-    rescaler->AutomaticInputMinMaxComputationOff();
-    rescaler->SetInputMinimum(inputMin);
-    rescaler->SetInputMaximum(inputMax);
+  /** Compute the quantiles on the full resolution image with quantile
+   * sketches, in a single streamed pass */
+  void ComputeQuantilesWithSketches(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp = image->GetNumberOfComponentsPerPixel();
 
-    if (rescaleType == "linear")
-    {
-      rescaler->SetGamma(GetParameterFloat("type.linear.gamma"));
-    }
+    auto quantiles = std::make_shared<QuantileAccumulatorType>();
+    quantiles->SetRankError(0.01 * GetParameterFloat("quantile.error"));
+    // Samples with nodata values are ignored, band by band, as with the
+    // histograms
+    quantiles->SetNoDataFlag(true);
+    otbAppLogINFO(<< "Computing quantiles with a rank error lower than " << 100. * quantiles->GetRankError() << "%");
 
-    typename TImageType::PixelType minimum(nbComp);
-    typename TImageType::PixelType maximum(nbComp);
+    AccumulatorFilterType::Pointer accumulatorFilter = AccumulatorFilterType::New();
+    accumulatorFilter->AddAccumulator(quantiles);
+    accumulatorFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(accumulatorFilter->GetStreamer(), "Computing quantiles...");
 
-    /*
-    float outminvalue = std::numeric_limits<typename TImageType::InternalPixelType>::min();
-    float outmaxvalue = std::numeric_limits<typename TImageType::InternalPixelType>::max();
-    // TODO test outmin/outmax values
-    if (outminvalue > GetParameterFloat("outmin"))
-      itkExceptionMacro("The outmin value at " << GetParameterFloat("outmin") <<
-                        " is too low, select a value in "<< outminvalue <<" min.");
-    if ( outmaxvalue < GetParameterFloat("outmax") )
-      itkExceptionMacro("The outmax value at " << GetParameterFloat("outmax") <<
-                        " is too high, select a value in "<< outmaxvalue <<" max.");
-    */
+    if (IsParameterEnabled("mask"))
+    {
+      // Masked pixels are set to NaN, so that they are ignored
+      auto maskFunction = [](FloatVectorImageType::PixelType& vectorOut, const FloatVectorImageType::PixelType& vectorIn, const UInt8ImageType::PixelType& mask) {
+        for (unsigned int i = 0; i < vectorIn.Size(); i++)
+        {
+          vectorOut[i] = mask != 0 ? vectorIn[i] : std::numeric_limits<FloatVectorImageType::InternalPixelType>::quiet_NaN();
+        }
+      };
+      auto maskFilter = NewFunctorFilter(maskFunction, nbComp, {{0, 0}});
+      m_Filters.push_back(maskFilter.GetPointer());
+      maskFilter->SetInputs(image, this->GetParameterUInt8Image("mask"));
 
-    maximum.Fill(GetParameterFloat("outmax"));
-    minimum.Fill(GetParameterFloat("outmin"));
+      accumulatorFilter->SetInput(maskFilter->GetOutput());
+      accumulatorFilter->Update();
+      if (accumulatorFilter->GetNumberOfRelevantPixels() == 0)
+      {
+        otbAppLogINFO(<< "All pixels were masked, the application assume "
+                         "a wrong mask and include all the image");
+      }
+    }
 
-    rescaler->SetOutputMinimum(minimum);
-    rescaler->SetOutputMaximum(maximum);
+    if ((!IsParameterEnabled("mask")) || (accumulatorFilter->GetNumberOfRelevantPixels() == 0))
+    {
+      accumulatorFilter->SetInput(image);
+      accumulatorFilter->Update();
+    }
 
-    m_Filters.push_back(rescaler.GetPointer());
-    SetParameterOutputImage<TImageType>("out", rescaler->GetOutput());
+    for (unsigned int i = 0; i < nbComp; ++i)
+    {
+      inputMin[i] = quantiles->Quantile(i, 0.01 * GetParameterFloat("quantile.low"));
+      inputMax[i] = quantiles->Quantile(i, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
+    }
   }
 
   // Get the bands order
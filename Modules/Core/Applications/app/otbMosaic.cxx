@@ -48,6 +48,10 @@
 // danielson distance image
 #include "itkDanielssonDistanceMapImageFilter.h"
 
+// exact distance image
+#include "otbStreamingMaskColumnRunsFilter.h"
+#include "otbExactDistanceMapImageSource.h"
+
 // Interpolators
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbBCOInterpolateImageFunction.h"
@@ -137,6 +141,10 @@ public:
   /* Distance map image writer typedef */
   typedef otb::ImageFileReader<DoubleImageType> DistanceMapImageReaderType;
 
+  /* Exact distance map typedefs */
+  typedef otb::StreamingMaskColumnRunsFilter<UInt8MaskImageType> MaskColumnRunsFilterType;
+  typedef otb::ExactDistanceMapImageSource<DoubleImageType>      ExactDistanceMapSourceType;
+
   /* Vector data filters typedefs */
   typedef otb::VectorDataIntoImageProjectionFilter<VectorDataType, FloatVectorImageType> VectorDataReprojFilterType;
   typedef otb::VectorDataToLabelImageFilter<VectorDataType, LabelImageType>              RasterizerType;
@@ -215,7 +223,7 @@ private:
     SetDocLimitations(
         "1. When \"comp\" parameter is different than \"none\", the sampling ratio for "
         "distance map computation can be adjusted to make input images fit into memory (distance map "
-        "computation is not streamable)."
+        "computation is not streamable, unless distancemap.exact is set)."
         "2. When \"harmo\" method is not \"none\", an algorithm performs the color harmonization of "
         "the input images using quadratic programming (QP). The objective function of the QP is a set "
         "of matrices, each one with size NxN (N being the number of input images). Hence, a large number "
@@ -362,9 +370,17 @@ private:
                             "physical spacing of the original image. It is used to change the distance maps physical spacing: "
                             "since the distance map computation is not a streamable pipeline, it can be useful to compute slightly "
                             "smaller distance maps. distancemap.sr can be hence increased if input images are too big to fit the RAM, "
-                            "or in order to speed up the process");
+                            "or in order to speed up the process. With distancemap.exact, distance maps are streamed and "
+                            "distancemap.sr can be set to 1 to get full resolution distance maps");
     SetDefaultParameterFloat("distancemap.sr", 10);
 
+    AddParameter(ParameterType_Bool, "distancemap.exact", "Exact streamed distance maps");
+    SetParameterDescription("distancemap.exact",
+                            "Compute exact Euclidean distance maps on the fly, without temporary files: binary masks are "
+                            "streamed once to encode their objects, then the distance maps are generated for the regions "
+                            "requested by the mosaic filter. Results are slightly different from the default (Danielsson) "
+                            "distance maps, which are approximate.");
+
     // no-data value
     AddParameter(ParameterType_Float, "nodata", "no-data value");
     SetParameterDescription("nodata",
@@ -386,9 +402,10 @@ private:
   }
 
   /*
-   * Write a binary mask to disk from a vector data
+   * Build the pipeline of a binary mask from a vector data.
+   * Filters are kept in m_MaskFilters.
    */
-  void RasterizeBinaryMask(VectorDataType* vd, FloatVectorImageType* reference, string outputFileName, double spacingRatio, bool invert = false)
+  UInt8MaskImageType* BuildRasterizedBinaryMask(VectorDataType* vd, FloatVectorImageType* reference, double spacingRatio, bool invert = false)
   {
 
     // Reproject VectorData
@@ -438,9 +455,20 @@ private:
     labelThreshold->SetLowerThreshold(1);
     labelThreshold->SetUpperThreshold(itk::NumericTraits<LabelImageType::InternalPixelType>::max());
 
-    // Write file
+    m_MaskFilters.push_back(vdReproj.GetPointer());
+    m_MaskFilters.push_back(rasterizer.GetPointer());
+    m_MaskFilters.push_back(labelThreshold.GetPointer());
+
+    return labelThreshold->GetOutput();
+  }
+
+  /*
+   * Write a binary mask to disk from a vector data
+   */
+  void RasterizeBinaryMask(VectorDataType* vd, FloatVectorImageType* reference, string outputFileName, double spacingRatio, bool invert = false)
+  {
     UInt8MaskWriterType::Pointer writer = UInt8MaskWriterType::New();
-    writer->SetInput(labelThreshold->GetOutput());
+    writer->SetInput(BuildRasterizedBinaryMask(vd, reference, spacingRatio, invert));
     writer->SetFileName(outputFileName);
     AddProcess(writer, "Writing binary mask (from vector data) " + outputFileName);
     writer->Update();
@@ -464,7 +492,7 @@ private:
     reader->SetFileName(inputBinaryMaskFileName);
 
     // Pad the image
-    const unsigned int paddingRadius = 2;
+    const unsigned int paddingRadius = DistanceMapPaddingRadius;
     reader->UpdateOutputInformation();
     UInt8MaskImageType::SizeType size = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
     size[0] += 2 * paddingRadius;
@@ -497,9 +525,10 @@ private:
   }
 
   /*
-   * Write a binary mask from an input image
+   * Build the pipeline of a binary mask from an input image.
+   * Filters are kept in m_MaskFilters.
    */
-  void WriteBinaryMask(FloatVectorImageType* referenceImage, string outputFileName, double spacingRatio = 1.0)
+  UInt8MaskImageType* BuildBinaryMask(FloatVectorImageType* referenceImage, double spacingRatio = 1.0)
   {
     // No-data image
     IsNoDataFunctor nodata_functor(GetParameterFloat("nodata"));
@@ -520,9 +549,19 @@ private:
     resampler->SetOutputSpacing(outputSpacing);
     resampler->SetOutputOrigin(isNoDataFilter->GetOutput()->GetOrigin());
 
-    // Write image
+    m_MaskFilters.push_back(isNoDataFilter.GetPointer());
+    m_MaskFilters.push_back(resampler.GetPointer());
+
+    return resampler->GetOutput();
+  }
+
+  /*
+   * Write a binary mask from an input image
+   */
+  void WriteBinaryMask(FloatVectorImageType* referenceImage, string outputFileName, double spacingRatio = 1.0)
+  {
     UInt8MaskWriterType::Pointer writer = UInt8MaskWriterType::New();
-    writer->SetInput(resampler->GetOutput());
+    writer->SetInput(BuildBinaryMask(referenceImage, spacingRatio));
     writer->SetFileName(outputFileName);
     AddProcess(writer, "Writing binary mask (from image boundaries) " + outputFileName);
     writer->Update();
@@ -571,6 +610,44 @@ private:
     return outputFileName;
   }
 
+  /*
+   * Create the exact distance image of a binary mask, streamed without
+   * temporary file
+   */
+  void CreateExactDistanceImage(UInt8MaskImageType* mask, unsigned int id)
+  {
+    // Encode the objects of the mask
+    MaskColumnRunsFilterType::Pointer runsFilter = MaskColumnRunsFilterType::New();
+    runsFilter->SetInput(mask);
+    runsFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(runsFilter->GetStreamer(), "Encoding binary mask " + std::to_string(id));
+    runsFilter->Update();
+
+    // The distance image is generated on demand from the runs
+    ExactDistanceMapSourceType::Pointer distanceSource = ExactDistanceMapSourceType::New();
+    distanceSource->SetReferenceImage(mask);
+    distanceSource->SetColumnRuns(runsFilter->GetColumnRuns());
+    distanceSource->SetPaddingRadius(DistanceMapPaddingRadius);
+    distanceSource->SetUseImageSpacing(true);
+    distanceSource->UpdateOutputInformation();
+    m_ExactDistanceMapSources.push_back(distanceSource);
+
+    // The mask pipelines are no longer needed
+    m_MaskFilters.clear();
+  }
+
+  /*
+   * Return the distance image of the input image #id
+   */
+  DoubleImageType* GetDistanceImage(unsigned int id)
+  {
+    if (GetParameterInt("distancemap.exact"))
+    {
+      return m_ExactDistanceMapSources[id]->GetOutput();
+    }
+    return m_DistanceMapImageReader[id]->GetOutput();
+  }
+
   /*
    * Set the correction model to the mosaic filter
    */
@@ -853,8 +930,25 @@ private:
     otbAppLogINFO("Computing distance maps");
 
     m_DistanceMapImageReader.clear();
+    m_ExactDistanceMapSources.clear();
     for (unsigned int i = 0; i < GetParameterImageList("il")->Size(); i++)
     {
+      if (GetParameterInt("distancemap.exact"))
+      {
+        FloatVectorImageType* image = GetParameterImageList("il")->GetNthElement(i);
+        if (GetParameterByKey("vdcut")->HasValue())
+        {
+          CreateExactDistanceImage(
+              BuildRasterizedBinaryMask(GetParameterVectorDataList("vdcut")->GetNthElement(i), image, GetParameterFloat("distancemap.sr")), i);
+        }
+        else // use images boundaries
+        {
+          CreateExactDistanceImage(BuildBinaryMask(image, GetParameterFloat("distancemap.sr")), i);
+          image->PrepareForNewData();
+        }
+        continue;
+      }
+
       const string outputFileName = GenerateFileName("tmp_distance_image", i);
       if (GetParameterByKey("vdcut")->HasValue())
       {
@@ -941,7 +1035,7 @@ private:
       m_LargeFeatherMosaicFilter = LargeFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), GetDistanceImage(i));
       }
       ComputeDistanceOffset<LargeFeatherMosaicFilterType>(m_LargeFeatherMosaicFilter);
       mosaicFilter = static_cast<MosaicFilterType*>(m_LargeFeatherMosaicFilter);
@@ -957,7 +1051,7 @@ private:
       m_SlimFeatherMosaicFilter = SlimFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), GetDistanceImage(i));
       }
       ComputeDistanceOffset<SlimFeatherMosaicFilterType>(m_SlimFeatherMosaicFilter);
 
@@ -1081,6 +1175,13 @@ private:
   // Distance images reader
   vector<DistanceMapImageReaderType::Pointer> m_DistanceMapImageReader;
 
+  // Exact distance images and the pipelines of their binary masks
+  vector<ExactDistanceMapSourceType::Pointer> m_ExactDistanceMapSources;
+  vector<itk::ProcessObject::Pointer>         m_MaskFilters;
+
+  // Padding of the binary masks for the distance images computation
+  static const unsigned int DistanceMapPaddingRadius = 2;
+
   // Parameters
   string         m_TempFilesPrefix; // Temp. directory
   vector<string> m_TemporaryFiles;  // Temp. filenames for distance images, masks, etc.
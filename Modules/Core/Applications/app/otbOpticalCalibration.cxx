@@ -31,6 +31,7 @@
 #include "itkMultiplyImageFilter.h"
 #include "otbClampImageFilter.h"
 #include "otbSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
+#include "otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
 #include "otbGroundSpacingImageFunction.h"
 
 #include <fstream>
@@ -99,6 +100,7 @@ public:
   typedef otb::ImageMetadataCorrectionParameters::Pointer AcquiCorrectionParametersPointerType;
 
   typedef otb::SurfaceAdjacencyEffectCorrectionSchemeFilter<DoubleVectorImageType, DoubleVectorImageType> SurfaceAdjacencyEffectCorrectionSchemeFilterType;
+  typedef otb::FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<DoubleVectorImageType, DoubleVectorImageType> FFTSurfaceAdjacencyEffectCorrectionSchemeFilterType;
 
   typedef otb::GroundSpacingImageFunction<FloatVectorImageType> GroundSpacingImageType;
 
@@ -336,12 +338,21 @@ private:
     SetParameterDescription("atmo.rsr", oss.str());
     MandatoryOff("atmo.rsr");
 
+    AddParameter(ParameterType_InputFilename, "atmo.lut", "Atmospheric LUT File");
+    SetParameterDescription("atmo.lut",
+                            "Table of precomputed atmospheric radiative terms (see the ComputeAtmosphericLUT application). "
+                            "When set, the radiative terms are interpolated in this table instead of running 6S. "
+                            "The table must contain the relative spectral responses of the bands for the selected aerosol model.");
+    MandatoryOff("atmo.lut");
+
     // Window radius for adjacency effects correction
     AddParameter(ParameterType_Int, "atmo.radius", "Window radius (adjacency effects)");
     SetParameterDescription("atmo.radius",
                             "Window radius for adjacency effects corrections"
                             "Setting this parameters will enable the correction of"
-                            "adjacency effects");
+                            "adjacency effects. Radii larger than 4 pixels are "
+                            "processed in the Fourier domain, whose cost does not "
+                            "depend on the radius.");
     MandatoryOff("atmo.radius");
     SetDefaultParameterInt("atmo.radius", 2);
     DisableParameter("atmo.radius");
@@ -920,6 +931,18 @@ private:
                                        GetParameterInt("acqui.hour"), GetParameterInt("acqui.minute"), 0.4);
       }
 
+      // Precomputed radiative terms
+      if (IsParameterEnabled("atmo.lut") && HasValue("atmo.lut"))
+      {
+        AtmosphericRadiativeTermsLUT::Pointer atmoLUT = AtmosphericRadiativeTermsLUT::New();
+        atmoLUT->Load(GetParameterString("atmo.lut"));
+        if (!atmoLUT->IsInside(AtmosphericRadiativeTermsLUT::MakePoint(m_paramAtmo, m_paramAcqui)))
+        {
+          otbAppLogWARNING("Atmospheric and acquisition parameters are outside of the atmospheric LUT, they are clamped to its bounds");
+        }
+        m_ReflectanceToSurfaceReflectanceFilter->SetAtmosphericRadiativeTermsLUT(atmoLUT);
+      }
+
       m_ReflectanceToSurfaceReflectanceFilter->UpdateOutputInformation();
       m_ReflectanceToSurfaceReflectanceFilter->SetIsSetAtmosphericRadiativeTerms(false);
       m_ReflectanceToSurfaceReflectanceFilter->SetUseGenerateParameters(true);
@@ -938,15 +961,21 @@ private:
       AtmosphericRadiativeTerms::Pointer atmoTerms = m_ReflectanceToSurfaceReflectanceFilter->GetAtmosphericRadiativeTerms();
       oss << std::endl << std::endl << atmoTerms << std::endl;
 
-      otbAppLogINFO("Atmospheric correction parameters compute by 6S : " + oss.str());
+      if (m_ReflectanceToSurfaceReflectanceFilter->GetAtmosphericRadiativeTermsLUT())
+        otbAppLogINFO("Atmospheric correction parameters interpolated in the LUT : " + oss.str());
+      else
+        otbAppLogINFO("Atmospheric correction parameters compute by 6S : " + oss.str());
 
       bool adjComputation = false;
       if (IsParameterEnabled("atmo.radius"))
       {
         otbAppLogINFO("Compute adjacency effects\n");
         adjComputation = true;
-        // Compute adjacency effect
-        m_SurfaceAdjacencyEffectCorrectionSchemeFilter = SurfaceAdjacencyEffectCorrectionSchemeFilterType::New();
+        // Compute adjacency effect, with FFTs for large windows
+        if (GetParameterInt("atmo.radius") > 4)
+          m_SurfaceAdjacencyEffectCorrectionSchemeFilter = FFTSurfaceAdjacencyEffectCorrectionSchemeFilterType::New();
+        else
+          m_SurfaceAdjacencyEffectCorrectionSchemeFilter = SurfaceAdjacencyEffectCorrectionSchemeFilterType::New();
 
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetAtmosphericRadiativeTerms(m_ReflectanceToSurfaceReflectanceFilter->GetAtmosphericRadiativeTerms());
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBlockedMatrixProduct_h
+#define otbBlockedMatrixProduct_h
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace otb
+{
+/**
+ * Number of pixels gathered at once by `ApplyLinearOperatorToPixels()`.
+ * With a few hundred bands, a block of pixels in double precision stays
+ * in the L2 cache.
+ */
+constexpr std::size_t BlockedMatrixProductPixelBlockSize = 64;
+
+/**
+ * Number of elements of the reduction dimension processed at once by
+ * `BlockedMatrixProduct()`.
+ */
+constexpr std::size_t BlockedMatrixProductDepthBlockSize = 256;
+
+/**
+ * Cache-blocked matrix product \f$ C = A . B \f$.
+ *
+ * All matrices are dense and stored row-major:
+ * - `a` is \f$ m \times k \f$,
+ * - `b` is \f$ k \times n \f$,
+ * - `c` is \f$ m \times n \f$ and is overwritten.
+ *
+ * The reduction dimension is split in panels of
+ * `BlockedMatrixProductDepthBlockSize` rows of `b`, so that the panel
+ * of `b` is reused from cache for every row of `a`. The innermost loop
+ * runs over contiguous rows of `b` and `c` and is left to the compiler
+ * to vectorize.
+ *
+ * `T` can be any type providing `+=`, `*` and construction from 0,
+ * including `std::complex`.
+ * @throw None
+ */
+template <typename T>
+void BlockedMatrixProduct(std::size_t m, std::size_t n, std::size_t k, T const* a, T const* b, T* c) noexcept
+{
+  std::fill(c, c + m * n, T(0));
+
+  for (std::size_t p0 = 0; p0 < k; p0 += BlockedMatrixProductDepthBlockSize)
+  {
+    const std::size_t p1 = std::min(k, p0 + BlockedMatrixProductDepthBlockSize);
+
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      T const* aRow = a + i * k;
+      T*       cRow = c + i * n;
+
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        const T  aip  = aRow[p];
+        T const* bRow = b + p * n;
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          cRow[j] += aip * bRow[j];
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Applies the same linear operator to a run of interleaved pixels.
+ *
+ * `in` holds `nbPixels` pixels of `nbInComps` components each,
+ * contiguous as in a `VectorImage` buffer line. `op` is the
+ * \f$ nbInComps \times nbOutComps \f$ row-major matrix such that each
+ * output pixel is the row vector \f$ p . op \f$. Results are written
+ * to `out`, `nbOutComps` components per pixel.
+ *
+ * Pixels are gathered by blocks of `BlockedMatrixProductPixelBlockSize`
+ * into a contiguous `T` matrix, multiplied with
+ * `BlockedMatrixProduct()`, and scattered back with a `static_cast` to
+ * the output component type.
+ * @throw std::bad_alloc
+ */
+template <typename T, typename TIn, typename TOut>
+void ApplyLinearOperatorToPixels(TIn const* in, std::size_t nbPixels, std::size_t nbInComps, T const* op, std::size_t nbOutComps, TOut* out)
+{
+  const std::size_t blockSize = std::min(nbPixels, BlockedMatrixProductPixelBlockSize);
+  std::vector<T>    gathered(blockSize * nbInComps);
+  std::vector<T>    product(blockSize * nbOutComps);
+
+  for (std::size_t first = 0; first < nbPixels; first += blockSize)
+  {
+    const std::size_t count = std::min(blockSize, nbPixels - first);
+
+    TIn const* inBlock = in + first * nbInComps;
+    for (std::size_t i = 0; i < count * nbInComps; ++i)
+    {
+      gathered[i] = static_cast<T>(inBlock[i]);
+    }
+
+    BlockedMatrixProduct(count, nbOutComps, nbInComps, gathered.data(), op, product.data());
+
+    TOut* outBlock = out + first * nbOutComps;
+    for (std::size_t i = 0; i < count * nbOutComps; ++i)
+    {
+      outBlock[i] = static_cast<TOut>(product[i]);
+    }
+  }
+}
+
+} // otb namespace
+
+#endif // otbBlockedMatrixProduct_h
@@ -62,6 +62,26 @@ public:
    */
   static std::string GetGeoidFile();
 
+  /**
+   * MetadataCacheDirectory is a directory where the metadata parsed
+   * from sensor products is cached (see ImageMetadataCache).
+   *
+   * If environment variable OTB_METADATA_CACHE_DIR is defined,
+   * returns it contents as a string
+   * Else, returns an empty string, and the cache is disabled
+   */
+  static std::string GetMetadataCacheDirectory();
+
+  /**
+   * TraceFile is the path of the Chrome trace file where execution
+   * spans are recorded (see Trace).
+   *
+   * If environment variable OTB_TRACE_FILE is defined,
+   * returns it contents as a string
+   * Else, returns an empty string, and tracing is disabled
+   */
+  static std::string GetTraceFile();
+
   /**
    * MaxRAMHint denotes the maximum memory OTB should use for
    * processing, expressed in MegaBytes.
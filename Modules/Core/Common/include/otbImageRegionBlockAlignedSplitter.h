@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbImageRegionBlockAlignedSplitter_h
+#define otbImageRegionBlockAlignedSplitter_h
+
+#include "itkRegion.h"
+#include "itkImageRegionSplitter.h"
+#include "itkIndex.h"
+#include "itkSize.h"
+#include <mutex>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageRegionBlockAlignedSplitter
+   * \brief Divide a region into pieces aligned on the blocks of the input and output files.
+   *
+   * Where ImageRegionAdaptativeSplitter follows a single tile hint, this
+   * splitter aligns the splits on the block grids of several input files
+   * (InputBlockSizes) and on the one of the output file (OutputBlockSize),
+   * so that no compressed input block is decoded for several splits and
+   * no output block is written partially. All the grids start at index 0.
+   *
+   * The splits are groups of cells of the least common multiple of the
+   * block sizes, the cells being grouped along lines first. A cell must
+   * not hold more pixels than a split of the requested number of splits:
+   * when the common grid is too large, the splits are aligned on the input
+   * blocks only, then on the output blocks only. If none of them fits,
+   * the splitter falls back to ImageRegionAdaptativeSplitter with the
+   * first input block size as tile hint.
+   *
+   * Once the splits are computed, GetInputDecodeAmplification() returns the
+   * number of input blocks read by the splits over the number of blocks
+   * of the region (the worst of the input grids, 1 when each block is
+   * decoded once, ignoring the GDAL block cache), and
+   * GetOutputWriteAmplification() does the same for the output blocks.
+   *
+   * A block size of 0 in a dimension means no constraint in this
+   * dimension. Only 2D regions are aligned.
+   *
+   * \sa ImageRegionAdaptativeSplitter
+   *
+   * \ingroup OTBCommon
+ */
+template <unsigned int VImageDimension>
+class ITK_EXPORT ImageRegionBlockAlignedSplitter : public itk::ImageRegionSplitter<VImageDimension>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageRegionBlockAlignedSplitter           Self;
+  typedef itk::ImageRegionSplitter<VImageDimension> Superclass;
+  typedef itk::SmartPointer<Self>                   Pointer;
+  typedef itk::SmartPointer<const Self>             ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageRegionBlockAlignedSplitter, itk::Object);
+
+  /** Dimension of the image available at compile time. */
+  itkStaticConstMacro(ImageDimension, unsigned int, VImageDimension);
+
+  typedef itk::Index<VImageDimension>        IndexType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+  typedef itk::Size<VImageDimension>         SizeType;
+  typedef typename SizeType::SizeValueType   SizeValueType;
+  typedef itk::ImageRegion<VImageDimension>  RegionType;
+
+  typedef std::vector<RegionType> StreamVectorType;
+  typedef std::vector<SizeType>   BlockSizeListType;
+
+  /** Set the block sizes of the input files */
+  void SetInputBlockSizes(const BlockSizeListType& blockSizes)
+  {
+    m_InputBlockSizes = blockSizes;
+    this->Modified();
+  }
+
+  const BlockSizeListType& GetInputBlockSizes() const
+  {
+    return m_InputBlockSizes;
+  }
+
+  /** Set the block size of the output file */
+  itkSetMacro(OutputBlockSize, SizeType);
+  itkGetConstReferenceMacro(OutputBlockSize, SizeType);
+
+  /** Set the ImageRegion parameter */
+  itkSetMacro(ImageRegion, RegionType);
+  itkGetConstReferenceMacro(ImageRegion, RegionType);
+
+  /** Set the requested number of splits parameter */
+  itkSetMacro(RequestedNumberOfSplits, unsigned int);
+  itkGetConstReferenceMacro(RequestedNumberOfSplits, unsigned int);
+
+  /** Size of the cells the splits are aligned on, 0 when the splitter
+   * fell back to ImageRegionAdaptativeSplitter */
+  itkGetConstReferenceMacro(AlignmentSize, SizeType);
+
+  /** Blocks decoded by the splits over the blocks of the region, for the
+   * worst input grid */
+  itkGetConstMacro(InputDecodeAmplification, double);
+
+  /** Blocks written by the splits over the blocks of the region, for the
+   * output grid */
+  itkGetConstMacro(OutputWriteAmplification, double);
+
+  /** Set the image region and the requested number of splits, and compute
+   * the splits if necessary */
+  unsigned int GetNumberOfSplits(const RegionType& region, unsigned int requestedNumber) override;
+
+  /** Set the image region, compute the splits if necessary and return the
+   * ith one */
+  RegionType GetSplit(unsigned int i, unsigned int numberOfPieces, const RegionType& region) override;
+
+  /** Number of blocks of the given size intersecting the splits, over the
+   * number of blocks intersecting the region */
+  static double ComputeBlockAmplification(const StreamVectorType& splits, const RegionType& region, const SizeType& blockSize);
+
+  /** Make the Modified() method update the IsUpToDate flag */
+  void Modified() const override
+  {
+    Superclass::Modified();
+    m_IsUpToDate = false;
+  }
+
+protected:
+  ImageRegionBlockAlignedSplitter()
+    : m_ImageRegion(), m_RequestedNumberOfSplits(0), m_InputDecodeAmplification(1.), m_OutputWriteAmplification(1.), m_IsUpToDate(false)
+  {
+    m_OutputBlockSize.Fill(0);
+    m_AlignmentSize.Fill(0);
+  }
+
+  ~ImageRegionBlockAlignedSplitter() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ImageRegionBlockAlignedSplitter(const ImageRegionBlockAlignedSplitter&) = delete;
+  void operator=(const ImageRegionBlockAlignedSplitter&) = delete;
+
+  /** Compute the splits and the amplifications */
+  void EstimateSplitMap();
+
+  /** Least common multiple of the block sizes, capped to the end of the
+   * region. Returns false if no block constrains the region. */
+  bool ComputeAlignment(const BlockSizeListType& blockSizes, SizeType& alignment) const;
+
+  /** Group the cells of the alignment grid in splits of at most
+   * maxPixels pixels */
+  void GroupCells(const SizeType& alignment, SizeValueType maxPixels);
+
+  BlockSizeListType m_InputBlockSizes;
+  SizeType          m_OutputBlockSize;
+  RegionType        m_ImageRegion;
+  unsigned int      m_RequestedNumberOfSplits;
+  SizeType          m_AlignmentSize;
+  double            m_InputDecodeAmplification;
+  double            m_OutputWriteAmplification;
+  StreamVectorType  m_StreamVector;
+
+  // Is the splitter up-to-date ?
+  mutable bool m_IsUpToDate;
+
+  // Lock to ensure thread-safety
+  std::mutex m_Lock;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbImageRegionBlockAlignedSplitter.hxx"
+#endif
+
+#endif
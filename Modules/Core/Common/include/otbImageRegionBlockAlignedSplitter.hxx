@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbImageRegionBlockAlignedSplitter_hxx
+#define otbImageRegionBlockAlignedSplitter_hxx
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "otbImageRegionAdaptativeSplitter.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <unsigned int VImageDimension>
+unsigned int ImageRegionBlockAlignedSplitter<VImageDimension>::GetNumberOfSplits(const RegionType& region, unsigned int requestedNumber)
+{
+  this->SetImageRegion(region);
+  this->SetRequestedNumberOfSplits(requestedNumber);
+
+  std::lock_guard<std::mutex> mutexHolder(m_Lock);
+  if (!m_IsUpToDate)
+  {
+    this->EstimateSplitMap();
+  }
+  return m_StreamVector.size();
+}
+
+template <unsigned int            VImageDimension>
+itk::ImageRegion<VImageDimension> ImageRegionBlockAlignedSplitter<VImageDimension>::GetSplit(unsigned int i, unsigned int itkNotUsed(numberOfPieces),
+                                                                                             const RegionType& region)
+{
+  this->SetImageRegion(region);
+
+  std::lock_guard<std::mutex> mutexHolder(m_Lock);
+  if (!m_IsUpToDate)
+  {
+    this->EstimateSplitMap();
+  }
+  return m_StreamVector.at(i);
+}
+
+template <unsigned int VImageDimension>
+double ImageRegionBlockAlignedSplitter<VImageDimension>::ComputeBlockAmplification(const StreamVectorType& splits, const RegionType& region,
+                                                                                   const SizeType& blockSize)
+{
+  auto nbBlocks = [&blockSize](const RegionType& r) {
+    double nb = 1.;
+    for (unsigned int d = 0; d < VImageDimension; ++d)
+    {
+      const IndexValueType b = std::max<IndexValueType>(blockSize[d], 1);
+      nb *= (r.GetIndex(d) + static_cast<IndexValueType>(r.GetSize(d)) - 1) / b - r.GetIndex(d) / b + 1;
+    }
+    return nb;
+  };
+
+  double read = 0.;
+  for (const auto& split : splits)
+  {
+    read += nbBlocks(split);
+  }
+  return read / nbBlocks(region);
+}
+
+template <unsigned int VImageDimension>
+bool ImageRegionBlockAlignedSplitter<VImageDimension>::ComputeAlignment(const BlockSizeListType& blockSizes, SizeType& alignment) const
+{
+  bool constrained = false;
+  for (unsigned int d = 0; d < VImageDimension; ++d)
+  {
+    const SizeValueType end = m_ImageRegion.GetIndex(d) + m_ImageRegion.GetSize(d);
+    SizeValueType       lcm = 1;
+    for (const auto& blockSize : blockSizes)
+    {
+      const SizeValueType b = std::max<SizeValueType>(blockSize[d], 1);
+      if (b > 1)
+      {
+        constrained = true;
+      }
+      SizeValueType x = lcm, y = b;
+      while (y != 0)
+      {
+        const SizeValueType r = x % y;
+        x                     = y;
+        y                     = r;
+      }
+      lcm = lcm / x * b;
+      // A single cell covers the region
+      if (lcm >= end)
+      {
+        lcm = end;
+        break;
+      }
+    }
+    alignment[d] = lcm;
+  }
+  return constrained;
+}
+
+template <unsigned int VImageDimension>
+void ImageRegionBlockAlignedSplitter<VImageDimension>::GroupCells(const SizeType& alignment, SizeValueType maxPixels)
+{
+  SizeType  cellsPerDim, groupCells, splitsPerDim;
+  IndexType firstCell;
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    firstCell[d]   = m_ImageRegion.GetIndex(d) / alignment[d];
+    cellsPerDim[d] = (m_ImageRegion.GetIndex(d) + m_ImageRegion.GetSize(d) + alignment[d] - 1) / alignment[d] - firstCell[d];
+  }
+
+  // Whole lines of cells first, then several lines, balancing the size
+  // of the groups
+  const SizeValueType maxCells = std::max<SizeValueType>(maxPixels / (alignment[0] * alignment[1]), 1);
+  SizeType            maxGroup;
+  maxGroup[0] = std::min(cellsPerDim[0], maxCells);
+  maxGroup[1] = maxGroup[0] == cellsPerDim[0] ? std::max<SizeValueType>(std::min(cellsPerDim[1], maxCells / cellsPerDim[0]), 1) : 1;
+
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    splitsPerDim[d] = (cellsPerDim[d] + maxGroup[d] - 1) / maxGroup[d];
+    groupCells[d]   = (cellsPerDim[d] + splitsPerDim[d] - 1) / splitsPerDim[d];
+  }
+
+  for (SizeValueType splity = 0; splity < splitsPerDim[1]; ++splity)
+  {
+    for (SizeValueType splitx = 0; splitx < splitsPerDim[0]; ++splitx)
+    {
+      RegionType newSplit;
+      for (unsigned int d = 0; d < 2; ++d)
+      {
+        const SizeValueType split = d == 0 ? splitx : splity;
+        newSplit.SetIndex(d, (firstCell[d] + split * groupCells[d]) * alignment[d]);
+        newSplit.SetSize(d, groupCells[d] * alignment[d]);
+      }
+
+      if (newSplit.Crop(m_ImageRegion))
+      {
+        m_StreamVector.push_back(newSplit);
+      }
+    }
+  }
+}
+
+template <unsigned int VImageDimension>
+void ImageRegionBlockAlignedSplitter<VImageDimension>::EstimateSplitMap()
+{
+  m_StreamVector.clear();
+  m_AlignmentSize.Fill(0);
+
+  if (m_RequestedNumberOfSplits <= 1)
+  {
+    m_StreamVector.push_back(m_ImageRegion);
+  }
+  else if (VImageDimension == 2)
+  {
+    const SizeValueType maxPixels = (m_ImageRegion.GetNumberOfPixels() + m_RequestedNumberOfSplits - 1) / m_RequestedNumberOfSplits;
+
+    // From the most to the least constrained grid
+    BlockSizeListType all(m_InputBlockSizes);
+    all.push_back(m_OutputBlockSize);
+    const std::vector<BlockSizeListType> candidates = {all, m_InputBlockSizes, BlockSizeListType(1, m_OutputBlockSize)};
+
+    for (const auto& blockSizes : candidates)
+    {
+      SizeType alignment;
+      if (this->ComputeAlignment(blockSizes, alignment) && alignment[0] * alignment[1] <= maxPixels)
+      {
+        m_AlignmentSize = alignment;
+        this->GroupCells(alignment, maxPixels);
+        break;
+      }
+    }
+  }
+
+  if (m_StreamVector.empty())
+  {
+    typedef ImageRegionAdaptativeSplitter<VImageDimension> AdaptativeSplitterType;
+    typename AdaptativeSplitterType::Pointer splitter = AdaptativeSplitterType::New();
+    SizeType                                 tileHint;
+    tileHint.Fill(0);
+    if (!m_InputBlockSizes.empty())
+    {
+      tileHint = m_InputBlockSizes.front();
+    }
+    splitter->SetTileHint(tileHint);
+
+    const unsigned int nbSplits = splitter->GetNumberOfSplits(m_ImageRegion, m_RequestedNumberOfSplits);
+    for (unsigned int i = 0; i < nbSplits; ++i)
+    {
+      m_StreamVector.push_back(splitter->GetSplit(i, nbSplits, m_ImageRegion));
+    }
+  }
+
+  m_InputDecodeAmplification = 1.;
+  for (const auto& blockSize : m_InputBlockSizes)
+  {
+    m_InputDecodeAmplification = std::max(m_InputDecodeAmplification, ComputeBlockAmplification(m_StreamVector, m_ImageRegion, blockSize));
+  }
+  m_OutputWriteAmplification = ComputeBlockAmplification(m_StreamVector, m_ImageRegion, m_OutputBlockSize);
+
+  m_IsUpToDate = true;
+}
+
+template <unsigned int VImageDimension>
+void ImageRegionBlockAlignedSplitter<VImageDimension>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "IsUpToDate: " << (m_IsUpToDate ? "true" : "false") << std::endl;
+  os << indent << "ImageRegion: " << m_ImageRegion << std::endl;
+  for (const auto& blockSize : m_InputBlockSizes)
+  {
+    os << indent << "Input block size: " << blockSize << std::endl;
+  }
+  os << indent << "Output block size: " << m_OutputBlockSize << std::endl;
+  os << indent << "Requested number of splits: " << m_RequestedNumberOfSplits << std::endl;
+  os << indent << "Actual number of splits: " << m_StreamVector.size() << std::endl;
+  os << indent << "Alignment size: " << m_AlignmentSize << std::endl;
+  os << indent << "Input decode amplification: " << m_InputDecodeAmplification << std::endl;
+  os << indent << "Output write amplification: " << m_OutputWriteAmplification << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageView_h
+#define otbImageView_h
+
+#include "otbMdSpan.h"
+#include "itkMacro.h"
+#include <type_traits>
+
+namespace otb
+{
+
+/** Extents of an image view: x, y and band */
+using ImageViewExtents = extents<dynamic_extent, dynamic_extent, dynamic_extent>;
+
+/** View over a region of an image buffer, indexed by (x, y, band)
+ * relatively to the start of the region.
+ *
+ * Bands are contiguous (stride 1), and the line stride is the one of
+ * the buffer, so that a view can cover a region smaller than the
+ * buffered region without copy. A view does not own the data: it is
+ * valid as long as the buffer of the image is.
+ *
+ * \code
+ * auto in  = MakeImageView(inputImage, region);
+ * auto out = MakeImageView(outputImage, region);
+ * for (ptrdiff_t y = 0; y < in.extent(1); ++y)
+ *   for (ptrdiff_t x = 0; x < in.extent(0); ++x)
+ *     for (ptrdiff_t b = 0; b < in.extent(2); ++b)
+ *       out(x, y, b) = 2 * in(x, y, b);
+ * \endcode
+ *
+ * \sa MakeImageView
+ */
+template <class T>
+using ImageView = basic_mdspan<T, ImageViewExtents, layout_stride>;
+
+/** Element type of the views over TImage: its internal pixel type,
+ * const for a const image */
+template <class TImage>
+using ImageViewValueType =
+    typename std::conditional<std::is_const<TImage>::value, const typename TImage::InternalPixelType, typename TImage::InternalPixelType>::type;
+
+/** Make a view over a region of the buffer of an image.
+ *
+ * Works with any 2D image storing its pixels in a single buffer
+ * (otb::Image, otb::VectorImage and their ITK counterparts). For an
+ * image of scalars (including images of FixedArray or RGBPixel, whose
+ * internal pixel type is the pixel type), the view has a single band.
+ *
+ * \throw itk::ExceptionObject if the region is not buffered
+ */
+template <class TImage>
+ImageView<ImageViewValueType<TImage>> MakeImageView(TImage* image, const typename TImage::RegionType& region)
+{
+  static_assert(TImage::ImageDimension == 2, "Image views are only available for 2D images");
+
+  const auto& buffered = image->GetBufferedRegion();
+  if (!buffered.IsInside(region))
+  {
+    itkGenericExceptionMacro(<< "Can not make a view over region " << region << " which is not inside the buffered region " << buffered);
+  }
+
+  using ValueType = ImageViewValueType<TImage>;
+  using ViewType  = ImageView<ValueType>;
+  using IndexType = typename ViewType::index_type;
+
+  const bool      isScalar = std::is_same<typename TImage::PixelType, typename TImage::InternalPixelType>::value;
+  const IndexType nbBands  = isScalar ? 1 : static_cast<IndexType>(image->GetNumberOfComponentsPerPixel());
+
+  ValueType* origin = image->GetBufferPointer() + image->ComputeOffset(region.GetIndex()) * nbBands;
+
+  const typename ViewType::mapping_type mapping(
+      ImageViewExtents(static_cast<IndexType>(region.GetSize()[0]), static_cast<IndexType>(region.GetSize()[1]), nbBands),
+      {{nbBands, static_cast<IndexType>(buffered.GetSize()[0]) * nbBands, 1}});
+  return ViewType(origin, mapping);
+}
+
+/** Make a view over the buffered region of an image */
+template <class TImage>
+ImageView<ImageViewValueType<TImage>> MakeImageView(TImage* image)
+{
+  return MakeImageView(image, image->GetBufferedRegion());
+}
+
+/** Make a view over count bands of a view, starting at band first */
+template <class T>
+ImageView<T> SelectBands(const ImageView<T>& view, typename ImageView<T>::index_type first, typename ImageView<T>::index_type count)
+{
+  assert(first >= 0 && count >= 0 && first + count <= view.extent(2));
+  const typename ImageView<T>::mapping_type mapping(ImageViewExtents(view.extent(0), view.extent(1), count), {{view.stride(0), view.stride(1), view.stride(2)}});
+  return ImageView<T>(view.data() + first * view.stride(2), mapping);
+}
+
+} // end namespace otb
+
+#endif
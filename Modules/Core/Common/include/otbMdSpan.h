@@ -95,7 +95,7 @@ public:
 
   template<class OtherElementType, class OtherExtents, class OtherLayoutPolicy>
   constexpr basic_mdspan(const basic_mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy>& other) noexcept
-  : m_ptr(other.m_ptr), m_map(other.m_map)
+  : m_ptr(other.data()), m_map(other.mapping())
   {}
 
   ~basic_mdspan() = default;
@@ -106,8 +106,8 @@ public:
   template<class OtherElementType, class OtherExtents, class OtherLayoutPolicy>
   constexpr basic_mdspan& operator=(const basic_mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy>& other) noexcept
   {
-    m_ptr = other.m_ptr;
-    m_map = other.m_map;
+    m_ptr = other.data();
+    m_map = other.mapping();
     return *this;
   }
 
@@ -21,6 +21,7 @@
 #ifndef otbSystem_h
 #define otbSystem_h
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -63,6 +64,10 @@ public:
 
   /** Returns true if the file descriptor fd is interactive (i.e. like isatty on unix) */
   static bool IsInteractive(int fd);
+
+  /** Get the resident memory of the process and its peak, in bytes.
+   * Returns false if they are not available on this system. */
+  static bool GetProcessMemory(std::uint64_t& resident, std::uint64_t& peakResident);
 };
 
 } // namespace otb
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTrace_h
+#define otbTrace_h
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "itkDataObject.h"
+#include "itkProcessObject.h"
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class Trace
+ * \brief Record of execution spans in a Chrome trace file.
+ *
+ * Tracing is enabled when the environment variable OTB_TRACE_FILE is
+ * set (see ConfigurationManager::GetTraceFile()): the spans are then
+ * written to this file in the Chrome trace event format, which can be
+ * loaded in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+ * When tracing is disabled, recording a span costs a test.
+ *
+ * Spans are usually recorded with TraceSpan, and the update of each
+ * filter of a pipeline with PipelineTrace.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT Trace
+{
+public:
+  using TimestampType = std::uint64_t;
+  using ArgumentsType = std::vector<std::pair<std::string, std::string>>;
+
+  /** Returns whether tracing is enabled */
+  static bool IsEnabled();
+
+  /** Current time, in microseconds */
+  static TimestampType GetTimestamp();
+
+  /** Record a span of the calling thread, from start to now */
+  static void AddSpan(const char* category, const char* name, TimestampType start, const ArgumentsType& arguments = ArgumentsType());
+
+  /** Write the recorded spans to the trace file. The file is also
+   * flushed and closed at exit. */
+  static void Flush();
+
+private:
+  Trace()             = delete;
+  ~Trace()            = delete;
+  Trace(const Trace&) = delete;
+  void operator=(const Trace&) = delete;
+};
+
+/** \class TraceSpan
+ * \brief Record a span from its construction to its destruction.
+ *
+ * \code
+ * {
+ *   TraceSpan span("io", "Read");
+ *   span.AddArgument("file", filename);
+ *   ...
+ * }
+ * \endcode
+ *
+ * The category and the name must outlive the span (string literals or
+ * class names for instance). Nothing is done when tracing is disabled.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT TraceSpan
+{
+public:
+  TraceSpan(const char* category, const char* name);
+  ~TraceSpan();
+
+  /** Add an argument shown with the span, formatted with operator<< */
+  template <class T>
+  void AddArgument(const char* key, const T& value)
+  {
+    if (m_Enabled)
+    {
+      std::ostringstream oss;
+      oss << value;
+      m_Arguments.emplace_back(key, oss.str());
+    }
+  }
+
+private:
+  TraceSpan(const TraceSpan&) = delete;
+  void operator=(const TraceSpan&) = delete;
+
+  bool                 m_Enabled;
+  const char*          m_Category;
+  const char*          m_Name;
+  Trace::TimestampType m_Start;
+  Trace::ArgumentsType m_Arguments;
+};
+
+/** \class PipelineTrace
+ * \brief Record the GenerateData of each filter of a pipeline.
+ *
+ * While it exists, the process objects upstream of its data objects
+ * are observed, and a span is recorded between the StartEvent and the
+ * EndEvent of each of them. Nothing is done when tracing is disabled.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT PipelineTrace
+{
+public:
+  PipelineTrace() = default;
+  explicit PipelineTrace(itk::DataObject* output);
+  ~PipelineTrace();
+
+  /** Observe the pipeline upstream of another data object */
+  void AddOutput(itk::DataObject* output);
+
+private:
+  PipelineTrace(const PipelineTrace&) = delete;
+  void operator=(const PipelineTrace&) = delete;
+
+  void Observe(itk::ProcessObject* process);
+  void OnEvent(itk::Object* caller, const itk::EventObject& event);
+
+  std::vector<std::pair<itk::ProcessObject::Pointer, unsigned long>> m_Observers;
+  std::map<const itk::Object*, Trace::TimestampType>                 m_Starts;
+  std::mutex                                                         m_Mutex;
+};
+
+} // namespace otb
+
+#endif
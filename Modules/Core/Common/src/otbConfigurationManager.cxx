@@ -52,6 +52,20 @@ std::string ConfigurationManager::GetGeoidFile()
   return svalue;
 }
 
+std::string ConfigurationManager::GetMetadataCacheDirectory()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_METADATA_CACHE_DIR", svalue);
+  return svalue;
+}
+
+std::string ConfigurationManager::GetTraceFile()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_TRACE_FILE", svalue);
+  return svalue;
+}
+
 ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
 {
   std::string max_ram_hint;
@@ -29,6 +29,10 @@
                    WIN32 / MSVC++ implementation
  *====================================================================*/
 #include <Windows.h>
+#ifndef PSAPI_VERSION
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo from kernel32
+#endif
+#include <psapi.h>
 #include <tchar.h>
 #include <stdio.h>
 #ifndef WIN32CE
@@ -43,6 +47,12 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <dirent.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
 #endif
 
 namespace otb
@@ -241,4 +251,44 @@ bool System::IsInteractive(int fd)
   return isatty(fd);
 #endif
 }
+
+bool System::GetProcessMemory(std::uint64_t& resident, std::uint64_t& peakResident)
+{
+  resident     = 0;
+  peakResident = 0;
+#if (defined(WIN32) || defined(WIN32CE)) && !defined(__CYGWIN__) && !defined(__MINGW32__)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return false;
+  resident     = counters.WorkingSetSize;
+  peakResident = counters.PeakWorkingSetSize;
+  return true;
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    return false;
+  resident     = info.resident_size;
+  peakResident = info.resident_size_max;
+  return true;
+#else
+  // Linux: sizes in kB in /proc/self/status
+  std::ifstream status("/proc/self/status");
+  std::string   line;
+  while (std::getline(status, line))
+  {
+    std::uint64_t* value = nullptr;
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      value = &resident;
+    else if (line.compare(0, 6, "VmHWM:") == 0)
+      value = &peakResident;
+    else
+      continue;
+    std::istringstream iss(line.substr(6));
+    iss >> *value;
+    *value *= 1024;
+  }
+  return resident != 0;
+#endif
+}
 }
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbTrace.h"
+#include "otbConfigurationManager.h"
+#include "otbLogger.h"
+
+#include "itkCommand.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <set>
+
+namespace otb
+{
+
+namespace
+{
+
+/** Trace file, opened at the first span and closed at exit */
+class TraceFile
+{
+public:
+  static TraceFile& GetInstance()
+  {
+    static TraceFile instance;
+    return instance;
+  }
+
+  bool IsOpen() const
+  {
+    return m_IsOpen;
+  }
+
+  void Write(const std::string& event)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_IsFirst)
+      m_Stream << ",\n";
+    m_Stream << event;
+    m_IsFirst = false;
+  }
+
+  void Flush()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stream.flush();
+  }
+
+  ~TraceFile()
+  {
+    if (m_IsOpen)
+    {
+      m_Stream << "\n]\n";
+    }
+  }
+
+private:
+  TraceFile() : m_IsOpen(false), m_IsFirst(true)
+  {
+    const std::string filename = ConfigurationManager::GetTraceFile();
+    if (filename.empty())
+    {
+      return;
+    }
+    m_Stream.open(filename);
+    if (!m_Stream)
+    {
+      otbLogMacro(Warning, << "Can not open the trace file " << filename << ", tracing is disabled");
+      return;
+    }
+    m_Stream << "[\n";
+    m_IsOpen = true;
+  }
+
+  std::ofstream m_Stream;
+  std::mutex    m_Mutex;
+  bool          m_IsOpen;
+  bool          m_IsFirst;
+};
+
+/** Small identifier of the calling thread */
+unsigned int GetThreadIdentifier()
+{
+  static std::atomic<unsigned int> nextIdentifier(0);
+  thread_local unsigned int        identifier = nextIdentifier++;
+  return identifier;
+}
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        os << ' ';
+      else
+        os << c;
+    }
+  }
+  os << '"';
+}
+
+/** Process objects observed by a PipelineTrace, so that nested
+ * pipeline traces do not record them twice */
+std::mutex                    observedMutex;
+std::set<itk::ProcessObject*> observedProcesses;
+
+} // namespace
+
+bool Trace::IsEnabled()
+{
+  static const bool enabled = TraceFile::GetInstance().IsOpen();
+  return enabled;
+}
+
+Trace::TimestampType Trace::GetTimestamp()
+{
+  using namespace std::chrono;
+  static const steady_clock::time_point origin = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - origin).count();
+}
+
+void Trace::AddSpan(const char* category, const char* name, TimestampType start, const ArgumentsType& arguments)
+{
+  if (!IsEnabled())
+  {
+    return;
+  }
+
+  const TimestampType end = GetTimestamp();
+
+  std::ostringstream oss;
+  oss << "{\"name\":";
+  WriteJSONString(oss, name);
+  oss << ",\"cat\":";
+  WriteJSONString(oss, category);
+  oss << ",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << end - start << ",\"pid\":0,\"tid\":" << GetThreadIdentifier();
+  if (!arguments.empty())
+  {
+    oss << ",\"args\":{";
+    for (auto it = arguments.begin(); it != arguments.end(); ++it)
+    {
+      if (it != arguments.begin())
+        oss << ',';
+      WriteJSONString(oss, it->first);
+      oss << ':';
+      WriteJSONString(oss, it->second);
+    }
+    oss << '}';
+  }
+  oss << '}';
+
+  TraceFile::GetInstance().Write(oss.str());
+}
+
+void Trace::Flush()
+{
+  if (IsEnabled())
+  {
+    TraceFile::GetInstance().Flush();
+  }
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name)
+  : m_Enabled(Trace::IsEnabled()), m_Category(category), m_Name(name), m_Start(m_Enabled ? Trace::GetTimestamp() : 0)
+{
+}
+
+TraceSpan::~TraceSpan()
+{
+  if (m_Enabled)
+  {
+    Trace::AddSpan(m_Category, m_Name, m_Start, m_Arguments);
+  }
+}
+
+PipelineTrace::PipelineTrace(itk::DataObject* output)
+{
+  this->AddOutput(output);
+}
+
+void PipelineTrace::AddOutput(itk::DataObject* output)
+{
+  if (!Trace::IsEnabled() || output == nullptr)
+  {
+    return;
+  }
+
+  // Walk the pipeline upstream
+  std::set<itk::ProcessObject*>    visited;
+  std::vector<itk::ProcessObject*> toVisit;
+  if (output->GetSource())
+    toVisit.push_back(output->GetSource());
+  while (!toVisit.empty())
+  {
+    itk::ProcessObject* process = toVisit.back();
+    toVisit.pop_back();
+    if (!visited.insert(process).second)
+    {
+      continue;
+    }
+    this->Observe(process);
+    for (itk::DataObject* input : process->GetInputs())
+    {
+      if (input != nullptr && input->GetSource())
+        toVisit.push_back(input->GetSource());
+    }
+  }
+}
+
+PipelineTrace::~PipelineTrace()
+{
+  std::lock_guard<std::mutex> lock(observedMutex);
+  for (auto& observer : m_Observers)
+  {
+    observer.first->RemoveObserver(observer.second);
+    observedProcesses.erase(observer.first.GetPointer());
+  }
+}
+
+void PipelineTrace::Observe(itk::ProcessObject* process)
+{
+  using CommandType = itk::MemberCommand<PipelineTrace>;
+
+  std::lock_guard<std::mutex> lock(observedMutex);
+  if (!observedProcesses.insert(process).second)
+  {
+    return;
+  }
+
+  CommandType::Pointer command = CommandType::New();
+  command->SetCallbackFunction(this, &PipelineTrace::OnEvent);
+  m_Observers.emplace_back(process, process->AddObserver(itk::StartEvent(), command));
+  m_Observers.emplace_back(process, process->AddObserver(itk::EndEvent(), command));
+}
+
+void PipelineTrace::OnEvent(itk::Object* caller, const itk::EventObject& event)
+{
+  if (itk::StartEvent().CheckEvent(&event))
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Starts[caller] = Trace::GetTimestamp();
+    return;
+  }
+
+  Trace::TimestampType start;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Starts.find(caller);
+    if (it == m_Starts.end())
+    {
+      return;
+    }
+    start = it->second;
+    m_Starts.erase(it);
+  }
+  Trace::AddSpan("filter", caller->GetNameOfClass(), start);
+}
+
+} // namespace otb
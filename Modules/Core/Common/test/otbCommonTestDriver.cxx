@@ -24,10 +24,12 @@ void RegisterTests()
 {
   REGISTER_TEST(otbImageRegionTileMapSplitter);
   REGISTER_TEST(otbImageRegionAdaptativeSplitter);
+  REGISTER_TEST(otbImageRegionBlockAlignedSplitter);
   REGISTER_TEST(otbRGBAPixelConverter);
   REGISTER_TEST(otbRectangle);
   REGISTER_TEST(otbSystemTest);
   REGISTER_TEST(otbStopwatchTest);
+  REGISTER_TEST(otbTraceTest);
   REGISTER_TEST(otbParseHdfSubsetName);
   REGISTER_TEST(otbParseHdfFileName);
   REGISTER_TEST(otbImageRegionSquareTileSplitter);
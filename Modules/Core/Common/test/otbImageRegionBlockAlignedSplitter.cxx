@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include <cstdlib>
+#include <iostream>
+
+typedef otb::ImageRegionBlockAlignedSplitter<2> BlockAlignedSplitterType;
+
+int otbImageRegionBlockAlignedSplitter(int itkNotUsed(argc), char* argv[])
+{
+  typedef BlockAlignedSplitterType::RegionType RegionType;
+  typedef BlockAlignedSplitterType::SizeType   SizeType;
+
+  RegionType region;
+  region.SetIndex(0, atoi(argv[1]));
+  region.SetIndex(1, atoi(argv[2]));
+  region.SetSize(0, atoi(argv[3]));
+  region.SetSize(1, atoi(argv[4]));
+
+  SizeType inputBlockSize, outputBlockSize;
+  inputBlockSize[0]  = atoi(argv[5]);
+  inputBlockSize[1]  = atoi(argv[6]);
+  outputBlockSize[0] = atoi(argv[7]);
+  outputBlockSize[1] = atoi(argv[8]);
+
+  const unsigned int requestedNbSplits = atoi(argv[9]);
+  const double       maxInputAmplif    = atof(argv[10]);
+  const double       maxOutputAmplif   = atof(argv[11]);
+
+  BlockAlignedSplitterType::Pointer splitter = BlockAlignedSplitterType::New();
+  splitter->SetInputBlockSizes(BlockAlignedSplitterType::BlockSizeListType(1, inputBlockSize));
+  splitter->SetOutputBlockSize(outputBlockSize);
+
+  const unsigned int nbSplits = splitter->GetNumberOfSplits(region, requestedNbSplits);
+  std::cout << splitter << std::endl;
+
+  // The splits must be a partition of the region
+  BlockAlignedSplitterType::StreamVectorType splits;
+  itk::SizeValueType                         nbPixels = 0;
+  for (unsigned int i = 0; i < nbSplits; ++i)
+  {
+    const RegionType split = splitter->GetSplit(i, nbSplits, region);
+    if (!region.IsInside(split))
+    {
+      std::cout << "Split " << split << " is outside of the region" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (const auto& other : splits)
+    {
+      RegionType intersection = split;
+      if (intersection.Crop(other))
+      {
+        std::cout << "Splits " << split << " and " << other << " overlap" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    nbPixels += split.GetNumberOfPixels();
+    splits.push_back(split);
+  }
+  if (nbPixels != region.GetNumberOfPixels())
+  {
+    std::cout << "The splits have " << nbPixels << " pixels instead of " << region.GetNumberOfPixels() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Aligned splits must fit in the requested number of splits
+  const SizeType alignment = splitter->GetAlignmentSize();
+  if (alignment[0] != 0 && nbSplits < requestedNbSplits)
+  {
+    std::cout << "Got " << nbSplits << " aligned splits for " << requestedNbSplits << " requested" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (splitter->GetInputDecodeAmplification() > maxInputAmplif + 1e-9 || splitter->GetOutputWriteAmplification() > maxOutputAmplif + 1e-9)
+  {
+    std::cout << "Amplifications " << splitter->GetInputDecodeAmplification() << " (input) and " << splitter->GetOutputWriteAmplification()
+              << " (output) instead of at most " << maxInputAmplif << " and " << maxOutputAmplif << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
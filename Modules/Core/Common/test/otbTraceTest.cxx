@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "otbTrace.h"
+
+int otbTraceTest(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " trace_file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!otb::Trace::IsEnabled())
+  {
+    std::cerr << "Tracing is not enabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    otb::TraceSpan span("test", "Outer");
+    span.AddArgument("file", "C:\\data\\\"image\".tif");
+    span.AddArgument("size", 42);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([] { otb::TraceSpan workUnit("test", "WorkUnit"); });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+  otb::Trace::Flush();
+
+  std::ifstream     ifs(argv[1]);
+  const std::string trace((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+  const std::vector<std::string> expected = {"[\n",
+                                             "\"name\":\"Outer\",\"cat\":\"test\",\"ph\":\"X\"",
+                                             "\"args\":{\"file\":\"C:\\\\data\\\\\\\"image\\\".tif\",\"size\":\"42\"}",
+                                             "\"name\":\"WorkUnit\""};
+  for (const auto& str : expected)
+  {
+    if (trace.find(str) == std::string::npos)
+    {
+      std::cerr << "Can not find " << str << " in the trace:\n" << trace << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::size_t nbWorkUnits = 0;
+  for (std::size_t pos = trace.find("WorkUnit"); pos != std::string::npos; pos = trace.find("WorkUnit", pos + 1))
+  {
+    ++nbWorkUnits;
+  }
+  if (nbWorkUnits != 4)
+  {
+    std::cerr << "Got " << nbWorkUnits << " work units instead of 4" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -42,6 +42,10 @@ namespace otb
  *
  * The output is a map of key points density.
  *
+ * The key points are detected once on the whole image, then the density
+ * is computed by multiple threads on the requested regions of the output,
+ * which can be streamed.
+ *
  * \ingroup OTBDensity
  */
 
@@ -79,6 +83,12 @@ public:
   typedef otb::PointSetToDensityImageFilter<PointSetType, OutputImageType> PointSetToDensityImageType;
   typedef typename PointSetToDensityImageType::Pointer PointSetToDensityImagePointerType;
 
+  /** Density function evaluated on each output pixel */
+  typedef typename PointSetToDensityImageType::PointSetDensityFunctionType DensityFunctionType;
+  typedef typename DensityFunctionType::Pointer                            DensityFunctionPointerType;
+
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+
   /** Get/Set the radius of the neighborhood over which the
   statistics are evaluated */
   itkSetMacro(NeighborhoodRadius, unsigned int);
@@ -101,19 +111,28 @@ protected:
    * Standard PrintSelf method.
    */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+  /**
+   * The detector needs the whole input.
+   */
+  void GenerateInputRequestedRegion() override;
+
+  /**
+   * Detect the key points, if not done yet.
+   */
+  void BeforeThreadedGenerateData() override;
+
   /**
    * Main computation method.
    */
-  // virtual void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId );
-  void GenerateData() override;
+  void DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread) override;
 
 private:
   KeyPointDensityImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  DetectorPointerType               m_Detector;
-  PointSetToDensityImagePointerType m_PointSetToDensityImageFilter;
-  unsigned int                      m_NeighborhoodRadius;
+  DetectorPointerType        m_Detector;
+  DensityFunctionPointerType m_DensityFunction;
+  unsigned int               m_NeighborhoodRadius;
 };
 }
 #ifndef OTB_MANUAL_INSTANTIATION
@@ -33,9 +33,9 @@ template <class TInputImage, class TOutputImage, class TDetector>
 KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::KeyPointDensityImageFilter()
 {
   this->SetNumberOfRequiredInputs(1);
-  m_NeighborhoodRadius           = 1;
-  m_Detector                     = DetectorType::New();
-  m_PointSetToDensityImageFilter = PointSetToDensityImageType::New();
+  m_NeighborhoodRadius = 1;
+  m_Detector           = DetectorType::New();
+  this->DynamicMultiThreadingOn();
 }
 
 /*---------------------------------------------------------
@@ -46,35 +46,47 @@ KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::~KeyPointDensi
 {
 }
 
-/**
- * threaded Generate Data
- */
+template <class TInputImage, class TOutputImage, class TDetector>
+void KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // Key points are detected on the whole image
+  InputImagePointerType ptr = const_cast<InputImageType*>(this->GetInput());
+  if (ptr)
+  {
+    ptr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
 
-/**
-* GenerateData Performs the pixel-wise addition
-*/
 template <class TInputImage, class TOutputImage, class TDetector>
-void KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::GenerateData()
-//::GenerateData( const OutputImageRegionType &outputRegionForThread, itk::ThreadIdType threadId )
+void KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::BeforeThreadedGenerateData()
 {
-  typename Superclass::OutputImagePointer outputImage = this->GetOutput();
-  InputImagePointerType                   ptr         = const_cast<InputImageType*>(this->GetInput());
-  if (!ptr)
-    return;
+  /** Detector, only updated for the first streamed region */
+  m_Detector->SetInput(this->GetInput());
+  m_Detector->Update();
 
-  /** Detector*/
-  m_Detector->SetInput(ptr);
+  m_DensityFunction = DensityFunctionType::New();
+  m_DensityFunction->SetPointSet(m_Detector->GetOutput());
+  m_DensityFunction->SetRadius(m_NeighborhoodRadius);
+}
+
+/**
+ * DynamicThreadedGenerateData computes the density of the key points around each pixel
+ */
+template <class TInputImage, class TOutputImage, class TDetector>
+void KeyPointDensityImageFilter<TInputImage, TOutputImage, TDetector>::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
+{
+  OutputImageType* outputImage = this->GetOutput();
 
-  /** Applying the pointsetTodensityImageFilter*/
-  m_PointSetToDensityImageFilter->SetInput(m_Detector->GetOutput());
-  m_PointSetToDensityImageFilter->SetRadius(m_NeighborhoodRadius);
-  m_PointSetToDensityImageFilter->SetSpacing(ptr->GetSignedSpacing());
-  m_PointSetToDensityImageFilter->SetSize(ptr->GetLargestPossibleRegion().GetSize());
-  m_PointSetToDensityImageFilter->SetOrigin(ptr->GetOrigin());
-  m_PointSetToDensityImageFilter->Update();
+  typename DensityFunctionType::InputType   pCenter;
+  itk::ImageRegionIterator<OutputImageType> itOut(outputImage, outputRegionForThread);
 
-  /** updating the output*/
-  this->GraftOutput(m_PointSetToDensityImageFilter->GetOutput());
+  for (itOut.GoToBegin(); !itOut.IsAtEnd(); ++itOut)
+  {
+    outputImage->TransformIndexToPhysicalPoint(itOut.GetIndex(), pCenter);
+    itOut.Set(m_DensityFunction->Evaluate(pCenter));
+  }
 }
 
 /**
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDescriptorsKDForest_h
+#define otbDescriptorsKDForest_h
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class DescriptorsKDForest
+ *  \brief Approximate search of the two nearest neighbours of descriptors.
+ *
+ * This class indexes a set of descriptors, stored row by row in a
+ * contiguous matrix, in a forest of randomized k-d trees: each tree
+ * splits on a dimension drawn among the ones of highest variance. A
+ * search explores the leaves of all the trees by increasing distance to
+ * the cells (best bin first), and stops after evaluating a maximum
+ * number of descriptors ("checks"). Without limit, the search is exact.
+ *
+ * Distances are Euclidean, computed in double precision like
+ * itk::Statistics::EuclideanDistanceMetric.
+ *
+ * The forest only keeps a pointer to the matrix, which must outlive it.
+ * Searches are const and can run concurrently.
+ *
+ * \sa KeyPointSetsMatchingFilter
+ *
+ * \ingroup OTBDescriptors
+ */
+template <class TValue>
+class DescriptorsKDForest
+{
+public:
+  typedef TValue ValueType;
+
+  /** Index in the matrix and distance of a neighbour */
+  typedef std::pair<unsigned int, double> NeighborType;
+
+  DescriptorsKDForest();
+
+  /** Index nbDescriptors descriptors of the given dimension */
+  void Build(const ValueType* descriptors, unsigned int nbDescriptors, unsigned int dimension, unsigned int nbTrees, unsigned int seed = 0);
+
+  /** Find the nearest and second nearest descriptors of the query,
+   * evaluating at most maxChecks descriptors (0 for an exact search).
+   * The second neighbour has an infinite distance if there is a single
+   * descriptor. */
+  void Search(const ValueType* query, unsigned int maxChecks, NeighborType& nearest, NeighborType& secondNearest) const;
+
+  unsigned int GetNumberOfDescriptors() const
+  {
+    return m_NbDescriptors;
+  }
+
+  /** Euclidean distance between two descriptors */
+  static double Distance(const ValueType* a, const ValueType* b, unsigned int dimension);
+
+private:
+  enum
+  {
+    /** Maximum number of descriptors in a leaf */
+    LeafSize = 8,
+    /** The split dimension is drawn among the ones of highest variance */
+    NbSplitCandidates = 5,
+    /** Number of descriptors used to estimate the variances */
+    NbSamples = 100
+  };
+
+  struct Node
+  {
+    /** Split dimension, -1 for a leaf */
+    int Dimension;
+    double       Split;
+    unsigned int Children[2];
+    /** Range of a leaf in the indices of its tree */
+    unsigned int Begin;
+    unsigned int End;
+  };
+
+  struct Tree
+  {
+    std::vector<Node>         Nodes;
+    std::vector<unsigned int> Indices;
+  };
+
+  void BuildTree(Tree& tree, unsigned int seed);
+
+  const ValueType*  m_Descriptors;
+  unsigned int      m_NbDescriptors;
+  unsigned int      m_Dimension;
+  std::vector<Tree> m_Trees;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDescriptorsKDForest.hxx"
+#endif
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDescriptorsKDForest_hxx
+#define otbDescriptorsKDForest_hxx
+
+#include "otbDescriptorsKDForest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+namespace otb
+{
+
+template <class TValue>
+DescriptorsKDForest<TValue>::DescriptorsKDForest() : m_Descriptors(nullptr), m_NbDescriptors(0), m_Dimension(0)
+{
+}
+
+template <class TValue>
+double DescriptorsKDForest<TValue>::Distance(const ValueType* a, const ValueType* b, unsigned int dimension)
+{
+  double sum = 0.;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    const double temp = a[i] - b[i];
+    sum += temp * temp;
+  }
+  return std::sqrt(sum);
+}
+
+template <class TValue>
+void DescriptorsKDForest<TValue>::Build(const ValueType* descriptors, unsigned int nbDescriptors, unsigned int dimension, unsigned int nbTrees,
+                                        unsigned int seed)
+{
+  m_Descriptors   = descriptors;
+  m_NbDescriptors = nbDescriptors;
+  m_Dimension     = dimension;
+  m_Trees.assign(std::max(nbTrees, 1u), Tree());
+  for (unsigned int t = 0; t < m_Trees.size(); ++t)
+  {
+    BuildTree(m_Trees[t], seed + t);
+  }
+}
+
+template <class TValue>
+void DescriptorsKDForest<TValue>::BuildTree(Tree& tree, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+
+  tree.Indices.resize(m_NbDescriptors);
+  for (unsigned int i = 0; i < m_NbDescriptors; ++i)
+  {
+    tree.Indices[i] = i;
+  }
+  tree.Nodes.clear();
+
+  Node root;
+  root.Dimension = -1;
+  root.Begin     = 0;
+  root.End       = m_NbDescriptors;
+  tree.Nodes.push_back(root);
+
+  std::vector<double>       mean(m_Dimension), variance(m_Dimension);
+  std::vector<unsigned int> dimensions(m_Dimension);
+  std::vector<unsigned int> toSplit(1, 0);
+  while (!toSplit.empty())
+  {
+    const unsigned int nodeIndex = toSplit.back();
+    toSplit.pop_back();
+    const unsigned int begin = tree.Nodes[nodeIndex].Begin;
+    const unsigned int end   = tree.Nodes[nodeIndex].End;
+    if (end - begin <= static_cast<unsigned int>(LeafSize))
+    {
+      continue;
+    }
+
+    // Mean and variance of the dimensions, on evenly spaced samples
+    const unsigned int nbSamples = std::min(end - begin, static_cast<unsigned int>(NbSamples));
+    const double       step      = static_cast<double>(end - begin) / nbSamples;
+    std::fill(mean.begin(), mean.end(), 0.);
+    std::fill(variance.begin(), variance.end(), 0.);
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const ValueType* row = m_Descriptors + static_cast<std::size_t>(tree.Indices[begin + static_cast<unsigned int>(s * step)]) * m_Dimension;
+      for (unsigned int d = 0; d < m_Dimension; ++d)
+      {
+        mean[d] += row[d];
+        variance[d] += static_cast<double>(row[d]) * row[d];
+      }
+    }
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      mean[d] /= nbSamples;
+      variance[d] = variance[d] / nbSamples - mean[d] * mean[d];
+      dimensions[d] = d;
+    }
+
+    const unsigned int nbCandidates = std::min(static_cast<unsigned int>(NbSplitCandidates), m_Dimension);
+    std::partial_sort(dimensions.begin(), dimensions.begin() + nbCandidates, dimensions.end(),
+                      [&variance](unsigned int a, unsigned int b) { return variance[a] > variance[b]; });
+    const unsigned int dimension = dimensions[std::uniform_int_distribution<unsigned int>(0, nbCandidates - 1)(generator)];
+    double             split     = mean[dimension];
+
+    auto isLower = [&](unsigned int index) { return m_Descriptors[static_cast<std::size_t>(index) * m_Dimension + dimension] < split; };
+    unsigned int middle = static_cast<unsigned int>(std::partition(tree.Indices.begin() + begin, tree.Indices.begin() + end, isLower) - tree.Indices.begin());
+    if (middle == begin || middle == end)
+    {
+      // Skewed distribution: split at the median instead
+      middle = begin + (end - begin) / 2;
+      std::nth_element(tree.Indices.begin() + begin, tree.Indices.begin() + middle, tree.Indices.begin() + end, [&](unsigned int a, unsigned int b) {
+        return m_Descriptors[static_cast<std::size_t>(a) * m_Dimension + dimension] < m_Descriptors[static_cast<std::size_t>(b) * m_Dimension + dimension];
+      });
+      // Split between the median and the next greater value, if any
+      const double median = m_Descriptors[static_cast<std::size_t>(tree.Indices[middle]) * m_Dimension + dimension];
+      double       next   = std::numeric_limits<double>::infinity();
+      for (unsigned int i = begin; i < end; ++i)
+      {
+        const double value = m_Descriptors[static_cast<std::size_t>(tree.Indices[i]) * m_Dimension + dimension];
+        if (value > median && value < next)
+        {
+          next = value;
+        }
+      }
+      if (next == std::numeric_limits<double>::infinity())
+      {
+        // All the descriptors have the same value on this dimension
+        continue;
+      }
+      split  = 0.5 * (median + next);
+      middle = static_cast<unsigned int>(std::partition(tree.Indices.begin() + begin, tree.Indices.begin() + end, isLower) - tree.Indices.begin());
+    }
+
+    Node children[2];
+    children[0].Dimension = children[1].Dimension = -1;
+    children[0].Begin                             = begin;
+    children[0].End                               = middle;
+    children[1].Begin                             = middle;
+    children[1].End                               = end;
+    for (unsigned int c = 0; c < 2; ++c)
+    {
+      tree.Nodes[nodeIndex].Children[c] = static_cast<unsigned int>(tree.Nodes.size());
+      toSplit.push_back(static_cast<unsigned int>(tree.Nodes.size()));
+      tree.Nodes.push_back(children[c]);
+    }
+    tree.Nodes[nodeIndex].Dimension = static_cast<int>(dimension);
+    tree.Nodes[nodeIndex].Split     = split;
+  }
+}
+
+template <class TValue>
+void DescriptorsKDForest<TValue>::Search(const ValueType* query, unsigned int maxChecks, NeighborType& nearest, NeighborType& secondNearest) const
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+  nearest               = NeighborType(0, infinity);
+  secondNearest         = NeighborType(0, infinity);
+  if (maxChecks == 0)
+  {
+    maxChecks = m_NbDescriptors;
+  }
+
+  // Branches not taken, by increasing distance of the query to their cell
+  struct Branch
+  {
+    double       Bound;
+    unsigned int Tree;
+    unsigned int Node;
+    bool operator>(const Branch& other) const
+    {
+      return Bound > other.Bound;
+    }
+  };
+  std::priority_queue<Branch, std::vector<Branch>, std::greater<Branch>> branches;
+  for (unsigned int t = 0; t < m_Trees.size(); ++t)
+  {
+    branches.push({0., t, 0});
+  }
+
+  std::unordered_set<unsigned int> checked;
+  checked.reserve(2 * maxChecks);
+  while (!branches.empty() && checked.size() < maxChecks)
+  {
+    const Branch branch = branches.top();
+    branches.pop();
+    // The bound is a lower bound of the distance to the descriptors of the cell
+    if (branch.Bound > secondNearest.second * secondNearest.second)
+    {
+      break;
+    }
+
+    const Tree&  tree      = m_Trees[branch.Tree];
+    unsigned int nodeIndex = branch.Node;
+    while (tree.Nodes[nodeIndex].Dimension >= 0)
+    {
+      const Node&  node  = tree.Nodes[nodeIndex];
+      const double delta = query[node.Dimension] - node.Split;
+      const unsigned int closest = delta < 0 ? 0 : 1;
+      branches.push({std::max(branch.Bound, delta * delta), branch.Tree, node.Children[1 - closest]});
+      nodeIndex = node.Children[closest];
+    }
+
+    const Node& leaf = tree.Nodes[nodeIndex];
+    for (unsigned int i = leaf.Begin; i < leaf.End; ++i)
+    {
+      const unsigned int index = tree.Indices[i];
+      if (!checked.insert(index).second)
+      {
+        continue;
+      }
+      const double distance = Distance(query, m_Descriptors + static_cast<std::size_t>(index) * m_Dimension, m_Dimension);
+      // Ties are resolved by index, like an exhaustive search
+      if (distance < nearest.second || (distance == nearest.second && index < nearest.first))
+      {
+        secondNearest = nearest;
+        nearest       = NeighborType(index, distance);
+      }
+      else if (distance < secondNearest.second)
+      {
+        secondNearest = NeighborType(index, distance);
+      }
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
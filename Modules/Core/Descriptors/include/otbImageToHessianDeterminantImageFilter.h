@@ -138,7 +138,13 @@ protected:
    */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
   /**
-   * Main computation method.
+   * The recursive Gaussian filters need the whole input.
+   */
+  void GenerateInputRequestedRegion() override;
+
+  /**
+   * Main computation method. The Hessian stays buffered between the
+   * streamed regions of the output.
    */
   void GenerateData() override;
 
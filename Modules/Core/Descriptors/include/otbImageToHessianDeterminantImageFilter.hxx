@@ -45,12 +45,29 @@ ImageToHessianDeterminantImageFilter<TInputImage, TOutputImage, TPrecision>::~Im
 {
 }
 
+template <class TInputImage, class TOutputImage, class TPrecision>
+void ImageToHessianDeterminantImageFilter<TInputImage, TOutputImage, TPrecision>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // The recursive Gaussian filters need the whole image
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
 template <class TInputImage, class TOutputImage, class TPrecision>
 void ImageToHessianDeterminantImageFilter<TInputImage, TOutputImage, TPrecision>::GenerateData(void)
 {
-  // Execute minipipeline
+  // Execute minipipeline. SetSigma() always modifies the Hessian filter,
+  // which would compute it again for each streamed region.
   m_HessianFilter->SetInput(this->GetInput());
-  m_HessianFilter->SetSigma(m_Sigma);
+  if (m_HessianFilter->GetSigma() != m_Sigma)
+  {
+    m_HessianFilter->SetSigma(m_Sigma);
+  }
   m_DeterminantFilter->GraftOutput(this->GetOutput());
   m_DeterminantFilter->Update();
   this->GraftOutput(m_DeterminantFilter->GetOutput());
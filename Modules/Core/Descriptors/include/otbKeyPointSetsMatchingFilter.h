@@ -24,6 +24,9 @@
 #include "otbObjectListSource.h"
 #include "otbLandmark.h"
 #include "itkEuclideanDistanceMetric.h"
+#include "otbDescriptorsKDForest.h"
+#include <type_traits>
+#include <vector>
 
 namespace otb
 {
@@ -41,6 +44,14 @@ namespace otb
  *   Matches are stored in a landmark object containing both matched points and point data. The landmark data will hold the distance value
  *   between the data.
  *
+ *   The nearest neighbors of the points are searched in parallel. With the default Euclidean distance, the descriptors are
+ *   copied in contiguous matrices: the exhaustive search then computes the distances to blocks of candidates at once, with
+ *   the same results as EuclideanDistanceMetric. Setting a recall lower than 1 replaces it by an approximate search in a
+ *   forest of randomized k-d trees (see DescriptorsKDForest), whose number of checks is tuned on a sample of the points so
+ *   that this ratio of them get their exact nearest neighbor. Other distances are evaluated exhaustively.
+ *
+ *   If a pointset holds a single point, the distance ratio cannot be computed and is set to 1.
+ *
  *   \sa Landmark
  *   \sa PointSet
  *   \sa EuclideanDistanceMetric
@@ -74,6 +85,8 @@ public:
   typedef ObjectList<LandmarkType>           LandmarkListType;
   typedef typename LandmarkListType::Pointer LandmarkListPointerType;
   typedef std::pair<unsigned int, double> NeighborSearchResultType;
+  typedef typename itk::NumericTraits<PointDataType>::ValueType DescriptorValueType;
+  typedef DescriptorsKDForest<DescriptorValueType> KDForestType;
 
   /// standard macros
   itkNewMacro(Self);
@@ -86,6 +99,15 @@ public:
   itkSetMacro(DistanceThreshold, double);
   itkGetMacro(DistanceThreshold, double);
 
+  /** Ratio of the points which should get their exact nearest neighbor.
+   * 1 (the default) searches exhaustively, lower values use a k-d forest. */
+  itkSetClampMacro(Recall, double, 0., 1.);
+  itkGetMacro(Recall, double);
+
+  /** Number of randomized trees of the approximate search */
+  itkSetMacro(NumberOfTrees, unsigned int);
+  itkGetMacro(NumberOfTrees, unsigned int);
+
   /// Set the first pointset
   void SetInput1(const PointSetType* pointset);
   /// Get the first pointset
@@ -115,6 +137,46 @@ protected:
   NeighborSearchResultType NearestNeighbor(const PointDataType& data1, const PointSetType* pointset);
 
 private:
+  /** Descriptors of a pointset, in the order of its point data */
+  struct DescriptorsType
+  {
+    std::vector<unsigned int>  Identifiers;
+    std::vector<PointDataType> Data;
+    /** Matrix of the descriptors, one per row */
+    std::vector<DescriptorValueType> Rows;
+    /** Blocks of BlockSize descriptors, interleaved dimension by dimension */
+    std::vector<DescriptorValueType> Blocks;
+    KDForestType                     Forest;
+  };
+
+  /** Number of descriptors whose distances are computed at once */
+  enum
+  {
+    BlockSize = 8
+  };
+
+  /** Whether the distance is the Euclidean one, computed on the contiguous descriptors */
+  typedef std::is_same<DistanceType, itk::Statistics::EuclideanDistanceMetric<PointDataType>> IsEuclidean;
+
+  void FillDescriptors(const PointSetType* pointset, DescriptorsType& descriptors) const;
+
+  /** Ratio of the distances to the nearest and second nearest neighbors */
+  static double DistanceRatio(double nearestDistance, double secondNearestDistance);
+
+  /** Exhaustive search of the neighbors of a query with the distance calculator */
+  NeighborSearchResultType GenericNearestNeighbor(const PointDataType& data1, const DescriptorsType& candidates) const;
+
+  /** Exhaustive search of the neighbors of a query among the Euclidean descriptors */
+  NeighborSearchResultType BlockNearestNeighbor(const DescriptorValueType* query, const DescriptorsType& candidates) const;
+
+  /** Search the neighbors of the given queries (positions in the queries), as positions in the candidates */
+  void SearchNeighbors(const DescriptorsType& queries, const std::vector<unsigned int>& positions, const DescriptorsType& candidates, unsigned int checks,
+                       std::vector<NeighborSearchResultType>& results);
+
+  /** Smallest number of checks of the approximate search meeting the recall */
+  unsigned int TuneChecks(const DescriptorsType& queries, const DescriptorsType& candidates);
+
+
   KeyPointSetsMatchingFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
@@ -124,6 +186,15 @@ private:
   // Distance threshold to decide matching
   double m_DistanceThreshold;
 
+  // Target recall of the approximate search
+  double m_Recall;
+
+  // Number of trees of the approximate search
+  unsigned int m_NumberOfTrees;
+
+  // Length of the descriptors
+  unsigned int m_Dimension;
+
   // Distance calculator
   DistancePointerType m_DistanceCalculator;
 };
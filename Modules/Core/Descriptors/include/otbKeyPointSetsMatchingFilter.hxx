@@ -22,6 +22,11 @@
 #define otbKeyPointSetsMatchingFilter_hxx
 
 #include "otbKeyPointSetsMatchingFilter.h"
+#include "otbMacro.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace otb
 {
@@ -32,6 +37,9 @@ KeyPointSetsMatchingFilter<TPointSet, TDistance>::KeyPointSetsMatchingFilter()
   this->SetNumberOfRequiredInputs(2);
   m_UseBackMatching   = false;
   m_DistanceThreshold = 0.6;
+  m_Recall            = 1.;
+  m_NumberOfTrees     = 4;
+  m_Dimension         = 0;
   // Object used to measure distance
   m_DistanceCalculator = DistanceType::New();
 }
@@ -61,155 +69,310 @@ void KeyPointSetsMatchingFilter<TPointSet, TDistance>::SetInput2(const PointSetT
 }
 
 template <class TPointSet, class TDistance>
-void KeyPointSetsMatchingFilter<TPointSet, TDistance>::GenerateData()
+void KeyPointSetsMatchingFilter<TPointSet, TDistance>::FillDescriptors(const PointSetType* pointset, DescriptorsType& descriptors) const
 {
-  //   std::cout<<"GenerateData()"<<std::endl;
-
-  // Get the input pointers
-  const PointSetType* ps1 = this->GetInput1();
-  const PointSetType* ps2 = this->GetInput2();
-
-  // Check if one of the pointsets is empty
-  if (ps1->GetNumberOfPoints() == 0 || ps2->GetNumberOfPoints() == 0)
+  const unsigned int nbPoints = pointset->GetNumberOfPoints();
+  descriptors.Identifiers.clear();
+  descriptors.Data.clear();
+  descriptors.Identifiers.reserve(nbPoints);
+  descriptors.Data.reserve(nbPoints);
+  for (PointDataIteratorType pdIt = pointset->GetPointData()->Begin(); pdIt != pointset->GetPointData()->End(); ++pdIt)
   {
-    itkExceptionMacro(<< "Empty input pointset !");
+    descriptors.Identifiers.push_back(pdIt.Index());
+    descriptors.Data.push_back(pdIt.Value());
   }
 
-  // Get the output pointer
-  LandmarkListPointerType landmarks = this->GetOutput();
-
-  // Define iterators on points and point data.
-  PointsIteratorType    pIt  = ps1->GetPoints()->Begin();
-  PointDataIteratorType pdIt = ps1->GetPointData()->Begin();
-
-  // iterate on pointset 1
-  while (pdIt != ps1->GetPointData()->End() && pIt != ps1->GetPoints()->End())
+  descriptors.Rows.clear();
+  descriptors.Blocks.clear();
+  if (!IsEuclidean::value)
   {
-    // Get point and point data at current location
-    bool          matchFound   = false;
-    unsigned int  currentIndex = pIt.Index();
-    PointDataType data         = pdIt.Value();
-    PointType     point        = pIt.Value();
+    return;
+  }
 
-    // These variables will hold the matched point and point data
-    PointDataType dataMatch;
-    PointType     pointMatch;
+  const unsigned int nbDescriptors = static_cast<unsigned int>(descriptors.Data.size());
+  descriptors.Rows.resize(static_cast<std::size_t>(nbDescriptors) * m_Dimension);
+  descriptors.Blocks.assign(static_cast<std::size_t>((nbDescriptors + BlockSize - 1) / BlockSize) * BlockSize * m_Dimension, 0);
+  for (unsigned int i = 0; i < nbDescriptors; ++i)
+  {
+    if (itk::NumericTraits<PointDataType>::GetLength(descriptors.Data[i]) != m_Dimension)
+    {
+      itkExceptionMacro(<< "All the point data must have the same length (" << m_Dimension << ")");
+    }
+    DescriptorValueType* row   = &descriptors.Rows[static_cast<std::size_t>(i) * m_Dimension];
+    DescriptorValueType* block = &descriptors.Blocks[static_cast<std::size_t>(i / BlockSize) * BlockSize * m_Dimension + i % BlockSize];
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      row[d]               = descriptors.Data[i][d];
+      block[d * BlockSize] = row[d];
+    }
+  }
+}
 
-    // call to the matching routine
-    NeighborSearchResultType searchResult1 = NearestNeighbor(data, ps2);
+template <class TPointSet, class TDistance>
+typename KeyPointSetsMatchingFilter<TPointSet, TDistance>::NeighborSearchResultType
+KeyPointSetsMatchingFilter<TPointSet, TDistance>::BlockNearestNeighbor(const DescriptorValueType* query, const DescriptorsType& candidates) const
+{
+  const unsigned int nbCandidates          = static_cast<unsigned int>(candidates.Data.size());
+  unsigned int       nearestIndex          = 0;
+  double             nearestDistance       = std::numeric_limits<double>::infinity();
+  double             secondNearestDistance = std::numeric_limits<double>::infinity();
 
-    // Check if the neighbor distance is lower than the threshold
-    if (searchResult1.second < m_DistanceThreshold)
+  for (unsigned int first = 0; first < nbCandidates; first += BlockSize)
+  {
+    // Same operations as EuclideanDistanceMetric, for BlockSize candidates at once
+    const DescriptorValueType* block = &candidates.Blocks[static_cast<std::size_t>(first) * m_Dimension];
+    double                     sums[BlockSize] = {};
+    for (unsigned int d = 0; d < m_Dimension; ++d)
     {
-      // Get the matched point and point data
-      dataMatch  = ps2->GetPointData()->GetElement(searchResult1.first);
-      pointMatch = ps2->GetPoints()->GetElement(searchResult1.first);
+      const DescriptorValueType  value  = query[d];
+      const DescriptorValueType* values = block + d * BlockSize;
+      for (unsigned int j = 0; j < BlockSize; ++j)
+      {
+        const double temp = value - values[j];
+        sums[j] += temp * temp;
+      }
+    }
 
-      // If the back matching option is on
-      if (m_UseBackMatching)
+    const unsigned int last = std::min(first + BlockSize, nbCandidates);
+    for (unsigned int i = first; i < last; ++i)
+    {
+      const double distanceValue = std::sqrt(sums[i - first]);
+      if (distanceValue < nearestDistance)
       {
-        // Perform the back search
-        NeighborSearchResultType searchResult2 = NearestNeighbor(dataMatch, ps1);
-
-        // Test if back search finds the same match
-        if (currentIndex == searchResult2.first)
-        {
-          matchFound = true;
-        }
+        secondNearestDistance = nearestDistance;
+        nearestDistance       = distanceValue;
+        nearestIndex          = i;
       }
-      else // else back matching
+      else if (distanceValue < secondNearestDistance)
       {
-        matchFound = true;
+        secondNearestDistance = distanceValue;
       }
     }
+  }
+
+  return NeighborSearchResultType(nearestIndex, DistanceRatio(nearestDistance, secondNearestDistance));
+}
+
+template <class TPointSet, class TDistance>
+void KeyPointSetsMatchingFilter<TPointSet, TDistance>::SearchNeighbors(const DescriptorsType& queries, const std::vector<unsigned int>& positions,
+                                                                       const DescriptorsType& candidates, unsigned int checks,
+                                                                       std::vector<NeighborSearchResultType>& results)
+{
+  results.resize(positions.size());
+  auto search = [&](itk::SizeValueType i) {
+    const unsigned int position = positions[i];
+    if (!IsEuclidean::value || candidates.Data.size() < 2)
+    {
+      results[i] = GenericNearestNeighbor(queries.Data[position], candidates);
+    }
+    else if (checks == 0)
+    {
+      results[i] = BlockNearestNeighbor(&queries.Rows[static_cast<std::size_t>(position) * m_Dimension], candidates);
+    }
+    else
+    {
+      typename KDForestType::NeighborType nearest, secondNearest;
+      candidates.Forest.Search(&queries.Rows[static_cast<std::size_t>(position) * m_Dimension], checks, nearest, secondNearest);
+      results[i] = NeighborSearchResultType(nearest.first, DistanceRatio(nearest.second, secondNearest.second));
+    }
+  };
+  this->GetMultiThreader()->ParallelizeArray(0, positions.size(), search, nullptr);
+}
 
-    // If we found a match, add the proper landmark
-    if (matchFound)
+template <class TPointSet, class TDistance>
+unsigned int KeyPointSetsMatchingFilter<TPointSet, TDistance>::TuneChecks(const DescriptorsType& queries, const DescriptorsType& candidates)
+{
+  // Exact neighbors of evenly spaced queries
+  const unsigned int        nbQueries = static_cast<unsigned int>(queries.Data.size());
+  const unsigned int        nbSamples = std::min(nbQueries, 200u);
+  std::vector<unsigned int> samples(nbSamples);
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    samples[s] = static_cast<unsigned int>(static_cast<std::size_t>(s) * nbQueries / nbSamples);
+  }
+  std::vector<NeighborSearchResultType> exact, approximate;
+  SearchNeighbors(queries, samples, candidates, 0, exact);
+
+  // Double the checks until enough samples get their exact nearest neighbor
+  const unsigned int nbCandidates = static_cast<unsigned int>(candidates.Data.size());
+  for (unsigned int checks = 32; checks < nbCandidates; checks *= 2)
+  {
+    SearchNeighbors(queries, samples, candidates, checks, approximate);
+    unsigned int nbFound = 0;
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      nbFound += approximate[s].first == exact[s].first;
+    }
+    if (nbFound >= m_Recall * nbSamples)
     {
-      LandmarkPointerType landmark = LandmarkType::New();
-      landmark->SetPoint1(point);
-      landmark->SetPointData1(data);
-      landmark->SetPoint2(pointMatch);
-      landmark->SetPointData2(dataMatch);
-      landmark->SetLandmarkData(searchResult1.second);
-
-      // Add the new landmark to the landmark list
-      landmarks->PushBack(landmark);
+      return checks;
     }
-    ++pdIt;
-    ++pIt;
   }
+  return 0;
 }
 
 template <class TPointSet, class TDistance>
-typename KeyPointSetsMatchingFilter<TPointSet, TDistance>::NeighborSearchResultType
-KeyPointSetsMatchingFilter<TPointSet, TDistance>::NearestNeighbor(const PointDataType& data1, const PointSetType* pointset)
+void KeyPointSetsMatchingFilter<TPointSet, TDistance>::GenerateData()
 {
-  //   std::cout<<"Call to NearestNeighbor()"<<std::endl;
-  // Declare the result
-  NeighborSearchResultType result;
+  // Get the input pointers
+  const PointSetType* ps1 = this->GetInput1();
+  const PointSetType* ps2 = this->GetInput2();
+
+  // Check if one of the pointsets is empty
+  if (ps1->GetNumberOfPoints() == 0 || ps2->GetNumberOfPoints() == 0)
+  {
+    itkExceptionMacro(<< "Empty input pointset !");
+  }
+
+  // Get the output pointer
+  LandmarkListPointerType landmarks = this->GetOutput();
 
-  // Define iterators on points and point data.
-  PointDataIteratorType pdIt = pointset->GetPointData()->Begin();
+  // Contiguous copies of the descriptors
+  m_Dimension = itk::NumericTraits<PointDataType>::GetLength(ps1->GetPointData()->Begin().Value());
+  DescriptorsType descriptors1, descriptors2;
+  FillDescriptors(ps1, descriptors1);
+  FillDescriptors(ps2, descriptors2);
 
-  // local variables
-  unsigned int nearestIndex = 0;
-  double       d1           = m_DistanceCalculator->Evaluate(data1, pdIt.Value());
-  ++pdIt;
-  double d2 = m_DistanceCalculator->Evaluate(data1, pdIt.Value());
-  ++pdIt;
+  // Index the descriptors for the approximate search
+  unsigned int checks = 0;
+  if (IsEuclidean::value && m_Recall < 1.)
+  {
+    descriptors2.Forest.Build(descriptors2.Rows.data(), static_cast<unsigned int>(descriptors2.Data.size()), m_Dimension, m_NumberOfTrees);
+    checks = TuneChecks(descriptors1, descriptors2);
+    if (checks != 0 && m_UseBackMatching)
+    {
+      descriptors1.Forest.Build(descriptors1.Rows.data(), static_cast<unsigned int>(descriptors1.Data.size()), m_Dimension, m_NumberOfTrees);
+    }
+    otbMsgDevMacro(<< "Approximate matching with " << checks << " checks (0 for an exhaustive search)");
+  }
 
-  if (d1 > d2)
+  // Forward search of all the points of pointset 1
+  std::vector<unsigned int> positions1(descriptors1.Data.size());
+  for (unsigned int i = 0; i < positions1.size(); ++i)
   {
-    nearestIndex = 1;
+    positions1[i] = i;
+  }
+  std::vector<NeighborSearchResultType> forward;
+  SearchNeighbors(descriptors1, positions1, descriptors2, checks, forward);
+
+  // Back search of the matched points of pointset 2
+  std::vector<unsigned int>             matched;
+  std::vector<NeighborSearchResultType> backward;
+  std::vector<unsigned int>             backwardIndex;
+  if (m_UseBackMatching)
+  {
+    backwardIndex.assign(descriptors2.Data.size(), 0);
+    std::vector<char> isMatched(descriptors2.Data.size(), 0);
+    for (const auto& result : forward)
+    {
+      if (result.second < m_DistanceThreshold && !isMatched[result.first])
+      {
+        isMatched[result.first]     = 1;
+        backwardIndex[result.first] = static_cast<unsigned int>(matched.size());
+        matched.push_back(result.first);
+      }
+    }
+    SearchNeighbors(descriptors2, matched, descriptors1, checks, backward);
   }
-  // Initialize distances
-  double nearestDistance       = std::min(d1, d2);
-  double secondNearestDistance = std::max(d1, d2);
-  double distanceValue;
 
-  // iterate on the pointset
-  while (pdIt != pointset->GetPointData()->End())
+  // Add the landmarks in the order of pointset 1
+  PointsIteratorType pIt = ps1->GetPoints()->Begin();
+  for (unsigned int i = 0; i < forward.size() && pIt != ps1->GetPoints()->End(); ++i, ++pIt)
   {
-    // Evaluate the distance
-    distanceValue = m_DistanceCalculator->Evaluate(data1, pdIt.Value());
+    const NeighborSearchResultType& searchResult1 = forward[i];
+
+    // Check if the neighbor distance is lower than the threshold, and if back search finds the same match
+    if (searchResult1.second >= m_DistanceThreshold || (m_UseBackMatching && backward[backwardIndex[searchResult1.first]].first != i))
+    {
+      continue;
+    }
+
+    const unsigned int  identifier = descriptors2.Identifiers[searchResult1.first];
+    LandmarkPointerType landmark   = LandmarkType::New();
+    landmark->SetPoint1(pIt.Value());
+    landmark->SetPointData1(descriptors1.Data[i]);
+    landmark->SetPoint2(ps2->GetPoints()->GetElement(identifier));
+    landmark->SetPointData2(descriptors2.Data[searchResult1.first]);
+    landmark->SetLandmarkData(searchResult1.second);
 
-    //       std::cout<<nearestIndex<<" "<<nearestDistance<<" "<<secondNearestDistance<<std::endl;
+    // Add the new landmark to the landmark list
+    landmarks->PushBack(landmark);
+  }
+}
 
-    // Check if this point is the nearest neighbor
+template <class TPointSet, class TDistance>
+typename KeyPointSetsMatchingFilter<TPointSet, TDistance>::NeighborSearchResultType
+KeyPointSetsMatchingFilter<TPointSet, TDistance>::GenericNearestNeighbor(const PointDataType& data1, const DescriptorsType& candidates) const
+{
+  unsigned int nearestIndex          = 0;
+  double       nearestDistance       = std::numeric_limits<double>::infinity();
+  double       secondNearestDistance = std::numeric_limits<double>::infinity();
+  for (unsigned int i = 0; i < candidates.Data.size(); ++i)
+  {
+    const double distanceValue = m_DistanceCalculator->Evaluate(data1, candidates.Data[i]);
     if (distanceValue < nearestDistance)
     {
       secondNearestDistance = nearestDistance;
       nearestDistance       = distanceValue;
-      nearestIndex          = pdIt.Index();
+      nearestIndex          = i;
     }
-    // Else check if it is the second nearest neighbor
     else if (distanceValue < secondNearestDistance)
     {
       secondNearestDistance = distanceValue;
     }
-    ++pdIt;
   }
+  return NeighborSearchResultType(nearestIndex, DistanceRatio(nearestDistance, secondNearestDistance));
+}
+
+template <class TPointSet, class TDistance>
+typename KeyPointSetsMatchingFilter<TPointSet, TDistance>::NeighborSearchResultType
+KeyPointSetsMatchingFilter<TPointSet, TDistance>::NearestNeighbor(const PointDataType& data1, const PointSetType* pointset)
+{
+  // Exhaustive search among the descriptors of the pointset, the index
+  // being the one of the point data
+  m_Dimension = itk::NumericTraits<PointDataType>::GetLength(data1);
+  DescriptorsType candidates;
+  FillDescriptors(pointset, candidates);
 
-  // Fill results
-  result.first = nearestIndex;
-  if (secondNearestDistance == 0)
+  NeighborSearchResultType result;
+  if (!IsEuclidean::value || candidates.Data.size() < 2)
   {
-    result.second = 1;
+    result = GenericNearestNeighbor(data1, candidates);
   }
   else
   {
-    result.second = nearestDistance / secondNearestDistance;
+    std::vector<DescriptorValueType> query(m_Dimension);
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      query[d] = data1[d];
+    }
+    result = BlockNearestNeighbor(query.data(), candidates);
+  }
+  if (!candidates.Identifiers.empty())
+  {
+    result.first = candidates.Identifiers[result.first];
   }
-
-  // return the result
   return result;
 }
 
+template <class TPointSet, class TDistance>
+double KeyPointSetsMatchingFilter<TPointSet, TDistance>::DistanceRatio(double nearestDistance, double secondNearestDistance)
+{
+  if (secondNearestDistance == 0 || secondNearestDistance == std::numeric_limits<double>::infinity())
+  {
+    return 1;
+  }
+  return nearestDistance / secondNearestDistance;
+}
+
 template <class TPointSet, class TDistance>
 void KeyPointSetsMatchingFilter<TPointSet, TDistance>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseBackMatching: " << m_UseBackMatching << std::endl;
+  os << indent << "DistanceThreshold: " << m_DistanceThreshold << std::endl;
+  os << indent << "Recall: " << m_Recall << std::endl;
+  os << indent << "NumberOfTrees: " << m_NumberOfTrees << std::endl;
 }
 
 } // end namespace otb
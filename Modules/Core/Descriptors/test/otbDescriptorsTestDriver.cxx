@@ -28,6 +28,7 @@ void RegisterTests()
   REGISTER_TEST(otbFourierMellinDescriptors);
   REGISTER_TEST(otbFourierMellinDescriptorsScaleInvariant);
   REGISTER_TEST(otbFourierMellinDescriptorsRotationInvariant);
+  REGISTER_TEST(otbKeyPointSetsMatchingFilter);
  #ifdef OTB_USE_SIFTFAST
   REGISTER_TEST(otbKeyPointsAlgorithmsTest);
  #endif
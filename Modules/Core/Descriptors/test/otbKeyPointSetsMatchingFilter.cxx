@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMacro.h"
+#include "otbKeyPointSetsMatchingFilter.h"
+#include "itkPointSet.h"
+#include "itkVariableLengthVector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+typedef itk::VariableLengthVector<float> DescriptorType;
+typedef itk::PointSet<DescriptorType, 2> PointSetType;
+typedef otb::KeyPointSetsMatchingFilter<PointSetType> MatchingFilterType;
+
+// Noisy copies of random descriptors around a few clusters
+PointSetType::Pointer GeneratePointSet(const std::vector<std::vector<float>>& references, unsigned int dimension, std::mt19937& generator)
+{
+  std::normal_distribution<float> noise(0.f, 0.3f);
+  PointSetType::Pointer           pointset = PointSetType::New();
+  for (unsigned int i = 0; i < references.size(); ++i)
+  {
+    PointSetType::PointType point;
+    point[0] = i;
+    point[1] = 2. * i;
+    DescriptorType descriptor(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      descriptor[d] = references[i][d] + noise(generator);
+    }
+    pointset->SetPoint(i, point);
+    pointset->SetPointData(i, descriptor);
+  }
+  return pointset;
+}
+
+// Reference matching, with the distance metric and without threads
+std::vector<std::pair<unsigned int, unsigned int>> Match(const PointSetType* ps1, const PointSetType* ps2, double threshold, bool backMatching)
+{
+  typedef itk::Statistics::EuclideanDistanceMetric<DescriptorType> DistanceType;
+  DistanceType::Pointer distance = DistanceType::New();
+  auto nearest = [&](const DescriptorType& data, const PointSetType* pointset, double& ratio) {
+    unsigned int index = 0;
+    double       d1 = 1e300, d2 = 1e300;
+    for (unsigned int j = 0; j < pointset->GetNumberOfPoints(); ++j)
+    {
+      const double d = distance->Evaluate(data, pointset->GetPointData()->GetElement(j));
+      if (d < d1)
+      {
+        d2    = d1;
+        d1    = d;
+        index = j;
+      }
+      else if (d < d2)
+      {
+        d2 = d;
+      }
+    }
+    ratio = d2 == 0 ? 1 : d1 / d2;
+    return index;
+  };
+
+  std::vector<std::pair<unsigned int, unsigned int>> matches;
+  for (unsigned int i = 0; i < ps1->GetNumberOfPoints(); ++i)
+  {
+    double             ratio = 0;
+    const unsigned int match = nearest(ps1->GetPointData()->GetElement(i), ps2, ratio);
+    double             backRatio;
+    if (ratio < threshold && (!backMatching || nearest(ps2->GetPointData()->GetElement(match), ps1, backRatio) == i))
+    {
+      matches.emplace_back(i, match);
+    }
+  }
+  return matches;
+}
+}
+
+int otbKeyPointSetsMatchingFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int nbPoints = 3000, dimension = 64, nbClusters = 50;
+  std::mt19937       generator(42);
+
+  std::normal_distribution<float>  cluster(0.f, 3.f), offset(0.f, 1.f);
+  std::vector<std::vector<float>> centers(nbClusters, std::vector<float>(dimension));
+  for (auto& center : centers)
+  {
+    for (auto& value : center)
+    {
+      value = cluster(generator);
+    }
+  }
+  std::vector<std::vector<float>> references(nbPoints, std::vector<float>(dimension));
+  for (unsigned int i = 0; i < nbPoints; ++i)
+  {
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      references[i][d] = centers[i % nbClusters][d] + offset(generator);
+    }
+  }
+  PointSetType::Pointer ps1 = GeneratePointSet(references, dimension, generator);
+  PointSetType::Pointer ps2 = GeneratePointSet(references, dimension, generator);
+
+  for (bool backMatching : {false, true})
+  {
+    const auto expected = Match(ps1, ps2, 0.8, backMatching);
+
+    // Exhaustive search: same matches, in the same order
+    MatchingFilterType::Pointer filter = MatchingFilterType::New();
+    filter->SetInput1(ps1);
+    filter->SetInput2(ps2);
+    filter->SetDistanceThreshold(0.8);
+    filter->SetUseBackMatching(backMatching);
+    filter->Update();
+    MatchingFilterType::LandmarkListType* landmarks = filter->GetOutput();
+    otbControlConditionTestMacro(landmarks->Size() != expected.size(),
+                                 "Got " << landmarks->Size() << " matches instead of " << expected.size() << " with back-matching " << backMatching);
+    for (unsigned int i = 0; i < expected.size(); ++i)
+    {
+      otbControlConditionTestMacro(landmarks->GetNthElement(i)->GetPoint1()[0] != expected[i].first ||
+                                       landmarks->GetNthElement(i)->GetPoint2()[0] != expected[i].second,
+                                   "Wrong match " << i << " with back-matching " << backMatching);
+    }
+
+    // Approximate search: most of the matches are found
+    MatchingFilterType::Pointer approximate = MatchingFilterType::New();
+    approximate->SetInput1(ps1);
+    approximate->SetInput2(ps2);
+    approximate->SetDistanceThreshold(0.8);
+    approximate->SetUseBackMatching(backMatching);
+    approximate->SetRecall(0.9);
+    approximate->Update();
+    unsigned int nbFound = 0;
+    for (unsigned int i = 0; i < approximate->GetOutput()->Size(); ++i)
+    {
+      const auto match = std::make_pair(static_cast<unsigned int>(approximate->GetOutput()->GetNthElement(i)->GetPoint1()[0]),
+                                        static_cast<unsigned int>(approximate->GetOutput()->GetNthElement(i)->GetPoint2()[0]));
+      nbFound += std::find(expected.begin(), expected.end(), match) != expected.end();
+    }
+    otbControlConditionTestMacro(nbFound < 0.8 * expected.size(),
+                                 "Approximate search found " << nbFound << " of the " << expected.size() << " matches with back-matching " << backMatching);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -32,10 +32,13 @@ namespace otb
 
 /** \class AsymmetricFusionOfLineDetectorImageFilter
  *
- * This class implements a composite filter that combines three filters:
- * two filters of line detector ( a line detector by ratio and a line
- * detector by croos-correlation) and a filter that produces a fusion of
- * those two line detector filters.
+ * This class implements a filter that combines two line detectors (a
+ * line detector by ratio and a line detector by cross-correlation) with
+ * their associative symmetrical sum. Both measures are computed from
+ * the same zones, in a single threaded pass over the neighbourhood of
+ * each pixel, instead of running the three filters one after the other.
+ *
+ * The output direction is the one of the line detector by ratio.
  *
  *
  * \ingroup OTBEdge
@@ -80,8 +83,11 @@ protected:
   typedef otb::LineRatioDetectorImageFilter<InputImageType, OutputImageType, OutputImageDirectionType, InterpolatorType>       LineRatioType;
   typedef otb::LineCorrelationDetectorImageFilter<InputImageType, OutputImageType, OutputImageDirectionType, InterpolatorType> LineCorrelationType;
   typedef otb::AssociativeSymmetricalSumImageFilter<InputImageType1, InputImageType2, OutputImageType> AssSymSumType;
+  typedef Functor::AssociativeSymmetricalSum<OutputPixelType, OutputPixelType, OutputPixelType>       AssSymSumFunctorType;
+
+  typedef typename Superclass::DirectionalZonesType DirectionalZonesType;
 
-  void GenerateData() override;
+  void ComputeDetection(DirectionalZonesType& pixelValues, const std::vector<double>& theta, OutputPixelType& intensity, OutputPixelType& direction) override;
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -91,7 +97,6 @@ private:
 
   typename LineRatioType::Pointer       m_LineRatio;
   typename LineCorrelationType::Pointer m_LineCorrelation;
-  typename AssSymSumType::Pointer       m_AssSymSum;
 };
 } // end namespace otb
 
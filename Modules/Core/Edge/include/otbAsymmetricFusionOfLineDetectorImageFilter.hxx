@@ -39,28 +39,43 @@ AsymmetricFusionOfLineDetectorImageFilter<TInputImage, TOutputImage, TOutputImag
 
   m_LineRatio       = LineRatioType::New();
   m_LineCorrelation = LineCorrelationType::New();
-  m_AssSymSum       = AssSymSumType::New();
 }
 
 template <class TInputImage, class TOutputImage, class TOutputImageDirection, class TInterpolator>
-void AsymmetricFusionOfLineDetectorImageFilter<TInputImage, TOutputImage, TOutputImageDirection, TInterpolator>::GenerateData()
+void AsymmetricFusionOfLineDetectorImageFilter<TInputImage, TOutputImage, TOutputImageDirection, TInterpolator>::ComputeDetection(
+    DirectionalZonesType& pixelValues, const std::vector<double>& theta, OutputPixelType& intensity, OutputPixelType& direction)
 {
-  m_LineRatio->SetInput(this->GetInput());
-  m_LineRatio->SetLengthLine(this->m_LengthLine);
-  m_LineRatio->SetWidthLine(this->m_WidthLine);
-  m_LineRatio->SetNumberOfDirections(this->m_NumberOfDirections);
+  // Highest measure of each detector over the directions
+  double ratio          = 0.;
+  double correlation    = 0.;
+  double ratioDirection = 0.;
 
-  m_LineCorrelation->SetInput(this->GetInput());
-  m_LineCorrelation->SetLengthLine(this->m_LengthLine);
-  m_LineCorrelation->SetWidthLine(this->m_WidthLine);
-  m_LineCorrelation->SetNumberOfDirections(this->m_NumberOfDirections);
+  for (unsigned int dir = 0; dir < pixelValues.size(); ++dir)
+  {
+    const double ratioTemp = m_LineRatio->ComputeMeasure(&pixelValues[dir][0], &pixelValues[dir][1], &pixelValues[dir][2]);
+    if (ratioTemp > ratio)
+    {
+      ratio          = ratioTemp;
+      ratioDirection = theta[dir];
+    }
 
-  m_AssSymSum->SetInput1(m_LineRatio->GetOutput());
-  m_AssSymSum->SetInput2(m_LineCorrelation->GetOutput());
+    const double correlationTemp = m_LineCorrelation->ComputeMeasure(&pixelValues[dir][0], &pixelValues[dir][1], &pixelValues[dir][2]);
+    if (correlationTemp > correlation)
+    {
+      correlation = correlationTemp;
+    }
+  }
 
-  m_AssSymSum->GraftOutput(this->GetOutput());
-  m_AssSymSum->Update();
-  this->GraftOutput(m_AssSymSum->GetOutput());
+  // Fusion of the two detections, as stored in their output images
+  AssSymSumFunctorType fusion;
+  intensity = fusion(static_cast<OutputPixelType>(ratio), static_cast<OutputPixelType>(correlation));
+  direction = static_cast<OutputPixelType>(ratioDirection);
+
+  if (intensity < this->GetThreshold())
+  {
+    intensity = itk::NumericTraits<OutputPixelType>::Zero;
+    direction = static_cast<OutputPixelType>(0);
+  }
 }
 
 /**
@@ -31,7 +31,10 @@ namespace otb
 /** \class EdgeDensityImageFilter
  *  \brief This composite filter computes the density of the edges around a pixel.
  *
- *
+ *  Edge detectors such as Canny are not local (non-maximum suppression
+ *  and hysteresis), so the detector always runs on the largest possible
+ *  region of the input. Its output is kept across the streamed regions,
+ *  and only the density is computed on the requested region.
  *
  * \ingroup OTBEdge
  */
@@ -104,6 +107,11 @@ protected:
    * Standard PrintSelf method.
    */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void UpdateOutputInformation() override;
+
+  void PropagateRequestedRegion(itk::DataObject* output) override;
+
   /**
    * Main computation method.
    */
@@ -46,17 +46,36 @@ EdgeDensityImageFilter<TInputImage, TOutputImage, TEdgeDetector, TDensityCount>:
 {
 }
 
-/**
- * threaded Generate Data
- */
 template <class TInputImage, class TOutputImage, class TEdgeDetector, class TDensityCount>
-void EdgeDensityImageFilter<TInputImage, TOutputImage, TEdgeDetector, TDensityCount>::GenerateData()
+void EdgeDensityImageFilter<TInputImage, TOutputImage, TEdgeDetector, TDensityCount>::UpdateOutputInformation()
 {
   m_Detector->SetInput(this->GetInput());
 
   m_DensityImageFilter->SetNeighborhoodRadius(m_NeighborhoodRadius);
   m_DensityImageFilter->SetInput(m_Detector->GetOutput());
 
+  m_DensityImageFilter->GetOutput()->UpdateOutputInformation();
+  this->GetOutput()->CopyInformation(m_DensityImageFilter->GetOutput());
+}
+
+template <class TInputImage, class TOutputImage, class TEdgeDetector, class TDensityCount>
+void EdgeDensityImageFilter<TInputImage, TOutputImage, TEdgeDetector, TDensityCount>::PropagateRequestedRegion(itk::DataObject* itkNotUsed(output))
+{
+  // The detector needs the whole input
+  m_Detector->GetOutput()->SetRequestedRegionToLargestPossibleRegion();
+  m_Detector->GetOutput()->PropagateRequestedRegion();
+}
+
+/**
+ * Generate Data
+ */
+template <class TInputImage, class TOutputImage, class TEdgeDetector, class TDensityCount>
+void EdgeDensityImageFilter<TInputImage, TOutputImage, TEdgeDetector, TDensityCount>::GenerateData()
+{
+  // Detect the edges on the whole image: the detector only runs again if
+  // its input changed, so the next streamed regions reuse its output
+  m_Detector->UpdateLargestPossibleRegion();
+
   m_DensityImageFilter->GraftOutput(this->GetOutput());
   m_DensityImageFilter->Update();
   this->GraftOutput(m_DensityImageFilter->GetOutput());
@@ -33,6 +33,11 @@ namespace otb
  *  The used edge detection filter is given as template of the class.
  *  The class only supports Image.
  *
+ *  Edge detectors such as Canny are not local (non-maximum suppression
+ *  and hysteresis), so the detector always runs on the largest possible
+ *  region of the input. Its output is kept across the streamed regions,
+ *  and only the binarization is computed on the requested region.
+ *
  *
  * \ingroup OTBEdge
  */
@@ -110,6 +115,8 @@ protected:
   EdgeDetectorImageFilter();
   ~EdgeDetectorImageFilter() override;
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+  void UpdateOutputInformation() override;
+  void PropagateRequestedRegion(itk::DataObject* output) override;
   void GenerateData() override;
 
 private:
@@ -49,16 +49,33 @@ EdgeDetectorImageFilter<TInputImage, TOutputImage, TEdgeDetection>::~EdgeDetecto
 {
 }
 
+template <class TInputImage, class TOutputImage, class TEdgeDetection>
+void EdgeDetectorImageFilter<TInputImage, TOutputImage, TEdgeDetection>::UpdateOutputInformation()
+{
+  m_Detector->SetInput(this->GetInput());
+  m_BinaryFilter->SetInput(m_Detector->GetOutput());
+  m_BinaryFilter->GetOutput()->UpdateOutputInformation();
+  this->GetOutput()->CopyInformation(m_BinaryFilter->GetOutput());
+}
+
+template <class TInputImage, class TOutputImage, class TEdgeDetection>
+void EdgeDetectorImageFilter<TInputImage, TOutputImage, TEdgeDetection>::PropagateRequestedRegion(itk::DataObject* itkNotUsed(output))
+{
+  // The detector needs the whole input
+  m_Detector->GetOutput()->SetRequestedRegionToLargestPossibleRegion();
+  m_Detector->GetOutput()->PropagateRequestedRegion();
+}
+
 /**
- * threaded Generate Data
+ * Generate Data
  */
 template <class TInputImage, class TOutputImage, class TEdgeDetection>
 void EdgeDetectorImageFilter<TInputImage, TOutputImage, TEdgeDetection>::GenerateData()
 {
-  m_Detector->SetInput(this->GetInput());
-  m_Detector->Update();
+  // Detect the edges on the whole image: the detector only runs again if
+  // its input changed, so the next streamed regions reuse its output
+  m_Detector->UpdateLargestPossibleRegion();
 
-  m_BinaryFilter->SetInput(m_Detector->GetOutput());
   m_BinaryFilter->GraftOutput(this->GetOutput());
   m_BinaryFilter->Update();
   this->GraftOutput(m_BinaryFilter->GetOutput());
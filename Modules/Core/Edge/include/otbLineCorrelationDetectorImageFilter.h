@@ -75,6 +75,10 @@ public:
   /** Definition of the size of the images. */
   typedef typename InputImageType::SizeType SizeType;
 
+  /** Measure of the detection from the pixels of the three zones of a
+   * direction (also used by AsymmetricFusionOfLineDetectorImageFilter) */
+  double ComputeMeasure(std::vector<double>* m1, std::vector<double>* m2, std::vector<double>* m3) override;
+
 protected:
   LineCorrelationDetectorImageFilter();
   ~LineCorrelationDetectorImageFilter() override
@@ -82,9 +86,6 @@ protected:
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /** Compute the measure */
-  double ComputeMeasure(std::vector<double>* m1, std::vector<double>* m2, std::vector<double>* m3) override;
-
 private:
   LineCorrelationDetectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -26,6 +26,7 @@
 #include "otbImageToModulusAndDirectionImageFilter.h"
 #include "otbImage.h"
 #include "itkNumericTraits.h"
+#include <vector>
 
 namespace otb
 {
@@ -43,6 +44,8 @@ namespace otb
  * ThreadedGenerateData"()" method calls the virtual
  * ComputeMeasure"()" method which implements the detection. This
  * method should be overloaded by each specific line detector.
+ * Detectors combining several measures in the same pass over the
+ * neighbourhood overload ComputeDetection"()" instead.
  *
  * The output is an image of intensity of detection and an image of
  * direction of the line for each pixel.
@@ -94,6 +97,11 @@ public:
   /** Definition of the size of the images. */
   typedef typename InputImageType::SizeType SizeType;
 
+  /** Pixel values of the three zones (center, left and right) of a
+   * direction, and of all the directions */
+  typedef std::vector<std::vector<double>> ZonesType;
+  typedef std::vector<ZonesType>           DirectionalZonesType;
+
   /** Set the length of the linear feature. */
   itkSetMacro(LengthLine, unsigned int);
 
@@ -148,6 +156,11 @@ protected:
 
   virtual double ComputeMeasure(std::vector<double>* m1, std::vector<double>* m2, std::vector<double>* m3);
 
+  /** Compute the output intensity and direction of a pixel from the zones
+   * of each direction of angle theta. The default keeps the direction of
+   * the highest ComputeMeasure(), and cancels it below the threshold. */
+  virtual void ComputeDetection(DirectionalZonesType& pixelValues, const std::vector<double>& theta, OutputPixelType& intensity, OutputPixelType& direction);
+
   /** Length of the linear feature = 2*m_LengthLine+1 */
   unsigned int m_LengthLine;
 
@@ -136,6 +136,8 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
 
   typename InputImageType::ConstPointer input = this->GetInput();
 
+  // Interpolator on the input, used where the whole rotated region lies
+  // in the buffered region (no boundary condition is needed there)
   InterpolatorPointer interpolator2 = InterpolatorType::New();
   interpolator2->SetInputImage(input);
 
@@ -156,6 +158,7 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
   itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType> bC;
   faceList = bC(input, outputRegionForThread, m_FaceList);
 
+  const InputImageRegionType& bufferedRegion = input->GetBufferedRegion();
 
   typename TInputImage::IndexType                bitIndex;
   typename InterpolatorType::ContinuousIndexType Index;
@@ -166,30 +169,26 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
   const unsigned int NB_DIR = this->GetNumberOfDirections();
   // Number of zone
   const int NB_ZONE = 3;
-  // Definition of the 4 directions
-  // double Theta[NB_DIR];
-  // ROMAIN
-  double* Theta = new double[NB_DIR];
+  // Definition of the directions, and of their rotations
+  std::vector<double> Theta(NB_DIR);
+  std::vector<double> CosTheta(NB_DIR);
+  std::vector<double> SinTheta(NB_DIR);
 
   // La rotation nulle correspond a un contour horizontal -> 0 !!
   for (unsigned int i = 0; i < NB_DIR; ++i)
   {
-    Theta[i] = (CONST_PI * (i / double(NB_DIR)));
-    /*    if(Theta[i]>CONST_PI)
-          Theta[i] = Theta[i]-CONST_PI;
-        if((i/double(NB_DIR))==0.5)
-          Theta[i]=0.; */
+    Theta[i]    = (CONST_PI * (i / double(NB_DIR)));
+    CosTheta[i] = std::cos(Theta[i]);
+    SinTheta[i] = std::sin(Theta[i]);
   }
 
+  // Contains for the directions the pixels belonging to each zone. The
+  // vectors are kept from one pixel to the next to avoid reallocations.
+  DirectionalZonesType PixelValues(NB_DIR, ZonesType(NB_ZONE));
+
   // Number of the zone
   unsigned int zone;
 
-  // Intensity of the linear feature
-  double R;
-
-  // Direction of detection
-  double Direction = 0.;
-
   // Pixel location in the input image
   int X, Y;
 
@@ -208,8 +207,6 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
   // Process each of the boundary faces.  These are N-d regions which border
   // the edge of the buffer.
 
-  // bool interiorFace = true;
-
   for (fit = faceList.begin(); fit != faceList.end(); ++fit)
   {
     bit = itk::ConstNeighborhoodIterator<InputImageType>(m_Radius, input, *fit);
@@ -223,52 +220,60 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
     cit.OverrideBoundaryCondition(&nbc);
     cit.GoToBegin();
 
+    // If the face keeps the rotated region of all its pixels inside the
+    // buffered region, the input image can be used for the interpolation
+    bool interiorFace = true;
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      const long faceStart = fit->GetIndex()[dim];
+      const long faceEnd   = faceStart + static_cast<long>(fit->GetSize()[dim]);
+      const long bufStart  = bufferedRegion.GetIndex()[dim];
+      const long bufEnd    = bufStart + static_cast<long>(bufferedRegion.GetSize()[dim]);
+      interiorFace         = interiorFace && faceStart - static_cast<long>(m_FaceList[dim]) >= bufStart &&
+                     faceEnd + static_cast<long>(m_FaceList[dim]) <= bufEnd;
+    }
+
     otbMsgDevMacro(<< " ------------------- FaceList --------------------------");
 
     while ((!bit.IsAtEnd()) && (!cit.IsAtEnd()))
     {
-      InterpolatorPointer interpolator = InterpolatorType::New();
       // Location of the central pixel of the region
       off.Fill(0);
       bitIndex = bit.GetIndex(off);
       Xc       = bitIndex[0];
       Yc       = bitIndex[1];
 
-      // JULIEN :  If the processed region is the center face
-      // the input image can be used for the interpolation
-      // if (interiorFace)
-      //  {
-      //  interpolator->SetInputImage(input);
-      //  }
-      // else we must feed the interpolator with a partial image corresponding
+      // Else we must feed the interpolator with a partial image corresponding
       // to the boundary conditions
-      // else
-      //  {
-      typename InputImageType::RegionType tempRegion;
-      typename InputImageType::SizeType   tempSize;
-      tempSize[0] = 2 * m_FaceList[0] + 1;
-      tempSize[1] = 2 * m_FaceList[1] + 1;
-      tempRegion.SetSize(tempSize);
-      typename itk::ConstNeighborhoodIterator<InputImageType>::OffsetType tempIndex;
-      tempIndex[0] = off[0] - m_FaceList[0];
-      tempIndex[1] = off[1] - m_FaceList[1];
-      tempRegion.SetIndex(cit.GetIndex(tempIndex));
-      typename InputImageType::Pointer tempImage = InputImageType::New();
-      tempImage->SetRegions(tempRegion);
-      tempImage->Allocate();
-
-      for (unsigned int p = 0; p <= 2 * m_FaceList[0]; ++p)
+      InterpolatorPointer interpolator = interpolator2;
+      if (!interiorFace)
       {
-        for (unsigned int q = 0; q <= 2 * m_FaceList[1]; q++)
+        interpolator = InterpolatorType::New();
+        typename InputImageType::RegionType tempRegion;
+        typename InputImageType::SizeType   tempSize;
+        tempSize[0] = 2 * m_FaceList[0] + 1;
+        tempSize[1] = 2 * m_FaceList[1] + 1;
+        tempRegion.SetSize(tempSize);
+        typename itk::ConstNeighborhoodIterator<InputImageType>::OffsetType tempIndex;
+        tempIndex[0] = off[0] - m_FaceList[0];
+        tempIndex[1] = off[1] - m_FaceList[1];
+        tempRegion.SetIndex(cit.GetIndex(tempIndex));
+        typename InputImageType::Pointer tempImage = InputImageType::New();
+        tempImage->SetRegions(tempRegion);
+        tempImage->Allocate();
+
+        for (unsigned int p = 0; p <= 2 * m_FaceList[0]; ++p)
         {
-          typename itk::ConstNeighborhoodIterator<InputImageType>::OffsetType index;
-          index[0] = p - m_FaceList[0];
-          index[1] = q - m_FaceList[1];
-          tempImage->SetPixel(cit.GetIndex(index), cit.GetPixel(index));
+          for (unsigned int q = 0; q <= 2 * m_FaceList[1]; q++)
+          {
+            typename itk::ConstNeighborhoodIterator<InputImageType>::OffsetType index;
+            index[0] = p - m_FaceList[0];
+            index[1] = q - m_FaceList[1];
+            tempImage->SetPixel(cit.GetIndex(index), cit.GetPixel(index));
+          }
         }
+        interpolator->SetInputImage(tempImage);
       }
-      interpolator->SetInputImage(tempImage);
-      // }
 
       // Location of the central pixel between zone 1 and zone 2
       Yc12 = Yc - m_WidthLine - 1;
@@ -276,17 +281,14 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
       // Location of the central pixel between zone 1 and zone 3
       Yc13 = Yc + m_WidthLine + 1;
 
-      // Contains for the 4 directions the the pixels belonging to each zone
-      // std::vector<double> PixelValues[NB_DIR][NB_ZONE];
-      // ROMAIN
-      std::vector<double>** PixelValues = nullptr;
-      PixelValues                       = new std::vector<double>*[NB_DIR];
-      for (unsigned int i = 0; i < NB_DIR; ++i)
+      for (unsigned int dir = 0; dir < NB_DIR; ++dir)
       {
-        PixelValues[i] = nullptr;
-        PixelValues[i] = new std::vector<double>[NB_ZONE];
+        for (int z = 0; z < NB_ZONE; ++z)
+        {
+          PixelValues[dir][z].clear();
+        }
       }
-      // otbMsgDevMacro( << "\tCentre Xc/Yc="<<Xc<<" "<<Yc<<" Yc12/Yc13="<<Yc12<<" "<<Yc13);
+
       // Loop on the region
       for (unsigned int i = 0; i < m_Radius[0]; ++i)
         for (unsigned int j = 0; j < m_Radius[1]; ++j)
@@ -308,14 +310,14 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
             zone = 2;
           else
             continue;
-          // otbMsgDevMacro( << "\t\tPoint traite (i, j)=("<<i<<","<<j<<") -> X, Y="<<X<<","<<Y<<"  zone="<<zone);
+
           // Loop on the directions
           for (unsigned int dir = 0; dir < NB_DIR; ++dir)
           {
             // ROTATION( (X-Xc), (Y-Yc), Theta[dir], xout, yout);
 
-            xout = (X - Xc) * std::cos(Theta[dir]) - (Y - Yc) * std::sin(Theta[dir]);
-            yout = (X - Xc) * std::sin(Theta[dir]) + (Y - Yc) * std::cos(Theta[dir]);
+            xout = (X - Xc) * CosTheta[dir] - (Y - Yc) * SinTheta[dir];
+            yout = (X - Xc) * SinTheta[dir] + (Y - Yc) * CosTheta[dir];
 
             Index[0] = static_cast<CoordRepType>(xout + Xc);
             Index[1] = static_cast<CoordRepType>(yout + Yc);
@@ -324,57 +326,59 @@ void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirectio
           }
         } // end of the loop on the pixels of the region
 
-      R         = 0.;
-      Direction = 0.;
-
-      // Loop on the 4 directions
-
-      for (unsigned int dir = 0; dir < NB_DIR; ++dir)
-      {
+      OutputPixelType intensity;
+      OutputPixelType direction;
+      this->ComputeDetection(PixelValues, Theta, intensity, direction);
 
-        double Rtemp = this->ComputeMeasure(&PixelValues[dir][0], &PixelValues[dir][1], &PixelValues[dir][2]);
-
-        if (Rtemp > R)
-        {
-          R         = Rtemp;
-          Direction = Theta[dir];
-        }
-
-      } // end of the loop on the directions
-
-      // otbMsgDevMacro( << "\t\tR, Direction : "<<R<<","<<Direction);
-      if (R >= this->GetThreshold())
-      {
+      // Assignment of this value to the output pixel
+      it.Set(intensity);
 
-        // Assignment of this value to the output pixel
-        it.Set(static_cast<OutputPixelType>(R));
+      // Assignment of this value to the "outputdir" pixel
+      itdir.Set(direction);
 
-        // Assignment of this value to the "outputdir" pixel
-        itdir.Set(static_cast<OutputPixelType>(Direction));
-      }
-      else
-      {
-
-        it.Set(itk::NumericTraits<OutputPixelType>::Zero);
-
-        itdir.Set(static_cast<OutputPixelType>(0));
-      }
       ++bit;
       ++cit;
       ++it;
       ++itdir;
-      // interiorFace = false;
+    }
+  }
+}
 
-      for (unsigned int i = 0; i < NB_DIR; ++i)
-      {
-        delete[] PixelValues[i];
-        PixelValues[i] = nullptr;
-      }
-      delete[] PixelValues;
-      PixelValues = nullptr;
+template <class TInputImage, class TOutputImage, class TOutputImageDirection, class InterpolatorType>
+void LineDetectorImageFilterBase<TInputImage, TOutputImage, TOutputImageDirection, InterpolatorType>::ComputeDetection(DirectionalZonesType&      pixelValues,
+                                                                                                                         const std::vector<double>& theta,
+                                                                                                                         OutputPixelType&           intensity,
+                                                                                                                         OutputPixelType&           direction)
+{
+  // Intensity of the linear feature
+  double R = 0.;
+
+  // Direction of detection
+  double Direction = 0.;
+
+  // Loop on the directions
+  for (unsigned int dir = 0; dir < pixelValues.size(); ++dir)
+  {
+    double Rtemp = this->ComputeMeasure(&pixelValues[dir][0], &pixelValues[dir][1], &pixelValues[dir][2]);
+
+    if (Rtemp > R)
+    {
+      R         = Rtemp;
+      Direction = theta[dir];
     }
+
+  } // end of the loop on the directions
+
+  if (R >= this->GetThreshold())
+  {
+    intensity = static_cast<OutputPixelType>(R);
+    direction = static_cast<OutputPixelType>(Direction);
+  }
+  else
+  {
+    intensity = itk::NumericTraits<OutputPixelType>::Zero;
+    direction = static_cast<OutputPixelType>(0);
   }
-  delete[] Theta;
 }
 
 template <class TInputImage, class TOutputImage, class TOutputImageDirection, class InterpolatorType>
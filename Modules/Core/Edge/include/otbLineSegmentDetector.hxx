@@ -116,12 +116,16 @@ void LineSegmentDetector<TInputImage, TPrecision>::GenerateData()
   typedef itk::CastImageFilter<InputImageType, OutputImageType> castFilerType;
   typename castFilerType::Pointer castFilter = castFilerType::New();
   castFilter->SetInput(this->GetInput());
+  castFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   /** Compute the modulus and the orientation gradient image */
   m_GradientFilter->SetInput(castFilter->GetOutput());
   m_GradientFilter->SetSigma(0.6);
   m_MagnitudeFilter->SetInput(m_GradientFilter->GetOutput());
   m_OrientationFilter->SetInput(m_GradientFilter->GetOutput());
+  m_GradientFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  m_MagnitudeFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  m_OrientationFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   m_MagnitudeFilter->Update();
   m_OrientationFilter->Update();
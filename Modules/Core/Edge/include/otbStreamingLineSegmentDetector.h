@@ -33,6 +33,7 @@
 
 #include "otbPersistentFilterStreamingDecorator.h"
 #include "otbPersistentImageToVectorDataFilter.h"
+#include "otbOGRLayerWrapper.h"
 
 namespace otb
 {
@@ -42,6 +43,19 @@ namespace otb
  *  This filter is a generic PersistentImageFilter, which encapsulate
  *  the Line Segment detector filter.
  *
+ *  By default, each streamed region is processed at once and the
+ *  segments crossing the borders of the regions are cut. In tiled
+ *  mode (a margin, a tile size or an OGR layer set), the streamed
+ *  regions are split in tiles of TileSize pixels, processed in
+ *  parallel. Each tile is detected with an overlap margin around it,
+ *  and only keeps the segments whose middle lies inside it. The
+ *  segments cut by a tile, and the ones close to the borders of the
+ *  tiles, are reconciled once the whole image is processed: collinear
+ *  segments with close endpoints are merged.
+ *
+ *  In tiled mode, the segments can be written to an OGR layer as soon
+ *  as their tile is processed, instead of the output vector data.
+ *
  * \sa PersistentImageToVectorDataFilter
  *
  *
@@ -66,12 +80,45 @@ public:
   typedef typename Superclass::OutputVectorDataPointerType OutputVectorDataPointerType;
 
   typedef typename Superclass::ExtractImageFilterType ExtractImageFilterType;
+  typedef typename Superclass::RegionType             RegionType;
+
+  typedef ogr::Layer OGRLayerType;
+
+  /** Segment in continuous index coordinates */
+  struct SegmentType
+  {
+    double Start[2];
+    double End[2];
+    /** Whether the segment reaches the border of its tile */
+    bool Border;
+  };
+  typedef std::vector<SegmentType> SegmentListType;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Runtime information support. */
   itkTypeMacro(PersistentStreamingLineSegmentDetector, PersistentImageToVectorDataFilter);
 
+  /** Overlap margin in pixels around the tiles (tiled mode) */
+  itkSetMacro(Margin, unsigned int);
+  itkGetMacro(Margin, unsigned int);
+
+  /** Size of the tiles processed in parallel, 0 for a single tile per streamed region (tiled mode) */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetMacro(TileSize, unsigned int);
+
+  /** Set the layer in which the segments are written (tiled mode) */
+  void SetOGRLayer(const OGRLayerType& ogrLayer);
+  const OGRLayerType& GetOGRLayer() const;
+
+  /** Whether the tiled mode is enabled */
+  bool IsTiled() const;
+
+  void Reset() override;
+
+  void Synthetize() override;
+
 protected:
   PersistentStreamingLineSegmentDetector();
 
@@ -84,6 +131,22 @@ private:
   void operator=(const Self&) = delete;
 
   OutputVectorDataPointerType ProcessTile() override;
+
+  /** Detect the segments of a tile, adding the ones to reconcile to the pending ones */
+  void DetectSegments(const RegionType& tile, SegmentListType& segments, SegmentListType& pending) const;
+
+  /** Merge the collinear segments with close endpoints, one of them reaching the border of its tile */
+  void MergeSegments(SegmentListType& segments) const;
+
+  /** Write the segments in the OGR layer, or convert them to a vector data */
+  OutputVectorDataPointerType OutputSegments(const SegmentListType& segments);
+
+  unsigned int m_Margin;
+  unsigned int m_TileSize;
+  OGRLayerType m_OGRLayer;
+
+  /** Segments to reconcile at the end of the streaming */
+  SegmentListType m_PendingSegments;
 };
 
 template <class TImageType>
@@ -25,13 +25,21 @@
 #include "otbStreamingLineSegmentDetector.h"
 
 #include "otbVectorDataTransformFilter.h"
+#include "otbOGRFeatureWrapper.h"
+#include "otbMath.h"
 #include "itkAffineTransform.h"
+#include "itkImageAlgorithm.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 
 namespace otb
 {
 
 template <class TInputImage>
 PersistentStreamingLineSegmentDetector<TInputImage>::PersistentStreamingLineSegmentDetector()
+  : m_Margin(0), m_TileSize(0), m_OGRLayer(nullptr, false)
 {
 }
 
@@ -51,16 +59,96 @@ void PersistentStreamingLineSegmentDetector<TInputImage>::GenerateInputRequested
 
     typename InputImageType::RegionType region = this->GetOutput()->GetRequestedRegion();
 
-    region.PadByRadius(1);
+    region.PadByRadius(IsTiled() ? std::max(m_Margin, 1u) : 1);
     region.Crop(input->GetLargestPossibleRegion());
 
     input->SetRequestedRegion(region);
   }
 }
 
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::SetOGRLayer(const OGRLayerType& ogrLayer)
+{
+  m_OGRLayer = ogrLayer;
+  this->Modified();
+}
+
+template <class TInputImage>
+const typename PersistentStreamingLineSegmentDetector<TInputImage>::OGRLayerType& PersistentStreamingLineSegmentDetector<TInputImage>::GetOGRLayer() const
+{
+  return m_OGRLayer;
+}
+
+template <class TInputImage>
+bool PersistentStreamingLineSegmentDetector<TInputImage>::IsTiled() const
+{
+  return m_Margin > 0 || m_TileSize > 0 || m_OGRLayer;
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::Reset()
+{
+  Superclass::Reset();
+  m_PendingSegments.clear();
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::Synthetize()
+{
+  Superclass::Synthetize();
+  if (m_PendingSegments.empty())
+  {
+    return;
+  }
+
+  MergeSegments(m_PendingSegments);
+  OutputVectorDataPointerType merged = OutputSegments(m_PendingSegments);
+  m_PendingSegments.clear();
+
+  // Same concatenation as the one of the streamed tiles
+  OutputVectorDataPointerType output = this->GetOutputVectorData();
+  typename Superclass::ConcatenateVectorDataFilterPointerType concatenate = Superclass::ConcatenateVectorDataFilterType::New();
+  concatenate->AddInput(output);
+  concatenate->AddInput(merged);
+  concatenate->Update();
+  concatenate->GetOutput()->SetMetaDataDictionary(merged->GetMetaDataDictionary());
+  output->Graft(concatenate->GetOutput());
+}
+
 template <class TInputImage>
 typename PersistentStreamingLineSegmentDetector<TInputImage>::OutputVectorDataPointerType PersistentStreamingLineSegmentDetector<TInputImage>::ProcessTile()
 {
+  if (IsTiled())
+  {
+    // Split the streamed region in tiles, processed in parallel
+    const RegionType   region   = this->GetOutput()->GetRequestedRegion();
+    const unsigned int tileSize = m_TileSize > 0 ? m_TileSize : std::max(region.GetSize(0), region.GetSize(1));
+    std::vector<RegionType> tiles;
+    for (unsigned int y = 0; y < region.GetSize(1); y += tileSize)
+    {
+      for (unsigned int x = 0; x < region.GetSize(0); x += tileSize)
+      {
+        RegionType tile;
+        tile.SetIndex(0, region.GetIndex(0) + x);
+        tile.SetIndex(1, region.GetIndex(1) + y);
+        tile.SetSize(0, std::min(tileSize, static_cast<unsigned int>(region.GetSize(0)) - x));
+        tile.SetSize(1, std::min(tileSize, static_cast<unsigned int>(region.GetSize(1)) - y));
+        tiles.push_back(tile);
+      }
+    }
+
+    std::vector<SegmentListType> segments(tiles.size()), pending(tiles.size());
+    this->GetMultiThreader()->ParallelizeArray(0, tiles.size(), [&](itk::SizeValueType i) { DetectSegments(tiles[i], segments[i], pending[i]); }, nullptr);
+
+    SegmentListType regionSegments;
+    for (unsigned int i = 0; i < tiles.size(); ++i)
+    {
+      regionSegments.insert(regionSegments.end(), segments[i].begin(), segments[i].end());
+      m_PendingSegments.insert(m_PendingSegments.end(), pending[i].begin(), pending[i].end());
+    }
+    return OutputSegments(regionSegments);
+  }
+
   // Apply an ExtractImageFilter to avoid problems with filters asking for the LargestPossibleRegion
   typename ExtractImageFilterType::Pointer extract = ExtractImageFilterType::New();
   extract->SetInput(this->GetInput());
@@ -80,6 +168,281 @@ typename PersistentStreamingLineSegmentDetector<TInputImage>::OutputVectorDataPo
   return lsd->GetOutput();
 }
 
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::DetectSegments(const RegionType& tile, SegmentListType& segments, SegmentListType& pending) const
+{
+  // Endpoints closer to the border of a tile are considered cut by it
+  const double borderDistance = 2.;
+
+  const InputImageType* input   = this->GetInput();
+  const RegionType&     largest = input->GetLargestPossibleRegion();
+  RegionType            detectionRegion(tile);
+  detectionRegion.PadByRadius(std::max(m_Margin, 1u));
+  detectionRegion.Crop(input->GetBufferedRegion());
+
+  // Copy the tile, as the streamed region is shared by the threads
+  typename InputImageType::Pointer image = InputImageType::New();
+  image->CopyInformation(input);
+  image->SetRegions(detectionRegion);
+  image->Allocate();
+  itk::ImageAlgorithm::Copy(input, image.GetPointer(), detectionRegion, detectionRegion);
+  // LSD filter need the projection ref if available
+  image->SetMetaDataDictionary(input->GetMetaDataDictionary());
+
+  typename LSDType::Pointer lsd = LSDType::New();
+  lsd->SetNumberOfWorkUnits(1);
+  lsd->SetInput(image);
+  lsd->Update();
+
+  // Distance of a point to the borders of a region which are not the ones of the image
+  auto distanceToBorders = [&largest](const RegionType& region, const double* point) {
+    double distance = std::numeric_limits<double>::infinity();
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      const double first = region.GetIndex(d);
+      const double last  = region.GetIndex(d) + static_cast<double>(region.GetSize(d)) - 1;
+      if (region.GetIndex(d) != largest.GetIndex(d))
+      {
+        distance = std::min(distance, point[d] - first);
+      }
+      if (region.GetIndex(d) + region.GetSize(d) != largest.GetIndex(d) + largest.GetSize(d))
+      {
+        distance = std::min(distance, last - point[d]);
+      }
+    }
+    return distance;
+  };
+
+  const typename InputImageType::PointType   origin  = input->GetOrigin();
+  const typename InputImageType::SpacingType spacing = input->GetSignedSpacing();
+  const OutputVectorDataType*                 lines   = lsd->GetOutput();
+  for (auto it = lines->GetIteratorPair(); it.first != it.second; ++it.first)
+  {
+    const typename OutputVectorDataType::DataNodePointerType node = lines->Get(it.first);
+    if (!node->IsLineFeature())
+    {
+      continue;
+    }
+
+    // Back to index coordinates
+    const auto  vertices = node->GetLine()->GetVertexList();
+    SegmentType segment;
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      segment.Start[d] = (vertices->GetElement(0)[d] - origin[d]) / spacing[d];
+      segment.End[d]   = (vertices->GetElement(1)[d] - origin[d]) / spacing[d];
+    }
+
+    // Segments detected by several tiles belong to the one containing their middle
+    typename InputImageType::IndexType middle;
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      middle[d] = static_cast<typename InputImageType::IndexValueType>(std::floor(0.5 * (segment.Start[d] + segment.End[d]) + 0.5));
+    }
+    if (!tile.IsInside(middle))
+    {
+      continue;
+    }
+
+    segment.Border =
+        distanceToBorders(detectionRegion, segment.Start) < borderDistance || distanceToBorders(detectionRegion, segment.End) < borderDistance;
+    const double nearBorder = m_Margin + borderDistance;
+    if (segment.Border || distanceToBorders(tile, segment.Start) < nearBorder || distanceToBorders(tile, segment.End) < nearBorder)
+    {
+      pending.push_back(segment);
+    }
+    else
+    {
+      segments.push_back(segment);
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::MergeSegments(SegmentListType& segments) const
+{
+  // Tolerances on the distances (in pixels) and the angles between merged segments
+  const double distanceTolerance = 2.;
+  const double angleTolerance    = std::sin(CONST_PI / 16);
+
+  auto length = [](const SegmentType& segment) { return std::hypot(segment.End[0] - segment.Start[0], segment.End[1] - segment.Start[1]); };
+
+  // Whether the shorter segment lies along the longer one, with close endpoints
+  auto isMergeable = [&](const SegmentType& a, const SegmentType& b) {
+    const bool          aIsLonger = length(a) >= length(b);
+    const SegmentType&  longer    = aIsLonger ? a : b;
+    const SegmentType&  shorter   = aIsLonger ? b : a;
+    const double        norm      = length(longer);
+    if (norm == 0)
+    {
+      return false;
+    }
+    const double u[2] = {(longer.End[0] - longer.Start[0]) / norm, (longer.End[1] - longer.Start[1]) / norm};
+    const double shorterNorm = length(shorter);
+    if (shorterNorm > 0 &&
+        std::abs(u[0] * (shorter.End[1] - shorter.Start[1]) - u[1] * (shorter.End[0] - shorter.Start[0])) > angleTolerance * shorterNorm)
+    {
+      return false;
+    }
+    double tMin = std::numeric_limits<double>::infinity(), tMax = -tMin;
+    for (const double* point : {shorter.Start, shorter.End})
+    {
+      const double dx = point[0] - longer.Start[0];
+      const double dy = point[1] - longer.Start[1];
+      if (std::abs(u[0] * dy - u[1] * dx) > distanceTolerance)
+      {
+        return false;
+      }
+      tMin = std::min(tMin, u[0] * dx + u[1] * dy);
+      tMax = std::max(tMax, u[0] * dx + u[1] * dy);
+    }
+    return tMin - norm <= distanceTolerance && -tMax <= distanceTolerance;
+  };
+
+  // Groups of segments to merge, compared by increasing abscissa
+  const std::size_t        nbSegments = segments.size();
+  std::vector<std::size_t> parent(nbSegments), order(nbSegments);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::iota(order.begin(), order.end(), 0);
+  auto find = [&parent](std::size_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i         = parent[i];
+    }
+    return i;
+  };
+  auto minX = [&segments](std::size_t i) { return std::min(segments[i].Start[0], segments[i].End[0]); };
+  auto maxX = [&segments](std::size_t i) { return std::max(segments[i].Start[0], segments[i].End[0]); };
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return minX(a) < minX(b); });
+  for (std::size_t i = 0; i < nbSegments; ++i)
+  {
+    const std::size_t a = order[i];
+    for (std::size_t j = i + 1; j < nbSegments && minX(order[j]) <= maxX(a) + distanceTolerance; ++j)
+    {
+      const std::size_t b = order[j];
+      if ((segments[a].Border || segments[b].Border) && isMergeable(segments[a], segments[b]))
+      {
+        parent[find(a)] = find(b);
+      }
+    }
+  }
+
+  // Each group becomes the projection of its endpoints on its longest segment
+  std::vector<std::vector<std::size_t>> groups(nbSegments);
+  for (std::size_t i = 0; i < nbSegments; ++i)
+  {
+    groups[find(i)].push_back(i);
+  }
+  SegmentListType merged;
+  for (std::size_t i = 0; i < nbSegments; ++i)
+  {
+    const std::vector<std::size_t>& group = groups[find(i)];
+    if (group.front() != i)
+    {
+      continue;
+    }
+    SegmentType longest = segments[group.front()];
+    for (std::size_t member : group)
+    {
+      if (length(segments[member]) > length(longest))
+      {
+        longest = segments[member];
+      }
+    }
+    const double norm = length(longest);
+    if (group.size() == 1 || norm == 0)
+    {
+      merged.push_back(segments[i]);
+      continue;
+    }
+    const double u[2] = {(longest.End[0] - longest.Start[0]) / norm, (longest.End[1] - longest.Start[1]) / norm};
+    double       tMin = 0., tMax = norm;
+    for (std::size_t member : group)
+    {
+      for (const double* point : {segments[member].Start, segments[member].End})
+      {
+        const double t = u[0] * (point[0] - longest.Start[0]) + u[1] * (point[1] - longest.Start[1]);
+        tMin           = std::min(tMin, t);
+        tMax           = std::max(tMax, t);
+      }
+    }
+    SegmentType segment;
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      segment.Start[d] = longest.Start[d] + tMin * u[d];
+      segment.End[d]   = longest.Start[d] + tMax * u[d];
+    }
+    segment.Border = false;
+    merged.push_back(segment);
+  }
+  segments.swap(merged);
+}
+
+template <class TInputImage>
+typename PersistentStreamingLineSegmentDetector<TInputImage>::OutputVectorDataPointerType
+PersistentStreamingLineSegmentDetector<TInputImage>::OutputSegments(const SegmentListType& segments)
+{
+  typedef typename OutputVectorDataType::DataNodeType DataNodeType;
+  typedef typename OutputVectorDataType::LineType     LineType;
+
+  const typename InputImageType::PointType   origin  = this->GetInput()->GetOrigin();
+  const typename InputImageType::SpacingType spacing = this->GetInput()->GetSignedSpacing();
+
+  OutputVectorDataPointerType vectorData = OutputVectorDataType::New();
+  if (m_OGRLayer)
+  {
+    OGRErr err = m_OGRLayer.ogr().StartTransaction();
+    if (err != OGRERR_NONE)
+    {
+      itkExceptionMacro(<< "Unable to start transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+    }
+    for (const SegmentType& segment : segments)
+    {
+      OGRLineString line;
+      line.addPoint(origin[0] + segment.Start[0] * spacing[0], origin[1] + segment.Start[1] * spacing[1]);
+      line.addPoint(origin[0] + segment.End[0] * spacing[0], origin[1] + segment.End[1] * spacing[1]);
+      ogr::Feature feature(m_OGRLayer.GetLayerDefn());
+      feature.SetGeometry(&line);
+      m_OGRLayer.CreateFeature(feature);
+    }
+    err = m_OGRLayer.ogr().CommitTransaction();
+    if (err != OGRERR_NONE)
+    {
+      itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+    }
+    return vectorData;
+  }
+
+  // Same structure as the output of the LSD filter
+  vectorData->SetMetaDataDictionary(this->GetInput()->GetMetaDataDictionary());
+  vectorData->SetProjectionRef(this->GetInput()->GetProjectionRef());
+  typename DataNodeType::Pointer document = DataNodeType::New();
+  document->SetNodeType(otb::DOCUMENT);
+  vectorData->Add(document, vectorData->GetRoot());
+  typename DataNodeType::Pointer folder = DataNodeType::New();
+  folder->SetNodeType(otb::FOLDER);
+  vectorData->Add(folder, document);
+
+  for (const SegmentType& segment : segments)
+  {
+    typename LineType::VertexType start, end;
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      start[d] = origin[d] + segment.Start[d] * spacing[d];
+      end[d]   = origin[d] + segment.End[d] * spacing[d];
+    }
+    typename DataNodeType::Pointer node = DataNodeType::New();
+    node->SetNodeId("FEATURE_LINE");
+    node->SetNodeType(otb::FEATURE_LINE);
+    node->SetLine(LineType::New());
+    node->GetLine()->AddVertex(start);
+    node->GetLine()->AddVertex(end);
+    vectorData->Add(node, folder);
+  }
+  return vectorData;
+}
+
 
 } // end namespace otb
 #endif
@@ -26,6 +26,7 @@ otb_module(OTBEdge
   DEPENDS
     OTBCommon
     OTBConversion
+    OTBGdalAdapters
     OTBITK
     OTBImageBase
     OTBImageManipulation
@@ -27,7 +27,7 @@
 #include "otbImageFileWriter.h"
 #include "otbAsymmetricFusionOfLineDetectorImageFilter.h"
 
-int otbAsymmetricFusionOfLineDetector(int itkNotUsed(argc), char* argv[])
+int otbAsymmetricFusionOfLineDetector(int argc, char* argv[])
 {
   const char* inputFilename  = argv[1];
   const char* outputFilename = argv[2];
@@ -66,6 +66,12 @@ int otbAsymmetricFusionOfLineDetector(int itkNotUsed(argc), char* argv[])
   FilterAssSymSum->SetInput(reader->GetOutput());
   writer->SetInput(FilterAssSymSum->GetOutput());
 
+  // Optional number of streamed strips
+  if (argc > 5)
+  {
+    writer->SetNumberOfDivisionsStrippedStreaming(atoi(argv[5]));
+  }
+
   writer->Update();
 
   return EXIT_SUCCESS;
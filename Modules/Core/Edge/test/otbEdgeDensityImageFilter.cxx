@@ -26,7 +26,7 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 
-int otbEdgeDensityImageFilter(int itkNotUsed(argc), char* argv[])
+int otbEdgeDensityImageFilter(int argc, char* argv[])
 {
 
   const char*        infname  = argv[1];
@@ -74,6 +74,13 @@ int otbEdgeDensityImageFilter(int itkNotUsed(argc), char* argv[])
   WriterType::Pointer writer = WriterType::New();
   writer->SetFileName(outfname);
   writer->SetInput(filter->GetOutput());
+
+  // Optional number of streamed strips
+  if (argc > 8)
+  {
+    writer->SetNumberOfDivisionsStrippedStreaming(atoi(argv[8]));
+  }
+
   writer->Update();
 
   return EXIT_SUCCESS;
@@ -35,6 +35,7 @@ void RegisterTests()
   REGISTER_TEST(otbTouziEdgeDetectorDirection);
   REGISTER_TEST(otbVerticalSobelVectorImageFilterTest);
   REGISTER_TEST(otbStreamingLineSegmentDetector);
+  REGISTER_TEST(otbStreamingLineSegmentDetectorTiled);
   REGISTER_TEST(otbTouziEdgeDetector);
   REGISTER_TEST(otbLineRatioDetectorLinear);
   REGISTER_TEST(otbLineSegmentDetector);
@@ -23,6 +23,9 @@
 #include "otbStreamingLineSegmentDetector.h"
 #include "otbImageFileReader.h"
 #include "otbVectorDataFileWriter.h"
+#include "otbOGRDataSourceWrapper.h"
+#include <cmath>
+#include <vector>
 
 
 int otbStreamingLineSegmentDetector(int itkNotUsed(argc), char* argv[])
@@ -55,3 +58,99 @@ int otbStreamingLineSegmentDetector(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+typedef otb::Image<float, 2>                                        TiledImageType;
+typedef otb::StreamingLineSegmentDetector<TiledImageType>::FilterType TiledDetectorType;
+typedef TiledDetectorType::FilterType::OutputVectorDataType         TiledVectorDataType;
+
+std::vector<std::vector<double>> GetSegments(const TiledVectorDataType* vectorData)
+{
+  std::vector<std::vector<double>> segments;
+  for (auto it = vectorData->GetIteratorPair(); it.first != it.second; ++it.first)
+  {
+    if (vectorData->Get(it.first)->IsLineFeature())
+    {
+      const auto vertices = vectorData->Get(it.first)->GetLine()->GetVertexList();
+      segments.push_back({vertices->GetElement(0)[0], vertices->GetElement(0)[1], vertices->GetElement(1)[0], vertices->GetElement(1)[1]});
+    }
+  }
+  return segments;
+}
+}
+
+int otbStreamingLineSegmentDetectorTiled(int itkNotUsed(argc), char* argv[])
+{
+  const unsigned int nbLines  = atoi(argv[2]);
+  const unsigned int margin   = atoi(argv[3]);
+  const unsigned int tileSize = atoi(argv[4]);
+
+  typedef otb::ImageFileReader<TiledImageType> ReaderType;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->UpdateOutputInformation();
+  const double spacing = std::abs(reader->GetOutput()->GetSignedSpacing()[0]);
+
+  // Whole image at once
+  TiledDetectorType::Pointer reference = TiledDetectorType::New();
+  reference->GetFilter()->SetInput(reader->GetOutput());
+  reference->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(1);
+  reference->Update();
+  const auto referenceSegments = GetSegments(reference->GetFilter()->GetOutputVectorData());
+
+  // Streamed tiles
+  TiledDetectorType::Pointer tiled = TiledDetectorType::New();
+  tiled->GetFilter()->SetInput(reader->GetOutput());
+  tiled->GetFilter()->SetMargin(margin);
+  tiled->GetFilter()->SetTileSize(tileSize);
+  tiled->GetStreamer()->SetNumberOfLinesStrippedStreaming(nbLines);
+  tiled->Update();
+  const auto tiledSegments = GetSegments(tiled->GetFilter()->GetOutputVectorData());
+
+  // Same segments written in an OGR layer
+  otb::ogr::DataSource::Pointer dataSource = otb::ogr::DataSource::New();
+  otb::ogr::Layer               layer      = dataSource->CreateLayer("lines", nullptr, wkbLineString);
+  TiledDetectorType::Pointer    ogrTiled   = TiledDetectorType::New();
+  ogrTiled->GetFilter()->SetInput(reader->GetOutput());
+  ogrTiled->GetFilter()->SetMargin(margin);
+  ogrTiled->GetFilter()->SetTileSize(tileSize);
+  ogrTiled->GetFilter()->SetOGRLayer(layer);
+  ogrTiled->GetStreamer()->SetNumberOfLinesStrippedStreaming(nbLines);
+  ogrTiled->Update();
+  otbControlConditionTestMacro(layer.GetFeatureCount(true) != static_cast<int>(tiledSegments.size()),
+                               "The OGR layer holds " << layer.GetFeatureCount(true) << " segments instead of " << tiledSegments.size());
+
+  // Long segments of the whole image are found across the tiles
+  const double tolerance = 3 * spacing;
+  unsigned int nbLong = 0, nbFound = 0;
+  for (const auto& segment : referenceSegments)
+  {
+    const double length = std::hypot(segment[2] - segment[0], segment[3] - segment[1]);
+    if (length < 30 * spacing)
+    {
+      continue;
+    }
+    ++nbLong;
+    for (const auto& candidate : tiledSegments)
+    {
+      const double candidateLength = std::hypot(candidate[2] - candidate[0], candidate[3] - candidate[1]);
+      const double u[2]            = {(candidate[2] - candidate[0]) / candidateLength, (candidate[3] - candidate[1]) / candidateLength};
+      bool         isAlong         = candidateLength >= 0.8 * length;
+      for (unsigned int p = 0; p < 4 && isAlong; p += 2)
+      {
+        const double dx = segment[p] - candidate[0];
+        const double dy = segment[p + 1] - candidate[1];
+        isAlong         = std::abs(u[0] * dy - u[1] * dx) < tolerance;
+      }
+      if (isAlong)
+      {
+        ++nbFound;
+        break;
+      }
+    }
+  }
+  otbControlConditionTestMacro(nbFound < 0.8 * nbLong, "Only " << nbFound << " of the " << nbLong << " long segments are found with tiles");
+
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,9 @@
 
 #include "itkMacro.h"
 #include "otbFunctorImageFilter.h"
+#include "otbBlockedMatrixProduct.h"
+#include <cassert>
+#include <vector>
 
 namespace otb
 {
@@ -67,6 +70,20 @@ public:
     return result;
   }
 
+  /** Computes the dot products of a run of nbPixels contiguous pixels
+   * at once (see FunctorImageFilter) */
+  template <class TIn, class TOut>
+  void ProcessBlock(const TIn* in, size_t nbPixels, size_t nbInComps, TOut* out, size_t nbOutComps) const
+  {
+    assert(nbInComps == m_Vector.Size() && nbOutComps == 1);
+    std::vector<OutputType> vector(nbInComps);
+    for (unsigned int i = 0; i < nbInComps; ++i)
+    {
+      vector[i] = static_cast<OutputType>(m_Vector[i]);
+    }
+    ApplyLinearOperatorToPixels(in, nbPixels, nbInComps, vector.data(), nbOutComps, out);
+  }
+
 private:
   InputType m_Vector;
 };
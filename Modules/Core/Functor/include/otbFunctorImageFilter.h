@@ -24,6 +24,7 @@
 #include "otbVariadicNamedInputsImageFilter.h"
 #include "otbImage.h"
 #include "otbVectorImage.h"
+#include "otbImageView.h"
 #include "itkRGBPixel.h"
 #include "itkRGBAPixel.h"
 #include "itkFixedArray.h"
@@ -266,6 +267,91 @@ struct FunctorFilterSuperclassHelper<void (C::*)(R&, T...), TNameMap>
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
 };
 
+namespace functor_filter_details
+{
+// Helper to map any well-formed type to void (until c++17 that has
+// std::void_t)
+template <typename... T>
+struct MakeVoid
+{
+  using Type = void;
+};
+
+/**
+ * \struct HasBlockOperator
+ * \brief Struct testing if functor F provides a block operator for
+ *        input components TIn and output components TOut.
+ *
+ * The block operator has the following prototype:
+ * void ProcessBlock(const TIn * in, size_t nbPixels, size_t nbInComps, TOut * out, size_t nbOutComps) const
+ */
+template <class F, class TIn, class TOut, class = void>
+struct HasBlockOperator : std::false_type
+{
+};
+
+template <class F, class TIn, class TOut>
+struct HasBlockOperator<F, TIn, TOut,
+                        typename MakeVoid<decltype(std::declval<const F&>().ProcessBlock(std::declval<const TIn*>(), size_t(), size_t(),
+                                                                                         std::declval<TOut*>(), size_t()))>::Type> : std::true_type
+{
+};
+
+/**
+ * \struct HasTileOperator
+ * \brief Struct testing if functor F provides a tile operator for
+ *        input components TIn and output components TOut.
+ *
+ * The tile operator has the following prototype:
+ * void ProcessTile(const ImageView<const TIn> & in, const ImageView<TOut> & out) const
+ */
+template <class F, class TIn, class TOut, class = void>
+struct HasTileOperator : std::false_type
+{
+};
+
+template <class F, class TIn, class TOut>
+struct HasTileOperator<F, TIn, TOut,
+                       typename MakeVoid<decltype(std::declval<const F&>().ProcessTile(std::declval<const ImageView<const TIn>&>(),
+                                                                                       std::declval<const ImageView<TOut>&>()))>::Type> : std::true_type
+{
+};
+
+/**
+ * \struct UseBlockOperator
+ * \brief Struct testing if the block operator of F can be used: F
+ *        must have a single input which is not a neighborhood, and
+ *        provide a matching block operator.
+ */
+template <class F, class TInputs, class TNeigh, class TOutputImage>
+struct UseBlockOperator : std::false_type
+{
+};
+
+template <class F, class TInputImage, class TOutputImage>
+struct UseBlockOperator<F, std::tuple<TInputImage>, std::tuple<std::false_type>, TOutputImage>
+    : HasBlockOperator<F, typename TInputImage::InternalPixelType, typename TOutputImage::InternalPixelType>
+{
+};
+
+/**
+ * \struct UseTileOperator
+ * \brief Struct testing if the tile operator of F can be used: F
+ *        must have a single input which is not a neighborhood, and
+ *        provide a matching tile operator.
+ */
+template <class F, class TInputs, class TNeigh, class TOutputImage>
+struct UseTileOperator : std::false_type
+{
+};
+
+template <class F, class TInputImage, class TOutputImage>
+struct UseTileOperator<F, std::tuple<TInputImage>, std::tuple<std::false_type>, TOutputImage>
+    : HasTileOperator<F, typename TInputImage::InternalPixelType, typename TOutputImage::InternalPixelType>
+{
+};
+} // End namespace functor_filter_details
+
 
 /**
  * \brief This helper method builds a fully functional FunctorImageFilter from a functor instance
@@ -310,6 +396,21 @@ auto NewFunctorFilter(Functor f, itk::Size<2> radius = {{0, 0}});
  *
  * All image types will be deduced from the TFunction operator().
  *
+ * If the functor has a single non-neighborhood input and also provides
+ * void ProcessBlock(const TIn * in, size_t nbPixels, size_t nbInComps, TOut * out, size_t nbOutComps) const,
+ * where TIn and TOut are the internal pixel types of the input and
+ * output images, the filter hands each output line to this method
+ * directly from the image buffers instead of calling operator() pixel
+ * by pixel. This lets linear operators process a whole run of pixels
+ * as one matrix product (see BlockedMatrixProduct).
+ *
+ * Such a functor can instead provide
+ * void ProcessTile(const ImageView<const TIn> & in, const ImageView<TOut> & out) const,
+ * which receives views over the whole region of a thread, indexed by
+ * (x, y, band). Kernels can then work scanline by scanline or on the
+ * whole tile, without building a VariableLengthVector per pixel. The
+ * tile operator takes precedence over the block operator.
+ *
  * \sa VariadicInputsImageFilter
  * \sa NewFunctorFilter
  *
@@ -342,6 +443,14 @@ public:
   using InputImageType = typename Superclass::template InputImageType<I>;
   using Superclass::NumberOfInputs;
 
+  // True if the functor can process whole lines of pixels at once
+  // (see class documentation)
+  using UseBlockOperator = functor_filter_details::UseBlockOperator<TFunction, InputTypesTupleType, InputHasNeighborhood, OutputImageType>;
+
+  // True if the functor can process whole tiles at once (see class
+  // documentation)
+  using UseTileOperator = functor_filter_details::UseTileOperator<TFunction, InputTypesTupleType, InputHasNeighborhood, OutputImageType>;
+
   /** Run-time type information (and related methods). */
   itkTypeMacro(FunctorImageFilter, VariadicInputsImageFilter);
 
@@ -22,6 +22,7 @@
 #define otbFunctorImageFilter_hxx
 
 #include "otbFunctorImageFilter.h"
+#include "otbTrace.h"
 #include "itkProgressReporter.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionConstIterator.h"
@@ -289,6 +290,67 @@ struct NumberOfOutputComponents<F, otb::VectorImage<T>, N>
   }
 };
 
+// Default implementation does not process anything and let the
+// pixel-wise loop do the job
+template <bool UseBlockOperator>
+struct BlockOperatorProxy
+{
+  template <class F, class Tuple, class TOutputImage>
+  static bool Process(const F&, const Tuple&, TOutputImage*, const itk::ImageRegion<2>&)
+  {
+    return false;
+  }
+};
+
+// Hands each line of the region to the ProcessBlock() method of the
+// functor, straight from the input and output buffers
+template <>
+struct BlockOperatorProxy<true>
+{
+  template <class F, class Tuple, class TOutputImage>
+  static bool Process(const F& f, const Tuple& inputs, TOutputImage* outputImage, const itk::ImageRegion<2>& region)
+  {
+    const auto*  inputImage = std::get<0>(inputs);
+    const size_t nbInComps  = inputImage->GetNumberOfComponentsPerPixel();
+    const size_t nbOutComps = outputImage->GetNumberOfComponentsPerPixel();
+    const size_t nbPixels   = region.GetSize()[0];
+
+    auto index = region.GetIndex();
+    for (size_t line = 0; line < region.GetSize()[1]; ++line, ++index[1])
+    {
+      const auto* in  = inputImage->GetBufferPointer() + inputImage->ComputeOffset(index) * nbInComps;
+      auto*       out = outputImage->GetBufferPointer() + outputImage->ComputeOffset(index) * nbOutComps;
+      f.ProcessBlock(in, nbPixels, nbInComps, out, nbOutComps);
+    }
+    return true;
+  }
+};
+
+// Default implementation does not process anything and let the
+// block or pixel-wise loops do the job
+template <bool UseTileOperator>
+struct TileOperatorProxy
+{
+  template <class F, class Tuple, class TOutputImage>
+  static bool Process(const F&, const Tuple&, TOutputImage*, const itk::ImageRegion<2>&)
+  {
+    return false;
+  }
+};
+
+// Hands the whole region to the ProcessTile() method of the functor,
+// as views over the input and output buffers
+template <>
+struct TileOperatorProxy<true>
+{
+  template <class F, class Tuple, class TOutputImage>
+  static bool Process(const F& f, const Tuple& inputs, TOutputImage* outputImage, const itk::ImageRegion<2>& region)
+  {
+    f.ProcessTile(MakeImageView(std::get<0>(inputs), region), MakeImageView(outputImage, region));
+    return true;
+  }
+};
+
 } // end namespace functor_filter_details
 
 template <class TFunction, class TNameMap>
@@ -333,6 +395,22 @@ void FunctorImageFilter<TFunction, TNameMap>::DynamicThreadedGenerateData(const
     return;
   }
 
+  TraceSpan span("thread", "FunctorImageFilter::WorkUnit");
+  span.AddArgument("index", outputRegionForThread.GetIndex());
+  span.AddArgument("size", regionSize);
+
+  // Functors providing a tile operator process the whole region at once
+  if (functor_filter_details::TileOperatorProxy<UseTileOperator::value>::Process(m_Functor, this->GetInputs(), this->GetOutput(), outputRegionForThread))
+  {
+    return;
+  }
+
+  // Functors providing a block operator process whole lines at once
+  if (functor_filter_details::BlockOperatorProxy<UseBlockOperator::value>::Process(m_Functor, this->GetInputs(), this->GetOutput(), outputRegionForThread))
+  {
+    return;
+  }
+
   // Build output iterator
   itk::ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
 
@@ -25,6 +25,8 @@
 #include "otbVariadicAddFunctor.h"
 #include "otbVariadicConcatenateFunctor.h"
 #include "otbVariadicNamedInputsImageFilter.h"
+#include "otbDotProductImageFilter.h"
+#include "itkImageRegionConstIterator.h"
 #include <tuple>
 
 #include <numeric>
@@ -332,6 +334,37 @@ struct VectorModulus
   }
 };
 
+// Weighted sum of the bands, with a tile operator
+template <typename T>
+struct WeightedSum
+{
+  T operator()(const itk::VariableLengthVector<T>& in) const
+  {
+    T out = 0;
+    for (auto band = 0u; band < in.Size(); ++band)
+    {
+      out += (band + 1) * in[band];
+    }
+    return out;
+  }
+
+  void ProcessTile(const ImageView<const T>& in, const ImageView<T>& out) const
+  {
+    for (ptrdiff_t y = 0; y < in.extent(1); ++y)
+    {
+      for (ptrdiff_t x = 0; x < in.extent(0); ++x)
+      {
+        T sum = 0;
+        for (ptrdiff_t band = 0; band < in.extent(2); ++band)
+        {
+          sum += (band + 1) * in(x, y, band);
+        }
+        out(x, y, 0) = sum;
+      }
+    }
+  }
+};
+
 int otbFunctorImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
 {
   // test functions in functor_filter_details namespace
@@ -473,5 +506,78 @@ int otbFunctorImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
   argFilter->SetInputs(cimage);
   argFilter->Update();
 
+  // Test FunctorImageFilter with a functor providing a block operator
+  using DotProductFilterType = DotProductImageFilter<VectorImageType, ImageType>;
+  static_assert(DotProductFilterType::UseBlockOperator::value, "DotProductFunctor block operator should be used");
+  static_assert(!decltype(median)::ObjectType::UseBlockOperator::value, "Neighborhood functors can not use block operator");
+
+  auto vimage3 = VectorImageType::New();
+  vimage3->SetRegions(size);
+  vimage3->SetNumberOfComponentsPerPixel(3);
+  vimage3->Allocate();
+  double* buffer = vimage3->GetBufferPointer();
+  for (size_t i = 0; i < 3 * size[0] * size[1]; ++i)
+  {
+    buffer[i] = static_cast<double>(i % 17) - 8.;
+  }
+
+  itk::VariableLengthVector<double> dotVector(3);
+  dotVector[0] = 0.5;
+  dotVector[1] = -2.;
+  dotVector[2] = 3.;
+
+  auto dotProduct = DotProductFilterType::New();
+  dotProduct->GetModifiableFunctor().SetVector(dotVector);
+  dotProduct->SetInputs(vimage3);
+  dotProduct->Update();
+
+  auto                                          dotFunctor = dotProduct->GetFunctor();
+  itk::ImageRegionConstIterator<VectorImageType> inIt(vimage3, vimage3->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType>       outIt(dotProduct->GetOutput(), vimage3->GetLargestPossibleRegion());
+  for (; !inIt.IsAtEnd(); ++inIt, ++outIt)
+  {
+    if (std::abs(dotFunctor(inIt.Get()) - outIt.Get()) > 1e-12)
+    {
+      std::cerr << "Block operator and pixel operator differ at " << inIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test FunctorImageFilter with a functor providing a tile operator,
+  // on thread regions smaller than the buffered region
+  auto weightedSum = NewFunctorFilter(WeightedSum<double>{});
+  static_assert(decltype(weightedSum)::ObjectType::UseTileOperator::value, "WeightedSum tile operator should be used");
+  static_assert(!decltype(median)::ObjectType::UseTileOperator::value, "Neighborhood functors can not use tile operator");
+  static_assert(!decltype(add)::ObjectType::UseTileOperator::value, "VariadicAdd has no tile operator");
+  weightedSum->SetInputs(vimage3);
+  weightedSum->SetNumberOfWorkUnits(4);
+  weightedSum->Update();
+
+  itk::ImageRegionConstIterator<ImageType> sumIt(weightedSum->GetOutput(), vimage3->GetLargestPossibleRegion());
+  for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++sumIt)
+  {
+    if (WeightedSum<double>{}(inIt.Get()) != sumIt.Get())
+    {
+      std::cerr << "Tile operator and pixel operator differ at " << inIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test the image views
+  auto view = MakeImageView(vimage3.GetPointer());
+  if (view.extent(0) != static_cast<ptrdiff_t>(size[0]) || view.extent(1) != static_cast<ptrdiff_t>(size[1]) || view.extent(2) != 3)
+  {
+    std::cerr << "Wrong image view extents" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const VectorImageType*      constImage = vimage3;
+  VectorImageType::RegionType subRegion({{1, 2}}, {{3, 2}});
+  auto                        subView = SelectBands(MakeImageView(constImage, subRegion), 1, 2);
+  if (subView(2, 1, 1) != vimage3->GetPixel({{3, 3}})[2] || subView(0, 0, 0) != vimage3->GetPixel({{1, 2}})[1])
+  {
+    std::cerr << "Wrong image view values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
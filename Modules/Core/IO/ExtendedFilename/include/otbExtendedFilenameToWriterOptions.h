@@ -41,6 +41,9 @@ namespace otb
  * - &nodata=<VALUE>/<VALUE:VALUE...> : to set specific nodata values
  * - &multiwrite=<(bool)false> : to deactivate multi-writing
  * - &epsg=<VALUE> : to set the spatial reference system
+ * - &overviews:count=<VALUE> : to compute overviews while writing
+ * - &overviews:resampling=<nearest|average|mode> : to set their resampling method
+ * - &cog=<(bool)false> : to write a cloud optimized GeoTIFF
  *
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for
  * more information
@@ -83,6 +86,9 @@ public:
     std::pair<bool, std::string> box;
     std::pair<bool, std::string> bandRange;
     std::pair<bool, unsigned int> srsValue;
+    std::pair<bool, int>            overviewsCount;
+    std::pair<bool, GDALResampling> overviewsResampling;
+    std::pair<bool, bool>           cloudOptimized;
     std::vector<std::string> optionList;
   };
 
@@ -120,6 +126,12 @@ public:
   std::string GetBandRange() const;
   bool        SrsValueIsSet() const;
   unsigned int GetSrsValue() const;
+  bool           OverviewsCountIsSet() const;
+  int            GetOverviewsCount() const;
+  bool           OverviewsResamplingIsSet() const;
+  GDALResampling GetOverviewsResampling() const;
+  bool           CloudOptimizedIsSet() const;
+  bool           GetCloudOptimized() const;
 
   bool        BoxIsSet() const;
   std::string GetBox() const;
@@ -54,8 +54,16 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
 
   m_Options.srsValue.first = false;
 
+  m_Options.overviewsCount.first       = false;
+  m_Options.overviewsCount.second      = 0;
+  m_Options.overviewsResampling.first  = false;
+  m_Options.overviewsResampling.second = GDAL_RESAMPLING_NEAREST;
+  m_Options.cloudOptimized.first       = false;
+  m_Options.cloudOptimized.second      = false;
+
   m_Options.optionList = {"writegeom", "writerpctags", "multiwrite", "streaming:type",
-    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg"};
+    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg",
+    "overviews:count", "overviews:resampling", "cog"};
 }
 
 void ExtendedFilenameToWriterOptions::SetExtendedFileName(const char* extFname)
@@ -153,27 +161,28 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
   if (!map["streaming:type"].empty())
   {
     if (map["streaming:type"] == "auto" || map["streaming:type"] == "tiled" ||
-        map["streaming:type"] == "stripped" || map["streaming:type"] == "none")
+        map["streaming:type"] == "stripped" || map["streaming:type"] == "aligned" || map["streaming:type"] == "none")
     {
       m_Options.streamingType.first  = true;
       m_Options.streamingType.second = map["streaming:type"];
     }
     else
     {
-      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped,aligned,none.");
     }
   }
 
   if (!map["streaming:sizemode"].empty())
   {
-    if (map["streaming:sizemode"] == "auto" || map["streaming:sizemode"] == "nbsplits" || map["streaming:sizemode"] == "height")
+    if (map["streaming:sizemode"] == "auto" || map["streaming:sizemode"] == "nbsplits" || map["streaming:sizemode"] == "height" ||
+        map["streaming:sizemode"] == "measured")
     {
       m_Options.streamingSizeMode.first  = true;
       m_Options.streamingSizeMode.second = map["streaming:sizemode"];
     }
     else
     {
-      itkWarningMacro("Unknown value " << map["streaming:sizemode"] << " for streaming:sizemode option. Available values are auto,nbsplits,height.");
+      itkWarningMacro("Unknown value " << map["streaming:sizemode"] << " for streaming:sizemode option. Available values are auto,nbsplits,height,measured.");
     }
   }
 
@@ -246,6 +255,58 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["overviews:count"].empty())
+  {
+    if (map["overviews:count"] == "auto")
+    {
+      m_Options.overviewsCount.first  = true;
+      m_Options.overviewsCount.second = -1;
+    }
+    else
+    {
+      int count = -1;
+      try
+      {
+        count = std::stoi(map["overviews:count"]);
+      }
+      catch (const std::logic_error&)
+      {
+      }
+      if (count >= 0)
+      {
+        m_Options.overviewsCount.first  = true;
+        m_Options.overviewsCount.second = count;
+      }
+      else
+      {
+        itkWarningMacro("Unknown value " << map["overviews:count"] << " for overviews:count option. Must be auto or a positive integer.");
+      }
+    }
+  }
+
+  if (!map["overviews:resampling"].empty())
+  {
+    if (map["overviews:resampling"] == "nearest" || map["overviews:resampling"] == "average" || map["overviews:resampling"] == "mode")
+    {
+      m_Options.overviewsResampling.first = true;
+      m_Options.overviewsResampling.second =
+          map["overviews:resampling"] == "nearest" ? GDAL_RESAMPLING_NEAREST : map["overviews:resampling"] == "average" ? GDAL_RESAMPLING_AVERAGE : GDAL_RESAMPLING_MODE;
+    }
+    else
+    {
+      itkWarningMacro("Unknown value " << map["overviews:resampling"] << " for overviews:resampling option. Available values are nearest,average,mode.");
+    }
+  }
+
+  if (!map["cog"].empty())
+  {
+    m_Options.cloudOptimized.first = true;
+    if (map["cog"] == "On" || map["cog"] == "on" || map["cog"] == "ON" || map["cog"] == "true" || map["cog"] == "True" || map["cog"] == "1")
+    {
+      m_Options.cloudOptimized.second = true;
+    }
+  }
+
   // Option Checking
   for (it = map.begin(); it != map.end(); it++)
   {
@@ -376,4 +437,34 @@ unsigned int ExtendedFilenameToWriterOptions::GetSrsValue() const
   return m_Options.srsValue.second;
 }
 
+bool ExtendedFilenameToWriterOptions::OverviewsCountIsSet() const
+{
+  return m_Options.overviewsCount.first;
+}
+
+int ExtendedFilenameToWriterOptions::GetOverviewsCount() const
+{
+  return m_Options.overviewsCount.second;
+}
+
+bool ExtendedFilenameToWriterOptions::OverviewsResamplingIsSet() const
+{
+  return m_Options.overviewsResampling.first;
+}
+
+GDALResampling ExtendedFilenameToWriterOptions::GetOverviewsResampling() const
+{
+  return m_Options.overviewsResampling.second;
+}
+
+bool ExtendedFilenameToWriterOptions::CloudOptimizedIsSet() const
+{
+  return m_Options.cloudOptimized.first;
+}
+
+bool ExtendedFilenameToWriterOptions::GetCloudOptimized() const
+{
+  return m_Options.cloudOptimized.second;
+}
+
 } // end namespace otb
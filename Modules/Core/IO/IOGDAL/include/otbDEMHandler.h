@@ -134,7 +134,8 @@ public:
    */
   bool IsValidDEMDirectory(const std::string& DEMDirectory) const;
 
-  /** Try to open a geoid file
+  /** Try to open a geoid file. Nothing is done if this geoid file is
+   * already opened.
    * \param[in] geoidFile input geoid path
    */
   bool OpenGeoidFile(std::string geoidFile);
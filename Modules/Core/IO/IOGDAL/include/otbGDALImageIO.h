@@ -24,7 +24,10 @@
 
 
 /* C++ Libraries */
+#include <memory>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 /* ITK Libraries */
 #include "otbImageIOBase.h"
@@ -33,6 +36,7 @@
 
 #include "OTBIOGDALExport.h"
 #include "otbSpatialReference.h"
+#include "otbGDALOverviewsBuilder.h"
 
 class GDALDataset;
 
@@ -40,6 +44,7 @@ namespace otb
 {
 class GDALDatasetWrapper;
 class GDALDataTypeWrapper;
+class GDALStreamingOverviews;
 
 /** \class GDALImageIO
  *
@@ -69,6 +74,11 @@ class GDALDataTypeWrapper;
  *
  * The streaming read is implemented.
  *
+ * When writing a GeoTIFF, the overviews can be computed from the
+ * written regions (see GDALStreamingOverviews) instead of reading the
+ * file again, and the file can be laid out as a cloud optimized
+ * GeoTIFF (COG) once the last region is written.
+ *
  * \ingroup IOFilters
  *
  *
@@ -114,6 +124,20 @@ public:
   itkSetMacro(WriteRPCTags, bool);
   itkGetMacro(WriteRPCTags, bool);
 
+  /** Set/Get the number of overviews computed while writing a GeoTIFF
+   * (0 for none, -1 to decimate until the image fits in 256x256 pixels) */
+  itkSetMacro(NumberOfOverviewsToWrite, int);
+  itkGetMacro(NumberOfOverviewsToWrite, int);
+
+  /** Set/Get the resampling method of the written overviews (nearest,
+   * average or mode) */
+  itkSetMacro(OverviewsResampling, GDALResampling);
+  itkGetMacro(OverviewsResampling, GDALResampling);
+
+  /** Set/Get whether the GeoTIFF is written as a cloud optimized GeoTIFF */
+  itkSetMacro(CloudOptimized, bool);
+  itkGetMacro(CloudOptimized, bool);
+
 
   /** Set/Get the options */
   void SetOptions(const GDALCreationOptionsType& opts)
@@ -161,6 +185,15 @@ public:
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
+  /** Reads some bands of the IO region directly into a buffer with
+   * the given layout, instead of the packed pixels of Read(). Bands
+   * start at 1, the values are converted to bufferType, and the spaces
+   * between consecutive pixels, lines and bands are in bytes. This
+   * lets several files fill the bands of a single buffer without an
+   * intermediate copy. Indexed color images are not supported. */
+  void ReadBands(void* buffer, const std::type_info& bufferType, const std::vector<int>& bands, std::ptrdiff_t pixelSpace, std::ptrdiff_t lineSpace,
+                 std::ptrdiff_t bandSpace);
+
   /** Get Info about all subDataset in hdf file */
   bool GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc);
 
@@ -259,6 +292,8 @@ protected:
   void InternalReadImageInformation();
   /** Write all information on the image*/
   void InternalWriteImageInformation(const void* buffer);
+  /** Write a region of the image, see Write() */
+  void InternalWrite(const void* buffer);
   /** Number of bands of the image*/
   int m_NbBands;
   /** Buffer*/
@@ -293,6 +328,16 @@ private:
   /** Dump the ImageMetadata content into GDAL metadata */
   void ExportMetadata();
 
+  /** Create the overviews of the written dataset, computed from the
+   * written regions */
+  void CreateStreamingOverviews();
+
+  /** Copy the temporary GeoTIFF to the output file as a COG */
+  void WriteCloudOptimized();
+
+  /** Close and delete the temporary GeoTIFF, if any */
+  void RemoveTemporaryFile();
+
   /** Import the ImageMetadata content from GDAL metadata */
   void ImportMetadata();
 
@@ -346,6 +391,16 @@ private:
 
 
   NoDataListType m_NoDataList;
+
+  /** Overviews computed while writing */
+  int            m_NumberOfOverviewsToWrite;
+  GDALResampling m_OverviewsResampling;
+  std::unique_ptr<GDALStreamingOverviews> m_StreamingOverviews;
+
+  /** Whether the output is a COG, and the GeoTIFF written before the
+   * COG layout */
+  bool        m_CloudOptimized;
+  std::string m_TemporaryFileName;
 };
 
 } // end namespace otb
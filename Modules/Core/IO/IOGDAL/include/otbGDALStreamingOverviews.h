@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALStreamingOverviews_h
+#define otbGDALStreamingOverviews_h
+
+#include "otbGDALOverviewsBuilder.h"
+
+#include "OTBIOGDALExport.h"
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class GDALStreamingOverviews
+ *  \brief Computes the overviews of an image while its regions are written.
+ *
+ * Building the overviews of a written file with GDALOverviewsBuilder
+ * reads the whole full resolution image again. This class computes
+ * them from the regions pushed during the streamed writing instead:
+ * each level is the previous one decimated by 2 (its size is rounded
+ * up, like GDAL overviews), with a nearest, average or mode kernel
+ * (mode is meant for label images). The kernels ignore no-data values,
+ * a decimated pixel with no valid source pixel is no-data.
+ *
+ * As soon as the 2x2 source pixels of an overview pixel are known, it
+ * is computed and given to the sink, grouped in rectangular regions,
+ * and decimated in turn for the next level. Source pixels whose
+ * neighbours have not been written yet are kept until they are. With
+ * regions aligned on even coordinates (strips or tiles of even size,
+ * as produced by the streaming managers), at most one row is kept per
+ * level.
+ *
+ * Buffers are pixel interleaved, in double precision.
+ *
+ * \sa GDALImageIO
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALStreamingOverviews
+{
+public:
+  /** Receives the computed regions of a level (1 for the first overview) */
+  typedef std::function<void(unsigned int level, int startX, int startY, int sizeX, int sizeY, const double* buffer)> SinkType;
+
+  GDALStreamingOverviews(int sizeX, int sizeY, int nbBands, unsigned int nbLevels, GDALResampling resampling, const SinkType& sink);
+
+  /** Only nearest, average and mode are supported */
+  static bool IsSupported(GDALResampling resampling);
+
+  /** Number of levels until both dimensions are not greater than minSize */
+  static unsigned int CountLevels(int sizeX, int sizeY, int minSize);
+
+  /** Set the no-data value of a band (starting at 0) */
+  void SetNoDataValue(int band, double value);
+
+  /** Push a region of the full resolution image */
+  void Push(int startX, int startY, int sizeX, int sizeY, const double* buffer);
+
+  /** Whether all the pixels of all the levels have been computed */
+  bool IsComplete() const;
+
+  unsigned int GetNumberOfLevels() const
+  {
+    return static_cast<unsigned int>(m_Levels.size());
+  }
+
+  /** Size of a level (0 for the full resolution) */
+  int GetLevelSizeX(unsigned int level) const;
+  int GetLevelSizeY(unsigned int level) const;
+
+private:
+  /** Source pixels waiting for their neighbours, by row */
+  struct PendingRow
+  {
+    std::vector<double> Values;
+    std::vector<char>   IsSet;
+  };
+
+  /** Decimation of a source level into the next one */
+  struct Level
+  {
+    int                       SizeX;
+    int                       SizeY;
+    std::map<int, PendingRow> Pending;
+    /** Number of computed pixels of each row of the next level */
+    std::vector<int> NbDone;
+  };
+
+  void Decimate(unsigned int level, int startX, int startY, int sizeX, int sizeY, const double* buffer);
+
+  void Reduce(const double* const* sources, unsigned int nbSources, double* out) const;
+
+  bool IsNoData(int band, double value) const;
+
+  int                 m_NbBands;
+  GDALResampling      m_Resampling;
+  SinkType            m_Sink;
+  std::vector<Level>  m_Levels;
+  std::vector<char>   m_HasNoData;
+  std::vector<double> m_NoData;
+  int                 m_LastSizeX;
+  int                 m_LastSizeY;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbGDALVirtualBandStack_h
+#define otbGDALVirtualBandStack_h
+
+#include "OTBIOGDALExport.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** Write a GDAL VRT stacking bands of several files of the same size.
+ *
+ * The VRT only references the source bands: it is a stacked view of
+ * the files, without any pixel copy. Each output band has the type,
+ * the no-data value and the description of its source band, and the
+ * georeferencing is the one of the first file.
+ *
+ * \param vrtFileName The VRT file to write
+ * \param bands The file and the band (starting at 1) of each output band
+ * \throw itk::ExceptionObject if a file can not be opened, if a band
+ * does not exist or if the files have different sizes
+ *
+ * \ingroup OTBIOGDAL
+ */
+OTBIOGDAL_EXPORT void WriteVirtualBandStack(const std::string& vrtFileName, const std::vector<std::pair<std::string, int>>& bands);
+
+} // namespace otb
+
+#endif
@@ -678,6 +678,11 @@ bool DEMHandlerTLS::OpenGeoidFile(const std::string& geoidFile)
 bool DEMHandler::OpenGeoidFile(std::string geoidFile)
 {
   otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandler::OpenGeoidFile("<<geoidFile<<")");
+  if (!geoidFile.empty() && geoidFile == m_GeoidFilename)
+  {
+    otbLogMacro(Debug, << "Geoid file '"<< geoidFile << "' is already opened.");
+    return true;
+  }
 
   // In case the geoid is not valid, we still try to open it for real,
   // even if the DEMHandlerTLS will not serve to anything...
@@ -19,6 +19,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <complex>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -27,6 +29,7 @@
 #include "otbMacro.h"
 #include "otbSystem.h"
 #include "otbStopwatch.h"
+#include "otbTrace.h"
 #include "itksys/SystemTools.hxx"
 #include "otbImage.h"
 #include "otb_tinyxml.h"
@@ -44,6 +47,7 @@
 #include "itksys/RegularExpression.hxx"
 
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbGDALStreamingOverviews.h"
 
 #include "otb_boost_string_header.h"
 
@@ -63,6 +67,10 @@ inline unsigned int uint_ceildivpow2(unsigned int a, unsigned int b)
 template<std::size_t N, class T>
 constexpr std::size_t getsize_tabs(const T(&)[N], T(&)[N]) { return N; }
 
+// Size of the double precision buffer used to push the written regions
+// into the streamed overviews
+constexpr std::size_t OverviewsChunkSize = 4 << 20;
+
 namespace otb
 {
 
@@ -126,6 +134,10 @@ GDALImageIO::GDALImageIO()
   m_WriteRPCTags      = false;
 
   m_epsgCode          = 0;
+
+  m_NumberOfOverviewsToWrite = 0;
+  m_OverviewsResampling      = GDAL_RESAMPLING_NEAREST;
+  m_CloudOptimized           = false;
 }
 
 GDALImageIO::~GDALImageIO()
@@ -152,6 +164,8 @@ void GDALImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "Compression Level : " << m_CompressionLevel << "\n";
   os << indent << "IsComplex (otb side) : " << m_IsComplex << "\n";
   os << indent << "Byte per pixel : " << m_BytePerPixel << "\n";
+  os << indent << "Number of overviews to write : " << m_NumberOfOverviewsToWrite << "\n";
+  os << indent << "Cloud optimized : " << m_CloudOptimized << "\n";
 }
 
 // Read a 3D image (or event more bands)... not implemented yet
@@ -162,6 +176,13 @@ void GDALImageIO::ReadVolume(void*)
 // Read image with GDAL
 void GDALImageIO::Read(void* buffer)
 {
+  TraceSpan span("io", "GDALImageIO::Read");
+  span.AddArgument("file", m_FileName);
+  span.AddArgument("x", this->GetIORegion().GetIndex(0));
+  span.AddArgument("y", this->GetIORegion().GetIndex(1));
+  span.AddArgument("width", this->GetIORegion().GetSize(0));
+  span.AddArgument("height", this->GetIORegion().GetSize(1));
+
   // Convert buffer from void * to unsigned char *
   unsigned char* p = static_cast<unsigned char*>(buffer);
 
@@ -275,6 +296,87 @@ void GDALImageIO::Read(void* buffer)
   }
 }
 
+void GDALImageIO::ReadBands(void* buffer, const std::type_info& bufferType, const std::vector<int>& bands, std::ptrdiff_t pixelSpace,
+                            std::ptrdiff_t lineSpace, std::ptrdiff_t bandSpace)
+{
+  TraceSpan span("io", "GDALImageIO::ReadBands");
+  span.AddArgument("file", m_FileName);
+  span.AddArgument("bands", bands.size());
+
+  if (buffer == nullptr)
+  {
+    itkExceptionMacro(<< "Buffer passed to GDALImageIO for reading is NULL.");
+  }
+  if (m_IsIndexed)
+  {
+    itkExceptionMacro(<< "Reading bands of the indexed color image '" << m_FileName << "' is not supported.");
+  }
+
+  GDALDataType bufferPixType = GDT_Unknown;
+  if (bufferType == typeid(unsigned char))
+    bufferPixType = GDT_Byte;
+  else if (bufferType == typeid(unsigned short))
+    bufferPixType = GDT_UInt16;
+  else if (bufferType == typeid(short))
+    bufferPixType = GDT_Int16;
+  else if (bufferType == typeid(unsigned int))
+    bufferPixType = GDT_UInt32;
+  else if (bufferType == typeid(int))
+    bufferPixType = GDT_Int32;
+  else if (bufferType == typeid(float))
+    bufferPixType = GDT_Float32;
+  else if (bufferType == typeid(double))
+    bufferPixType = GDT_Float64;
+  else if (bufferType == typeid(std::complex<float>))
+    bufferPixType = GDT_CFloat32;
+  else if (bufferType == typeid(std::complex<double>))
+    bufferPixType = GDT_CFloat64;
+  else
+  {
+    itkExceptionMacro(<< "Unsupported buffer type " << bufferType.name() << " to read bands of '" << m_FileName << "'.");
+  }
+
+  for (int band : bands)
+  {
+    if (band < 1 || band > m_NbBands)
+    {
+      itkExceptionMacro(<< "Band " << band << " is not in the " << m_NbBands << " bands of '" << m_FileName << "'.");
+    }
+  }
+
+  // Same region as Read()
+  int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
+  int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
+  int lNbLinesRegion     = this->GetIORegion().GetSize()[1];
+  int lNbColumnsRegion   = this->GetIORegion().GetSize()[0];
+
+  int lFirstLine   = lFirstLineRegion * (1 << m_ResolutionFactor);
+  int lFirstColumn = lFirstColumnRegion * (1 << m_ResolutionFactor);
+  int lNbLines     = lNbLinesRegion * (1 << m_ResolutionFactor);
+  int lNbColumns   = lNbColumnsRegion * (1 << m_ResolutionFactor);
+
+  if (lFirstLine + lNbLines > static_cast<int>(m_OriginalDimensions[1]))
+    lNbLines = static_cast<int>(m_OriginalDimensions[1] - lFirstLine);
+  if (lFirstColumn + lNbColumns > static_cast<int>(m_OriginalDimensions[0]))
+    lNbColumns = static_cast<int>(m_OriginalDimensions[0] - lFirstColumn);
+
+  otbLogMacro(Debug, << "GDAL reads [" << lFirstColumn << ", " << lFirstColumnRegion + lNbColumnsRegion - 1 << "]x[" << lFirstLineRegion << ", "
+                     << lFirstLineRegion + lNbLinesRegion - 1 << "] x " << bands.size() << " bands from file " << m_FileName);
+
+  otb::Stopwatch chrono  = otb::Stopwatch::StartNew();
+  CPLErr         lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read, lFirstColumn, lFirstLine, lNbColumns, lNbLines, buffer, lNbColumnsRegion, lNbLinesRegion,
+                                                     bufferPixType, static_cast<int>(bands.size()), const_cast<int*>(bands.data()), pixelSpace,
+                                                     lineSpace, bandSpace);
+  chrono.Stop();
+
+  if (lCrGdal == CE_Failure)
+  {
+    itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+
+  otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms")
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
@@ -1181,6 +1283,27 @@ bool GDALImageIO::CanStreamWrite()
 
 void GDALImageIO::Write(const void* buffer)
 {
+  try
+  {
+    this->InternalWrite(buffer);
+  }
+  catch (...)
+  {
+    // Do not leave the temporary file of a COG output behind
+    this->RemoveTemporaryFile();
+    throw;
+  }
+}
+
+void GDALImageIO::InternalWrite(const void* buffer)
+{
+  TraceSpan span("io", "GDALImageIO::Write");
+  span.AddArgument("file", m_FileName);
+  span.AddArgument("x", this->GetIORegion().GetIndex(0));
+  span.AddArgument("y", this->GetIORegion().GetIndex(1));
+  span.AddArgument("width", this->GetIORegion().GetSize(0));
+  span.AddArgument("height", this->GetIORegion().GetSize(1));
+
   // Check if we have to write the image information
   if (m_FlagWriteImageInformation == true)
   {
@@ -1250,6 +1373,28 @@ void GDALImageIO::Write(const void* buffer)
 
     otbLogMacro(Debug, << "GDAL write took " << chrono.GetElapsedMilliseconds() << " ms")
 
+    // Decimate the region into the overviews. Rows are converted by
+    // chunks of bounded size, an even number of rows so that the pending
+    // rows of the overviews stay few.
+    if (m_StreamingOverviews)
+    {
+      const std::size_t   rowValues  = static_cast<std::size_t>(lNbColumns) * m_NbBands;
+      const std::size_t   rowBytes   = rowValues * m_BytePerPixel;
+      const unsigned int  chunkLines = std::min<unsigned int>(lNbLines, std::max<std::size_t>(2, (OverviewsChunkSize / (rowValues * sizeof(double))) & ~std::size_t(1)));
+      std::vector<double> values(chunkLines * rowValues);
+      for (unsigned int line = 0; line < lNbLines; line += chunkLines)
+      {
+        const unsigned int nbLines = std::min(chunkLines, lNbLines - line);
+        const auto*        source  = static_cast<const unsigned char*>(buffer) + line * rowBytes;
+        for (unsigned int row = 0; row < nbLines; ++row)
+        {
+          GDALCopyWords(const_cast<unsigned char*>(source + row * rowBytes), m_PxType->pixType, m_BytePerPixel, values.data() + row * rowValues, GDT_Float64,
+                        sizeof(double), static_cast<int>(rowValues));
+        }
+        m_StreamingOverviews->Push(lFirstColumn, lFirstLine + line, lNbColumns, nbLines, values.data());
+      }
+    }
+
         // Flush dataset cache
         m_Dataset->GetDataSet()
             ->FlushCache();
@@ -1284,8 +1429,22 @@ void GDALImageIO::Write(const void* buffer)
   if (lFirstLine + lNbLines == m_Dimensions[1] && lFirstColumn + lNbColumns == m_Dimensions[0])
   {
     // Last pixel written
+    if (m_StreamingOverviews)
+    {
+      if (!m_StreamingOverviews->IsComplete())
+      {
+        itkExceptionMacro(<< "The overviews of " << m_FileName << " are incomplete: some regions of the image were not written");
+      }
+      m_StreamingOverviews.reset();
+    }
+
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
+
+    if (!m_TemporaryFileName.empty())
+    {
+      this->WriteCloudOptimized();
+    }
   }
 }
 
@@ -1422,12 +1581,32 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
     itkExceptionMacro(<< "GDAL Writing failed: the image file name '" << m_FileName << "' is not recognized by GDAL.");
   }
 
+  // Overviews and COG layout are only computed for GeoTIFF
+  const bool writeOverviews = m_NumberOfOverviewsToWrite != 0 || m_CloudOptimized;
+  if (writeOverviews && (driverShortName != "GTiff" || GDALDataTypeIsComplex(m_PxType->pixType)))
+  {
+    otbLogMacro(Warning, << "Overviews and COG layout are only written for GeoTIFF files of real pixels, they are ignored for " << m_FileName);
+  }
+  const bool streamOverviews = writeOverviews && driverShortName == "GTiff" && !GDALDataTypeIsComplex(m_PxType->pixType);
+
+  m_TemporaryFileName.clear();
   if (m_CanStreamWrite)
   {
     GDALCreationOptionsType creationOptions = m_CreationOptions;
-    m_Dataset =
-        GDALDriverManagerWrapper::GetInstance().Create(driverShortName, GetGdalWriteImageFileName(driverShortName, m_FileName), m_Dimensions[0],
-                                                       m_Dimensions[1], m_NbBands, m_PxType->pixType, otb::ogr::StringListConverter(creationOptions).to_ogr());
+    std::string             fileName        = GetGdalWriteImageFileName(driverShortName, m_FileName);
+    if (streamOverviews && m_CloudOptimized)
+    {
+      // The image and its overviews are streamed to a tiled GeoTIFF, copied
+      // to the output with the COG layout once the last region is written
+      m_TemporaryFileName = fileName + ".tmp.tif";
+      fileName            = m_TemporaryFileName;
+      if (!CreationOptionContains("TILED="))
+      {
+        creationOptions.push_back("TILED=YES");
+      }
+    }
+    m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(driverShortName, fileName, m_Dimensions[0], m_Dimensions[1], m_NbBands, m_PxType->pixType,
+                                                               otb::ogr::StringListConverter(creationOptions).to_ogr());
   }
   else
   {
@@ -1632,6 +1811,133 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   {
     dataset->GetRasterBand(noData.first)->SetNoDataValue(noData.second);
   }
+
+  if (m_CanStreamWrite && streamOverviews)
+  {
+    this->CreateStreamingOverviews();
+  }
+}
+
+void GDALImageIO::CreateStreamingOverviews()
+{
+  unsigned int nbOverviews = m_NumberOfOverviewsToWrite >= 0 ? static_cast<unsigned int>(m_NumberOfOverviewsToWrite)
+                                                             : GDALStreamingOverviews::CountLevels(m_Dimensions[0], m_Dimensions[1], 256);
+  if (nbOverviews == 0)
+  {
+    return;
+  }
+
+  // Create empty overviews, filled while the regions are written
+  GDALDataset*     dataset = m_Dataset->GetDataSet();
+  std::vector<int> factors;
+  for (unsigned int level = 1; level <= nbOverviews; ++level)
+  {
+    factors.push_back(1 << level);
+  }
+  if (GDALBuildOverviews(dataset, "NONE", static_cast<int>(nbOverviews), factors.data(), 0, nullptr, nullptr, nullptr) != CE_None)
+  {
+    itkExceptionMacro(<< "Unable to create the overviews of " << m_FileName << " : " << CPLGetLastErrorMsg());
+  }
+
+  const int nbBands = m_NbBands;
+  auto      sink    = [this, dataset, nbBands](unsigned int level, int startX, int startY, int sizeX, int sizeY, const double* buffer) {
+    for (int band = 0; band < nbBands; ++band)
+    {
+      GDALRasterBand* overview = dataset->GetRasterBand(band + 1)->GetOverview(level - 1);
+      CPLErr          lCrGdal  = overview->RasterIO(GF_Write, startX, startY, sizeX, sizeY, const_cast<double*>(buffer + band), sizeX, sizeY, GDT_Float64,
+                                            sizeof(double) * nbBands, sizeof(double) * nbBands * sizeX);
+      if (lCrGdal == CE_Failure)
+      {
+        itkExceptionMacro(<< "Error while writing the overview " << level << " of '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+      }
+    }
+  };
+
+  m_StreamingOverviews.reset(new GDALStreamingOverviews(m_Dimensions[0], m_Dimensions[1], m_NbBands, nbOverviews, m_OverviewsResampling, sink));
+  for (int band = 0; band < m_NbBands; ++band)
+  {
+    int          hasNoData = 0;
+    const double noData    = dataset->GetRasterBand(band + 1)->GetNoDataValue(&hasNoData);
+    if (hasNoData)
+    {
+      m_StreamingOverviews->SetNoDataValue(band, noData);
+    }
+  }
+}
+
+void GDALImageIO::RemoveTemporaryFile()
+{
+  if (m_TemporaryFileName.empty())
+  {
+    return;
+  }
+  m_StreamingOverviews.reset();
+  m_Dataset = GDALDatasetWrapperPointer();
+  if (itksys::SystemTools::FileExists(m_TemporaryFileName))
+  {
+    GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff")->Delete(m_TemporaryFileName.c_str());
+  }
+  m_TemporaryFileName.clear();
+}
+
+void GDALImageIO::WriteCloudOptimized()
+{
+  const std::string realFileName = GetGdalWriteImageFileName("GTiff", m_FileName);
+
+  GDALDatasetWrapperPointer source = GDALDriverManagerWrapper::GetInstance().Open(m_TemporaryFileName);
+  if (source.IsNull())
+  {
+    itkExceptionMacro(<< "Unable to open the temporary file " << m_TemporaryFileName);
+  }
+
+  GDALCreationOptionsType creationOptions;
+#if GDAL_VERSION_NUM >= 3010000
+  // The COG driver reuses the overviews of the source. Its tiles are
+  // square, so the GeoTIFF block size options map to its block size.
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("COG");
+  for (const auto& option : m_CreationOptions)
+  {
+    if (boost::algorithm::starts_with(option, "BLOCKXSIZE="))
+    {
+      creationOptions.push_back("BLOCKSIZE=" + option.substr(11));
+    }
+    else if (!boost::algorithm::starts_with(option, "TILED=") && !boost::algorithm::starts_with(option, "BLOCKYSIZE="))
+    {
+      creationOptions.push_back(option);
+    }
+  }
+  // Without streamed overviews, do not let the driver compute them
+  if (source->GetDataSet()->GetRasterBand(1)->GetOverviewCount() == 0)
+  {
+    creationOptions.push_back("OVERVIEWS=NONE");
+  }
+#else
+  // Before the COG driver, copying the overviews of the source first
+  // gives the same layout
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff");
+  creationOptions    = m_CreationOptions;
+  creationOptions.push_back("TILED=YES");
+  creationOptions.push_back("COPY_SRC_OVERVIEWS=YES");
+#endif
+  if (driver == nullptr)
+  {
+    itkExceptionMacro(<< "Unable to instantiate the GDAL driver to write the COG " << m_FileName);
+  }
+
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+  GDALDataset*   hOutputDS =
+      driver->CreateCopy(realFileName.c_str(), source->GetDataSet(), FALSE, otb::ogr::StringListConverter(creationOptions).to_ogr(), nullptr, nullptr);
+  chrono.Stop();
+  otbLogMacro(Debug, << "COG layout of " << m_FileName << " took " << chrono.GetElapsedMilliseconds() << " ms");
+
+  source = GDALDatasetWrapperPointer();
+  this->RemoveTemporaryFile();
+
+  if (!hOutputDS)
+  {
+    itkExceptionMacro(<< "Error while writing image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+  GDALClose(hOutputDS);
 }
 
 std::string GDALImageIO::FilenameToGdalDriverShortName(const std::string& name) const
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALStreamingOverviews.h"
+
+#include "itkMacro.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+GDALStreamingOverviews::GDALStreamingOverviews(int sizeX, int sizeY, int nbBands, unsigned int nbLevels, GDALResampling resampling, const SinkType& sink)
+  : m_NbBands(nbBands),
+    m_Resampling(resampling),
+    m_Sink(sink),
+    m_HasNoData(nbBands, 0),
+    m_NoData(nbBands, 0.)
+{
+  if (sizeX <= 0 || sizeY <= 0 || nbBands <= 0)
+  {
+    itkGenericExceptionMacro(<< "Invalid image size for the overviews: " << sizeX << "x" << sizeY << " x " << nbBands << " bands");
+  }
+  if (!IsSupported(resampling))
+  {
+    itkGenericExceptionMacro(<< "Unsupported resampling method for streamed overviews: " << resampling);
+  }
+
+  m_Levels.resize(nbLevels);
+  for (auto& level : m_Levels)
+  {
+    level.SizeX = sizeX;
+    level.SizeY = sizeY;
+    sizeX       = (sizeX + 1) / 2;
+    sizeY       = (sizeY + 1) / 2;
+    level.NbDone.assign(sizeY, 0);
+  }
+  m_LastSizeX = sizeX;
+  m_LastSizeY = sizeY;
+}
+
+bool GDALStreamingOverviews::IsSupported(GDALResampling resampling)
+{
+  return resampling == GDAL_RESAMPLING_NEAREST || resampling == GDAL_RESAMPLING_AVERAGE || resampling == GDAL_RESAMPLING_MODE;
+}
+
+unsigned int GDALStreamingOverviews::CountLevels(int sizeX, int sizeY, int minSize)
+{
+  minSize             = std::max(minSize, 1);
+  unsigned int levels = 0;
+  while (sizeX > minSize || sizeY > minSize)
+  {
+    sizeX = (sizeX + 1) / 2;
+    sizeY = (sizeY + 1) / 2;
+    ++levels;
+  }
+  return levels;
+}
+
+void GDALStreamingOverviews::SetNoDataValue(int band, double value)
+{
+  m_HasNoData.at(band) = 1;
+  m_NoData.at(band)    = value;
+}
+
+int GDALStreamingOverviews::GetLevelSizeX(unsigned int level) const
+{
+  return level < m_Levels.size() ? m_Levels[level].SizeX : m_LastSizeX;
+}
+
+int GDALStreamingOverviews::GetLevelSizeY(unsigned int level) const
+{
+  return level < m_Levels.size() ? m_Levels[level].SizeY : m_LastSizeY;
+}
+
+void GDALStreamingOverviews::Push(int startX, int startY, int sizeX, int sizeY, const double* buffer)
+{
+  if (startX < 0 || startY < 0 || sizeX <= 0 || sizeY <= 0 || startX + sizeX > GetLevelSizeX(0) || startY + sizeY > GetLevelSizeY(0))
+  {
+    itkGenericExceptionMacro(<< "Region [" << startX << ", " << startY << ", " << sizeX << ", " << sizeY << "] is outside of the image");
+  }
+  if (!m_Levels.empty())
+  {
+    Decimate(0, startX, startY, sizeX, sizeY, buffer);
+  }
+}
+
+bool GDALStreamingOverviews::IsComplete() const
+{
+  for (const auto& level : m_Levels)
+  {
+    const int outSizeX = (level.SizeX + 1) / 2;
+    for (int nbDone : level.NbDone)
+    {
+      if (nbDone != outSizeX)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool GDALStreamingOverviews::IsNoData(int band, double value) const
+{
+  return m_HasNoData[band] && (value == m_NoData[band] || (std::isnan(value) && std::isnan(m_NoData[band])));
+}
+
+void GDALStreamingOverviews::Reduce(const double* const* sources, unsigned int nbSources, double* out) const
+{
+  for (int band = 0; band < m_NbBands; ++band)
+  {
+    if (m_Resampling == GDAL_RESAMPLING_NEAREST)
+    {
+      out[band] = sources[0][band];
+      continue;
+    }
+
+    double       values[4];
+    unsigned int nbValues = 0;
+    for (unsigned int s = 0; s < nbSources; ++s)
+    {
+      if (!IsNoData(band, sources[s][band]))
+      {
+        values[nbValues++] = sources[s][band];
+      }
+    }
+
+    if (nbValues == 0)
+    {
+      out[band] = m_NoData[band];
+    }
+    else if (m_Resampling == GDAL_RESAMPLING_AVERAGE)
+    {
+      double sum = 0.;
+      for (unsigned int v = 0; v < nbValues; ++v)
+      {
+        sum += values[v];
+      }
+      out[band] = sum / nbValues;
+    }
+    else
+    {
+      // Most frequent value, the first one in the window on ties
+      unsigned int best = 0, bestCount = 0;
+      for (unsigned int v = 0; v < nbValues; ++v)
+      {
+        const unsigned int count = static_cast<unsigned int>(std::count(values, values + nbValues, values[v]));
+        if (count > bestCount)
+        {
+          best      = v;
+          bestCount = count;
+        }
+      }
+      out[band] = values[best];
+    }
+  }
+}
+
+void GDALStreamingOverviews::Decimate(unsigned int level, int startX, int startY, int sizeX, int sizeY, const double* buffer)
+{
+  Level&    source   = m_Levels[level];
+  const int outSizeX = (source.SizeX + 1) / 2;
+
+  // Pixels of the next level whose source window intersects the region
+  const int firstI = startX / 2;
+  const int firstJ = startY / 2;
+  const int outW   = (startX + sizeX - 1) / 2 - firstI + 1;
+  const int outH   = (startY + sizeY - 1) / 2 - firstJ + 1;
+
+  auto fetch = [&](int row, int col) -> const double* {
+    if (row >= startY && row < startY + sizeY && col >= startX && col < startX + sizeX)
+    {
+      return buffer + (static_cast<std::size_t>(row - startY) * sizeX + (col - startX)) * m_NbBands;
+    }
+    auto it = source.Pending.find(row);
+    if (it != source.Pending.end() && it->second.IsSet[col])
+    {
+      return &it->second.Values[static_cast<std::size_t>(col) * m_NbBands];
+    }
+    return nullptr;
+  };
+
+  std::vector<char>   computed(static_cast<std::size_t>(outW) * outH, 0);
+  std::vector<double> out(computed.size() * m_NbBands);
+
+  for (int j = 0; j < outH; ++j)
+  {
+    const int rows[2] = {2 * (firstJ + j), std::min(2 * (firstJ + j) + 1, source.SizeY - 1)};
+    for (int i = 0; i < outW; ++i)
+    {
+      const int     cols[2] = {2 * (firstI + i), std::min(2 * (firstI + i) + 1, source.SizeX - 1)};
+      const double* sources[4];
+      unsigned int  nbSources = 0;
+      bool          complete  = true;
+      for (int r = 0; r < 2 && complete; ++r)
+      {
+        for (int c = 0; c < 2 && complete; ++c)
+        {
+          if ((r == 1 && rows[1] == rows[0]) || (c == 1 && cols[1] == cols[0]))
+          {
+            continue;
+          }
+          sources[nbSources] = fetch(rows[r], cols[c]);
+          complete           = sources[nbSources++] != nullptr;
+        }
+      }
+      if (complete)
+      {
+        Reduce(sources, nbSources, &out[(static_cast<std::size_t>(j) * outW + i) * m_NbBands]);
+        computed[j * outW + i] = 1;
+        ++source.NbDone[firstJ + j];
+      }
+    }
+  }
+
+  // Keep the pixels of the region whose decimated pixel is not known yet
+  for (int row = startY; row < startY + sizeY; ++row)
+  {
+    for (int col = startX; col < startX + sizeX; ++col)
+    {
+      if (!computed[(row / 2 - firstJ) * outW + (col / 2 - firstI)])
+      {
+        PendingRow& pending = source.Pending[row];
+        if (pending.Values.empty())
+        {
+          pending.Values.resize(static_cast<std::size_t>(source.SizeX) * m_NbBands);
+          pending.IsSet.assign(source.SizeX, 0);
+        }
+        std::copy_n(fetch(row, col), m_NbBands, &pending.Values[static_cast<std::size_t>(col) * m_NbBands]);
+        pending.IsSet[col] = 1;
+      }
+    }
+  }
+
+  // Release the rows whose decimated row is complete
+  for (int j = firstJ; j < firstJ + outH; ++j)
+  {
+    if (source.NbDone[j] == outSizeX)
+    {
+      source.Pending.erase(2 * j);
+      source.Pending.erase(2 * j + 1);
+    }
+  }
+
+  // Group the computed pixels in rectangles: runs of computed pixels
+  // are extended while the following rows have the same runs
+  struct Rectangle
+  {
+    int FirstI, EndI, FirstJ, EndJ;
+  };
+  std::vector<Rectangle> open, done;
+  for (int j = 0; j < outH; ++j)
+  {
+    std::vector<Rectangle> next;
+    for (int i = 0; i < outW;)
+    {
+      if (!computed[j * outW + i])
+      {
+        ++i;
+        continue;
+      }
+      int end = i;
+      while (end < outW && computed[j * outW + end])
+      {
+        ++end;
+      }
+      auto it = std::find_if(open.begin(), open.end(), [&](const Rectangle& r) { return r.FirstI == i && r.EndI == end; });
+      if (it != open.end())
+      {
+        it->EndJ = j + 1;
+        next.push_back(*it);
+        open.erase(it);
+      }
+      else
+      {
+        next.push_back({i, end, j, j + 1});
+      }
+      i = end;
+    }
+    done.insert(done.end(), open.begin(), open.end());
+    open.swap(next);
+  }
+  done.insert(done.end(), open.begin(), open.end());
+
+  std::vector<double> region;
+  for (const auto& r : done)
+  {
+    const int w = r.EndI - r.FirstI;
+    const int h = r.EndJ - r.FirstJ;
+    region.resize(static_cast<std::size_t>(w) * h * m_NbBands);
+    for (int j = 0; j < h; ++j)
+    {
+      std::copy_n(&out[(static_cast<std::size_t>(r.FirstJ + j) * outW + r.FirstI) * m_NbBands], w * m_NbBands, &region[static_cast<std::size_t>(j) * w * m_NbBands]);
+    }
+    m_Sink(level + 1, firstI + r.FirstI, firstJ + r.FirstJ, w, h, region.data());
+    if (level + 1 < m_Levels.size())
+    {
+      Decimate(level + 1, firstI + r.FirstI, firstJ + r.FirstJ, w, h, region.data());
+    }
+  }
+}
+
+} // end namespace otb
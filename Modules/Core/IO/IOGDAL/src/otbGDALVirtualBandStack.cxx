@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbGDALVirtualBandStack.h"
+#include "otbGDALDriverManagerWrapper.h"
+#include "itkMacro.h"
+#include "gdal_vrt.h"
+#include <map>
+
+namespace otb
+{
+
+void WriteVirtualBandStack(const std::string& vrtFileName, const std::vector<std::pair<std::string, int>>& bands)
+{
+  if (bands.empty())
+  {
+    itkGenericExceptionMacro(<< "No band to stack in " << vrtFileName);
+  }
+
+  // Open each file once
+  std::map<std::string, GDALDatasetWrapper::Pointer> datasets;
+  for (const auto& band : bands)
+  {
+    if (datasets.count(band.first) == 0)
+    {
+      GDALDatasetWrapper::Pointer dataset = GDALDriverManagerWrapper::GetInstance().Open(band.first);
+      if (dataset.IsNull())
+      {
+        itkGenericExceptionMacro(<< "Can not open " << band.first);
+      }
+      datasets[band.first] = dataset;
+    }
+  }
+
+  GDALDataset* first = datasets[bands.front().first]->GetDataSet();
+  const int    sizeX = first->GetRasterXSize();
+  const int    sizeY = first->GetRasterYSize();
+
+  GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("VRT");
+  if (driver == nullptr)
+  {
+    itkGenericExceptionMacro(<< "The GDAL VRT driver is not available");
+  }
+  GDALDataset* vrt = driver->Create(vrtFileName.c_str(), sizeX, sizeY, 0, GDT_Byte, nullptr);
+  if (vrt == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Can not create " << vrtFileName << ": " << CPLGetLastErrorMsg());
+  }
+
+  double geoTransform[6];
+  if (first->GetGeoTransform(geoTransform) == CE_None)
+  {
+    vrt->SetGeoTransform(geoTransform);
+  }
+  const char* projection = first->GetProjectionRef();
+  if (projection != nullptr && projection[0] != '\0')
+  {
+    vrt->SetProjection(projection);
+  }
+  if (first->GetMetadata("RPC") != nullptr)
+  {
+    vrt->SetMetadata(first->GetMetadata("RPC"), "RPC");
+  }
+
+  int vrtBand = 0;
+  for (const auto& band : bands)
+  {
+    GDALDataset* dataset = datasets[band.first]->GetDataSet();
+    if (dataset->GetRasterXSize() != sizeX || dataset->GetRasterYSize() != sizeY)
+    {
+      GDALClose(vrt);
+      itkGenericExceptionMacro(<< "The size of " << band.first << " differs from the size of " << bands.front().first);
+    }
+    if (band.second < 1 || band.second > dataset->GetRasterCount())
+    {
+      GDALClose(vrt);
+      itkGenericExceptionMacro(<< "Band " << band.second << " is not in the " << dataset->GetRasterCount() << " bands of " << band.first);
+    }
+
+    GDALRasterBand* source = dataset->GetRasterBand(band.second);
+    vrt->AddBand(source->GetRasterDataType(), nullptr);
+    GDALRasterBand* target = vrt->GetRasterBand(++vrtBand);
+    VRTAddSimpleSource(reinterpret_cast<VRTSourcedRasterBandH>(target), source, -1, -1, -1, -1, -1, -1, -1, -1, nullptr, VRT_NODATA_UNSET);
+
+    int          hasNoData = 0;
+    const double noData    = source->GetNoDataValue(&hasNoData);
+    if (hasNoData)
+    {
+      target->SetNoDataValue(noData);
+    }
+    target->SetDescription(source->GetDescription());
+  }
+
+  // Flush the VRT to the file
+  GDALClose(vrt);
+}
+
+} // namespace otb
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMacro.h"
+#include "otbGDALStreamingOverviews.h"
+#include "otbGDALDriverManagerWrapper.h"
+#include "otbExtendedFilenameToWriterOptions.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbVectorImage.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+typedef std::vector<std::vector<double>> LevelsType;
+
+// Push an image by tiles, and gather the overviews given to the sink
+LevelsType ComputeOverviews(const std::vector<double>& image, int sizeX, int sizeY, int nbBands, unsigned int nbLevels, otb::GDALResampling resampling,
+                            int tileX, int tileY, bool noData)
+{
+  LevelsType                    levels(nbLevels + 1);
+  otb::GDALStreamingOverviews* overviews = nullptr;
+  auto sink = [&](unsigned int level, int startX, int startY, int w, int h, const double* buffer) {
+    const int levelSizeX = overviews->GetLevelSizeX(level);
+    levels[level].resize(static_cast<std::size_t>(levelSizeX) * overviews->GetLevelSizeY(level) * nbBands);
+    for (int j = 0; j < h; ++j)
+    {
+      std::copy_n(buffer + static_cast<std::size_t>(j) * w * nbBands, w * nbBands,
+                  &levels[level][(static_cast<std::size_t>(startY + j) * levelSizeX + startX) * nbBands]);
+    }
+  };
+  otb::GDALStreamingOverviews streamingOverviews(sizeX, sizeY, nbBands, nbLevels, resampling, sink);
+  overviews = &streamingOverviews;
+  if (noData)
+  {
+    streamingOverviews.SetNoDataValue(1, 0.);
+  }
+
+  std::vector<double> tile;
+  for (int y = 0; y < sizeY; y += tileY)
+  {
+    for (int x = 0; x < sizeX; x += tileX)
+    {
+      const int w = std::min(tileX, sizeX - x);
+      const int h = std::min(tileY, sizeY - y);
+      tile.resize(static_cast<std::size_t>(w) * h * nbBands);
+      for (int j = 0; j < h; ++j)
+      {
+        std::copy_n(&image[(static_cast<std::size_t>(y + j) * sizeX + x) * nbBands], w * nbBands, &tile[static_cast<std::size_t>(j) * w * nbBands]);
+      }
+      streamingOverviews.Push(x, y, w, h, tile.data());
+    }
+  }
+  if (!streamingOverviews.IsComplete())
+  {
+    levels.clear();
+  }
+  return levels;
+}
+}
+
+int otbGDALStreamingOverviews(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const int          sizeX = 37, sizeY = 23, nbBands = 3;
+  const unsigned int nbLevels = otb::GDALStreamingOverviews::CountLevels(sizeX, sizeY, 1);
+  otbControlConditionTestMacro(nbLevels != 6, "Wrong number of levels: " << nbLevels);
+
+  // Labels from 0 to 3, 0 being no-data in the second band
+  std::vector<double> image(static_cast<std::size_t>(sizeX) * sizeY * nbBands);
+  for (std::size_t i = 0; i < image.size(); ++i)
+  {
+    image[i] = (i * 7 + i / 5) % 4;
+  }
+
+  const otb::GDALResampling resamplings[] = {otb::GDAL_RESAMPLING_NEAREST, otb::GDAL_RESAMPLING_AVERAGE, otb::GDAL_RESAMPLING_MODE};
+  const int                 tiles[][2]    = {{37, 5}, {37, 1}, {8, 6}, {7, 5}, {3, 3}, {1, 1}};
+  for (otb::GDALResampling resampling : resamplings)
+  {
+    for (bool noData : {false, true})
+    {
+      // Whole image at once
+      const LevelsType reference = ComputeOverviews(image, sizeX, sizeY, nbBands, nbLevels, resampling, sizeX, sizeY, noData);
+      otbControlConditionTestMacro(reference.empty(), "Incomplete overviews");
+
+      // First level, computed directly
+      const int sizeX1 = (sizeX + 1) / 2;
+      for (int j = 0; j < (sizeY + 1) / 2; ++j)
+      {
+        for (int i = 0; i < sizeX1; ++i)
+        {
+          for (int band = 0; band < nbBands; ++band)
+          {
+            std::vector<double> window;
+            for (int y = 2 * j; y < std::min(2 * j + 2, sizeY); ++y)
+            {
+              for (int x = 2 * i; x < std::min(2 * i + 2, sizeX); ++x)
+              {
+                const double value = image[(static_cast<std::size_t>(y) * sizeX + x) * nbBands + band];
+                if (!noData || band != 1 || value != 0.)
+                {
+                  window.push_back(value);
+                }
+              }
+            }
+            double expected = 0.;
+            if (resampling == otb::GDAL_RESAMPLING_NEAREST)
+            {
+              expected = image[(static_cast<std::size_t>(2 * j) * sizeX + 2 * i) * nbBands + band];
+            }
+            else if (resampling == otb::GDAL_RESAMPLING_AVERAGE && !window.empty())
+            {
+              for (double value : window)
+              {
+                expected += value;
+              }
+              expected /= window.size();
+            }
+            else if (!window.empty())
+            {
+              long bestCount = 0;
+              for (double value : window)
+              {
+                const long count = std::count(window.begin(), window.end(), value);
+                if (count > bestCount)
+                {
+                  bestCount = count;
+                  expected  = value;
+                }
+              }
+            }
+            const double value = reference[1][(static_cast<std::size_t>(j) * sizeX1 + i) * nbBands + band];
+            otbControlConditionTestMacro(std::abs(value - expected) > 1e-12,
+                                         "Wrong value at (" << i << ", " << j << ") of band " << band << " with resampling " << resampling << ": " << value
+                                                            << " instead of " << expected);
+          }
+        }
+      }
+
+      // Streamed by strips and tiles of any size
+      for (const auto& tile : tiles)
+      {
+        const LevelsType streamed = ComputeOverviews(image, sizeX, sizeY, nbBands, nbLevels, resampling, tile[0], tile[1], noData);
+        otbControlConditionTestMacro(streamed != reference, "Streamed overviews differ with tiles of " << tile[0] << "x" << tile[1]);
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbGDALImageIOStreamingOverviews(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename       = argv[1];
+  const std::string  outputFilename      = argv[2];
+  const unsigned int expectedNbOverviews = atoi(argv[3]);
+
+  typedef otb::VectorImage<unsigned short>  ImageType;
+  typedef otb::ImageFileReader<ImageType>   ReaderType;
+  typedef otb::ImageFileWriter<ImageType>   WriterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetInput(reader->GetOutput());
+  writer->Update();
+
+  otb::ExtendedFilenameToWriterOptions::Pointer options = otb::ExtendedFilenameToWriterOptions::New();
+  options->SetExtendedFileName(outputFilename);
+  const std::string fileName = options->GetSimpleFileName();
+
+  otb::GDALDatasetWrapper::Pointer wrapper = otb::GDALDriverManagerWrapper::GetInstance().Open(fileName);
+  otbControlConditionTestMacro(wrapper.IsNull(), "Unable to open " << fileName);
+  GDALDataset* dataset = wrapper->GetDataSet();
+  const int    sizeX   = dataset->GetRasterXSize();
+  const int    sizeY   = dataset->GetRasterYSize();
+  const int    nbBands = dataset->GetRasterCount();
+  otbControlConditionTestMacro(static_cast<unsigned int>(dataset->GetRasterBand(1)->GetOverviewCount()) != expectedNbOverviews,
+                               "Got " << dataset->GetRasterBand(1)->GetOverviewCount() << " overviews, expected " << expectedNbOverviews);
+
+  if (options->GetCloudOptimized())
+  {
+    otbControlConditionTestMacro(itksys::SystemTools::FileExists(fileName + ".tmp.tif"), "The temporary file was not removed");
+#if GDAL_VERSION_NUM >= 3010000
+    const char* layout = dataset->GetMetadataItem("LAYOUT", "IMAGE_STRUCTURE");
+    otbControlConditionTestMacro(layout == nullptr || std::string(layout) != "COG", "The output is not a COG");
+#endif
+  }
+
+  // Overviews computed from the whole written image
+  std::vector<double> image(static_cast<std::size_t>(sizeX) * sizeY * nbBands);
+  dataset->RasterIO(GF_Read, 0, 0, sizeX, sizeY, image.data(), sizeX, sizeY, GDT_Float64, nbBands, nullptr, sizeof(double) * nbBands,
+                    sizeof(double) * nbBands * sizeX, sizeof(double));
+  const LevelsType reference =
+      ComputeOverviews(image, sizeX, sizeY, nbBands, expectedNbOverviews, options->GetOverviewsResampling(), sizeX, sizeY, false);
+
+  for (unsigned int level = 1; level <= expectedNbOverviews; ++level)
+  {
+    GDALRasterBand*     overview = dataset->GetRasterBand(1)->GetOverview(level - 1);
+    const int           w        = overview->GetXSize();
+    const int           h        = overview->GetYSize();
+    std::vector<double> values(static_cast<std::size_t>(w) * h * nbBands);
+    for (int band = 0; band < nbBands; ++band)
+    {
+      dataset->GetRasterBand(band + 1)->GetOverview(level - 1)->RasterIO(GF_Read, 0, 0, w, h, &values[band], w, h, GDT_Float64, sizeof(double) * nbBands,
+                                                                          sizeof(double) * nbBands * w);
+    }
+    otbControlConditionTestMacro(values.size() != reference[level].size(), "Wrong size of overview " << level << ": " << w << "x" << h);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      // Overviews are rounded to the pixel type of the file
+      otbControlConditionTestMacro(std::abs(values[i] - reference[level][i]) > 0.5,
+                                   "Wrong value " << values[i] << " in overview " << level << " instead of " << reference[level][i]);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
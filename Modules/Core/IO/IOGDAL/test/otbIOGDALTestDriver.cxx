@@ -26,6 +26,8 @@ void RegisterTests()
   REGISTER_TEST(otbGDALImageIOTest_uint16);
   REGISTER_TEST(otbGDALImageIOTestWriteMetadata);
   REGISTER_TEST(otbGDALOverviewsBuilder);
+  REGISTER_TEST(otbGDALStreamingOverviews);
+  REGISTER_TEST(otbGDALImageIOStreamingOverviews);
   REGISTER_TEST(otbGDALImageIOTestCanWrite);
   REGISTER_TEST(otbOGRVectorDataIOCanWrite);
   REGISTER_TEST(otbGDALReadPxlComplexFloat);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbBandStackImageSource_h
+#define otbBandStackImageSource_h
+
+#include "otbImageFileReader.h"
+#include "otbGDALImageIO.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class BandStackImageSource
+ * \brief Stacks bands of several files of the same size into a vector image.
+ *
+ * Each output band is a (file, band) pair. Instead of splitting the
+ * files into mono-band images and merging them pixel by pixel, the
+ * requested region of each file is read by its GDALImageIO directly
+ * into the output buffer: the bands of a file which are consecutive in
+ * the output are read in one call, with the output pixel stride. GDAL
+ * converts the values to the output pixel type. The source streams
+ * like an ImageFileReader.
+ *
+ * Files are read with an ImageFileReader, so extended filenames are
+ * supported, and the bands of a file are the ones it reads (after the
+ * band selection of the extended filename). The files must be read
+ * through GDAL and not be color indexed (see CanStack()). The geometry
+ * and the image metadata are the ones of the first file, with the band
+ * metadata of each source band.
+ *
+ * When only a stacked view of the files is needed, WriteVRT() writes
+ * it as a GDAL VRT instead of reading any pixel.
+ *
+ * \sa ImageFileReader
+ * \sa WriteVirtualBandStack
+ *
+ * \ingroup OTBImageIO
+ */
+template <class TOutputImage>
+class ITK_EXPORT BandStackImageSource : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef BandStackImageSource           Self;
+  typedef itk::ImageSource<TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BandStackImageSource, ImageSource);
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+  typedef ImageFileReader<OutputImageType>            ReaderType;
+
+  /** Append a band (starting at 1) of a file to the output bands */
+  void AddBand(const std::string& fileName, unsigned int band);
+
+  /** Append all the bands of a file to the output bands */
+  void AddImage(const std::string& fileName);
+
+  /** Remove all the output bands */
+  void Clear();
+
+  /** Number of output bands (available once the output information
+   * is generated if whole files were added) */
+  unsigned int GetNumberOfBands() const
+  {
+    return static_cast<unsigned int>(m_BandMap.size());
+  }
+
+  /** Write the stack as a GDAL VRT referencing the source bands */
+  void WriteVRT(const std::string& vrtFileName);
+
+  /** Whether the pixels of a reader can be read directly by the
+   * source: its file is read through GDAL, and each output band is a
+   * band of the file (no color table). The output information of the
+   * reader must be up to date. */
+  static bool CanStack(ReaderType* reader);
+
+protected:
+  BandStackImageSource();
+  ~BandStackImageSource() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  BandStackImageSource(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Index of the reader of a file, added if needed */
+  unsigned int GetReaderIndex(const std::string& fileName);
+
+  /** One reader per distinct file */
+  std::vector<std::string>                  m_FileNames;
+  std::vector<typename ReaderType::Pointer> m_Readers;
+
+  /** Bands as added: reader and band, 0 for all the bands */
+  std::vector<std::pair<unsigned int, unsigned int>> m_Bands;
+
+  /** Reader and band of the file (starting at 1) of each output band */
+  std::vector<std::pair<unsigned int, int>> m_BandMap;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbBandStackImageSource.hxx"
+#endif
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbBandStackImageSource_hxx
+#define otbBandStackImageSource_hxx
+
+#include "otbBandStackImageSource.h"
+#include "otbGDALVirtualBandStack.h"
+#include <cstddef>
+#include <typeinfo>
+
+namespace otb
+{
+
+template <class TOutputImage>
+BandStackImageSource<TOutputImage>::BandStackImageSource()
+{
+}
+
+template <class TOutputImage>
+unsigned int BandStackImageSource<TOutputImage>::GetReaderIndex(const std::string& fileName)
+{
+  for (unsigned int i = 0; i < m_FileNames.size(); ++i)
+  {
+    if (m_FileNames[i] == fileName)
+    {
+      return i;
+    }
+  }
+
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  m_FileNames.push_back(fileName);
+  m_Readers.push_back(reader);
+  return static_cast<unsigned int>(m_Readers.size() - 1);
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::AddBand(const std::string& fileName, unsigned int band)
+{
+  if (band == 0)
+  {
+    itkExceptionMacro(<< "Bands start at 1");
+  }
+  m_Bands.push_back(std::make_pair(this->GetReaderIndex(fileName), band));
+  this->Modified();
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::AddImage(const std::string& fileName)
+{
+  m_Bands.push_back(std::make_pair(this->GetReaderIndex(fileName), 0u));
+  this->Modified();
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::Clear()
+{
+  m_FileNames.clear();
+  m_Readers.clear();
+  m_Bands.clear();
+  m_BandMap.clear();
+  this->Modified();
+}
+
+template <class TOutputImage>
+bool BandStackImageSource<TOutputImage>::CanStack(ReaderType* reader)
+{
+  const GDALImageIO* io = dynamic_cast<const GDALImageIO*>(reader->GetImageIO());
+  return io != nullptr && io->GetNumberOfComponents() == static_cast<unsigned int>(io->GetNbBands());
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::GenerateOutputInformation()
+{
+  if (m_Bands.empty())
+  {
+    itkExceptionMacro(<< "No band to stack");
+  }
+
+  for (unsigned int i = 0; i < m_Readers.size(); ++i)
+  {
+    m_Readers[i]->UpdateOutputInformation();
+    if (!CanStack(m_Readers[i]))
+    {
+      itkExceptionMacro(<< "The bands of " << m_FileNames[i] << " can not be read directly with GDAL");
+    }
+    if (m_Readers[i]->GetOutput()->GetLargestPossibleRegion() != m_Readers[0]->GetOutput()->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "The size of " << m_FileNames[i] << " differs from the size of " << m_FileNames[0]);
+    }
+  }
+
+  // Band of the file and band metadata of each output band
+  const OutputImageType*                firstOutput = m_Readers[m_Bands.front().first]->GetOutput();
+  ImageMetadata                         imd         = firstOutput->GetImageMetadata();
+  ImageMetadata::ImageMetadataBandsType bandsMetadata;
+
+  m_BandMap.clear();
+  for (const auto& band : m_Bands)
+  {
+    const ReaderType*                reader   = m_Readers[band.first];
+    const std::vector<unsigned int>& bandList = reader->GetBandList();
+    const unsigned int               nbBands  = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+    if (band.second > nbBands)
+    {
+      itkExceptionMacro(<< "Band " << band.second << " is not in the " << nbBands << " bands of " << m_FileNames[band.first]);
+    }
+
+    const unsigned int first = band.second == 0 ? 1 : band.second;
+    const unsigned int last  = band.second == 0 ? nbBands : band.second;
+    for (unsigned int b = first; b <= last; ++b)
+    {
+      m_BandMap.push_back(std::make_pair(band.first, static_cast<int>(bandList.empty() ? b : bandList[b - 1] + 1)));
+      const ImageMetadata& readerImd = reader->GetOutput()->GetImageMetadata();
+      bandsMetadata.push_back(b - 1 < readerImd.Bands.size() ? readerImd.Bands[b - 1] : ImageMetadataBase());
+    }
+  }
+  imd.Bands = bandsMetadata;
+
+  OutputImageType* output = this->GetOutput();
+  output->CopyInformation(firstOutput);
+  output->SetNumberOfComponentsPerPixel(static_cast<unsigned int>(m_BandMap.size()));
+  output->SetImageMetadata(imd);
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::GenerateData()
+{
+  OutputImageType* output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  const OutputImageRegionType& region = output->GetBufferedRegion();
+  itk::ImageIORegion           ioRegion(OutputImageType::ImageDimension);
+  for (unsigned int i = 0; i < OutputImageType::ImageDimension; ++i)
+  {
+    ioRegion.SetIndex(i, region.GetIndex()[i]);
+    ioRegion.SetSize(i, region.GetSize()[i]);
+  }
+
+  // Output layout, in bytes
+  const std::ptrdiff_t valueSpace = sizeof(OutputInternalPixelType);
+  const std::ptrdiff_t pixelSpace = valueSpace * m_BandMap.size();
+  const std::ptrdiff_t lineSpace  = pixelSpace * region.GetSize()[0];
+
+  OutputInternalPixelType* buffer = output->GetBufferPointer();
+
+  // Read each run of consecutive output bands of the same file at once
+  std::vector<int> bands;
+  for (std::size_t first = 0; first < m_BandMap.size();)
+  {
+    const unsigned int readerIndex = m_BandMap[first].first;
+    std::size_t        last        = first;
+    bands.clear();
+    for (; last < m_BandMap.size() && m_BandMap[last].first == readerIndex; ++last)
+    {
+      bands.push_back(m_BandMap[last].second);
+    }
+
+    GDALImageIO* io = static_cast<GDALImageIO*>(m_Readers[readerIndex]->GetImageIO());
+    io->SetIORegion(ioRegion);
+    io->ReadBands(buffer + first, typeid(OutputInternalPixelType), bands, pixelSpace, lineSpace, valueSpace);
+
+    first = last;
+  }
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::WriteVRT(const std::string& vrtFileName)
+{
+  this->UpdateOutputInformation();
+
+  // The name of the dataset opened by GDAL, which may differ from the
+  // name of the file (directory products, sub-datasets)
+  std::vector<std::pair<std::string, int>> bands;
+  for (const auto& band : m_BandMap)
+  {
+    bands.push_back(std::make_pair(std::string(m_Readers[band.first]->GetImageIO()->GetFileName()), band.second));
+  }
+  WriteVirtualBandStack(vrtFileName, bands);
+}
+
+template <class TOutputImage>
+void BandStackImageSource<TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of files: " << m_Readers.size() << std::endl;
+  os << indent << "Number of bands: " << m_BandMap.size() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -132,6 +132,14 @@ public:
   // Retrieve the real source file name if derived dataset */
   static std::string GetDerivedDatasetSourceFileName(const std::string& filename);
 
+  /** Bands of the file (starting at 0) read into the output bands,
+   * empty when all the bands are read in order. Set when the output
+   * information is generated. */
+  const std::vector<unsigned int>& GetBandList() const
+  {
+    return m_BandList;
+  }
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override;
@@ -39,6 +39,8 @@
 #include "otbMetaDataKey.h"
 #include "otbImageMetadata.h"
 #include "otbImageMetadataInterfaceFactory.h"
+#include "otbImageMetadataCache.h"
+#include "otbDefaultImageMetadataInterface.h"
 #include "otbImageCommons.h"
 #include "otbGeomMetadataSupplier.h"
 
@@ -425,7 +427,26 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformatio
     auto gdalMetadataSupplierPointer = dynamic_cast<MetadataSupplierInterface*>(m_ImageIO.GetPointer());
     if (gdalMetadataSupplierPointer)
     {
-      ImageMetadataInterfaceFactory::CreateIMI(imd, *gdalMetadataSupplierPointer);
+      // Cache entries are keyed by full path, so that the same relative
+      // path opened from another directory does not hit them
+      const std::string productPath = itksys::SystemTools::CollapseFullPath(DerivatedFileName);
+      std::string       cacheKey    = m_FileName;
+      const auto        pos         = cacheKey.find(DerivatedFileName);
+      if (pos != std::string::npos)
+        cacheKey.replace(pos, DerivatedFileName.size(), productPath);
+
+      if (!ImageMetadataCache::Load(cacheKey, productPath, imd))
+      {
+        ImageMetadataCache::DependencyRecorder recorder;
+        auto imi = ImageMetadataInterfaceFactory::CreateIMI(imd, *gdalMetadataSupplierPointer);
+        // Only sensor products are worth caching
+        if (dynamic_cast<DefaultImageMetadataInterface*>(imi.GetPointer()) == nullptr)
+        {
+          std::vector<std::string> dependencies = gdalMetadataSupplierPointer->GetResourceFiles();
+          dependencies.insert(dependencies.end(), recorder.GetFiles().begin(), recorder.GetFiles().end());
+          ImageMetadataCache::Store(cacheKey, productPath, imd, "", dependencies);
+        }
+      }
       otbLogMacro(Info, << "Loading metadata from official product");
     }
   }
@@ -138,6 +138,12 @@ public:
    *   composite filters for example */
   void SetAutomaticStrippedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'stripped' and configure the number of MB
+   *   available. The first strips are computed from the estimated memory
+   *   consumption of the pipeline, the next ones are resized from the memory
+   *   actually used by the process (see MeasuredRAMStrippedStreamingManager) */
+  void SetMeasuredStrippedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /**  Set the streaming mode to 'tiled' and configure the dimension of the tiles
    *   in pixels for each dimension (square tiles will be generated) */
   void SetTileDimensionTiledStreaming(unsigned int tileDimension);
@@ -162,6 +168,16 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'aligned' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline.
+   *   Splits are aligned on the blocks of the input files and on the blocks
+   *   of the output file given by the GDAL creation options (TILED,
+   *   BLOCKXSIZE, BLOCKYSIZE), see ImageRegionBlockAlignedSplitter.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType* input);
@@ -223,6 +239,10 @@ private:
   ImageFileWriter(const ImageFileWriter&) = delete;
   void operator=(const ImageFileWriter&) = delete;
 
+  /** Block size of the output file from the GDAL creation options, 0 in
+   * the dimensions where it is unknown or not aligned with the region */
+  typename InputImageRegionType::SizeType GetOutputBlockSize(const InputImageRegionType& region) const;
+
   void ObserveSourceFilterProgress(itk::Object* object, const itk::EventObject& event)
   {
     if (typeid(event) != typeid(itk::ProgressEvent))
@@ -42,15 +42,19 @@
 #include "otbNumberOfDivisionsTiledStreamingManager.h"
 #include "otbNumberOfLinesStrippedStreamingManager.h"
 #include "otbRAMDrivenStrippedStreamingManager.h"
+#include "otbMeasuredRAMStrippedStreamingManager.h"
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
 
 #include "otb_boost_tokenizer_header.h"
 
 #include "otbStringUtils.h"
 #include "otbUtils.h"
+#include "otbTrace.h"
 #include "itkProgressTransformer.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -129,6 +133,16 @@ void ImageFileWriter<TInputImage>::SetAutomaticStrippedStreaming(unsigned int av
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetMeasuredStrippedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef MeasuredRAMStrippedStreamingManager<TInputImage>  MeasuredRAMStrippedStreamingManagerType;
+  typename MeasuredRAMStrippedStreamingManagerType::Pointer streamingManager = MeasuredRAMStrippedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 template <class TInputImage>
 void ImageFileWriter<TInputImage>::SetTileDimensionTiledStreaming(unsigned int tileDimension)
 {
@@ -158,6 +172,71 @@ void ImageFileWriter<TInputImage>::SetAutomaticAdaptativeStreaming(unsigned int
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage>  RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
+template <class TInputImage>
+typename ImageFileWriter<TInputImage>::InputImageRegionType::SizeType ImageFileWriter<TInputImage>::GetOutputBlockSize(const InputImageRegionType& region) const
+{
+  typename InputImageRegionType::SizeType blockSize;
+  blockSize.Fill(0);
+
+  GDALImageIO* imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
+  if (imageIO == nullptr)
+  {
+    return blockSize;
+  }
+
+  // GeoTIFF layout: tiles of 256x256 by default, or strips
+  bool         tiled      = imageIO->GetCloudOptimized();
+  unsigned int blockSizeX = 256;
+  unsigned int blockSizeY = 0;
+  for (const auto& option : imageIO->GetOptions())
+  {
+    const auto  pos = option.find('=');
+    std::string key = option.substr(0, pos);
+    std::transform(key.begin(), key.end(), key.begin(), ::toupper);
+    std::string value = pos == std::string::npos ? std::string() : option.substr(pos + 1);
+    std::transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+    if (key == "TILED")
+      tiled = value == "YES" || value == "TRUE" || value == "ON" || value == "1";
+    else if (key == "BLOCKXSIZE")
+      blockSizeX = std::max(atoi(value.c_str()), 0);
+    else if (key == "BLOCKYSIZE")
+      blockSizeY = std::max(atoi(value.c_str()), 0);
+  }
+
+  if (tiled)
+  {
+    blockSize[0] = blockSizeX;
+    blockSize[1] = blockSizeY != 0 ? blockSizeY : 256;
+  }
+  else if (blockSizeY != 0)
+  {
+    blockSize[0] = region.GetSize(0);
+    blockSize[1] = blockSizeY;
+  }
+
+  // The blocks of the file start at the first pixel of the written region,
+  // the splits are aligned from index 0
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    if (blockSize[d] != 0 && region.GetIndex(d) % blockSize[d] != 0)
+    {
+      blockSize[d] = 0;
+    }
+  }
+  return blockSize;
+}
+
 /**
  *
  */
@@ -294,6 +373,19 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
       }
       this->SetAutomaticAdaptativeStreaming(sizevalue);
     }
+    else if (type == "aligned")
+    {
+      if (sizemode != "auto")
+      {
+        otbLogMacro(Warning, << "In aligned streaming type, the sizemode option will be ignored.");
+      }
+      if (sizevalue == 0)
+      {
+        otbLogMacro(Warning, << "sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use "
+                                "the default value");
+      }
+      this->SetAutomaticBlockAlignedStreaming(sizevalue);
+    }
     else if (type == "tiled")
     {
       if (sizemode == "auto")
@@ -314,6 +406,11 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
         }
         this->SetNumberOfDivisionsTiledStreaming(sizevalue);
       }
+      else if (sizemode == "measured")
+      {
+        otbLogMacro(Warning, << "Streaming sizemode measured is only available with stripped streaming, auto sizemode will be used instead.");
+        this->SetAutomaticTiledStreaming(sizevalue);
+      }
       else if (sizemode == "height")
       {
         if (sizevalue == 0)
@@ -346,6 +443,15 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
         }
         this->SetNumberOfDivisionsStrippedStreaming(sizevalue);
       }
+      else if (sizemode == "measured")
+      {
+        if (sizevalue == 0)
+        {
+          otbLogMacro(
+              Warning, << "sizemode is measured but sizevalue is 0. Value will be fetched from configuration file if any, or from cmake configuration otherwise.");
+        }
+        this->SetMeasuredStrippedStreaming(sizevalue);
+      }
       else if (sizemode == "height")
       {
         if (sizevalue == 0)
@@ -422,7 +528,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0) &&
-      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet()))
+      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet() ||
+       m_FilenameHelper->OverviewsCountIsSet() || m_FilenameHelper->CloudOptimizedIsSet()))
   {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -441,6 +548,15 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
       imageIO->SetNoDataList(m_FilenameHelper->GetNoDataList());
     if  (m_FilenameHelper->SrsValueIsSet())
 	  imageIO->SetEpsgCode(m_FilenameHelper->GetSrsValue());
+
+    // A COG has overviews, computed while writing unless their number is set
+    imageIO->SetCloudOptimized(m_FilenameHelper->GetCloudOptimized());
+    if (m_FilenameHelper->OverviewsCountIsSet())
+      imageIO->SetNumberOfOverviewsToWrite(m_FilenameHelper->GetOverviewsCount());
+    else if (m_FilenameHelper->GetCloudOptimized())
+      imageIO->SetNumberOfOverviewsToWrite(-1);
+    if (m_FilenameHelper->OverviewsResamplingIsSet())
+      imageIO->SetOverviewsResampling(m_FilenameHelper->GetOverviewsResampling());
   }
 
 
@@ -515,6 +631,13 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     otbLogMacro(Debug, << "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
   }
+
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage> RAMDrivenBlockAlignedStreamingManagerType;
+  if (auto blockAlignedManager = dynamic_cast<RAMDrivenBlockAlignedStreamingManagerType*>(m_StreamingManager.GetPointer()))
+  {
+    blockAlignedManager->SetOutputBlockSize(this->GetOutputBlockSize(inputRegion));
+  }
+
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
@@ -575,6 +698,9 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 template <class TInputImage>
 void ImageFileWriter<TInputImage>::Update()
 {
+  TraceSpan updateSpan("streaming", "ImageFileWriter::Update");
+  updateSpan.AddArgument("file", m_FileName);
+
   this->UpdateOutputInformation();
 
   this->SetAbortGenerateData(0);
@@ -618,15 +744,26 @@ void ImageFileWriter<TInputImage>::Update()
    * piece, and copy the results into the output image.
    */
   InputImageRegionType streamRegion;
+  PipelineTrace        pipelineTrace(inputPtr);
 
   for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
        m_CurrentDivision++, m_DivisionProgress = 0, pt.GetProcessObject())
   {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    // Some streaming managers resize the next splits while streaming
+    m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+    TraceSpan splitSpan("streaming", "Split");
+    splitSpan.AddArgument("division", m_CurrentDivision);
+    splitSpan.AddArgument("index", streamRegion.GetIndex());
+    splitSpan.AddArgument("size", streamRegion.GetSize());
+
+    {
+      TraceSpan computeSpan("streaming", "Compute");
+      inputPtr->SetRequestedRegion(streamRegion);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+    }
 
     // Write the whole image
     itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
@@ -640,6 +777,7 @@ void ImageFileWriter<TInputImage>::Update()
     m_ImageIO->SetIORegion(m_IORegion);
 
     // Start writing stream region in the image file
+    TraceSpan writeSpan("streaming", "Write");
     this->GenerateData();
   }
 
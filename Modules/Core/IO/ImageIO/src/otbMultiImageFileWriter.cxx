@@ -20,6 +20,7 @@
 
 #include "otbMultiImageFileWriter.h"
 #include "otbImageIOFactory.h"
+#include "otbTrace.h"
 
 namespace otb
 {
@@ -224,6 +225,8 @@ void MultiImageFileWriter::UpdateOutputData(itk::DataObject* itkNotUsed(output))
     return;
   }
 
+  TraceSpan updateSpan("streaming", "MultiImageFileWriter::Update");
+
   // Initialize streaming
   this->InitializeStreaming();
 
@@ -268,9 +271,18 @@ void MultiImageFileWriter::UpdateOutputData(itk::DataObject* itkNotUsed(output))
     }
   }
 
+  PipelineTrace pipelineTrace;
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  {
+    pipelineTrace.AddOutput(m_SinkList[inputIndex]->GetInput());
+  }
+
   for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
+    TraceSpan splitSpan("streaming", "Split");
+    splitSpan.AddArgument("division", m_CurrentDivision);
+
     // Update all stream regions
     for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
     {
@@ -394,6 +406,12 @@ void MultiImageFileWriter::GenerateData()
     index[1] -= shiftIndex[1];
     
     region.SetIndex(index);
+
+    // Computes the stream region of the input, then writes it
+    TraceSpan writeSpan("streaming", "Write");
+    writeSpan.AddArgument("input", inputIndex);
+    writeSpan.AddArgument("index", region.GetIndex());
+    writeSpan.AddArgument("size", region.GetSize());
     m_SinkList[inputIndex]->Write(region);
   }
 }
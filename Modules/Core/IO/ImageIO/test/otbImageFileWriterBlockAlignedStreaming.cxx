@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+/** Write a tiled image, then copy it to another tiled file with block
+ * aligned streaming, and check that the splits are aligned on both block
+ * grids and that the output file has the requested blocks */
+int otbImageFileWriterBlockAlignedStreaming(int itkNotUsed(argc), char* argv[])
+{
+  const std::string  inputFilename   = argv[1];
+  const std::string  outputFilename  = argv[2];
+  const unsigned int inputBlockSize  = atoi(argv[3]);
+  const unsigned int outputBlockSize = atoi(argv[4]);
+  const unsigned int ram             = atoi(argv[5]);
+
+  typedef otb::Image<float, 2>            ImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+  typedef otb::ImageFileWriter<ImageType> WriterType;
+
+  ImageType::SizeType size;
+  size[0] = 1000;
+  size[1] = 800;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(it.GetIndex()[0] * 3 + it.GetIndex()[1] * 7));
+  }
+
+  std::ostringstream inputFilenameExtended;
+  inputFilenameExtended << inputFilename << "?&gdal:co:TILED=YES&gdal:co:BLOCKXSIZE=" << inputBlockSize << "&gdal:co:BLOCKYSIZE=" << inputBlockSize;
+
+  WriterType::Pointer inputWriter = WriterType::New();
+  inputWriter->SetFileName(inputFilenameExtended.str());
+  inputWriter->SetInput(image);
+  inputWriter->Update();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  std::ostringstream outputFilenameExtended;
+  outputFilenameExtended << outputFilename << "?&streaming:type=aligned&streaming:sizevalue=" << ram
+                         << "&gdal:co:TILED=YES&gdal:co:BLOCKXSIZE=" << outputBlockSize << "&gdal:co:BLOCKYSIZE=" << outputBlockSize;
+  std::cout << "Output image with user defined path " << outputFilenameExtended.str() << std::endl;
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilenameExtended.str());
+  writer->SetInput(reader->GetOutput());
+  writer->Update();
+
+  // The splits are aligned on the least common multiple of the blocks
+  unsigned int gcd = inputBlockSize, r = outputBlockSize;
+  while (r != 0)
+  {
+    const unsigned int tmp = gcd % r;
+    gcd                    = r;
+    r                      = tmp;
+  }
+  const unsigned int alignment = inputBlockSize / gcd * outputBlockSize;
+
+  WriterType::StreamingManagerType* manager  = writer->GetStreamingManager();
+  const unsigned int                nbSplits = manager->GetNumberOfSplits();
+  if (nbSplits < 2)
+  {
+    std::cerr << "The image is written in " << nbSplits << " split, streaming is not tested" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < nbSplits; ++i)
+  {
+    const ImageType::RegionType split = manager->GetSplit(i);
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      const unsigned long end = split.GetIndex(d) + split.GetSize(d);
+      if (split.GetIndex(d) % alignment != 0 || (end % alignment != 0 && end != size[d]))
+      {
+        std::cerr << "Split " << i << " " << split << " is not aligned on a " << alignment << " pixels grid" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  std::cout << nbSplits << " splits aligned on a " << alignment << " pixels grid" << std::endl;
+
+  // Blocks and pixels of the output file
+  ReaderType::Pointer outputReader = ReaderType::New();
+  outputReader->SetFileName(outputFilename);
+  outputReader->Update();
+
+  const otb::ImageMetadata& imd = outputReader->GetOutput()->GetImageMetadata();
+  if (!imd.Has(otb::MDNum::TileHintX) || !imd.Has(otb::MDNum::TileHintY) || imd[otb::MDNum::TileHintX] != outputBlockSize ||
+      imd[otb::MDNum::TileHintY] != outputBlockSize)
+  {
+    std::cerr << "The output file does not have blocks of " << outputBlockSize << "x" << outputBlockSize << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> outIt(outputReader->GetOutput(), outputReader->GetOutput()->GetLargestPossibleRegion());
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    if (outIt.Get() != image->GetPixel(outIt.GetIndex()))
+    {
+      std::cerr << "Pixel comparison failed at index = " << outIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test PASSED !" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbImageFileWriterWithExtendedOptionBox);
+  REGISTER_TEST(otbImageFileWriterBlockAlignedStreaming);
   REGISTER_TEST(otbShortRGBImageIOTest);
   REGISTER_TEST(otbPipelineMetadataHandlingWithUFFilterTest);
   REGISTER_TEST(otbImageMetadataFileWriterTest);
@@ -23,6 +23,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "otbMath.h"
+#include <vector>
 
 namespace otb
 {
@@ -42,6 +43,10 @@ namespace otb
  * For example, if the image has 2 bands, the matrix is \f$ \begin{pmatrix} \alpha & \beta \\ \gama & \delta \end{pmatrix} \f$
  * The pixel \f$ [a, b] \f$ will give the output pixel \f$ [\alpha.a + \beta.b, \gamma.a + \delta.b  ]. \f$
  *
+ * Pixels are not multiplied one at a time: each output line is gathered into a
+ * contiguous matrix and multiplied by the transition matrix as a whole with a
+ * cache-blocked kernel (see BlockedMatrixProduct), then scattered to the output.
+ *
  *
  * \ingroup OTBImageManipulation
  */
@@ -117,6 +122,11 @@ protected:
    */
   void GenerateOutputInformation() override;
 
+  /**
+   * Lays out the matrix as the contiguous operator applied to pixel rows.
+   */
+  void BeforeThreadedGenerateData() override;
+
   /** MatrixImageFilter can be implemented for a multithreaded filter treatment.
    * Thus, this implementation give the ThreadedGenerateData() method.
    * that is called for each process thread. Image data are automatically allocated
@@ -138,6 +148,9 @@ private:
       Otherwise the applied operation is  \f$ p . M \f$ where p is the pixel represented as a row vector.
   */
   bool m_MatrixByVector;
+
+  /** Row-major inSize x outSize operator such that the output pixel is p . m_Operator */
+  std::vector<InputRealType> m_Operator;
 };
 } // end namespace otb
 
@@ -23,8 +23,10 @@
 
 #include "otbMacro.h" //for 
 #include "otbMatrixImageFilter.h"
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
+#include "otbBlockedMatrixProduct.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageScanlineIterator.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -73,6 +75,23 @@ void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::GenerateOutputInform
   }
 }
 
+template <class TInputImage, class TOutputImage, class TMatrix>
+void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::BeforeThreadedGenerateData()
+{
+  const unsigned int inSize  = m_MatrixByVector ? m_Matrix.cols() : m_Matrix.rows();
+  const unsigned int outSize = m_MatrixByVector ? m_Matrix.rows() : m_Matrix.cols();
+
+  // M . p is computed as p . M^T
+  m_Operator.resize(inSize * outSize);
+  for (unsigned int i = 0; i < inSize; ++i)
+  {
+    for (unsigned int j = 0; j < outSize; ++j)
+    {
+      m_Operator[i * outSize + j] = static_cast<InputRealType>(m_MatrixByVector ? m_Matrix(j, i) : m_Matrix(i, j));
+    }
+  }
+}
+
 template <class TInputImage, class TOutputImage, class TMatrix>
 void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
 {
@@ -80,39 +99,47 @@ void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::DynamicThreadedGener
   typename OutputImageType::Pointer     outputPtr = this->GetOutput();
   typename InputImageType::ConstPointer inputPtr  = this->GetInput();
 
-  typename itk::ImageRegionConstIterator<InputImageType> inIt(inputPtr, outputRegionForThread);
-  itk::ImageRegionIterator<OutputImageType>              outIt(outputPtr, outputRegionForThread);
-
-  inIt.GoToBegin();
-  outIt.GoToBegin();
+  itk::ImageScanlineConstIterator<InputImageType> inIt(inputPtr, outputRegionForThread);
+  itk::ImageScanlineIterator<OutputImageType>     outIt(outputPtr, outputRegionForThread);
 
   const unsigned int inSize  = m_MatrixByVector ? m_Matrix.cols() : m_Matrix.rows();
   const unsigned int outSize = m_MatrixByVector ? m_Matrix.rows() : m_Matrix.cols();
 
-  VectorType inVect(inSize, InputRealType(0.));
-  VectorType outVect(outSize, InputRealType(0.));
+  // Pixels of a line are gathered by blocks into a contiguous matrix
+  const std::size_t          blockSize = std::min<std::size_t>(outputRegionForThread.GetSize()[0], BlockedMatrixProductPixelBlockSize);
+  std::vector<InputRealType> gathered(blockSize * inSize);
+  std::vector<InputRealType> product(blockSize * outSize);
+
+  OutputPixelType outPix;
+  outPix.SetSize(outSize);
 
   while (!outIt.IsAtEnd())
   {
-    const InputPixelType& inPix = inIt.Get();
-    OutputPixelType       outPix;
-    outPix.SetSize(outSize);
-
-    for (unsigned int i = 0; i < inSize; ++i)
+    while (!outIt.IsAtEndOfLine())
     {
-      inVect[i] = static_cast<InputRealType>(inPix[i]);
+      std::size_t count = 0;
+      for (; count < blockSize && !inIt.IsAtEndOfLine(); ++count, ++inIt)
+      {
+        const InputPixelType& inPix = inIt.Get();
+        for (unsigned int i = 0; i < inSize; ++i)
+        {
+          gathered[count * inSize + i] = static_cast<InputRealType>(inPix[i]);
+        }
+      }
+
+      BlockedMatrixProduct(count, outSize, inSize, gathered.data(), m_Operator.data(), product.data());
+
+      for (std::size_t p = 0; p < count; ++p, ++outIt)
+      {
+        for (unsigned int i = 0; i < outSize; ++i)
+        {
+          outPix[i] = static_cast<OutputInternalPixelType>(product[p * outSize + i]);
+        }
+        outIt.Set(outPix);
+      }
     }
-
-    outVect = m_MatrixByVector ? m_Matrix * inVect : inVect * m_Matrix;
-
-    for (unsigned int i = 0; i < outSize; ++i)
-    {
-      outPix[i] = static_cast<OutputInternalPixelType>(outVect[i]);
-    }
-    outIt.Set(outPix);
-
-    ++inIt;
-    ++outIt;
+    inIt.NextLine();
+    outIt.NextLine();
   }
 }
 
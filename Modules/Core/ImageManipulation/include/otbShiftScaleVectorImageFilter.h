@@ -23,6 +23,7 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkVariableLengthVector.h"
+#include "otbImageView.h"
 
 namespace otb
 {
@@ -139,6 +140,43 @@ public:
     return result;
   }
 
+  /** Same computation on a whole tile
+   * \param in A view over the input pixels
+   * \param out A view over the output pixels, with as many bands
+   */
+  void ProcessTile(const ImageView<const typename TInput::ValueType>& in, const ImageView<typename TOutput::ValueType>& out) const
+  {
+    const ptrdiff_t nbBands = in.extent(2);
+
+    // consistency checking
+    if (nbBands != static_cast<ptrdiff_t>(m_Scale.GetSize()) || nbBands != static_cast<ptrdiff_t>(m_Shift.GetSize()))
+    {
+      itkGenericExceptionMacro(<< "Pixel size different from scale or shift size !");
+    }
+
+    // transformation, band by band so that the inner loop runs along
+    // a scanline with constant factors
+    for (ptrdiff_t i = 0; i < nbBands; ++i)
+    {
+      const bool     scaled        = m_Scale[i] > 1e-10;
+      const RealType invertedScale = scaled ? 1 / m_Scale[i] : 1;
+      for (ptrdiff_t y = 0; y < in.extent(1); ++y)
+      {
+        for (ptrdiff_t x = 0; x < in.extent(0); ++x)
+        {
+          if (scaled)
+          {
+            out(x, y, i) = static_cast<typename TOutput::ValueType>(invertedScale * (in(x, y, i) - m_Shift[i]));
+          }
+          else
+          {
+            out(x, y, i) = static_cast<typename TOutput::ValueType>(in(x, y, i) - m_Shift[i]);
+          }
+        }
+      }
+    }
+  }
+
 private:
   TInput  m_Shift;
   TOutput m_Scale;
@@ -155,6 +193,9 @@ private:
  *  Beware that the behaviour differs from itk::ShiftScaleImageFilter
  *  (which add shift instead of subtracting it).
  *
+ *  Each thread region is processed at once through image views
+ *  (see VectorShiftScale::ProcessTile()).
+ *
  *  \sa VectorShiftScale
  *  \ingroup IntensityImageFilters
  *  \ingroup MultiThreaded
@@ -176,6 +217,7 @@ public:
 
   typedef typename TOutputImage::PixelType                       OutputPixelType;
   typedef typename TInputImage::PixelType                        InputPixelType;
+  typedef typename TOutputImage::RegionType                      OutputImageRegionType;
   typedef typename InputPixelType::ValueType                     InputValueType;
   typedef typename OutputPixelType::ValueType                    OutputValueType;
   typedef typename itk::NumericTraits<InputValueType>::RealType  InputRealType;
@@ -210,6 +252,9 @@ protected:
   /** Generate input requested region */
   void GenerateInputRequestedRegion(void) override;
 
+  /** Apply the functor on the whole region of the thread */
+  void DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread) override;
+
 private:
   ShiftScaleVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
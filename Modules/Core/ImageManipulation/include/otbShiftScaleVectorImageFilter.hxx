@@ -59,6 +59,17 @@ void ShiftScaleVectorImageFilter<TInputImage, TOutputImage>::BeforeThreadedGener
   this->GetFunctor().SetScaleValues(m_Scale);
   this->GetFunctor().SetShiftValues(m_Shift);
 }
+/**
+ * Processing of a thread region.
+ */
+template <class TInputImage, class TOutputImage>
+void ShiftScaleVectorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
+{
+  typename TInputImage::RegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  this->GetFunctor().ProcessTile(MakeImageView(this->GetInput(), inputRegionForThread), MakeImageView(this->GetOutput(), outputRegionForThread));
+}
 
 } // end namespace otb
 #endif
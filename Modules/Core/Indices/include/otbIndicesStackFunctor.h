@@ -24,6 +24,7 @@
 #include <vector>
 #include <stdexcept>
 #include "itkVariableLengthVector.h"
+#include "otbImageView.h"
 
 namespace otb
 {
@@ -37,7 +38,8 @@ namespace Functor
  * This functor can be built from a vector of TIndice*. its operator()
  * will apply each functor of this vector to the input pixel, and
  * return a VariableLengthVector containing the list resulting
- * values. It can be used with otb::FunctorImageFilter
+ * values. It can be used with otb::FunctorImageFilter, which then
+ * computes the indices tile by tile with ProcessTile().
  *
  * \sa FunctorImageFilter
  *
@@ -82,6 +84,21 @@ public:
       ++idx;
     }
   }
+  /**
+   * Compute the indices on a whole tile, each indice filling its own
+   * band of the output view (used by FunctorImageFilter instead of
+   * operator())
+   */
+  void ProcessTile(const ImageView<const typename IndiceType::InputType>& in, const ImageView<typename IndiceType::OutputType>& out) const
+  {
+    ptrdiff_t idx = 0;
+    for (auto indice : m_Indices)
+    {
+      indice->ProcessTile(in, SelectBands(out, idx, 1));
+      ++idx;
+    }
+  }
+
   /**
    * \return the size of the indices list (to be used by FunctorImgeFilter)
    */
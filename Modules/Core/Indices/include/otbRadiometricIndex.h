@@ -23,6 +23,7 @@
 
 #include "itkVariableLengthVector.h"
 #include "otbBandName.h"
+#include "otbImageView.h"
 #include <array>
 #include <set>
 #include <string>
@@ -51,6 +52,12 @@ namespace Functor
  * best performances use the Value() method when implementing
  * operator() to avoid branches.
  *
+ * Indices can also be computed on whole tiles with ProcessTile(),
+ * which FunctorImageFilter uses instead of operator(). Its default
+ * implementation calls operator() on each pixel without copying it;
+ * indices on the critical path override it with ApplyOnTile() and a
+ * kernel reading the bands from the buffer directly.
+ *
  * \ingroup OTBIndices
  */
 template <typename TInput, typename TOutput>
@@ -161,7 +168,41 @@ public:
    */
   virtual TOutput operator()(const itk::VariableLengthVector<TInput>& input) const = 0;
 
+  /**
+   * Compute the indice on a whole tile
+   * \param input A view over the input pixels
+   * \param output A view over the output pixels, with a single band
+   */
+  virtual void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const
+  {
+    // Wraps each input pixel without copy
+    itk::VariableLengthVector<TInput> pixel;
+    const unsigned int                nbBands = static_cast<unsigned int>(input.extent(2));
+
+    ApplyOnTile(input, output, [&](const TInput* in) {
+      pixel.SetData(const_cast<TInput*>(in), nbBands, false);
+      return (*this)(pixel);
+    });
+  }
+
 protected:
+  /**
+   * Helper to implement ProcessTile(): sets each output pixel to the
+   * value returned by kernel(in), in pointing to the bands of the
+   * input pixel.
+   */
+  template <class TKernel>
+  static void ApplyOnTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output, TKernel&& kernel)
+  {
+    for (ptrdiff_t y = 0; y < input.extent(1); ++y)
+    {
+      for (ptrdiff_t x = 0; x < input.extent(0); ++x)
+      {
+        output(x, y, 0) = static_cast<TOutput>(kernel(&input(x, y, 0)));
+      }
+    }
+  }
+
   /**
    * Helper method to retrieve index for band name. With respect to
    * the public method, this method will not throw an exception if
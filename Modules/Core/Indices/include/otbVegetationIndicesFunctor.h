@@ -55,6 +55,14 @@ public:
     return static_cast<TOutput>(Compute(red, nir));
   }
 
+  void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const override
+  {
+    const size_t red = this->UncheckedBandIndex(CommonBandNames::RED) - 1;
+    const size_t nir = this->UncheckedBandIndex(CommonBandNames::NIR) - 1;
+
+    this->ApplyOnTile(input, output, [red, nir](const TInput* in) { return Compute(static_cast<double>(in[red]), static_cast<double>(in[nir])); });
+  }
+
   // This static compute will be used in indices derived from NDVI
   static double Compute(const double& red, const double& nir)
   {
@@ -90,6 +98,19 @@ public:
     auto red = this->Value(CommonBandNames::RED, input);
     auto nir = this->Value(CommonBandNames::NIR, input);
 
+    return Compute(red, nir);
+  }
+
+  void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const override
+  {
+    const size_t red = this->UncheckedBandIndex(CommonBandNames::RED) - 1;
+    const size_t nir = this->UncheckedBandIndex(CommonBandNames::NIR) - 1;
+
+    this->ApplyOnTile(input, output, [red, nir](const TInput* in) { return Compute(static_cast<double>(in[red]), static_cast<double>(in[nir])); });
+  }
+
+  static TOutput Compute(const double& red, const double& nir)
+  {
     if (std::abs(red) < RadiometricIndex<TInput, TOutput>::Epsilon)
     {
       return static_cast<TOutput>(0.);
@@ -157,6 +178,19 @@ public:
     auto red = this->Value(CommonBandNames::RED, input);
     auto nir = this->Value(CommonBandNames::NIR, input);
 
+    return Compute(red, nir);
+  }
+
+  void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const override
+  {
+    const size_t red = this->UncheckedBandIndex(CommonBandNames::RED) - 1;
+    const size_t nir = this->UncheckedBandIndex(CommonBandNames::NIR) - 1;
+
+    this->ApplyOnTile(input, output, [red, nir](const TInput* in) { return Compute(static_cast<double>(in[red]), static_cast<double>(in[nir])); });
+  }
+
+  static TOutput Compute(const double& red, const double& nir)
+  {
     if (std::abs(nir + red + L) < RadiometricIndex<TInput, TOutput>::Epsilon)
     {
       return static_cast<TOutput>(0.);
@@ -491,6 +525,22 @@ public:
     auto red  = this->Value(CommonBandNames::RED, input);
     auto nir  = this->Value(CommonBandNames::NIR, input);
 
+    return Compute(blue, red, nir);
+  }
+
+  void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const override
+  {
+    const size_t blue = this->UncheckedBandIndex(CommonBandNames::BLUE) - 1;
+    const size_t red  = this->UncheckedBandIndex(CommonBandNames::RED) - 1;
+    const size_t nir  = this->UncheckedBandIndex(CommonBandNames::NIR) - 1;
+
+    this->ApplyOnTile(input, output, [blue, red, nir](const TInput* in) {
+      return Compute(static_cast<double>(in[blue]), static_cast<double>(in[red]), static_cast<double>(in[nir]));
+    });
+  }
+
+  static TOutput Compute(const double& blue, const double& red, const double& nir)
+  {
     double denominator = nir + C1 * red - C2 * blue + L;
     if (std::abs(denominator) < RadiometricIndex<TInput, TOutput>::Epsilon)
     {
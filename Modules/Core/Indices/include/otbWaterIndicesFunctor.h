@@ -55,6 +55,19 @@ public:
     auto mir = this->Value(CommonBandNames::MIR, input);
     auto nir = this->Value(CommonBandNames::NIR, input);
 
+    return Compute(nir, mir);
+  }
+
+  void ProcessTile(const ImageView<const TInput>& input, const ImageView<TOutput>& output) const override
+  {
+    const size_t nir = this->UncheckedBandIndex(CommonBandNames::NIR) - 1;
+    const size_t mir = this->UncheckedBandIndex(CommonBandNames::MIR) - 1;
+
+    this->ApplyOnTile(input, output, [nir, mir](const TInput* in) { return Compute(static_cast<double>(in[nir]), static_cast<double>(in[mir])); });
+  }
+
+  static TOutput Compute(const double& nir, const double& mir)
+  {
     if (std::abs(nir + mir) < RadiometricIndex<TInput, TOutput>::Epsilon)
     {
       return 0.;
@@ -25,6 +25,7 @@
 #include "otbIndicesStackFunctor.h"
 
 #include <iomanip>
+#include <vector>
 
 template <typename T>
 itk::VariableLengthVector<T> build_pixel(const std::initializer_list<T>& il)
@@ -58,10 +59,29 @@ bool CheckResult(const std::string& testName, std::map<typename TIndice::BandNam
     std::cerr << testName << "\t- failed: expected " << expected << ", got " << v << std::endl;
     return false;
   }
-  else
+
+  // The tile operator must give the same result, on a 2x1 tile
+  // holding the pixel twice
+  using InputViewType  = otb::ImageView<const typename TIndice::InputType>;
+  using OutputViewType = otb::ImageView<typename TIndice::OutputType>;
+
+  const ptrdiff_t                         nbBands = pixel.Size();
+  std::vector<typename TIndice::InputType> tile;
+  tile.reserve(2 * nbBands);
+  tile.insert(tile.end(), pixel.GetDataPointer(), pixel.GetDataPointer() + nbBands);
+  tile.insert(tile.end(), pixel.GetDataPointer(), pixel.GetDataPointer() + nbBands);
+  typename TIndice::OutputType tileOutput[2] = {};
+
+  indice.ProcessTile(InputViewType(tile.data(), typename InputViewType::mapping_type(otb::ImageViewExtents(2, 1, nbBands), {{nbBands, 2 * nbBands, 1}})),
+                     OutputViewType(tileOutput, typename OutputViewType::mapping_type(otb::ImageViewExtents(2, 1, 1), {{1, 2, 1}})));
+
+  if (tileOutput[0] != v || tileOutput[1] != v)
   {
-    return true;
+    std::cerr << std::setprecision(10);
+    std::cerr << testName << "\t- failed: tile operator gives " << tileOutput[0] << " and " << tileOutput[1] << " instead of " << v << std::endl;
+    return false;
   }
+  return true;
 }
 
 
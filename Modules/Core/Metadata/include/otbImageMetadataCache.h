@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageMetadataCache_h
+#define otbImageMetadataCache_h
+
+#include "OTBMetadataExport.h"
+#include "otbImageMetadata.h"
+
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageMetadataCache
+ *
+ * \brief On-disk cache of the ImageMetadata parsed from sensor products
+ *
+ * Parsing the metadata of some products (Sentinel-1 annotations, large
+ * DIMAP files, ...) can take seconds, and is done again each time the product
+ * is opened. This class stores the parsed ImageMetadata as a keywordlist
+ * in a cache directory, so that it can be reloaded directly.
+ *
+ * An entry is identified by a key (usually the full path of the file given
+ * to the reader) and is valid as long as the OTB version and the
+ * modification time and the size of the product file are unchanged. The
+ * same goes for the other files the metadata was read from (DIMAP or
+ * annotation XML files, RPC files, ...), given to Store() as dependencies.
+ * A DependencyRecorder collects the files read by XMLMetadataSupplier and
+ * by the metadata interfaces while it is alive.
+ *
+ * The cache is enabled by setting the environment variable
+ * OTB_METADATA_CACHE_DIR (see ConfigurationManager::GetMetadataCacheDirectory()).
+ *
+ * Metadata holding a sensor geometry that has no keywordlist representation
+ * (MDGeom::SensorGeometry, MDGeom::Spot5Geometry, MDGeom::Adjustment) is not cached.
+ *
+ * \ingroup OTBMetadata
+ */
+class OTBMetadata_EXPORT ImageMetadataCache
+{
+public:
+  /**
+   * @brief Load the cached metadata of a product
+   *
+   * @param key The key identifying the entry
+   * @param productPath The file used to check the validity of the entry
+   * @param imd The ImageMetadata to fill, left unchanged if no valid entry is found
+   * @param cacheDirectory Cache directory, the configured one is used when empty
+   * @return True if a valid entry was found
+   */
+  static bool Load(const std::string& key, const std::string& productPath, ImageMetadata& imd,
+                   const std::string& cacheDirectory = "");
+
+  /**
+   * @brief Store the metadata of a product in the cache
+   *
+   * @param key The key identifying the entry
+   * @param productPath The file used to check the validity of the entry
+   * @param imd The ImageMetadata to store
+   * @param cacheDirectory Cache directory, the configured one is used when empty
+   * @param dependencies Other files the metadata was read from
+   * @return True if the entry was written
+   */
+  static bool Store(const std::string& key, const std::string& productPath, const ImageMetadata& imd,
+                    const std::string& cacheDirectory = "", const std::vector<std::string>& dependencies = {});
+
+  /** Path of the cache file corresponding to a key */
+  static std::string GetCacheFileName(const std::string& key, const std::string& cacheDirectory);
+
+  /** Record a file read while parsing metadata, into the DependencyRecorder
+   * alive in the calling thread if any */
+  static void RecordDependency(const std::string& fileName);
+
+  /** \class DependencyRecorder
+   *
+   * \brief Collect the files read by the metadata parsers in the current
+   * thread, from its construction to its destruction.
+   *
+   * \ingroup OTBMetadata
+   */
+  class OTBMetadata_EXPORT DependencyRecorder
+  {
+  public:
+    DependencyRecorder();
+    ~DependencyRecorder();
+
+    DependencyRecorder(const DependencyRecorder&) = delete;
+    DependencyRecorder& operator=(const DependencyRecorder&) = delete;
+
+    /** Files recorded so far */
+    const std::vector<std::string>& GetFiles() const
+    {
+      return m_Files;
+    }
+
+  private:
+    friend class ImageMetadataCache;
+
+    DependencyRecorder*      m_Previous;
+    std::vector<std::string> m_Files;
+  };
+
+private:
+  ImageMetadataCache() = delete;
+  ~ImageMetadataCache() = delete;
+};
+
+} // end namespace otb
+
+#endif
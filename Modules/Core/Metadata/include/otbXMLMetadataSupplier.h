@@ -28,6 +28,9 @@
 #include "otbMetadataSupplierInterface.h"
 #include "otbStringUtilities.h"
 
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace otb
 {
@@ -59,6 +62,11 @@ public:
   /**
    * @brief Get the first metadata value corresponding to a given path
    *
+   * Jokers (_#) are expanded through the path index built at construction,
+   * so that fully qualified paths are resolved without scanning the whole
+   * dictionary. Paths that cannot be resolved this way (partial paths for
+   * instance) fall back to a substring search.
+   *
    * @param path The path to look for
    * @param hasValue True if path is found
    * @return The value corresponding to path. Empty string if not found.
@@ -115,7 +123,7 @@ public:
    */
   std::string PrintSelf() const;
 
-  ~XMLMetadataSupplier() = default;
+  ~XMLMetadataSupplier() override;
 protected:
 
   char** AddXMLNameValueToList(char** papszList, const char *pszName,
@@ -178,11 +186,37 @@ protected:
    */
   std::vector<std::string> GetAllStartWith(char** papszStrList, const char *pszName) const;
 
+  /** Fill the path index from the content of m_MetadataDic */
+  void BuildIndex();
+
+  /**
+   * @brief Find the position of a key in m_MetadataDic using the path index
+   *
+   * Unlike GetMetadataValue(), the match is case sensitive, as the
+   * substring search of GetFirstMetadataValue() is.
+   *
+   * @param path The path to look for, it may contain _# jokers
+   * @return The position of the first matching entry, -1 if not found
+   */
+  long FindIndexedEntry(std::string const& path) const;
+
 private:
   /** List of resource files */
   std::string m_FileName;
   /** Dictionary containing the metadata */
   char** m_MetadataDic = nullptr;
+  /** Number of entries and allocated size of m_MetadataDic */
+  std::size_t m_DicSize = 0;
+  std::size_t m_DicCapacity = 0;
+  /** Position of the first entry of each key, keys are lower case
+   * (like CSLFetchNameValue, the lookup is case insensitive) */
+  std::unordered_map<std::string, std::size_t> m_KeyIndex;
+  /** Instance numbers of each node path (case sensitive, like
+   * GetNumberOf()): "a.b" -> {1, 2} when a.b_1 and a.b_2 exist, 0 stands
+   * for an instance without "_N" suffix */
+  std::unordered_map<std::string, std::set<unsigned int>> m_NodeIds;
+  /** Names of the root elements */
+  std::unordered_set<std::string> m_RootNames;
 };
 
 } // end namespace otb
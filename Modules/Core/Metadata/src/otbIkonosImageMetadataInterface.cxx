@@ -20,6 +20,7 @@
 
 
 #include "otbIkonosImageMetadataInterface.h"
+#include "otbImageMetadataCache.h"
 
 #include "otbStringUtils.h"
 #include "itkMetaDataObject.h"
@@ -65,7 +66,7 @@ namespace
   void ParseMetadataFile(const std::string & metadataFilename, 
                          T& metadataAssociativeContainer)
   {
-
+    ImageMetadataCache::RecordDependency(metadataFilename);
     std::ifstream file(metadataFilename);
 
     if (file.is_open()) 
@@ -119,7 +120,7 @@ namespace
   void ParseHeaderFile(const std::string & hdrFilename, 
                          T& metadataAssociativeContainer)
   {
-
+    ImageMetadataCache::RecordDependency(hdrFilename);
     std::ifstream file(hdrFilename);
 
     if (file.is_open()) 
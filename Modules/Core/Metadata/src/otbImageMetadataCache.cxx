@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageMetadataCache.h"
+#include "otbConfigurationManager.h"
+#include "otbConfigure.h"
+#include "otbMacro.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <set>
+#include <sstream>
+
+namespace otb
+{
+
+namespace
+{
+const std::string CacheHeader = "OTB_IMAGE_METADATA_CACHE 2";
+
+/** Recorder of the dependencies alive in the current thread */
+thread_local ImageMetadataCache::DependencyRecorder* CurrentRecorder = nullptr;
+
+std::string Escape(const std::string& in)
+{
+  std::string out;
+  out.reserve(in.size());
+  for (char c : in)
+  {
+    if (c == '\\')
+      out += "\\\\";
+    else if (c == '\n')
+      out += "\\n";
+    else
+      out += c;
+  }
+  return out;
+}
+
+std::string Unescape(const std::string& in)
+{
+  std::string out;
+  out.reserve(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i)
+  {
+    if (in[i] == '\\' && i + 1 < in.size())
+    {
+      ++i;
+      out += (in[i] == 'n') ? '\n' : in[i];
+    }
+    else
+      out += in[i];
+  }
+  return out;
+}
+
+/** Signature of the product: modification time and size */
+std::string GetProductSignature(const std::string& productPath)
+{
+  std::ostringstream oss;
+  oss << itksys::SystemTools::ModifiedTime(productPath) << " " << itksys::SystemTools::FileLength(productPath);
+  return oss.str();
+}
+
+std::string ToExactString(double value)
+{
+  std::ostringstream oss;
+  oss << std::setprecision(17) << value;
+  return oss.str();
+}
+
+/** Same format as LUT::ToString(), without loss of precision */
+template <unsigned int VDim>
+std::string LUTToExactString(const MetaData::LUT<VDim>& lut)
+{
+  std::ostringstream oss;
+  oss << std::setprecision(17);
+  for (unsigned int dim = 0; dim < VDim; dim++)
+  {
+    oss << "LUT" << VDim << "D.DIM" << dim << ".SIZE = " << lut.Axis[dim].Size << "\n";
+    if (!lut.Axis[dim].Values.empty())
+    {
+      oss << "LUT" << VDim << "D.DIM" << dim << ".VALUES = ";
+      otb::Join(oss, lut.Axis[dim].Values, " ");
+      oss << "\n";
+    }
+    else
+    {
+      oss << "LUT" << VDim << "D.DIM" << dim << ".ORIGIN = " << lut.Axis[dim].Origin << "\n"
+          << "LUT" << VDim << "D.DIM" << dim << ".SPACING = " << lut.Axis[dim].Spacing << "\n";
+    }
+  }
+  oss << "LUT" << VDim << "D.ARRAY = ";
+  otb::Join(oss, lut.Array, " ");
+  return oss.str();
+}
+
+/** ImageMetadataBase::ToKeywordlist() uses the default stream precision,
+ * numeric values are exported again with full precision */
+void ExportExactValues(const ImageMetadataBase& md, MetaData::Keywordlist& kwl)
+{
+  for (const auto& kv : md.NumericKeys)
+    kwl[MetaData::MDNumNames.left.at(kv.first)] = ToExactString(kv.second);
+  for (const auto& kv : md.LUT1DKeys)
+    kwl[MetaData::MDL1DNames.left.at(kv.first)] = LUTToExactString(kv.second);
+  for (const auto& kv : md.LUT2DKeys)
+    kwl[MetaData::MDL2DNames.left.at(kv.first)] = LUTToExactString(kv.second);
+}
+
+void RPCToKeywordlist(const Projection::RPCParam& rpc, MetaData::Keywordlist& kwl, const std::string& prefix)
+{
+  auto toString = ToExactString;
+  auto arrayToString = [](const double* array) {
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+    for (int i = 0; i < 20; ++i)
+      oss << array[i] << " ";
+    return oss.str();
+  };
+  kwl.emplace(prefix + "LineOffset", toString(rpc.LineOffset));
+  kwl.emplace(prefix + "SampleOffset", toString(rpc.SampleOffset));
+  kwl.emplace(prefix + "LatOffset", toString(rpc.LatOffset));
+  kwl.emplace(prefix + "LonOffset", toString(rpc.LonOffset));
+  kwl.emplace(prefix + "HeightOffset", toString(rpc.HeightOffset));
+  kwl.emplace(prefix + "LineScale", toString(rpc.LineScale));
+  kwl.emplace(prefix + "SampleScale", toString(rpc.SampleScale));
+  kwl.emplace(prefix + "LatScale", toString(rpc.LatScale));
+  kwl.emplace(prefix + "LonScale", toString(rpc.LonScale));
+  kwl.emplace(prefix + "HeightScale", toString(rpc.HeightScale));
+  kwl.emplace(prefix + "LineNum", arrayToString(rpc.LineNum));
+  kwl.emplace(prefix + "LineDen", arrayToString(rpc.LineDen));
+  kwl.emplace(prefix + "SampleNum", arrayToString(rpc.SampleNum));
+  kwl.emplace(prefix + "SampleDen", arrayToString(rpc.SampleDen));
+}
+
+Projection::RPCParam RPCFromKeywordlist(const MetaData::Keywordlist& kwl, const std::string& prefix)
+{
+  auto get = [&kwl, &prefix](const std::string& key) -> const std::string& {
+    auto it = kwl.find(prefix + key);
+    if (it == kwl.end())
+      otbGenericExceptionMacro(itk::ExceptionObject, << "Missing key " << prefix + key);
+    return it->second;
+  };
+  auto toArray = [&get](const std::string& key, double* array) {
+    std::istringstream iss(get(key));
+    for (int i = 0; i < 20; ++i)
+    {
+      if (!(iss >> array[i]))
+        otbGenericExceptionMacro(itk::ExceptionObject, << "Unable to decode " << key);
+    }
+  };
+  Projection::RPCParam rpc;
+  rpc.LineOffset   = std::stod(get("LineOffset"));
+  rpc.SampleOffset = std::stod(get("SampleOffset"));
+  rpc.LatOffset    = std::stod(get("LatOffset"));
+  rpc.LonOffset    = std::stod(get("LonOffset"));
+  rpc.HeightOffset = std::stod(get("HeightOffset"));
+  rpc.LineScale    = std::stod(get("LineScale"));
+  rpc.SampleScale  = std::stod(get("SampleScale"));
+  rpc.LatScale     = std::stod(get("LatScale"));
+  rpc.LonScale     = std::stod(get("LonScale"));
+  rpc.HeightScale  = std::stod(get("HeightScale"));
+  toArray("LineNum", rpc.LineNum);
+  toArray("LineDen", rpc.LineDen);
+  toArray("SampleNum", rpc.SampleNum);
+  toArray("SampleDen", rpc.SampleDen);
+  return rpc;
+}
+}
+
+ImageMetadataCache::DependencyRecorder::DependencyRecorder() : m_Previous(CurrentRecorder)
+{
+  CurrentRecorder = this;
+}
+
+ImageMetadataCache::DependencyRecorder::~DependencyRecorder()
+{
+  CurrentRecorder = m_Previous;
+}
+
+void ImageMetadataCache::RecordDependency(const std::string& fileName)
+{
+  // Files read by nested recorders are dependencies of the outer ones too
+  for (DependencyRecorder* recorder = CurrentRecorder; recorder != nullptr; recorder = recorder->m_Previous)
+  {
+    recorder->m_Files.push_back(fileName);
+  }
+}
+
+std::string ImageMetadataCache::GetCacheFileName(const std::string& key, const std::string& cacheDirectory)
+{
+  std::ostringstream oss;
+  oss << cacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(key) << ".imd";
+  return oss.str();
+}
+
+bool ImageMetadataCache::Load(const std::string& key, const std::string& productPath, ImageMetadata& imd, const std::string& cacheDirectory)
+{
+  const std::string directory = cacheDirectory.empty() ? ConfigurationManager::GetMetadataCacheDirectory() : cacheDirectory;
+  if (directory.empty() || !itksys::SystemTools::FileExists(productPath, true))
+    return false;
+
+  std::ifstream ifs(GetCacheFileName(key, directory));
+  if (!ifs)
+    return false;
+
+  std::string line;
+  if (!std::getline(ifs, line) || line != CacheHeader)
+    return false;
+  if (!std::getline(ifs, line) || line != std::string("version=") + OTB_VERSION_STRING)
+    return false;
+  if (!std::getline(ifs, line) || line != "key=" + Escape(key))
+    return false;
+  if (!std::getline(ifs, line) || line != "product=" + GetProductSignature(productPath))
+    return false;
+
+  ImageMetadata::KeywordlistVector kwlVect;
+  while (std::getline(ifs, line))
+  {
+    if (line.empty())
+      continue;
+    // Dependencies are listed before the keywordlists
+    if (kwlVect.empty() && line.compare(0, 11, "dependency=") == 0)
+    {
+      const auto sep = line.rfind('\t');
+      if (sep == std::string::npos)
+        return false;
+      const std::string dependency = Unescape(line.substr(11, sep - 11));
+      if (!itksys::SystemTools::FileExists(dependency, true) || line.substr(sep + 1) != GetProductSignature(dependency))
+        return false;
+      continue;
+    }
+    if (line.front() == '[')
+    {
+      kwlVect.emplace_back();
+      continue;
+    }
+    const auto sep = line.find('=');
+    if (kwlVect.empty() || sep == std::string::npos)
+      return false;
+    kwlVect.back().emplace(line.substr(0, sep), Unescape(line.substr(sep + 1)));
+  }
+  if (kwlVect.empty())
+    return false;
+
+  ImageMetadata cached;
+  try
+  {
+    if (!cached.FromKeywordlists(kwlVect))
+      return false;
+    const auto& kwl = kwlVect.front();
+    if (kwl.count(MetaData::MDGeomNames.left.at(MDGeom::RPC)))
+      cached.Add(MDGeom::RPC, RPCFromKeywordlist(kwl, "RPC."));
+    if (kwl.count(MetaData::MDGeomNames.left.at(MDGeom::SAR)))
+    {
+      SARParam sar;
+      sar.FromKeywordlist(kwl, "SAR.");
+      cached.Add(MDGeom::SAR, sar);
+    }
+    if (kwl.count(MetaData::MDGeomNames.left.at(MDGeom::SARCalib)))
+    {
+      SARCalib sarCalib;
+      sarCalib.FromKeywordlist(kwl, "SARCalib.");
+      cached.Add(MDGeom::SARCalib, sarCalib);
+    }
+    if (kwl.count(MetaData::MDGeomNames.left.at(MDGeom::GCP)))
+    {
+      Projection::GCPParam gcps;
+      gcps.FromKeywordlist(kwl, "GCP.");
+      cached.Add(MDGeom::GCP, gcps);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    otbLogMacro(Warning, << "Ignoring invalid metadata cache entry for " << key << ": " << e.what());
+    return false;
+  }
+
+  imd = std::move(cached);
+  otbLogMacro(Debug, << "Metadata of " << key << " loaded from cache " << GetCacheFileName(key, directory));
+  return true;
+}
+
+bool ImageMetadataCache::Store(const std::string& key, const std::string& productPath, const ImageMetadata& imd, const std::string& cacheDirectory,
+                               const std::vector<std::string>& dependencies)
+{
+  const std::string directory = cacheDirectory.empty() ? ConfigurationManager::GetMetadataCacheDirectory() : cacheDirectory;
+  if (directory.empty() || !itksys::SystemTools::FileExists(productPath, true))
+    return false;
+
+  // These geometries have no keywordlist representation
+  if (imd.Has(MDGeom::SensorGeometry) || imd.Has(MDGeom::Spot5Geometry) || imd.Has(MDGeom::Adjustment))
+    return false;
+
+  ImageMetadata::KeywordlistVector kwlVect;
+  try
+  {
+    imd.AppendToKeywordlists(kwlVect);
+    ExportExactValues(imd, kwlVect.front());
+    for (std::size_t band = 0; band < imd.Bands.size(); ++band)
+      ExportExactValues(imd.Bands[band], kwlVect[band + 1]);
+
+    auto& kwl = kwlVect.front();
+    if (imd.Has(MDGeom::RPC))
+      RPCToKeywordlist(imd.GetRPCParam(), kwl, "RPC.");
+    if (imd.Has(MDGeom::SAR))
+      imd.GetSARParam().ToKeywordlist(kwl, "SAR.");
+    if (imd.Has(MDGeom::SARCalib))
+      boost::any_cast<const SARCalib&>(imd[MDGeom::SARCalib]).ToKeywordlist(kwl, "SARCalib.");
+    if (imd.Has(MDGeom::GCP))
+      boost::any_cast<const Projection::GCPParam&>(imd[MDGeom::GCP]).ToKeywordlist(kwl, "GCP.");
+  }
+  catch (const std::exception& e)
+  {
+    otbLogMacro(Warning, << "Unable to cache the metadata of " << key << ": " << e.what());
+    return false;
+  }
+
+  // The validity of the entry is checked against every file the metadata
+  // was read from. Missing files are skipped: parsers may look for files
+  // that do not belong to the product.
+  std::ostringstream    dependencyLines;
+  std::set<std::string> checked{productPath};
+  for (const auto& file : dependencies)
+  {
+    const std::string dependency = itksys::SystemTools::CollapseFullPath(file);
+    if (!checked.insert(dependency).second || !itksys::SystemTools::FileExists(dependency, true))
+      continue;
+    dependencyLines << "dependency=" << Escape(dependency) << "\t" << GetProductSignature(dependency) << "\n";
+  }
+
+  if (!itksys::SystemTools::MakeDirectory(directory))
+    return false;
+
+  // Write to a temporary file first, so that concurrent readers never see
+  // a partial entry
+  const std::string fileName = GetCacheFileName(key, directory);
+  std::ostringstream tmpName;
+  tmpName << fileName << "." << std::hex << std::random_device{}() << ".tmp";
+  {
+    std::ofstream ofs(tmpName.str());
+    if (!ofs)
+      return false;
+    ofs << CacheHeader << "\n";
+    ofs << "version=" << OTB_VERSION_STRING << "\n";
+    ofs << "key=" << Escape(key) << "\n";
+    ofs << "product=" << GetProductSignature(productPath) << "\n";
+    ofs << dependencyLines.str();
+    for (std::size_t i = 0; i < kwlVect.size(); ++i)
+    {
+      ofs << "[" << i << "]\n";
+      for (const auto& kv : kwlVect[i])
+        ofs << kv.first << "=" << Escape(kv.second) << "\n";
+    }
+    if (!ofs)
+    {
+      ofs.close();
+      std::remove(tmpName.str().c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpName.str().c_str(), fileName.c_str()) != 0)
+  {
+    std::remove(tmpName.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+} // end namespace otb
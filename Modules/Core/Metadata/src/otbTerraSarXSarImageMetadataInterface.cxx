@@ -20,6 +20,7 @@
 
 
 #include "otbTerraSarXSarImageMetadataInterface.h"
+#include "otbImageMetadataCache.h"
 
 #include "otbStringUtils.h"
 #include "otbMath.h"
@@ -499,6 +500,7 @@ void ReadGeorefGCP(const otb::MetaData::TimePoint & azimuthTimeStart, const std:
   Projection::GCPParam gcp;
 
   // Open the xml file
+  ImageMetadataCache::RecordDependency(geoRefXmlFileName);
   TiXmlDocument doc(geoRefXmlFileName);
   if (!doc.LoadFile())
   {
@@ -19,13 +19,27 @@
  */
 
 #include "otbXMLMetadataSupplier.h"
+#include "otbImageMetadataCache.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <unordered_set>
 
+namespace
+{
+std::string ToLower(std::string s)
+{
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+  return s;
+}
+}
+
 namespace otb
 {
 XMLMetadataSupplier::XMLMetadataSupplier(const std::string & fileName)
   : m_FileName(fileName)
 {
+  ImageMetadataCache::RecordDependency(m_FileName);
   CPLXMLNode* psNode = CPLParseXMLFile(m_FileName.c_str());
   if(psNode != nullptr)
     m_MetadataDic = ReadXMLToList(psNode, m_MetadataDic);
@@ -34,28 +48,114 @@ XMLMetadataSupplier::XMLMetadataSupplier(const std::string & fileName)
     otbLogMacro(Warning, <<"Unable to parse XML file " << fileName);
     m_MetadataDic = nullptr;
   }
-  // if(fileName.find("LUT")!= std::string::npos)
-  //   int nbLines = CSLSave(m_MetadataDic, "/home/florian/OTB/test/lut.txt");
-  // else
-  //   int nbLines = CSLSave(m_MetadataDic, "/home/florian/OTB/test/output.txt");
   CPLDestroyXMLNode(psNode);
+  BuildIndex();
+}
+
+XMLMetadataSupplier::~XMLMetadataSupplier()
+{
+  CSLDestroy(m_MetadataDic);
+}
+
+void XMLMetadataSupplier::BuildIndex()
+{
+  m_KeyIndex.clear();
+  m_NodeIds.clear();
+  m_RootNames.clear();
+  if (m_MetadataDic == nullptr)
+    return;
+
+  m_KeyIndex.reserve(m_DicSize);
+  std::size_t pos = 0;
+  for (char** entry = m_MetadataDic; *entry != nullptr; ++entry, ++pos)
+  {
+    const char* sep = strchr(*entry, '=');
+    if (sep == nullptr)
+      continue;
+    const std::string key(*entry, sep - *entry);
+    // emplace() keeps the first entry, as CSLFetchNameValue() does
+    m_KeyIndex.emplace(ToLower(key), pos);
+
+    // Register every node of the path, and the size of the lists ("node_N")
+    std::size_t start = 0;
+    std::size_t end   = key.find('.');
+    m_RootNames.insert(key.substr(0, end));
+    while (start < key.size())
+    {
+      const std::size_t segEnd     = (end == std::string::npos) ? key.size() : end;
+      const std::size_t underscore = key.rfind('_', segEnd);
+      if (underscore != std::string::npos && underscore > start && underscore + 1 < segEnd && segEnd - underscore < 10
+          && std::all_of(key.begin() + underscore + 1, key.begin() + segEnd, [](unsigned char c) { return std::isdigit(c); }))
+      {
+        const unsigned int id = std::stoi(key.substr(underscore + 1, segEnd - underscore - 1));
+        m_NodeIds[key.substr(0, underscore)].insert(id);
+      }
+      else if (end != std::string::npos)
+      {
+        m_NodeIds[key.substr(0, end)].insert(0);
+      }
+      if (end == std::string::npos)
+        break;
+      start = end + 1;
+      end   = key.find('.', start);
+    }
+  }
+}
+
+long XMLMetadataSupplier::FindIndexedEntry(std::string const& path) const
+{
+  const std::size_t joker = path.find("_#");
+  if (joker == std::string::npos)
+  {
+    auto it = m_KeyIndex.find(ToLower(path));
+    if (it == m_KeyIndex.end())
+      return -1;
+    // The index is case insensitive, the key has to match exactly here
+    const char* entry = m_MetadataDic[it->second];
+    if (strncmp(entry, path.c_str(), path.size()) != 0)
+      return -1;
+    return static_cast<long>(it->second);
+  }
+
+  const std::string base = path.substr(0, joker);
+  const std::string tail = path.substr(joker + 2);
+  auto nodeIt = m_NodeIds.find(base);
+  if (nodeIt == m_NodeIds.end())
+    return -1;
+  // A node with a single instance has no "_N" suffix
+  long ret = -1;
+  for (auto it = nodeIt->second.begin(); ret < 0 && it != nodeIt->second.end(); ++it)
+    ret = FindIndexedEntry(*it == 0 ? base + tail : base + "_" + std::to_string(*it) + tail);
+  return ret;
 }
 
 std::string XMLMetadataSupplier::GetMetadataValue(std::string const& path, bool& hasValue, int /*band*/) const
 {
-  const char * ret = CSLFetchNameValue(m_MetadataDic, path.c_str());
-  if (ret)
-    hasValue = true;
-  else
+  auto it = m_KeyIndex.find(ToLower(path));
+  if (it == m_KeyIndex.end())
   {
     hasValue = false;
-    ret = "";
+    return "";
   }
-  return std::string(ret);
+  hasValue = true;
+  const char* entry = m_MetadataDic[it->second];
+  return std::string(entry + path.size() + 1);
 }
 
 std::string XMLMetadataSupplier::GetFirstMetadataValue(std::string const& path, bool& hasValue) const
 {
+  // Fully qualified paths are resolved through the index
+  if (m_RootNames.count(path.substr(0, path.find('.'))))
+  {
+    const long pos = FindIndexedEntry(path);
+    if (pos >= 0)
+    {
+      hasValue = true;
+      const char* entry = m_MetadataDic[pos];
+      return std::string(strchr(entry, '=') + 1);
+    }
+  }
+
   // Search for the  first joker
   std::size_t found = path.find("_#");
   // Looking for the keys corresponding to the part of the path before the first joker
@@ -98,12 +198,31 @@ std::string XMLMetadataSupplier::GetResourceFile(std::string const& /*s*/) const
  * AddXMLNameValueToList() is a GDAL function non exposed from API.
  * The original code source is available here
  * https://github.com/OSGeo/gdal/blob/13323826f941afbd8a4f188312a3cec20e487290/gcore/gdal_mdreader.cpp#L297
+ *
+ * Unlike CSLAddNameValue(), the size of the list is tracked so that
+ * appending an entry does not need to count the whole list.
  */
 char** XMLMetadataSupplier::AddXMLNameValueToList(char** papszList,
                                                const char *pszName,
                                                const char *pszValue)
 {
-    return CSLAddNameValue(papszList, pszName, pszValue);
+    if (pszName == nullptr || pszValue == nullptr)
+        return papszList;
+
+    if (papszList == nullptr)
+    {
+        m_DicSize = 0;
+        m_DicCapacity = 0;
+    }
+    if (m_DicSize + 1 >= m_DicCapacity)
+    {
+        m_DicCapacity = std::max<std::size_t>(64, 2 * m_DicCapacity);
+        papszList = static_cast<char**>(CPLRealloc(papszList, m_DicCapacity * sizeof(char*)));
+    }
+    const std::string line = std::string(pszName) + '=' + pszValue;
+    papszList[m_DicSize++] = CPLStrdup(line.c_str());
+    papszList[m_DicSize] = nullptr;
+    return papszList;
 }
 
 /**
@@ -307,6 +426,10 @@ int XMLMetadataSupplier::GetNbBands() const
 
 unsigned int XMLMetadataSupplier::GetNumberOf(std::string const & path) const
 {
+  auto nodeIt = m_NodeIds.find(path);
+  if (nodeIt != m_NodeIds.end())
+    return nodeIt->second.size();
+
   std::unordered_set<int> idx;
   for(auto const& key : GetAllStartWith(m_MetadataDic, path.c_str()))
   {
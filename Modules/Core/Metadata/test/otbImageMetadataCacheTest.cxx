@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageMetadataCache.h"
+#include "otbMacro.h"
+#include <cstdio>
+#include <fstream>
+
+int otbImageMetadataCacheTest(int itkNotUsed(argc), char* argv[])
+{
+  using namespace otb;
+  const std::string cacheDir = argv[1];
+  const std::string product  = cacheDir + "/product.txt";
+  {
+    std::ofstream ofs(product);
+    ofs << "product";
+  }
+  std::remove(ImageMetadataCache::GetCacheFileName(product, cacheDir).c_str());
+
+  ImageMetadata md;
+  md.Add(MDStr::SensorID, "PHR");
+  md.Add(MDGeom::ProjectionWKT, std::string("UTM projRef"));
+  md.Add(MDTime::ProductionDate, MetaData::ReadFormattedDate(std::string("2009-08-10T10:30:08.142149Z")));
+  md.Add(std::string("Comment"), std::string("multi\nline"));
+  md.Add(MDNum::SunElevation, 23.123456789012345);
+  for (unsigned int bandId = 0; bandId < 3; bandId++)
+  {
+    ImageMetadataBase bmd;
+    bmd.Add(MDStr::BandName, "B" + std::to_string(bandId));
+    bmd.Add(MDNum::PhysicalGain, 1.0 / (bandId + 3.0));
+    md.Bands.push_back(bmd);
+  }
+  Projection::RPCParam rpc;
+  rpc.LineOffset = 1234.5;
+  rpc.LatScale   = 0.123456789012345;
+  rpc.SampleDen[19] = -1e-7;
+  md.Add(MDGeom::RPC, rpc);
+
+  otbControlConditionTestMacro(ImageMetadataCache::Load(product, product, md, cacheDir), "Unexpected cache hit before Store()");
+  otbControlConditionTestMacro(ImageMetadataCache::Store(product, cacheDir + "/missing.txt", md, cacheDir), "Store() accepted a missing product");
+  otbControlConditionTestMacro(!ImageMetadataCache::Store(product, product, md, cacheDir), "Store() failed");
+
+  ImageMetadata cached;
+  otbControlConditionTestMacro(!ImageMetadataCache::Load(product, product, cached, cacheDir), "Load() failed");
+  otbControlConditionTestMacro(cached.ToJSON() != md.ToJSON(), "Cached metadata differs");
+  otbControlConditionTestMacro(cached.Bands.size() != 3, "Wrong number of cached bands");
+  otbControlConditionTestMacro(cached.Bands[2][MDNum::PhysicalGain] != md.Bands[2][MDNum::PhysicalGain], "Precision lost on band values");
+  otbControlConditionTestMacro(cached[MDNum::SunElevation] != md[MDNum::SunElevation], "Precision lost on numeric values");
+  otbControlConditionTestMacro(cached[std::string("Comment")] != "multi\nline", "Wrong escaped value");
+  otbControlConditionTestMacro(!cached.Has(MDGeom::RPC) || !(cached.GetRPCParam() == rpc), "Wrong cached RPC model");
+
+  ImageMetadata other;
+  otbControlConditionTestMacro(ImageMetadataCache::Load(product + "?other", product, other, cacheDir), "Unexpected cache hit with another key");
+
+  // Modifying the product invalidates the entry
+  {
+    std::ofstream ofs(product, std::ios::app);
+    ofs << " modified";
+  }
+  otbControlConditionTestMacro(ImageMetadataCache::Load(product, product, other, cacheDir), "Unexpected cache hit on a modified product");
+
+  // Modifying a file the metadata was read from invalidates the entry too
+  const std::string sidecar = cacheDir + "/product_sidecar.xml";
+  {
+    std::ofstream ofs(sidecar);
+    ofs << "<sidecar/>";
+  }
+  std::vector<std::string> dependencies;
+  {
+    ImageMetadataCache::DependencyRecorder recorder;
+    ImageMetadataCache::RecordDependency(sidecar);
+    ImageMetadataCache::RecordDependency(cacheDir + "/missing_sidecar.xml");
+    dependencies = recorder.GetFiles();
+  }
+  otbControlConditionTestMacro(dependencies.size() != 2, "Wrong number of recorded dependencies");
+  otbControlConditionTestMacro(!ImageMetadataCache::Store(product, product, md, cacheDir, dependencies), "Store() with dependencies failed");
+  otbControlConditionTestMacro(!ImageMetadataCache::Load(product, product, other, cacheDir), "Load() with dependencies failed");
+  {
+    std::ofstream ofs(sidecar, std::ios::app);
+    ofs << "<modified/>";
+  }
+  otbControlConditionTestMacro(ImageMetadataCache::Load(product, product, other, cacheDir), "Unexpected cache hit on a modified dependency");
+
+  return EXIT_SUCCESS;
+}
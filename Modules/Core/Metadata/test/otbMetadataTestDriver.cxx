@@ -26,7 +26,9 @@ void RegisterTests()
   REGISTER_TEST(otbNoDataHelperTest);
   REGISTER_TEST(otbSarCalibrationLookupDataTest);
   REGISTER_TEST(otbImageMetadataTest);
+  REGISTER_TEST(otbImageMetadataCacheTest);
   REGISTER_TEST(otbGeomMetadataSupplierTest);
   REGISTER_TEST(otbXMLMetadataSupplierTest);
+  REGISTER_TEST(otbXMLMetadataSupplierIndexTest);
   REGISTER_TEST(otbSentinel1ThermalNoiseLutTest);
 }
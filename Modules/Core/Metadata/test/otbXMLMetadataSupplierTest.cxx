@@ -19,6 +19,8 @@
  */
 
 #include "otbXMLMetadataSupplier.h"
+#include "otbMacro.h"
+#include <fstream>
 
 int otbXMLMetadataSupplierTest(int itkNotUsed(argc), char* argv[])
 {
@@ -37,3 +39,31 @@ int otbXMLMetadataSupplierTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbXMLMetadataSupplierIndexTest(int itkNotUsed(argc), char* argv[])
+{
+  const std::string fileName = std::string(argv[1]) + "/otbXMLMetadataSupplierIndexTest.xml";
+  {
+    std::ofstream ofs(fileName);
+    ofs << "<Root><Item_1>a</Item_1><Item_4>b</Item_4>"
+        << "<Node><Leaf>c</Leaf></Node><Node><Leaf>d</Leaf></Node>"
+        << "<Mixed>e</Mixed></Root>";
+  }
+  otb::XMLMetadataSupplier mds(fileName);
+
+  bool hasValue = false;
+  // Number of instances, not the highest instance number
+  otbControlConditionTestMacro(mds.GetNumberOf("Root.Item") != 2, "Wrong number of Root.Item");
+  otbControlConditionTestMacro(mds.GetNumberOf("Root.Node") != 2, "Wrong number of Root.Node");
+  otbControlConditionTestMacro(mds.GetNumberOf("root.node") != 0, "GetNumberOf() should be case sensitive");
+
+  // GetMetadataValue() is case insensitive, as CSLFetchNameValue()
+  otbControlConditionTestMacro(mds.GetMetadataValue("root.mixed", hasValue) != "e" || !hasValue, "GetMetadataValue() should be case insensitive");
+
+  // GetFirstMetadataValue() is case sensitive
+  otbControlConditionTestMacro(mds.GetFirstMetadataValue("Root.Node_#.Leaf", hasValue) != "c" || !hasValue, "Wrong first value of Root.Node_#.Leaf");
+  mds.GetFirstMetadataValue("Root.node_#.leaf", hasValue);
+  otbControlConditionTestMacro(hasValue, "GetFirstMetadataValue() should be case sensitive");
+
+  return EXIT_SUCCESS;
+}
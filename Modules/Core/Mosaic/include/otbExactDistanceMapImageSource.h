@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbExactDistanceMapImageSource_h
+#define otbExactDistanceMapImageSource_h
+
+#include "itkImageSource.h"
+#include "otbStreamingMaskColumnRunsFilter.h"
+
+namespace otb
+{
+/** \class ExactDistanceMapImageSource
+ * \brief Generates the exact Euclidean distance map of a binary mask, for any requested region.
+ *
+ * Each output pixel holds the distance to the nearest object (non-zero)
+ * pixel of the mask, 0 on the objects, like
+ * itk::DanielssonDistanceMapImageFilter with a binary input. The mask is
+ * only known through its MaskColumnRuns, computed beforehand by
+ * StreamingMaskColumnRunsFilter, so the source does not read the mask
+ * and can be streamed and threaded like any other source.
+ *
+ * The transform is the separable one of Felzenszwalb and Huttenlocher:
+ * the distance to the nearest object of the column is found in the runs
+ * of the column, then the lower envelope of the parabolas of the
+ * columns gives the exact distance along each output row. The vertical
+ * distances of the requested columns bound the distance, so only the
+ * columns within that bound are visited.
+ *
+ * The output geometry is the one of the reference image given with
+ * SetReferenceImage(), grown by PaddingRadius pixels on each side.
+ * Padding pixels are objects: they make the image border an edge.
+ *
+ * Pixels without any object in the image get the maximum of the pixel
+ * type.
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TOutputImage>
+class ITK_EXPORT ExactDistanceMapImageSource : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ExactDistanceMapImageSource   Self;
+  typedef itk::ImageSource<TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ExactDistanceMapImageSource, ImageSource);
+
+  typedef TOutputImage                          OutputImageType;
+  typedef typename OutputImageType::RegionType  OutputImageRegionType;
+  typedef typename OutputImageType::PixelType   OutputImagePixelType;
+  typedef itk::ImageBase<2>                     ReferenceImageType;
+  typedef MaskColumnRuns                        ColumnRunsType;
+  typedef typename ColumnRunsType::IndexValueType IndexValueType;
+
+  static_assert(TOutputImage::ImageDimension == 2, "ExactDistanceMapImageSource only supports 2D images");
+
+  /** Runs of the mask */
+  void SetColumnRuns(const ColumnRunsType& runs)
+  {
+    m_ColumnRuns = runs;
+    this->Modified();
+  }
+  const ColumnRunsType& GetColumnRuns() const
+  {
+    return m_ColumnRuns;
+  }
+
+  /** Image giving the geometry of the mask */
+  itkSetConstObjectMacro(ReferenceImage, ReferenceImageType);
+  itkGetConstObjectMacro(ReferenceImage, ReferenceImageType);
+
+  /** Number of object pixels added around the mask (default 0) */
+  itkSetMacro(PaddingRadius, unsigned int);
+  itkGetMacro(PaddingRadius, unsigned int);
+
+  /** Distances in physical units (default) or in pixels */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+protected:
+  ExactDistanceMapImageSource();
+  ~ExactDistanceMapImageSource() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ExactDistanceMapImageSource(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Distance in pixels from a pixel of the padded mask to the nearest
+   * object of its column (infinity if there is none) */
+  double ColumnDistance(IndexValueType x, IndexValueType y) const;
+
+  ColumnRunsType                        m_ColumnRuns;
+  typename ReferenceImageType::ConstPointer m_ReferenceImage;
+  unsigned int                          m_PaddingRadius;
+  bool                                  m_UseImageSpacing;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbExactDistanceMapImageSource.hxx"
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbExactDistanceMapImageSource_hxx
+#define otbExactDistanceMapImageSource_hxx
+
+#include "otbExactDistanceMapImageSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "itkContinuousIndex.h"
+#include "itkImageScanlineIterator.h"
+
+namespace otb
+{
+
+template <class TOutputImage>
+ExactDistanceMapImageSource<TOutputImage>::ExactDistanceMapImageSource() : m_PaddingRadius(0), m_UseImageSpacing(true)
+{
+}
+
+template <class TOutputImage>
+void ExactDistanceMapImageSource<TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (m_ReferenceImage.IsNull())
+  {
+    itkExceptionMacro(<< "The reference image is not set");
+  }
+
+  auto region = m_ReferenceImage->GetLargestPossibleRegion();
+  if (region != m_ColumnRuns.Region || m_ColumnRuns.Offsets.size() != region.GetSize(0) + 1)
+  {
+    itkExceptionMacro(<< "The column runs do not match the reference image region " << region);
+  }
+
+  OutputImageType* output = this->GetOutput();
+  output->CopyInformation(m_ReferenceImage);
+
+  // Output pixel i is the pixel i - PaddingRadius of the mask
+  itk::ContinuousIndex<double, 2> shift;
+  shift.Fill(-static_cast<double>(m_PaddingRadius));
+  typename OutputImageType::PointType origin;
+  m_ReferenceImage->TransformContinuousIndexToPhysicalPoint(shift, origin);
+  output->SetOrigin(origin);
+
+  auto size = region.GetSize();
+  size[0] += 2 * m_PaddingRadius;
+  size[1] += 2 * m_PaddingRadius;
+  OutputImageRegionType outputRegion(region.GetIndex(), size);
+  output->SetLargestPossibleRegion(outputRegion);
+}
+
+template <class TOutputImage>
+double ExactDistanceMapImageSource<TOutputImage>::ColumnDistance(IndexValueType x, IndexValueType y) const
+{
+  const auto&          region = m_ColumnRuns.Region;
+  const IndexValueType x0     = region.GetIndex(0);
+  const IndexValueType y0     = region.GetIndex(1);
+  const IndexValueType y1     = y0 + static_cast<IndexValueType>(region.GetSize(1));
+
+  // Padding pixels are objects
+  if (x < x0 || x >= x0 + static_cast<IndexValueType>(region.GetSize(0)) || y < y0 || y >= y1)
+  {
+    return 0.;
+  }
+
+  double distance = std::numeric_limits<double>::infinity();
+  if (m_PaddingRadius > 0)
+  {
+    distance = std::min(y - (y0 - 1), y1 - y);
+  }
+
+  const auto begin = m_ColumnRuns.Runs.begin() + m_ColumnRuns.Offsets[x - x0];
+  const auto end   = m_ColumnRuns.Runs.begin() + m_ColumnRuns.Offsets[x - x0 + 1];
+  const auto next  = std::lower_bound(begin, end, y, [](const typename ColumnRunsType::RunType& run, IndexValueType row) { return run.second < row; });
+  if (next != end)
+  {
+    if (next->first <= y)
+    {
+      return 0.;
+    }
+    distance = std::min<double>(distance, next->first - y);
+  }
+  if (next != begin)
+  {
+    distance = std::min<double>(distance, y - (next - 1)->second);
+  }
+  return distance;
+}
+
+template <class TOutputImage>
+void ExactDistanceMapImageSource<TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
+{
+  OutputImageType* output = this->GetOutput();
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  double       sx = 1., sy = 1.;
+  if (m_UseImageSpacing)
+  {
+    sx = std::abs(output->GetSignedSpacing()[0]);
+    sy = std::abs(output->GetSignedSpacing()[1]);
+  }
+
+  const IndexValueType pad     = m_PaddingRadius;
+  const auto&          largest = output->GetLargestPossibleRegion();
+  const IndexValueType lx0     = largest.GetIndex(0);
+  const IndexValueType lx1     = lx0 + static_cast<IndexValueType>(largest.GetSize(0)) - 1;
+  const IndexValueType ox0     = outputRegionForThread.GetIndex(0);
+  const IndexValueType ox1     = ox0 + static_cast<IndexValueType>(outputRegionForThread.GetSize(0)) - 1;
+
+  // Lower envelope of the parabolas of the columns: apex columns, apex
+  // heights (squared vertical distances) and left bounds
+  std::vector<IndexValueType> apex;
+  std::vector<double>         height;
+  std::vector<double>         bound;
+
+  itk::ImageScanlineIterator<OutputImageType> it(output, outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    const IndexValueType y = it.GetIndex()[1] - pad;
+
+    // The distance of the requested pixels is at most the largest of their
+    // vertical distances, so farther columns can not be the nearest ones
+    double maxDistance = 0.;
+    for (IndexValueType x = ox0; x <= ox1 && maxDistance < infinity; ++x)
+    {
+      maxDistance = std::max(maxDistance, ColumnDistance(x - pad, y) * sy);
+    }
+    IndexValueType first = lx0, last = lx1;
+    if (maxDistance < infinity)
+    {
+      const IndexValueType radius = static_cast<IndexValueType>(std::ceil(maxDistance / sx));
+      first                       = std::max(lx0, ox0 - radius);
+      last                        = std::min(lx1, ox1 + radius);
+    }
+
+    apex.clear();
+    height.clear();
+    bound.clear();
+    for (IndexValueType x = first; x <= last; ++x)
+    {
+      const double g = ColumnDistance(x - pad, y);
+      if (g == infinity)
+      {
+        continue;
+      }
+      const double f = (g * sy) * (g * sy);
+      const double p = x * sx;
+      while (!apex.empty())
+      {
+        const double q = apex.back() * sx;
+        const double s = ((f + p * p) - (height.back() + q * q)) / (2. * (p - q));
+        if (s <= bound.back())
+        {
+          apex.pop_back();
+          height.pop_back();
+          bound.pop_back();
+        }
+        else
+        {
+          bound.push_back(s);
+          break;
+        }
+      }
+      if (apex.empty())
+      {
+        bound.push_back(-infinity);
+      }
+      apex.push_back(x);
+      height.push_back(f);
+    }
+
+    std::size_t k = 0;
+    for (IndexValueType x = ox0; !it.IsAtEndOfLine(); ++it, ++x)
+    {
+      if (apex.empty())
+      {
+        it.Set(itk::NumericTraits<OutputImagePixelType>::max());
+        continue;
+      }
+      const double p = x * sx;
+      while (k + 1 < apex.size() && bound[k + 1] < p)
+      {
+        ++k;
+      }
+      const double dx = p - apex[k] * sx;
+      it.Set(static_cast<OutputImagePixelType>(std::sqrt(dx * dx + height[k])));
+    }
+  }
+}
+
+template <class TOutputImage>
+void ExactDistanceMapImageSource<TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of runs: " << m_ColumnRuns.Runs.size() << std::endl;
+  os << indent << "Padding radius: " << m_PaddingRadius << std::endl;
+  os << indent << "Use image spacing: " << m_UseImageSpacing << std::endl;
+}
+
+} // end namespace otb
+#endif
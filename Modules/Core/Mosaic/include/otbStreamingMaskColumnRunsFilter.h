@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbStreamingMaskColumnRunsFilter_h
+#define otbStreamingMaskColumnRunsFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "itkImageRegion.h"
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class MaskColumnRuns
+ * \brief Run-length encoding of the object pixels of a 2D binary mask, column by column.
+ *
+ * Object pixels are the non-zero pixels of the mask. The runs of column
+ * `Region.GetIndex(0) + i` are `Runs[Offsets[i]]` to `Runs[Offsets[i+1]-1]`,
+ * sorted by row; each run holds its first and last row indices.
+ *
+ * A mask covering a footprint has a couple of runs per column, so this
+ * is all an exact distance transform needs to know about the mask (see
+ * ExactDistanceMapImageSource).
+ *
+ * \ingroup OTBMosaic
+ */
+class MaskColumnRuns
+{
+public:
+  typedef itk::ImageRegion<2>                       RegionType;
+  typedef itk::IndexValueType                       IndexValueType;
+  typedef std::pair<IndexValueType, IndexValueType> RunType;
+
+  RegionType               Region;
+  std::vector<std::size_t> Offsets;
+  std::vector<RunType>     Runs;
+};
+
+/** \class PersistentMaskColumnRunsFilter
+ * \brief Computes the MaskColumnRuns of a binary mask, using the output requested region.
+ *
+ * This filter persists its temporary data: the runs of the n regions it
+ * is updated on are gathered by Synthetize(), which merges runs spanning
+ * several regions. Reset() clears them.
+ *
+ * \sa PersistentImageFilter
+ * \sa ExactDistanceMapImageSource
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentMaskColumnRunsFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentMaskColumnRunsFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentMaskColumnRunsFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                      ImageType;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::IndexType  IndexType;
+  typedef typename TInputImage::PixelType  PixelType;
+
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  static_assert(TInputImage::ImageDimension == 2, "PersistentMaskColumnRunsFilter only supports 2D masks");
+
+  typedef MaskColumnRuns                 ColumnRunsType;
+  typedef ColumnRunsType::RunType        RunType;
+  typedef ColumnRunsType::IndexValueType IndexValueType;
+
+  /** Return the runs, valid after Synthetize() */
+  const ColumnRunsType& GetColumnRuns() const
+  {
+    return m_ColumnRuns;
+  }
+
+  /** The output image is not used */
+  void AllocateOutputs() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentMaskColumnRunsFilter();
+  ~PersistentMaskColumnRunsFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentMaskColumnRunsFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Run of a column found by a thread: (column, (first row, last row)) */
+  typedef std::pair<IndexValueType, RunType> ColumnRunType;
+
+  std::vector<std::vector<ColumnRunType>> m_ThreadRuns;
+  ColumnRunsType                          m_ColumnRuns;
+}; // end of class PersistentMaskColumnRunsFilter
+
+
+/** \class StreamingMaskColumnRunsFilter
+ * \brief This class streams the whole input mask through the PersistentMaskColumnRunsFilter.
+ *
+ * \code
+ * typedef otb::StreamingMaskColumnRunsFilter<MaskImageType> RunsFilterType;
+ * RunsFilterType::Pointer runs = RunsFilterType::New();
+ * runs->SetInput(mask);
+ * runs->Update();
+ * distanceSource->SetColumnRuns(runs->GetColumnRuns());
+ * \endcode
+ *
+ * \sa PersistentMaskColumnRunsFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TInputImage>
+class ITK_EXPORT StreamingMaskColumnRunsFilter : public PersistentFilterStreamingDecorator<PersistentMaskColumnRunsFilter<TInputImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingMaskColumnRunsFilter                                                   Self;
+  typedef PersistentFilterStreamingDecorator<PersistentMaskColumnRunsFilter<TInputImage>> Superclass;
+  typedef itk::SmartPointer<Self>                                                         Pointer;
+  typedef itk::SmartPointer<const Self>                                                   ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingMaskColumnRunsFilter, PersistentFilterStreamingDecorator);
+
+  typedef typename Superclass::FilterType         RunsFilterType;
+  typedef typename RunsFilterType::ColumnRunsType ColumnRunsType;
+  typedef TInputImage                             InputImageType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Return the runs of the mask */
+  const ColumnRunsType& GetColumnRuns() const
+  {
+    return this->GetFilter()->GetColumnRuns();
+  }
+
+protected:
+  /** Constructor */
+  StreamingMaskColumnRunsFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingMaskColumnRunsFilter() override
+  {
+  }
+
+private:
+  StreamingMaskColumnRunsFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingMaskColumnRunsFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbStreamingMaskColumnRunsFilter_hxx
+#define otbStreamingMaskColumnRunsFilter_hxx
+
+#include "otbStreamingMaskColumnRunsFilter.h"
+
+#include <algorithm>
+#include "itkImageScanlineConstIterator.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+PersistentMaskColumnRunsFilter<TInputImage>::PersistentMaskColumnRunsFilter()
+{
+  this->DynamicMultiThreadingOff();
+  this->Reset();
+}
+
+template <class TInputImage>
+void PersistentMaskColumnRunsFilter<TInputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentMaskColumnRunsFilter<TInputImage>::Reset()
+{
+  m_ThreadRuns.clear();
+  m_ThreadRuns.resize(this->GetNumberOfWorkUnits());
+  m_ColumnRuns = ColumnRunsType();
+}
+
+template <class TInputImage>
+void PersistentMaskColumnRunsFilter<TInputImage>::Synthetize()
+{
+  const RegionType& largest = this->GetInput()->GetLargestPossibleRegion();
+
+  std::vector<ColumnRunType> runs;
+  for (auto& threadRuns : m_ThreadRuns)
+  {
+    runs.insert(runs.end(), threadRuns.begin(), threadRuns.end());
+    threadRuns.clear();
+  }
+  std::sort(runs.begin(), runs.end());
+
+  m_ColumnRuns.Region = largest;
+  m_ColumnRuns.Offsets.assign(largest.GetSize(0) + 1, 0);
+  m_ColumnRuns.Runs.clear();
+  m_ColumnRuns.Runs.reserve(runs.size());
+
+  // Merge the pieces of runs cut by the stream and thread regions
+  IndexValueType column = largest.GetIndex(0);
+  for (const auto& run : runs)
+  {
+    for (; column < run.first; ++column)
+    {
+      m_ColumnRuns.Offsets[column - largest.GetIndex(0) + 1] = m_ColumnRuns.Runs.size();
+    }
+    const std::size_t first = m_ColumnRuns.Offsets[column - largest.GetIndex(0)];
+    if (m_ColumnRuns.Runs.size() > first && run.second.first <= m_ColumnRuns.Runs.back().second + 1)
+    {
+      m_ColumnRuns.Runs.back().second = std::max(m_ColumnRuns.Runs.back().second, run.second.second);
+    }
+    else
+    {
+      m_ColumnRuns.Runs.push_back(run.second);
+    }
+  }
+  for (; column < largest.GetIndex(0) + static_cast<IndexValueType>(largest.GetSize(0)); ++column)
+  {
+    m_ColumnRuns.Offsets[column - largest.GetIndex(0) + 1] = m_ColumnRuns.Runs.size();
+  }
+}
+
+template <class TInputImage>
+void PersistentMaskColumnRunsFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize(1));
+
+  const IndexValueType x0    = outputRegionForThread.GetIndex(0);
+  const IndexValueType width = outputRegionForThread.GetSize(0);
+  const IndexValueType y1    = outputRegionForThread.GetIndex(1) + static_cast<IndexValueType>(outputRegionForThread.GetSize(1)) - 1;
+
+  // First row of the run currently open in each column, if any
+  const IndexValueType        noRun = itk::NumericTraits<IndexValueType>::min();
+  std::vector<IndexValueType> openRun(width, noRun);
+  std::vector<ColumnRunType>& runs = m_ThreadRuns[threadId];
+
+  itk::ImageScanlineConstIterator<TInputImage> it(this->GetInput(), outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    const IndexValueType y = it.GetIndex()[1];
+    for (IndexValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+    {
+      const bool isObject = it.Get() != itk::NumericTraits<PixelType>::ZeroValue();
+      if (isObject && openRun[i] == noRun)
+      {
+        openRun[i] = y;
+      }
+      else if (!isObject && openRun[i] != noRun)
+      {
+        runs.emplace_back(x0 + i, RunType(openRun[i], y - 1));
+        openRun[i] = noRun;
+      }
+    }
+    progress.CompletedPixel();
+  }
+
+  for (IndexValueType i = 0; i < width; ++i)
+  {
+    if (openRun[i] != noRun)
+    {
+      runs.emplace_back(x0 + i, RunType(openRun[i], y1));
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentMaskColumnRunsFilter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of runs: " << m_ColumnRuns.Runs.size() << std::endl;
+}
+
+} // end namespace otb
+#endif
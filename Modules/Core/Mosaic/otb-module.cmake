@@ -28,6 +28,7 @@ otb_module(OTBMosaic
     OTBCommon
     OTBConversion
     OTBFunctor
+    OTBStreaming
 
   TEST_DEPENDS
 
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAtmosphericRadiativeTermsLUT_h
+#define otbAtmosphericRadiativeTermsLUT_h
+
+#include "OTBOpticalCalibrationExport.h"
+#include "otbAtmosphericRadiativeTerms.h"
+#include "otbAtmosphericCorrectionParameters.h"
+#include "otbImageMetadataCorrectionParameters.h"
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class AtmosphericRadiativeTermsLUT
+ *  \brief Precomputed 6S atmospheric radiative terms, interpolated on a grid.
+ *
+ * Running 6S for each band of each processed image is expensive, while
+ * the atmospheric and geometric conditions of a sensor vary smoothly.
+ * This class stores the radiative terms computed by SIXSTraits on a
+ * regular grid of the parameters they depend on (solar and viewing
+ * zenithal angles, relative azimuth, atmospheric pressure, water vapor,
+ * ozone and aerosol optical thickness), for each spectral band and
+ * aerosol model. Lookups interpolate the grid multilinearly instead of
+ * running 6S.
+ *
+ * The grid axes are set with SetAxis() (an axis with a single node is
+ * constant), then Build() runs 6S on all the nodes for a band and an
+ * aerosol model. Bands are identified by their relative spectral
+ * response. The table can be saved to and loaded from a text file, to
+ * be built once offline (see the ComputeAtmosphericLUT application).
+ *
+ * Parameters outside of the grid are clamped to its bounds: IsInside()
+ * tells whether a lookup is an interpolation. The acquisition date is
+ * not an axis, since it does not change the radiative terms.
+ *
+ * \sa RadiometryCorrectionParametersToAtmosphericRadiativeTerms
+ *
+ * \ingroup Radiometry
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+class OTBOpticalCalibration_EXPORT AtmosphericRadiativeTermsLUT : public itk::DataObject
+{
+public:
+  /** Standard typedefs */
+  typedef AtmosphericRadiativeTermsLUT  Self;
+  typedef itk::DataObject               Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkTypeMacro(AtmosphericRadiativeTermsLUT, DataObject);
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  typedef AtmosphericCorrectionParameters::AerosolModelType AerosolModelType;
+  typedef FilterFunctionValues                              FilterFunctionValuesType;
+
+  /** Axes of the grid */
+  typedef enum {
+    SOLAR_ZENITH = 0,
+    VIEWING_ZENITH,
+    RELATIVE_AZIMUTH,
+    ATMOSPHERIC_PRESSURE,
+    WATER_VAPOR,
+    OZONE,
+    AEROSOL_OPTICAL,
+    NUMBER_OF_AXES
+  } AxisType;
+
+  /** Radiative terms stored for each node, in the order of
+   * AtmosphericRadiativeTermsSingleChannel */
+  typedef enum {
+    INTRINSIC_ATMOSPHERIC_REFLECTANCE = 0,
+    SPHERICAL_ALBEDO,
+    TOTAL_GASEOUS_TRANSMISSION,
+    DOWNWARD_TRANSMITTANCE,
+    UPWARD_TRANSMITTANCE,
+    UPWARD_DIFFUSE_TRANSMITTANCE,
+    UPWARD_DIRECT_TRANSMITTANCE,
+    UPWARD_DIFFUSE_TRANSMITTANCE_FOR_RAYLEIGH,
+    UPWARD_DIFFUSE_TRANSMITTANCE_FOR_AEROSOL,
+    NUMBER_OF_TERMS
+  } TermType;
+
+  typedef std::vector<double>                   AxisNodesType;
+  typedef std::array<double, NUMBER_OF_AXES>    PointType;
+  typedef std::array<double, NUMBER_OF_TERMS>   TermsType;
+
+  /** Set the nodes of an axis (strictly increasing). This clears the table. */
+  void SetAxis(AxisType axis, const AxisNodesType& nodes);
+  const AxisNodesType& GetAxis(AxisType axis) const
+  {
+    return m_Axes[axis];
+  }
+
+  /** Name of an axis, as used in the LUT file */
+  static const char* GetAxisName(AxisType axis);
+
+  /** Number of nodes of the grid */
+  std::size_t GetNumberOfNodes() const;
+
+  /** Run 6S on all the nodes of the grid for a band and an aerosol model.
+   * The band is not modified: 6S resamples a copy of it. */
+  void Build(const FilterFunctionValuesType* band, AerosolModelType aerosolModel);
+
+  /** Whether the table contains a band for an aerosol model */
+  bool Contains(const FilterFunctionValuesType* band, AerosolModelType aerosolModel) const;
+
+  /** Number of (band, aerosol model) tables */
+  std::size_t GetNumberOfTables() const
+  {
+    return m_Tables.size();
+  }
+
+  /** Grid point of the given acquisition and atmospheric parameters */
+  static PointType MakePoint(const AtmosphericCorrectionParameters* paramAtmo, const ImageMetadataCorrectionParameters* paramAcqui);
+
+  /** Whether a point is inside the grid (no clamping) */
+  bool IsInside(const PointType& point) const;
+
+  /** Multilinear interpolation of the radiative terms of a band */
+  TermsType Interpolate(const FilterFunctionValuesType* band, AerosolModelType aerosolModel, const PointType& point) const;
+
+  /** Radiative terms of all the bands, as computed by
+   * RadiometryCorrectionParametersToAtmosphericRadiativeTerms::Compute() */
+  AtmosphericRadiativeTerms::Pointer Compute(const AtmosphericCorrectionParameters* paramAtmo, const ImageMetadataCorrectionParameters* paramAcqui) const;
+
+  /** Save/Load the grid and the tables */
+  void Save(const std::string& filename) const;
+  void Load(const std::string& filename);
+
+protected:
+  /** Constructor */
+  AtmosphericRadiativeTermsLUT();
+  /** Destructor */
+  ~AtmosphericRadiativeTermsLUT() override
+  {
+  }
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  AtmosphericRadiativeTermsLUT(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Key of a table: aerosol model and a fingerprint of the relative spectral response */
+  static std::string MakeKey(const FilterFunctionValuesType* band, AerosolModelType aerosolModel);
+
+  std::array<AxisNodesType, NUMBER_OF_AXES> m_Axes;
+
+  /** Terms of each node (first axis varying fastest), by key */
+  std::map<std::string, std::vector<double>> m_Tables;
+};
+
+} // end namespace otb
+
+#endif
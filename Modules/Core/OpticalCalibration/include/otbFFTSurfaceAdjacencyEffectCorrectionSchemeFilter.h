@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter_h
+#define otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter_h
+
+#include "otbSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
+#include "vnl/vnl_matrix.h"
+#include <complex>
+
+namespace otb
+{
+
+/** \class FFTSurfaceAdjacencyEffectCorrectionSchemeFilter
+ *  \brief Adjacency effects correction computed in the Fourier domain.
+ *
+ * This filter computes the same correction as
+ * SurfaceAdjacencyEffectCorrectionSchemeFilter (same weights, same zero
+ * flux Neumann boundary condition), but the neighborhood contribution is
+ * computed as a convolution with the overlap-save method: the requested
+ * region is cut into blocks whose FFT size is about four times the window
+ * radius, and the blocks are processed in parallel. The cost per pixel
+ * only grows with the logarithm of the radius instead of its square,
+ * which makes large windows (several kilometers) affordable.
+ *
+ * Two bands are transformed at once, as the real and imaginary parts of a
+ * complex block. The VNL FFT is used, so block sizes only have 2, 3 and 5
+ * as prime factors. Results match the direct filter up to rounding errors.
+ *
+ * \sa SurfaceAdjacencyEffectCorrectionSchemeFilter
+ *
+ * \ingroup Radiometry
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT FFTSurfaceAdjacencyEffectCorrectionSchemeFilter : public SurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>
+{
+public:
+  /** "typedef" for standard classes. */
+  typedef FFTSurfaceAdjacencyEffectCorrectionSchemeFilter Self;
+  typedef SurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** object factory method. */
+  itkNewMacro(Self);
+
+  /** return class name. */
+  itkTypeMacro(FFTSurfaceAdjacencyEffectCorrectionSchemeFilter, SurfaceAdjacencyEffectCorrectionSchemeFilter);
+
+  typedef typename Superclass::InputImageType        InputImageType;
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::InputImageRegionType  InputImageRegionType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename Superclass::WeightingMatrixType   WeightingMatrixType;
+  typedef typename Superclass::DoubleContainerType   DoubleContainerType;
+
+  typedef std::complex<double>    ComplexType;
+  typedef vnl_matrix<ComplexType> SpectrumType;
+
+  /** Smallest size greater or equal to n with only 2, 3 and 5 as prime factors */
+  static unsigned int GetNextFFTSize(unsigned int n);
+
+protected:
+  FFTSurfaceAdjacencyEffectCorrectionSchemeFilter()
+  {
+  }
+  ~FFTSurfaceAdjacencyEffectCorrectionSchemeFilter() override
+  {
+  }
+
+  /** Process the requested region block by block */
+  void GenerateData() override;
+
+private:
+  FFTSurfaceAdjacencyEffectCorrectionSchemeFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Spectrum of the weights of a band on a block of the given size,
+   * arranged so that the circular convolution gives the weighted sum of
+   * the neighborhood. */
+  SpectrumType ComputeKernelSpectrum(const WeightingMatrixType& weights, unsigned int rows, unsigned int cols) const;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter.hxx"
+#endif
+
+#endif
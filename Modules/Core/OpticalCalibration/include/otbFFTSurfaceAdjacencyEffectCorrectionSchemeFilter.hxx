@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter_hxx
+#define otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter_hxx
+
+#include "otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
+#include "vnl/algo/vnl_fft_2d.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+unsigned int FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::GetNextFFTSize(unsigned int n)
+{
+  for (n = std::max(n, 1U);; ++n)
+  {
+    unsigned int m = n;
+    for (unsigned int factor : {2U, 3U, 5U})
+    {
+      while (m % factor == 0)
+      {
+        m /= factor;
+      }
+    }
+    if (m == 1)
+    {
+      return n;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+typename FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::SpectrumType
+FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::ComputeKernelSpectrum(const WeightingMatrixType& weights, unsigned int rows,
+                                                                                                  unsigned int cols) const
+{
+  const int radius = static_cast<int>(this->GetWindowRadius());
+
+  // The weight of the offset (dx, dy) is stored at (-dx, -dy), so that
+  // the circular convolution of a block sums pixel(x + dx, y + dy) * weight(dx, dy)
+  SpectrumType spectrum(rows, cols, ComplexType(0.));
+  for (int dy = -radius; dy <= radius; ++dy)
+  {
+    for (int dx = -radius; dx <= radius; ++dx)
+    {
+      spectrum((rows - dy) % rows, (cols - dx) % cols) = weights(dy + radius, dx + radius);
+    }
+  }
+
+  vnl_fft_2d<double> fft(rows, cols);
+  fft.fwd_transform(spectrum);
+  return spectrum;
+}
+
+template <class TInputImage, class TOutputImage>
+void FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+  this->GenerateParameters();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const unsigned int        nbBands                  = inputPtr->GetNumberOfComponentsPerPixel();
+  const int                 radius                   = static_cast<int>(this->GetWindowRadius());
+  const auto                weights                  = this->GetFunctor().GetWeightingValues();
+  const DoubleContainerType upwardTransmittanceRatio = this->GetFunctor().GetUpwardTransmittanceRatio();
+  const DoubleContainerType diffuseRatio             = this->GetFunctor().GetDiffuseRatio();
+
+  const OutputImageRegionType outputRegion   = outputPtr->GetRequestedRegion();
+  const OutputImageRegionType outputBuffer   = outputPtr->GetBufferedRegion();
+  const InputImageRegionType  bufferedRegion = inputPtr->GetBufferedRegion();
+
+  // The overlap-save method computes a block of N pixels from N + 2 * radius
+  // input pixels: blocks of about 4 * radius keep the overhead bounded.
+  const unsigned int defaultBlockSize = GetNextFFTSize(std::max(4 * radius, 2 * radius + 64));
+  unsigned int       blockSize[2];
+  unsigned int       tileSize[2];
+  unsigned int       nbTiles[2];
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    const unsigned int regionSize = outputRegion.GetSize(dim);
+    blockSize[dim]                = GetNextFFTSize(std::min(regionSize, defaultBlockSize - 2 * radius) + 2 * radius);
+    tileSize[dim]                 = blockSize[dim] - 2 * radius;
+    nbTiles[dim]                  = (regionSize + tileSize[dim] - 1) / tileSize[dim];
+  }
+  const unsigned int rows = blockSize[1];
+  const unsigned int cols = blockSize[0];
+
+  // Two bands a and b are transformed at once as z = a + i b. With
+  // Z' (k) = conj(Z(-k)), the spectrum of (a * Ka) + i (b * Kb) is
+  // (Ka + Kb) / 2 Z + (Ka - Kb) / 2 Z'. A single last band has Kb = Ka.
+  std::vector<SpectrumType> sumSpectra;
+  std::vector<SpectrumType> diffSpectra;
+  for (unsigned int band = 0; band < nbBands; band += 2)
+  {
+    const SpectrumType first  = ComputeKernelSpectrum(weights[band], rows, cols);
+    const SpectrumType second = band + 1 < nbBands ? ComputeKernelSpectrum(weights[band + 1], rows, cols) : first;
+    SpectrumType       sum(rows, cols);
+    SpectrumType       diff(rows, cols);
+    for (unsigned int i = 0; i < rows; ++i)
+    {
+      for (unsigned int j = 0; j < cols; ++j)
+      {
+        sum(i, j)  = 0.5 * (first(i, j) + second(i, j));
+        diff(i, j) = 0.5 * (first(i, j) - second(i, j));
+      }
+    }
+    sumSpectra.push_back(sum);
+    diffSpectra.push_back(diff);
+  }
+
+  const double normalization = 1. / (static_cast<double>(rows) * static_cast<double>(cols));
+
+  const typename InputImageType::InternalPixelType* inputBuffer  = inputPtr->GetBufferPointer();
+  typename OutputImageType::InternalPixelType*      outputValues = outputPtr->GetBufferPointer();
+
+  auto processTile = [&](itk::SizeValueType tile) {
+    const itk::IndexValueType tileX = outputRegion.GetIndex(0) + (tile % nbTiles[0]) * tileSize[0];
+    const itk::IndexValueType tileY = outputRegion.GetIndex(1) + (tile / nbTiles[0]) * tileSize[1];
+    const itk::IndexValueType width =
+        std::min<itk::IndexValueType>(tileSize[0], outputRegion.GetIndex(0) + outputRegion.GetSize(0) - tileX);
+    const itk::IndexValueType height =
+        std::min<itk::IndexValueType>(tileSize[1], outputRegion.GetIndex(1) + outputRegion.GetSize(1) - tileY);
+
+    // Offsets of the block columns and lines in the input buffer, clamped
+    // to its bounds (zero flux Neumann boundary condition)
+    std::vector<itk::OffsetValueType> columnOffsets(cols);
+    std::vector<itk::OffsetValueType> lineOffsets(rows);
+    for (unsigned int j = 0; j < cols; ++j)
+    {
+      const itk::IndexValueType x = std::min<itk::IndexValueType>(std::max<itk::IndexValueType>(tileX - radius + j, bufferedRegion.GetIndex(0)),
+                                                                  bufferedRegion.GetIndex(0) + bufferedRegion.GetSize(0) - 1);
+      columnOffsets[j] = (x - bufferedRegion.GetIndex(0)) * nbBands;
+    }
+    for (unsigned int i = 0; i < rows; ++i)
+    {
+      const itk::IndexValueType y = std::min<itk::IndexValueType>(std::max<itk::IndexValueType>(tileY - radius + i, bufferedRegion.GetIndex(1)),
+                                                                  bufferedRegion.GetIndex(1) + bufferedRegion.GetSize(1) - 1);
+      lineOffsets[i] = (y - bufferedRegion.GetIndex(1)) * bufferedRegion.GetSize(0) * nbBands;
+    }
+
+    vnl_fft_2d<double> fft(rows, cols);
+    SpectrumType       block(rows, cols);
+    SpectrumType       product(rows, cols);
+
+    for (unsigned int band = 0; band < nbBands; band += 2)
+    {
+      const bool hasPair = band + 1 < nbBands;
+      for (unsigned int i = 0; i < rows; ++i)
+      {
+        for (unsigned int j = 0; j < cols; ++j)
+        {
+          const auto* pixel = inputBuffer + lineOffsets[i] + columnOffsets[j] + band;
+          block(i, j)       = ComplexType(static_cast<double>(pixel[0]), hasPair ? static_cast<double>(pixel[1]) : 0.);
+        }
+      }
+      fft.fwd_transform(block);
+
+      const SpectrumType& sum  = sumSpectra[band / 2];
+      const SpectrumType& diff = diffSpectra[band / 2];
+      for (unsigned int i = 0; i < rows; ++i)
+      {
+        for (unsigned int j = 0; j < cols; ++j)
+        {
+          product(i, j) = sum(i, j) * block(i, j) + diff(i, j) * std::conj(block((rows - i) % rows, (cols - j) % cols));
+        }
+      }
+      fft.bwd_transform(product);
+
+      // The first and last radius lines and columns of the block are wrapped around
+      for (itk::IndexValueType i = 0; i < height; ++i)
+      {
+        for (itk::IndexValueType j = 0; j < width; ++j)
+        {
+          const ComplexType contribution = product(i + radius, j + radius) * normalization;
+          const auto*       center       = inputBuffer + lineOffsets[i + radius] + columnOffsets[j + radius] + band;
+          auto*             outPixel     = outputValues +
+                               ((tileY + i - outputBuffer.GetIndex(1)) * outputBuffer.GetSize(0) + tileX + j - outputBuffer.GetIndex(0)) * nbBands + band;
+          outPixel[0] = static_cast<double>(center[0]) * upwardTransmittanceRatio[band] + contribution.real() * diffuseRatio[band];
+          if (hasPair)
+          {
+            outPixel[1] = static_cast<double>(center[1]) * upwardTransmittanceRatio[band + 1] + contribution.imag() * diffuseRatio[band + 1];
+          }
+        }
+      }
+    }
+  };
+
+  this->GetMultiThreader()->ParallelizeArray(0, nbTiles[0] * nbTiles[1], processTile, this);
+}
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 #include "otbUnaryImageFunctorWithVectorImageFilter.h"
 
 #include "otbRadiometryCorrectionParametersToAtmosphericRadiativeTerms.h"
+#include "otbAtmosphericRadiativeTermsLUT.h"
 #include "otbAtmosphericCorrectionParameters.h"
 
 #include "otbMacro.h"
@@ -180,6 +181,8 @@ public:
   typedef otb::AtmosphericRadiativeTerms                  AtmosphericRadiativeTermsType;
   typedef typename AtmosphericRadiativeTermsType::Pointer AtmosphericRadiativeTermsPointerType;
 
+  typedef otb::AtmosphericRadiativeTermsLUT AtmosphericRadiativeTermsLUTType;
+
 
   typedef otb::FilterFunctionValues                            FilterFunctionValuesType;
   typedef FilterFunctionValuesType::WavelengthSpectralBandType ValueType;        // float
@@ -221,6 +224,11 @@ public:
   itkGetObjectMacro(AcquiCorrectionParameters, AcquiCorrectionParametersType);
 
 
+  /** Get/Set a precomputed table of radiative terms. When set, the
+   * radiative terms are interpolated in this table instead of running 6S. */
+  itkSetObjectMacro(AtmosphericRadiativeTermsLUT, AtmosphericRadiativeTermsLUTType);
+  itkGetConstObjectMacro(AtmosphericRadiativeTermsLUT, AtmosphericRadiativeTermsLUTType);
+
   /** Compute radiative terms if necessary and then update functors attributes. */
   void GenerateParameters();
 
@@ -269,6 +277,8 @@ private:
   AtmosphericRadiativeTermsPointerType m_AtmosphericRadiativeTerms;
   AtmoCorrectionParametersPointerType  m_AtmoCorrectionParameters;
   AcquiCorrectionParametersPointerType m_AcquiCorrectionParameters;
+
+  AtmosphericRadiativeTermsLUTType::Pointer m_AtmosphericRadiativeTermsLUT;
 };
 
 } // end namespace otb
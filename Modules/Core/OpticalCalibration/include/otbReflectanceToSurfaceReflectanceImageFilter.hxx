@@ -154,7 +154,14 @@ void ReflectanceToSurfaceReflectanceImageFilter<TInputImage, TOutputImage>::Upda
   }
 
 
-  m_AtmosphericRadiativeTerms = CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters);
+  if (m_AtmosphericRadiativeTermsLUT.IsNotNull())
+  {
+    m_AtmosphericRadiativeTerms = m_AtmosphericRadiativeTermsLUT->Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters);
+  }
+  else
+  {
+    m_AtmosphericRadiativeTerms = CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters);
+  }
 }
 
 template <class TInputImage, class TOutputImage>
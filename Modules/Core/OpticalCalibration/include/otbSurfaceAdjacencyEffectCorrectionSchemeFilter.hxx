@@ -177,6 +177,9 @@ void SurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::Up
     }
   }
 
+  // Parameters are computed again when the filter is modified
+  m_WeightingValues.clear();
+
   for (unsigned int band = 0; band < inputPtr->GetNumberOfComponentsPerPixel(); ++band)
   {
     double rayleigh = m_AtmosphericRadiativeTerms->GetUpwardDiffuseTransmittanceForRayleigh(band);
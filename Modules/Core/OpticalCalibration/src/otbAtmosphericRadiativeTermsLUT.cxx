@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbAtmosphericRadiativeTermsLUT.h"
+#include "otbSIXSTraits.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace otb
+{
+
+namespace
+{
+const char* const LUTFileMagic = "OTB_ATMOSPHERIC_LUT";
+const int         LUTFileVersion = 1;
+}
+
+AtmosphericRadiativeTermsLUT::AtmosphericRadiativeTermsLUT()
+{
+  for (auto& axis : m_Axes)
+  {
+    axis.assign(1, 0.);
+  }
+}
+
+const char* AtmosphericRadiativeTermsLUT::GetAxisName(AxisType axis)
+{
+  static const char* const names[NUMBER_OF_AXES] = {"solarzenith", "viewingzenith", "relativeazimuth", "pressure", "watervapor", "ozone", "aot"};
+  return names[axis];
+}
+
+void AtmosphericRadiativeTermsLUT::SetAxis(AxisType axis, const AxisNodesType& nodes)
+{
+  if (nodes.empty())
+  {
+    itkExceptionMacro(<< "Axis " << GetAxisName(axis) << " has no node");
+  }
+  for (std::size_t i = 1; i < nodes.size(); ++i)
+  {
+    if (!(nodes[i] > nodes[i - 1]))
+    {
+      itkExceptionMacro(<< "Nodes of axis " << GetAxisName(axis) << " must be strictly increasing");
+    }
+  }
+  m_Axes[axis] = nodes;
+  m_Tables.clear();
+  this->Modified();
+}
+
+std::size_t AtmosphericRadiativeTermsLUT::GetNumberOfNodes() const
+{
+  std::size_t nbNodes = 1;
+  for (const auto& axis : m_Axes)
+  {
+    nbNodes *= axis.size();
+  }
+  return nbNodes;
+}
+
+std::string AtmosphericRadiativeTermsLUT::MakeKey(const FilterFunctionValuesType* band, AerosolModelType aerosolModel)
+{
+  // FNV-1a of the response values
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (float value : band->GetFilterFunctionValues())
+  {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (std::size_t i = 0; i < sizeof(float); ++i)
+    {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+  }
+
+  std::ostringstream oss;
+  oss << static_cast<int>(aerosolModel) << ':' << std::setprecision(std::numeric_limits<float>::max_digits10) << band->GetMinSpectralValue() << ':'
+      << band->GetMaxSpectralValue() << ':' << band->GetUserStep() << ':' << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+void AtmosphericRadiativeTermsLUT::Build(const FilterFunctionValuesType* band, AerosolModelType aerosolModel)
+{
+  // The table is found from the band given by the caller, while 6S
+  // resamples the band in place when its step is not the 6S one
+  const std::string key = MakeKey(band, aerosolModel);
+
+  FilterFunctionValuesType::Pointer resampledBand = FilterFunctionValuesType::New();
+  resampledBand->SetMinSpectralValue(band->GetMinSpectralValue());
+  resampledBand->SetMaxSpectralValue(band->GetMaxSpectralValue());
+  resampledBand->SetUserStep(band->GetUserStep());
+  resampledBand->SetFilterFunctionValues(band->GetFilterFunctionValues());
+
+  const std::size_t   nbNodes = GetNumberOfNodes();
+  std::vector<double> table(nbNodes * NUMBER_OF_TERMS);
+
+  // 6S is not reentrant: nodes are computed one after the other
+  std::array<std::size_t, NUMBER_OF_AXES> position;
+  position.fill(0);
+  for (std::size_t node = 0; node < nbNodes; ++node)
+  {
+    double* terms = &table[node * NUMBER_OF_TERMS];
+    SIXSTraits::ComputeAtmosphericParameters(m_Axes[SOLAR_ZENITH][position[SOLAR_ZENITH]], 0., m_Axes[VIEWING_ZENITH][position[VIEWING_ZENITH]],
+                                             m_Axes[RELATIVE_AZIMUTH][position[RELATIVE_AZIMUTH]], 1, 1,
+                                             m_Axes[ATMOSPHERIC_PRESSURE][position[ATMOSPHERIC_PRESSURE]], m_Axes[WATER_VAPOR][position[WATER_VAPOR]],
+                                             m_Axes[OZONE][position[OZONE]], aerosolModel, m_Axes[AEROSOL_OPTICAL][position[AEROSOL_OPTICAL]], resampledBand.GetPointer(),
+                                             terms[INTRINSIC_ATMOSPHERIC_REFLECTANCE], terms[SPHERICAL_ALBEDO], terms[TOTAL_GASEOUS_TRANSMISSION],
+                                             terms[DOWNWARD_TRANSMITTANCE], terms[UPWARD_TRANSMITTANCE], terms[UPWARD_DIFFUSE_TRANSMITTANCE],
+                                             terms[UPWARD_DIRECT_TRANSMITTANCE], terms[UPWARD_DIFFUSE_TRANSMITTANCE_FOR_RAYLEIGH],
+                                             terms[UPWARD_DIFFUSE_TRANSMITTANCE_FOR_AEROSOL]);
+
+    // Next node, first axis varying fastest
+    for (unsigned int axis = 0; axis < NUMBER_OF_AXES && ++position[axis] == m_Axes[axis].size(); ++axis)
+    {
+      position[axis] = 0;
+    }
+  }
+
+  m_Tables[key] = std::move(table);
+  this->Modified();
+}
+
+bool AtmosphericRadiativeTermsLUT::Contains(const FilterFunctionValuesType* band, AerosolModelType aerosolModel) const
+{
+  return m_Tables.count(MakeKey(band, aerosolModel)) > 0;
+}
+
+AtmosphericRadiativeTermsLUT::PointType AtmosphericRadiativeTermsLUT::MakePoint(const AtmosphericCorrectionParameters*   paramAtmo,
+                                                                                const ImageMetadataCorrectionParameters* paramAcqui)
+{
+  // 6S only depends on the azimuths through their difference, modulo 360
+  double relativeAzimuth = std::fmod(std::abs(paramAcqui->GetViewingAzimutalAngle() - paramAcqui->GetSolarAzimutalAngle()), 360.);
+  if (relativeAzimuth > 180.)
+  {
+    relativeAzimuth = 360. - relativeAzimuth;
+  }
+
+  PointType point;
+  point[SOLAR_ZENITH]         = paramAcqui->GetSolarZenithalAngle();
+  point[VIEWING_ZENITH]       = paramAcqui->GetViewingZenithalAngle();
+  point[RELATIVE_AZIMUTH]     = relativeAzimuth;
+  point[ATMOSPHERIC_PRESSURE] = paramAtmo->GetAtmosphericPressure();
+  point[WATER_VAPOR]          = paramAtmo->GetWaterVaporAmount();
+  point[OZONE]                = paramAtmo->GetOzoneAmount();
+  point[AEROSOL_OPTICAL]      = paramAtmo->GetAerosolOptical();
+  return point;
+}
+
+bool AtmosphericRadiativeTermsLUT::IsInside(const PointType& point) const
+{
+  for (unsigned int axis = 0; axis < NUMBER_OF_AXES; ++axis)
+  {
+    if (point[axis] < m_Axes[axis].front() || point[axis] > m_Axes[axis].back())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+AtmosphericRadiativeTermsLUT::TermsType AtmosphericRadiativeTermsLUT::Interpolate(const FilterFunctionValuesType* band, AerosolModelType aerosolModel,
+                                                                                  const PointType& point) const
+{
+  const auto table = m_Tables.find(MakeKey(band, aerosolModel));
+  if (table == m_Tables.end())
+  {
+    itkExceptionMacro(<< "The atmospheric LUT has no table for the relative spectral response from " << band->GetMinSpectralValue() << " to "
+                      << band->GetMaxSpectralValue() << " and the aerosol model " << static_cast<int>(aerosolModel));
+  }
+
+  // Lower node and weight of the upper node along each axis
+  std::array<std::size_t, NUMBER_OF_AXES> lower, stride;
+  std::array<double, NUMBER_OF_AXES>      weight;
+  std::size_t                             currentStride = 1;
+  for (unsigned int axis = 0; axis < NUMBER_OF_AXES; ++axis)
+  {
+    const AxisNodesType& nodes = m_Axes[axis];
+    stride[axis]               = currentStride;
+    currentStride *= nodes.size();
+
+    if (nodes.size() == 1 || point[axis] <= nodes.front())
+    {
+      lower[axis]  = 0;
+      weight[axis] = 0.;
+    }
+    else if (point[axis] >= nodes.back())
+    {
+      lower[axis]  = nodes.size() - 2;
+      weight[axis] = 1.;
+    }
+    else
+    {
+      lower[axis]  = std::upper_bound(nodes.begin(), nodes.end(), point[axis]) - nodes.begin() - 1;
+      weight[axis] = (point[axis] - nodes[lower[axis]]) / (nodes[lower[axis] + 1] - nodes[lower[axis]]);
+    }
+  }
+
+  // Sum over the corners of the enclosing cell, skipping the null weights
+  TermsType terms;
+  terms.fill(0.);
+  for (unsigned int corner = 0; corner < (1u << NUMBER_OF_AXES); ++corner)
+  {
+    double      cornerWeight = 1.;
+    std::size_t node         = 0;
+    for (unsigned int axis = 0; axis < NUMBER_OF_AXES && cornerWeight != 0.; ++axis)
+    {
+      const bool upper = (corner >> axis) & 1u;
+      cornerWeight *= upper ? weight[axis] : 1. - weight[axis];
+      node += (lower[axis] + (upper ? 1 : 0)) * stride[axis];
+    }
+    if (cornerWeight == 0.)
+    {
+      continue;
+    }
+    const double* values = &table->second[node * NUMBER_OF_TERMS];
+    for (unsigned int term = 0; term < NUMBER_OF_TERMS; ++term)
+    {
+      terms[term] += cornerWeight * values[term];
+    }
+  }
+  return terms;
+}
+
+AtmosphericRadiativeTerms::Pointer AtmosphericRadiativeTermsLUT::Compute(const AtmosphericCorrectionParameters*   paramAtmo,
+                                                                         const ImageMetadataCorrectionParameters* paramAcqui) const
+{
+  AtmosphericRadiativeTerms::Pointer radTermsOut = AtmosphericRadiativeTerms::New();
+
+  const auto         bands  = paramAcqui->GetWavelengthSpectralBand();
+  const unsigned int NbBand = bands->Size();
+  radTermsOut->ValuesInitialization(NbBand);
+
+  const PointType point = MakePoint(paramAtmo, paramAcqui);
+  for (unsigned int i = 0; i < NbBand; ++i)
+  {
+    FilterFunctionValuesType* band  = bands->GetNthElement(i);
+    const TermsType           terms = Interpolate(band, paramAtmo->GetAerosolModel(), point);
+
+    radTermsOut->SetIntrinsicAtmosphericReflectance(i, terms[INTRINSIC_ATMOSPHERIC_REFLECTANCE]);
+    radTermsOut->SetSphericalAlbedo(i, terms[SPHERICAL_ALBEDO]);
+    radTermsOut->SetTotalGaseousTransmission(i, terms[TOTAL_GASEOUS_TRANSMISSION]);
+    radTermsOut->SetDownwardTransmittance(i, terms[DOWNWARD_TRANSMITTANCE]);
+    radTermsOut->SetUpwardTransmittance(i, terms[UPWARD_TRANSMITTANCE]);
+    radTermsOut->SetUpwardDiffuseTransmittance(i, terms[UPWARD_DIFFUSE_TRANSMITTANCE]);
+    radTermsOut->SetUpwardDirectTransmittance(i, terms[UPWARD_DIRECT_TRANSMITTANCE]);
+    radTermsOut->SetUpwardDiffuseTransmittanceForRayleigh(i, terms[UPWARD_DIFFUSE_TRANSMITTANCE_FOR_RAYLEIGH]);
+    radTermsOut->SetUpwardDiffuseTransmittanceForAerosol(i, terms[UPWARD_DIFFUSE_TRANSMITTANCE_FOR_AEROSOL]);
+    radTermsOut->SetWavelengthSpectralBand(i, band->GetCenterSpectralValue());
+  }
+
+  return radTermsOut;
+}
+
+void AtmosphericRadiativeTermsLUT::Save(const std::string& filename) const
+{
+  std::ofstream fout(filename.c_str());
+  if (!fout)
+  {
+    itkExceptionMacro(<< "Unable to write the atmospheric LUT file " << filename);
+  }
+  fout << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+  fout << LUTFileMagic << ' ' << LUTFileVersion << '\n';
+  for (unsigned int axis = 0; axis < NUMBER_OF_AXES; ++axis)
+  {
+    fout << "axis " << GetAxisName(static_cast<AxisType>(axis)) << ' ' << m_Axes[axis].size();
+    for (double node : m_Axes[axis])
+    {
+      fout << ' ' << node;
+    }
+    fout << '\n';
+  }
+  for (const auto& table : m_Tables)
+  {
+    fout << "table " << table.first << '\n';
+    for (std::size_t i = 0; i < table.second.size(); ++i)
+    {
+      fout << table.second[i] << ((i + 1) % NUMBER_OF_TERMS == 0 ? '\n' : ' ');
+    }
+  }
+
+  if (!fout)
+  {
+    itkExceptionMacro(<< "Error while writing the atmospheric LUT file " << filename);
+  }
+}
+
+void AtmosphericRadiativeTermsLUT::Load(const std::string& filename)
+{
+  std::ifstream fin(filename.c_str());
+  if (!fin)
+  {
+    itkExceptionMacro(<< "Unable to open the atmospheric LUT file " << filename);
+  }
+
+  std::string magic;
+  int         version = 0;
+  fin >> magic >> version;
+  if (magic != LUTFileMagic || version != LUTFileVersion)
+  {
+    itkExceptionMacro(<< filename << " is not an atmospheric LUT file (version " << LUTFileVersion << ")");
+  }
+
+  std::array<AxisNodesType, NUMBER_OF_AXES> axes;
+  for (unsigned int axis = 0; axis < NUMBER_OF_AXES; ++axis)
+  {
+    std::string keyword, name;
+    std::size_t nbNodes = 0;
+    fin >> keyword >> name >> nbNodes;
+    if (!fin || keyword != "axis" || name != GetAxisName(static_cast<AxisType>(axis)) || nbNodes == 0)
+    {
+      itkExceptionMacro(<< "Missing axis " << GetAxisName(static_cast<AxisType>(axis)) << " in the atmospheric LUT file " << filename);
+    }
+    axes[axis].resize(nbNodes);
+    for (double& node : axes[axis])
+    {
+      fin >> node;
+    }
+  }
+
+  m_Axes = axes;
+  m_Tables.clear();
+  const std::size_t nbValues = GetNumberOfNodes() * NUMBER_OF_TERMS;
+
+  std::string keyword, key;
+  while (fin >> keyword >> key)
+  {
+    if (keyword != "table")
+    {
+      itkExceptionMacro(<< "Unexpected keyword " << keyword << " in the atmospheric LUT file " << filename);
+    }
+    std::vector<double>& table = m_Tables[key];
+    table.resize(nbValues);
+    for (double& value : table)
+    {
+      fin >> value;
+    }
+    if (!fin)
+    {
+      itkExceptionMacro(<< "Truncated table " << key << " in the atmospheric LUT file " << filename);
+    }
+  }
+  this->Modified();
+}
+
+void AtmosphericRadiativeTermsLUT::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  for (unsigned int axis = 0; axis < NUMBER_OF_AXES; ++axis)
+  {
+    os << indent << "Axis " << GetAxisName(static_cast<AxisType>(axis)) << ": [" << m_Axes[axis].front() << ", " << m_Axes[axis].back() << "], "
+       << m_Axes[axis].size() << " nodes" << std::endl;
+  }
+  os << indent << "Number of tables: " << m_Tables.size() << std::endl;
+}
+
+} // end namespace otb
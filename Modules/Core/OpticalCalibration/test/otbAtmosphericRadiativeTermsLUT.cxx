@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMacro.h"
+#include "otbAtmosphericRadiativeTermsLUT.h"
+#include "otbSIXSTraits.h"
+#include <cmath>
+#include <iostream>
+
+typedef otb::AtmosphericRadiativeTermsLUT    LUTType;
+typedef otb::AtmosphericCorrectionParameters AtmoParametersType;
+typedef otb::FilterFunctionValues            FilterFunctionValuesType;
+
+namespace
+{
+// Radiative terms computed by 6S at a point of the grid
+LUTType::TermsType RunSIXS(const LUTType::PointType& point, AtmoParametersType::AerosolModelType aerosolModel, FilterFunctionValuesType* band)
+{
+  LUTType::TermsType terms;
+  otb::SIXSTraits::ComputeAtmosphericParameters(
+      point[LUTType::SOLAR_ZENITH], 0., point[LUTType::VIEWING_ZENITH], point[LUTType::RELATIVE_AZIMUTH], 6, 15, point[LUTType::ATMOSPHERIC_PRESSURE],
+      point[LUTType::WATER_VAPOR], point[LUTType::OZONE], aerosolModel, point[LUTType::AEROSOL_OPTICAL], band, terms[0], terms[1], terms[2], terms[3], terms[4],
+      terms[5], terms[6], terms[7], terms[8]);
+  return terms;
+}
+}
+
+int otbAtmosphericRadiativeTermsLUT(int itkNotUsed(argc), char* argv[])
+{
+  const char* lutFileName = argv[1];
+
+  // Flat response between 0.5 and 0.6 µm
+  FilterFunctionValuesType::Pointer band = FilterFunctionValuesType::New();
+  band->SetFilterFunctionValues(FilterFunctionValuesType::ValuesVectorType(41, 1.f));
+  band->SetMinSpectralValue(0.5);
+  band->SetMaxSpectralValue(0.6);
+  band->SetUserStep(0.0025);
+
+  const AtmoParametersType::AerosolModelType aerosolModel = AtmoParametersType::CONTINENTAL;
+
+  LUTType::Pointer lut = LUTType::New();
+  lut->SetAxis(LUTType::SOLAR_ZENITH, {20., 40.});
+  lut->SetAxis(LUTType::VIEWING_ZENITH, {0., 10.});
+  lut->SetAxis(LUTType::RELATIVE_AZIMUTH, {0., 180.});
+  lut->SetAxis(LUTType::ATMOSPHERIC_PRESSURE, {1013.});
+  lut->SetAxis(LUTType::WATER_VAPOR, {1., 3.});
+  lut->SetAxis(LUTType::OZONE, {0.3});
+  lut->SetAxis(LUTType::AEROSOL_OPTICAL, {0.1, 0.3});
+  lut->Build(band, aerosolModel);
+
+  otbControlConditionTestMacro(!lut->Contains(band, aerosolModel), "Missing table");
+  otbControlConditionTestMacro(lut->Contains(band, AtmoParametersType::MARITIME), "Unexpected table");
+
+  // On a node, the LUT gives the 6S terms
+  const LUTType::PointType node = {40., 10., 180., 1013., 1., 0.3, 0.3};
+  const LUTType::TermsType atNode = lut->Interpolate(band, aerosolModel, node);
+  const LUTType::TermsType sixsAtNode = RunSIXS(node, aerosolModel, band);
+  for (unsigned int term = 0; term < LUTType::NUMBER_OF_TERMS; ++term)
+  {
+    otbControlConditionTestMacro(std::abs(atNode[term] - sixsAtNode[term]) > 1e-12, "Wrong term " << term << " on a node");
+  }
+
+  // Between the nodes, the interpolation is close to 6S
+  const LUTType::PointType middle = {30., 5., 90., 1013., 2., 0.3, 0.2};
+  otbControlConditionTestMacro(!lut->IsInside(middle), "Point should be inside the grid");
+  const LUTType::TermsType interpolated = lut->Interpolate(band, aerosolModel, middle);
+  const LUTType::TermsType sixs         = RunSIXS(middle, aerosolModel, band);
+  for (unsigned int term = 0; term < LUTType::NUMBER_OF_TERMS; ++term)
+  {
+    std::cout << "Term " << term << ": 6S " << sixs[term] << ", LUT " << interpolated[term] << std::endl;
+    otbControlConditionTestMacro(std::abs(interpolated[term] - sixs[term]) > 0.01, "Interpolation of term " << term << " is too far from 6S");
+  }
+
+  // Outside of the grid, parameters are clamped
+  LUTType::PointType outside = node;
+  outside[LUTType::AEROSOL_OPTICAL] = 0.9;
+  otbControlConditionTestMacro(lut->IsInside(outside), "Point should be outside of the grid");
+  otbControlConditionTestMacro(lut->Interpolate(band, aerosolModel, outside) != atNode, "Wrong clamping");
+
+  // Save and load
+  lut->Save(lutFileName);
+  LUTType::Pointer loaded = LUTType::New();
+  loaded->Load(lutFileName);
+  otbControlConditionTestMacro(loaded->GetNumberOfNodes() != lut->GetNumberOfNodes() || loaded->GetNumberOfTables() != 1, "Wrong loaded LUT");
+  otbControlConditionTestMacro(loaded->Interpolate(band, aerosolModel, middle) != interpolated, "Loaded LUT differs");
+
+  // Radiative terms from the correction parameters
+  AtmoParametersType::Pointer paramAtmo = AtmoParametersType::New();
+  paramAtmo->SetAerosolModel(aerosolModel);
+  paramAtmo->SetAtmosphericPressure(1013.);
+  paramAtmo->SetWaterVaporAmount(2.);
+  paramAtmo->SetOzoneAmount(0.3);
+  paramAtmo->SetAerosolOptical(0.2);
+
+  otb::ImageMetadataCorrectionParameters::Pointer paramAcqui = otb::ImageMetadataCorrectionParameters::New();
+  paramAcqui->SetSolarZenithalAngle(30.);
+  paramAcqui->SetSolarAzimutalAngle(300.);
+  paramAcqui->SetViewingZenithalAngle(5.);
+  paramAcqui->SetViewingAzimutalAngle(30.);
+  paramAcqui->GetWavelengthSpectralBand()->PushBack(band);
+
+  otb::AtmosphericRadiativeTerms::Pointer radTerms = loaded->Compute(paramAtmo, paramAcqui);
+  otbControlConditionTestMacro(radTerms->GetValues().size() != 1, "Wrong number of bands");
+  otbControlConditionTestMacro(radTerms->GetIntrinsicAtmosphericReflectance(0) != interpolated[LUTType::INTRINSIC_ATMOSPHERIC_REFLECTANCE] ||
+                                   radTerms->GetSphericalAlbedo(0) != interpolated[LUTType::SPHERICAL_ALBEDO] ||
+                                   radTerms->GetUpwardDiffuseTransmittanceForAerosol(0) != interpolated[LUTType::UPWARD_DIFFUSE_TRANSMITTANCE_FOR_AEROSOL],
+                               "Wrong radiative terms");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbVectorImage.h"
+#include "otbSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
+#include "otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "otbMacro.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+typedef otb::VectorImage<double, 2> ImageType;
+typedef otb::SurfaceAdjacencyEffectCorrectionSchemeFilter<ImageType, ImageType>    DirectFilterType;
+typedef otb::FFTSurfaceAdjacencyEffectCorrectionSchemeFilter<ImageType, ImageType> FFTFilterType;
+
+namespace
+{
+template <class TFilter>
+typename TFilter::Pointer MakeFilter(ImageType* image, otb::AtmosphericRadiativeTerms* terms, unsigned int radius)
+{
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetAtmosphericRadiativeTerms(terms);
+  filter->SetWindowRadius(radius);
+  filter->SetPixelSpacingInKilometers(0.02);
+  filter->SetZenithalViewingAngle(10.);
+  return filter;
+}
+
+double MaximumDifference(ImageType* first, ImageType* second, const ImageType::RegionType& region)
+{
+  double                                   maxDiff = 0.;
+  itk::ImageRegionConstIterator<ImageType> firstIt(first, region);
+  itk::ImageRegionConstIterator<ImageType> secondIt(second, region);
+  for (firstIt.GoToBegin(), secondIt.GoToBegin(); !firstIt.IsAtEnd(); ++firstIt, ++secondIt)
+  {
+    for (unsigned int band = 0; band < first->GetNumberOfComponentsPerPixel(); ++band)
+    {
+      maxDiff = std::max(maxDiff, std::abs(firstIt.Get()[band] - secondIt.Get()[band]));
+    }
+  }
+  return maxDiff;
+}
+}
+
+int otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Random reflectances on 3 bands: one pair and a single band
+  const unsigned int nbBands = 3;
+  ImageType::Pointer image   = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 160;
+  size[1] = 130;
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  auto random = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  random->SetSeed(42);
+  itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PixelType pixel(nbBands);
+    for (unsigned int band = 0; band < nbBands; ++band)
+    {
+      pixel[band] = random->GetUniformVariate(0., 0.6);
+    }
+    it.Set(pixel);
+  }
+
+  otb::AtmosphericRadiativeTerms::Pointer terms = otb::AtmosphericRadiativeTerms::New();
+  terms->ValuesInitialization(nbBands);
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    terms->SetUpwardTransmittance(band, 0.9 - 0.05 * band);
+    terms->SetUpwardDirectTransmittance(band, 0.8 - 0.05 * band);
+    terms->SetUpwardDiffuseTransmittance(band, 0.1);
+    terms->SetUpwardDiffuseTransmittanceForRayleigh(band, 0.05 + 0.01 * band);
+    terms->SetUpwardDiffuseTransmittanceForAerosol(band, 0.05 - 0.01 * band);
+  }
+
+  // Several blocks on each axis, and borders handled as the direct filter
+  for (unsigned int radius : {0U, 3U, 12U})
+  {
+    DirectFilterType::Pointer direct = MakeFilter<DirectFilterType>(image, terms, radius);
+    direct->Update();
+    FFTFilterType::Pointer fft = MakeFilter<FFTFilterType>(image, terms, radius);
+    fft->Update();
+
+    const double maxDiff = MaximumDifference(direct->GetOutput(), fft->GetOutput(), image->GetLargestPossibleRegion());
+    std::cout << "Radius " << radius << ": maximum difference " << maxDiff << std::endl;
+    otbControlConditionTestMacro(maxDiff > 1e-9, "FFT correction differs from the direct correction with radius " << radius);
+  }
+
+  // Streamed sub-region
+  DirectFilterType::Pointer direct = MakeFilter<DirectFilterType>(image, terms, 5);
+  direct->Update();
+  FFTFilterType::Pointer    fft    = MakeFilter<FFTFilterType>(image, terms, 5);
+  ImageType::RegionType subRegion;
+  subRegion.SetIndex(0, 17);
+  subRegion.SetIndex(1, 101);
+  subRegion.SetSize(0, 140);
+  subRegion.SetSize(1, 29);
+  fft->GetOutput()->SetRequestedRegion(subRegion);
+  fft->Update();
+  const double maxDiff = MaximumDifference(direct->GetOutput(), fft->GetOutput(), subRegion);
+  std::cout << "Sub-region: maximum difference " << maxDiff << std::endl;
+  otbControlConditionTestMacro(maxDiff > 1e-9, "FFT correction of a sub-region differs from the direct correction");
+
+  return EXIT_SUCCESS;
+}
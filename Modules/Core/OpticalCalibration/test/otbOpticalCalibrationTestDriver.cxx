@@ -43,7 +43,9 @@ void RegisterTests()
   REGISTER_TEST(otbAtmosphericCorrectionSequencementTest);
   REGISTER_TEST(otbSIXSTraitsTest);
   REGISTER_TEST(otbSIXSTraitsComputeAtmosphericParametersTest);
+  REGISTER_TEST(otbAtmosphericRadiativeTermsLUT);
   REGISTER_TEST(otbSurfaceAdjacencyEffectCorrectionSchemeFilter);
+  REGISTER_TEST(otbFFTSurfaceAdjacencyEffectCorrectionSchemeFilter);
   REGISTER_TEST(otbRadianceToImageImageFilter);
   REGISTER_TEST(otbReflectanceToRadianceImageFilter);
   REGISTER_TEST(otbImageToRadianceImageFilter);
@@ -106,7 +106,7 @@ private:
   void do_transform(OGRPoint& g) const;
   // void do_transform(OGRLinearRing         & g) const;
   /**
-   * Transforms all the points from a line-string, thanks to \c m_Transform.
+   * Transforms all the points from a line-string at once, thanks to \c m_Transform.
    * \param[in,out] g  line-string to transform
    * \throw Whatever is thrown by \c m_Transform::operator()
    */
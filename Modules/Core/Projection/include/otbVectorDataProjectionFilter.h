@@ -24,6 +24,8 @@
 #include "otbVectorDataToVectorDataFilter.h"
 #include "otbGenericRSTransform.h"
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace otb
 {
@@ -54,6 +56,10 @@ namespace otb
   * otb::GenericMapProjection or otb::InverseSensorModel or otb::ForwardSensorModel
   * (according to the available information).
   *
+  * The vertices of a block of features are transformed with a single call
+  * to the transform (see GenericRSTransform::TransformPoints()), and the
+  * blocks are processed in parallel, each work unit with its own transform.
+  *
   * \ingroup VectorDataFilter
   * \ingroup Projection
   *
@@ -92,6 +98,8 @@ public:
   typedef typename OutputVectorDataType::DataNodeType OutputDataNodeType;
   typedef typename InputVectorDataType::DataNodeType  InputDataNodeType;
 
+  typedef itk::SmartPointer<InputDataNodeType>        InputDataNodePointerType;
+  typedef itk::SmartPointer<OutputDataNodeType>       OutputDataNodePointerType;
   typedef typename InputVectorDataType::TreeNodeType  InputInternalTreeNodeType;
   typedef typename OutputVectorDataType::TreeNodeType OutputInternalTreeNodeType;
 
@@ -201,6 +209,28 @@ private:
   VectorDataProjectionFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Feature nodes of the input and their copy in the output */
+  typedef std::vector<std::pair<InputDataNodePointerType, OutputDataNodePointerType>> FeatureListType;
+  typedef typename FeatureListType::const_iterator                                    FeatureIteratorType;
+
+  enum
+  {
+    /** Minimum number of features projected by a work unit */
+    MinimumNumberOfFeaturesPerBlock = 256
+  };
+
+  /** Transform configured with the parameters of the filter */
+  InternalTransformPointerType CreateTransform(const std::string& outputProjectionRef) const;
+
+  /** Copy the nodes of the tree, the features being collected to be
+   * projected afterwards */
+  void CopyNode(InputVectorDataPointer inputVdata, InputDataNodePointerType source, OutputVectorDataPointer outputVdata,
+                OutputDataNodePointerType destination, FeatureListType& features) const;
+
+  /** Project the geometries of a block of features, transforming all
+   * their vertices at once */
+  void ProjectFeatures(const InternalTransformType* transform, FeatureIteratorType begin, FeatureIteratorType end) const;
+
   InternalTransformPointerType m_Transform;
   std::string                  m_InputProjectionRef;
   std::string                  m_OutputProjectionRef;
@@ -26,6 +26,8 @@
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
 #include "otbStopwatch.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -173,19 +175,22 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProcessLine(Inp
   typedef typename InputLineType::VertexListType::ConstPointer VertexListConstPointerType;
   typedef typename InputLineType::VertexListConstIteratorType  VertexListConstIteratorType;
   VertexListConstPointerType                                   vertexList = line->GetVertexList();
-  VertexListConstIteratorType                                  it         = vertexList->Begin();
-  typename OutputLineType::Pointer                             newLine    = OutputLineType::New();
-  while (it != vertexList->End())
+
+  std::vector<itk::Point<double, 2>> points;
+  points.reserve(vertexList->Size());
+  for (VertexListConstIteratorType it = vertexList->Begin(); it != vertexList->End(); ++it)
+  {
+    points.push_back(it.Value());
+  }
+  m_Transform->TransformPoints(points.data(), points.data(), points.size());
+
+  typename OutputLineType::Pointer newLine = OutputLineType::New();
+  for (const auto& point : points)
   {
-    itk::Point<double, 2>           point;
     itk::ContinuousIndex<double, 2> index;
-    typename InputLineType::VertexType pointCoord = it.Value();
-    point                                         = m_Transform->TransformPoint(pointCoord);
-    index[0]                                      = point[0];
-    index[1]                                      = point[1];
-    //       otbMsgDevMacro(<< "Converting: " << it.Value() << " -> " << pointCoord << " -> " << point << " -> " << index);
+    index[0] = point[0];
+    index[1] = point[1];
     newLine->AddVertex(index);
-    ++it;
   }
 
   return newLine;
@@ -201,18 +206,22 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProcessPolygon(
   typedef typename InputPolygonType::VertexListType::ConstPointer VertexListConstPointerType;
   typedef typename InputPolygonType::VertexListConstIteratorType  VertexListConstIteratorType;
   VertexListConstPointerType                                      vertexList = polygon->GetVertexList();
-  VertexListConstIteratorType                                     it         = vertexList->Begin();
-  typename OutputPolygonType::Pointer                             newPolygon = OutputPolygonType::New();
-  while (it != vertexList->End())
+
+  std::vector<itk::Point<double, 2>> points;
+  points.reserve(vertexList->Size());
+  for (VertexListConstIteratorType it = vertexList->Begin(); it != vertexList->End(); ++it)
+  {
+    points.push_back(it.Value());
+  }
+  m_Transform->TransformPoints(points.data(), points.data(), points.size());
+
+  typename OutputPolygonType::Pointer newPolygon = OutputPolygonType::New();
+  for (const auto& point : points)
   {
-    itk::Point<double, 2>           point;
     itk::ContinuousIndex<double, 2> index;
-    typename InputPolygonType::VertexType pointCoord = it.Value();
-    point                                            = m_Transform->TransformPoint(pointCoord);
-    index[0]                                         = point[0];
-    index[1]                                         = point[1];
+    index[0] = point[0];
+    index[1] = point[1];
     newPolygon->AddVertex(index);
-    ++it;
   }
   return newPolygon;
 }
@@ -239,30 +248,18 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProcessPolygonL
 template <class TInputVectorData, class TOutputVectorData>
 void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::InstantiateTransform(void)
 {
-  m_Transform = InternalTransformType::New();
-
   InputVectorDataPointer input      = this->GetInput();
   const itk::MetaDataDictionary& inputDict = input->GetMetaDataDictionary();
 
   OutputVectorDataPointer  output     = this->GetOutput();
   itk::MetaDataDictionary& outputDict = output->GetMetaDataDictionary();
 
-  m_Transform->SetInputImageMetadata(m_InputImageMetadata);
-  m_Transform->SetOutputImageMetadata(m_OutputImageMetadata);
-
   if (m_InputProjectionRef.empty())
   {
     itk::ExposeMetaData<std::string>(inputDict, MetaDataKey::ProjectionRefKey, m_InputProjectionRef);
   }
 
-  m_Transform->SetInputProjectionRef(m_InputProjectionRef);
-  m_Transform->SetOutputProjectionRef(m_OutputProjectionRef);
-  m_Transform->SetInputSpacing(m_InputSpacing);
-  m_Transform->SetInputOrigin(m_InputOrigin);
-  m_Transform->SetOutputSpacing(m_OutputSpacing);
-  m_Transform->SetOutputOrigin(m_OutputOrigin);
-
-  m_Transform->InstantiateTransform();
+  m_Transform = this->CreateTransform(m_OutputProjectionRef);
   // retrieve the output projection ref
   // if it is not specified and end up being geographic,
   // only the m_Transform will know
@@ -277,6 +274,151 @@ void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::Instantiat
   output->SetOrigin(m_OutputOrigin);
 }
 
+template <class TInputVectorData, class TOutputVectorData>
+typename VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::InternalTransformPointerType
+VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::CreateTransform(const std::string& outputProjectionRef) const
+{
+  InternalTransformPointerType transform = InternalTransformType::New();
+
+  transform->SetInputImageMetadata(m_InputImageMetadata);
+  transform->SetOutputImageMetadata(m_OutputImageMetadata);
+  transform->SetInputProjectionRef(m_InputProjectionRef);
+  transform->SetOutputProjectionRef(outputProjectionRef);
+  transform->SetInputSpacing(m_InputSpacing);
+  transform->SetInputOrigin(m_InputOrigin);
+  transform->SetOutputSpacing(m_OutputSpacing);
+  transform->SetOutputOrigin(m_OutputOrigin);
+
+  transform->InstantiateTransform();
+  return transform;
+}
+
+template <class TInputVectorData, class TOutputVectorData>
+void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::CopyNode(InputVectorDataPointer inputVdata, InputDataNodePointerType source,
+                                                                               OutputVectorDataPointer outputVdata, OutputDataNodePointerType destination,
+                                                                               FeatureListType& features) const
+{
+  // Same walk as VectorDataToVectorDataFilter::ProcessNode()
+  typedef typename InputVectorDataType::ChildrenListType InputChildrenListType;
+  InputChildrenListType children = inputVdata->GetChildrenList(source);
+
+  for (typename InputChildrenListType::const_iterator it = children.begin(); it != children.end(); ++it)
+  {
+    OutputDataNodePointerType newDataNode = OutputDataNodeType::New();
+    newDataNode->SetNodeType((*it)->GetNodeType());
+    newDataNode->SetNodeId((*it)->GetNodeId());
+    newDataNode->SetMetaDataDictionary((*it)->GetMetaDataDictionary());
+
+    switch ((*it)->GetNodeType())
+    {
+    case ROOT:
+      break;
+    case FEATURE_POINT:
+    case FEATURE_LINE:
+    case FEATURE_POLYGON:
+      outputVdata->Add(newDataNode, destination);
+      features.push_back(std::make_pair(*it, newDataNode));
+      break;
+    default:
+      outputVdata->Add(newDataNode, destination);
+      this->CopyNode(inputVdata, *it, outputVdata, newDataNode, features);
+      break;
+    }
+  }
+}
+
+template <class TInputVectorData, class TOutputVectorData>
+void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProjectFeatures(const InternalTransformType* transform, FeatureIteratorType begin,
+                                                                                      FeatureIteratorType end) const
+{
+  typedef typename InputLineType::VertexListConstIteratorType    LineVertexIteratorType;
+  typedef typename InputPolygonType::VertexListConstIteratorType PolygonVertexIteratorType;
+
+  // Gather the vertices of all the features
+  std::vector<itk::Point<double, 2>> points;
+  auto addRing = [&points](const InputPolygonType* ring) {
+    for (PolygonVertexIteratorType it = ring->GetVertexList()->Begin(); it != ring->GetVertexList()->End(); ++it)
+    {
+      points.push_back(it.Value());
+    }
+  };
+  for (FeatureIteratorType feature = begin; feature != end; ++feature)
+  {
+    const InputDataNodeType* node = feature->first;
+    switch (node->GetNodeType())
+    {
+    case FEATURE_POINT:
+      points.push_back(node->GetPoint());
+      break;
+    case FEATURE_LINE:
+      for (LineVertexIteratorType it = node->GetLine()->GetVertexList()->Begin(); it != node->GetLine()->GetVertexList()->End(); ++it)
+      {
+        points.push_back(it.Value());
+      }
+      break;
+    default:
+      addRing(node->GetPolygonExteriorRing());
+      for (auto it = node->GetPolygonInteriorRings()->Begin(); it != node->GetPolygonInteriorRings()->End(); ++it)
+      {
+        addRing(it.Get());
+      }
+      break;
+    }
+  }
+
+  transform->TransformPoints(points.data(), points.data(), points.size());
+
+  // Rebuild the geometries from the transformed vertices, in the same order
+  auto next = points.cbegin();
+  auto nextIndex = [&next]() {
+    itk::ContinuousIndex<double, 2> index;
+    index[0] = (*next)[0];
+    index[1] = (*next)[1];
+    ++next;
+    return index;
+  };
+  auto newRing = [&nextIndex](const InputPolygonType* ring) {
+    OutputPolygonPointerType newPolygon = OutputPolygonType::New();
+    for (unsigned int i = 0; i < ring->GetVertexList()->Size(); ++i)
+    {
+      newPolygon->AddVertex(nextIndex());
+    }
+    return newPolygon;
+  };
+  for (FeatureIteratorType feature = begin; feature != end; ++feature)
+  {
+    const InputDataNodeType* node    = feature->first;
+    OutputDataNodeType*      newNode = feature->second;
+    switch (node->GetNodeType())
+    {
+    case FEATURE_POINT:
+      newNode->SetPoint(*next++);
+      break;
+    case FEATURE_LINE:
+    {
+      OutputLinePointerType newLine = OutputLineType::New();
+      for (unsigned int i = 0; i < node->GetLine()->GetVertexList()->Size(); ++i)
+      {
+        newLine->AddVertex(nextIndex());
+      }
+      newNode->SetLine(newLine);
+      break;
+    }
+    default:
+    {
+      newNode->SetPolygonExteriorRing(newRing(node->GetPolygonExteriorRing()));
+      OutputPolygonListPointerType newPolygonList = OutputPolygonListType::New();
+      for (auto it = node->GetPolygonInteriorRings()->Begin(); it != node->GetPolygonInteriorRings()->End(); ++it)
+      {
+        newPolygonList->PushBack(newRing(it.Get()));
+      }
+      newNode->SetPolygonInteriorRings(newPolygonList);
+      break;
+    }
+    }
+  }
+}
+
 /**
    * GenerateData Performs the coordinate conversion for each element in the tree
  */
@@ -287,7 +429,9 @@ void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::GenerateDa
   InputVectorDataPointer  inputPtr  = this->GetInput();
   OutputVectorDataPointer outputPtr = this->GetOutput();
 
-  // Instantiate the transform
+  // Instantiate the transform, the other work units use transforms
+  // created from the same parameters
+  const std::string outputProjectionRef = m_OutputProjectionRef;
   this->InstantiateTransform();
 
   // Create the output tree root
@@ -299,7 +443,23 @@ void VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::GenerateDa
 
   // Start recursive processing
   otb::Stopwatch chrono = otb::Stopwatch::StartNew();
-  this->ProcessNode(inputPtr,inputPtr->GetRoot(),outputPtr,outputPtr->GetRoot());
+  FeatureListType features;
+  this->CopyNode(inputPtr, inputPtr->GetRoot(), outputPtr, outputPtr->GetRoot(), features);
+
+  const std::size_t nbBlocks =
+      std::max<std::size_t>(1, std::min<std::size_t>(this->GetNumberOfWorkUnits(), features.size() / MinimumNumberOfFeaturesPerBlock));
+  std::vector<InternalTransformPointerType> transforms(1, m_Transform);
+  while (transforms.size() < nbBlocks)
+  {
+    transforms.push_back(this->CreateTransform(outputProjectionRef));
+  }
+
+  auto projectBlock = [&](itk::SizeValueType block) {
+    FeatureIteratorType begin = features.begin() + block * features.size() / nbBlocks;
+    FeatureIteratorType end   = features.begin() + (block + 1) * features.size() / nbBlocks;
+    this->ProjectFeatures(transforms[block], begin, end);
+  };
+  this->GetMultiThreader()->ParallelizeArray(0, nbBlocks, projectBlock, nullptr);
   chrono.Stop();
   otbMsgDevMacro(<< "VectoDataProjectionFilter: features processed in " << chrono.GetElapsedMilliseconds() << " ms.");
 }
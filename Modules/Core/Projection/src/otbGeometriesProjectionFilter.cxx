@@ -32,6 +32,7 @@
 #include "itkMetaDataObject.h"
 #include "otbOGRGeometryWrapper.h"
 #include "otbOGRGeometriesVisitor.h"
+#include <vector>
 
 
 /*===========================================================================*/
@@ -60,11 +61,23 @@ void otb::internal::ReprojectTransformationFunctor::do_transform(OGRPoint& g) co
 
 void otb::internal::ReprojectTransformationFunctor::do_transform(OGRLineString& g) const
 {
-  OGRPoint point;
-  for (int i = 0, N = g.getNumPoints(); i != N; ++i)
+  typedef InternalTransformType::InputPointType InputPointType;
+  // All the points of the line are transformed at once
+  const int                   N = g.getNumPoints();
+  std::vector<InputPointType> points(N);
+  OGRPoint                    point;
+  for (int i = 0; i != N; ++i)
   {
     g.getPoint(i, &point);
-    do_transform(point); // no need to go through the redispatch cycle
+    points[i][0] = point.getX();
+    points[i][1] = point.getY();
+  }
+  m_Transform->TransformPoints(points.data(), points.data(), points.size());
+  for (int i = 0; i != N; ++i)
+  {
+    g.getPoint(i, &point); // keeps z and m
+    point.setX(points[i][0]);
+    point.setY(points[i][1]);
     g.setPoint(i, &point);
   }
 }
@@ -0,0 +1,780 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageAccumulators_h
+#define otbImageAccumulators_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkVariableLengthVector.h"
+#include "itkVariableSizeMatrix.h"
+#include "otbQuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageAccumulatorBase
+ * \brief Base class of the accumulators filled by PersistentMultiAccumulatorImageFilter.
+ *
+ * An accumulator keeps one partial result per thread. The filter calls
+ * Reset() before the first region is processed, Accumulate() with the
+ * relevant pixels of each line processed by a thread, and Synthetize()
+ * once all the regions have been processed, to merge the partial
+ * results.
+ *
+ * Pixels are given to Accumulate() as a contiguous array of
+ * `nbPixels * GetNumberOfComponents()` values, pixel after pixel. When
+ * the filter has a label image, the label of each pixel is given too.
+ *
+ * \sa PersistentMultiAccumulatorImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class ImageAccumulatorBase
+{
+public:
+  typedef TPrecision          PrecisionType;
+  typedef itk::IndexValueType LabelType;
+
+  virtual ~ImageAccumulatorBase() = default;
+
+  /** Clear the partial results, for the given number of threads and components */
+  virtual void Reset(unsigned int itkNotUsed(nbThreads), unsigned int nbComponents)
+  {
+    m_NumberOfComponents = nbComponents;
+  }
+
+  /** Accumulate nbPixels pixels processed by thread threadId. labels is
+   * null if the filter has no label image. */
+  virtual void Accumulate(const PrecisionType* values, const LabelType* labels, std::size_t nbPixels, itk::ThreadIdType threadId) = 0;
+
+  /** Merge the partial results of the threads */
+  virtual void Synthetize() = 0;
+
+  /** Whether the accumulator needs the labels of the pixels */
+  virtual bool RequiresLabels() const
+  {
+    return false;
+  }
+
+  unsigned int GetNumberOfComponents() const
+  {
+    return m_NumberOfComponents;
+  }
+
+protected:
+  unsigned int m_NumberOfComponents = 0;
+};
+
+/** \class MinMaxAccumulator
+ * \brief Minimum and maximum of each component.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class MinMaxAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>          Superclass;
+  typedef typename Superclass::PrecisionType        PrecisionType;
+  typedef typename Superclass::LabelType            LabelType;
+  typedef itk::VariableLengthVector<PrecisionType> RealPixelType;
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    m_ThreadMin.assign(nbThreads, std::vector<PrecisionType>(nbComponents, std::numeric_limits<PrecisionType>::max()));
+    m_ThreadMax.assign(nbThreads, std::vector<PrecisionType>(nbComponents, std::numeric_limits<PrecisionType>::lowest()));
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType*, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    PrecisionType*     vmin   = m_ThreadMin[threadId].data();
+    PrecisionType*     vmax   = m_ThreadMax[threadId].data();
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        vmin[j] = std::min(vmin[j], values[j]);
+        vmax[j] = std::max(vmax[j], values[j]);
+      }
+    }
+  }
+
+  void Synthetize() override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    m_Minimum.SetSize(nbComp);
+    m_Maximum.SetSize(nbComp);
+    m_Minimum.Fill(std::numeric_limits<PrecisionType>::max());
+    m_Maximum.Fill(std::numeric_limits<PrecisionType>::lowest());
+    for (std::size_t t = 0; t < m_ThreadMin.size(); ++t)
+    {
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        m_Minimum[j] = std::min(m_Minimum[j], m_ThreadMin[t][j]);
+        m_Maximum[j] = std::max(m_Maximum[j], m_ThreadMax[t][j]);
+      }
+    }
+  }
+
+  const RealPixelType& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const RealPixelType& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+private:
+  std::vector<std::vector<PrecisionType>> m_ThreadMin;
+  std::vector<std::vector<PrecisionType>> m_ThreadMax;
+  RealPixelType                           m_Minimum;
+  RealPixelType                           m_Maximum;
+};
+
+/** \class MomentsAccumulator
+ * \brief Number of pixels, mean and variance of each component.
+ *
+ * The variance uses the unbiased estimator unless UseUnbiasedEstimator
+ * is off, as in PersistentStreamingStatisticsVectorImageFilter. Use
+ * CovarianceAccumulator when the cross-component terms are needed.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class MomentsAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>          Superclass;
+  typedef typename Superclass::PrecisionType        PrecisionType;
+  typedef typename Superclass::LabelType            LabelType;
+  typedef itk::VariableLengthVector<PrecisionType> RealPixelType;
+
+  void SetUseUnbiasedEstimator(bool flag)
+  {
+    m_UseUnbiasedEstimator = flag;
+  }
+  bool GetUseUnbiasedEstimator() const
+  {
+    return m_UseUnbiasedEstimator;
+  }
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    m_ThreadSum.assign(nbThreads, std::vector<PrecisionType>(nbComponents, 0));
+    m_ThreadSquaredSum.assign(nbThreads, std::vector<PrecisionType>(nbComponents, 0));
+    m_ThreadCount.assign(nbThreads, 0);
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType*, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    PrecisionType*     sum    = m_ThreadSum[threadId].data();
+    PrecisionType*     sum2   = m_ThreadSquaredSum[threadId].data();
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        sum[j] += values[j];
+        sum2[j] += values[j] * values[j];
+      }
+    }
+    m_ThreadCount[threadId] += nbPixels;
+  }
+
+  void Synthetize() override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    m_Count                   = 0;
+    m_Sum.SetSize(nbComp);
+    m_Sum.Fill(0);
+    RealPixelType sum2(nbComp);
+    sum2.Fill(0);
+    for (std::size_t t = 0; t < m_ThreadSum.size(); ++t)
+    {
+      m_Count += m_ThreadCount[t];
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        m_Sum[j] += m_ThreadSum[t][j];
+        sum2[j] += m_ThreadSquaredSum[t][j];
+      }
+    }
+
+    m_Mean.SetSize(nbComp);
+    m_Variance.SetSize(nbComp);
+    m_Mean.Fill(0);
+    m_Variance.Fill(0);
+    if (m_Count == 0)
+    {
+      return;
+    }
+    const double n     = static_cast<double>(m_Count);
+    const double regul = (m_UseUnbiasedEstimator && m_Count > 1) ? n / (n - 1.) : 1.;
+    for (unsigned int j = 0; j < nbComp; ++j)
+    {
+      m_Mean[j]     = m_Sum[j] / n;
+      m_Variance[j] = regul * (sum2[j] / n - m_Mean[j] * m_Mean[j]);
+    }
+  }
+
+  itk::SizeValueType GetCount() const
+  {
+    return m_Count;
+  }
+  const RealPixelType& GetSum() const
+  {
+    return m_Sum;
+  }
+  const RealPixelType& GetMean() const
+  {
+    return m_Mean;
+  }
+  const RealPixelType& GetVariance() const
+  {
+    return m_Variance;
+  }
+  RealPixelType GetStandardDeviation() const
+  {
+    RealPixelType stddev(m_Variance.GetSize());
+    for (unsigned int j = 0; j < m_Variance.GetSize(); ++j)
+    {
+      stddev[j] = std::sqrt(std::max(m_Variance[j], PrecisionType(0)));
+    }
+    return stddev;
+  }
+
+private:
+  bool                                    m_UseUnbiasedEstimator = true;
+  std::vector<std::vector<PrecisionType>> m_ThreadSum;
+  std::vector<std::vector<PrecisionType>> m_ThreadSquaredSum;
+  std::vector<itk::SizeValueType>         m_ThreadCount;
+  itk::SizeValueType                      m_Count = 0;
+  RealPixelType                           m_Sum;
+  RealPixelType                           m_Mean;
+  RealPixelType                           m_Variance;
+};
+
+/** \class CovarianceAccumulator
+ * \brief Mean, correlation (second order moments) and covariance matrices of the components.
+ *
+ * Only the upper triangle of the second order moments is accumulated.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class CovarianceAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>          Superclass;
+  typedef typename Superclass::PrecisionType        PrecisionType;
+  typedef typename Superclass::LabelType            LabelType;
+  typedef itk::VariableLengthVector<PrecisionType> RealPixelType;
+  typedef itk::VariableSizeMatrix<PrecisionType>   MatrixType;
+
+  void SetUseUnbiasedEstimator(bool flag)
+  {
+    m_UseUnbiasedEstimator = flag;
+  }
+  bool GetUseUnbiasedEstimator() const
+  {
+    return m_UseUnbiasedEstimator;
+  }
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    m_ThreadSum.assign(nbThreads, std::vector<PrecisionType>(nbComponents, 0));
+    m_ThreadCrossSum.assign(nbThreads, std::vector<PrecisionType>(nbComponents * (nbComponents + 1) / 2, 0));
+    m_ThreadCount.assign(nbThreads, 0);
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType*, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    PrecisionType*     sum    = m_ThreadSum[threadId].data();
+    PrecisionType*     cross  = m_ThreadCrossSum[threadId].data();
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      PrecisionType* c = cross;
+      for (unsigned int r = 0; r < nbComp; ++r)
+      {
+        sum[r] += values[r];
+        for (unsigned int k = r; k < nbComp; ++k)
+        {
+          *c++ += values[r] * values[k];
+        }
+      }
+    }
+    m_ThreadCount[threadId] += nbPixels;
+  }
+
+  void Synthetize() override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    m_Count                   = 0;
+    m_Mean.SetSize(nbComp);
+    m_Mean.Fill(0);
+    m_Correlation.SetSize(nbComp, nbComp);
+    m_Correlation.Fill(0);
+    for (std::size_t t = 0; t < m_ThreadSum.size(); ++t)
+    {
+      m_Count += m_ThreadCount[t];
+      const PrecisionType* c = m_ThreadCrossSum[t].data();
+      for (unsigned int r = 0; r < nbComp; ++r)
+      {
+        m_Mean[r] += m_ThreadSum[t][r];
+        for (unsigned int k = r; k < nbComp; ++k)
+        {
+          m_Correlation(r, k) += *c++;
+        }
+      }
+    }
+
+    m_Covariance.SetSize(nbComp, nbComp);
+    m_Covariance.Fill(0);
+    if (m_Count == 0)
+    {
+      return;
+    }
+    const double n     = static_cast<double>(m_Count);
+    const double regul = (m_UseUnbiasedEstimator && m_Count > 1) ? n / (n - 1.) : 1.;
+    m_Mean /= n;
+    for (unsigned int r = 0; r < nbComp; ++r)
+    {
+      for (unsigned int k = r; k < nbComp; ++k)
+      {
+        m_Correlation(r, k) /= n;
+        m_Correlation(k, r) = m_Correlation(r, k);
+        m_Covariance(r, k)  = regul * (m_Correlation(r, k) - m_Mean[r] * m_Mean[k]);
+        m_Covariance(k, r)  = m_Covariance(r, k);
+      }
+    }
+  }
+
+  itk::SizeValueType GetCount() const
+  {
+    return m_Count;
+  }
+  const RealPixelType& GetMean() const
+  {
+    return m_Mean;
+  }
+  const MatrixType& GetCorrelation() const
+  {
+    return m_Correlation;
+  }
+  const MatrixType& GetCovariance() const
+  {
+    return m_Covariance;
+  }
+
+private:
+  bool                                    m_UseUnbiasedEstimator = true;
+  std::vector<std::vector<PrecisionType>> m_ThreadSum;
+  std::vector<std::vector<PrecisionType>> m_ThreadCrossSum;
+  std::vector<itk::SizeValueType>         m_ThreadCount;
+  itk::SizeValueType                      m_Count = 0;
+  RealPixelType                           m_Mean;
+  MatrixType                              m_Correlation;
+  MatrixType                              m_Covariance;
+};
+
+/** \class HistogramAccumulator
+ * \brief Histogram of each component, with fixed bounds.
+ *
+ * The bounds of the histograms must be known before the pass: set them
+ * with SetBounds() (or chain with a MinMaxAccumulator pass). Bin i of a
+ * component covers [min + i * step, min + (i+1) * step[, with
+ * step = (max - min) / nbBins; values outside [min, max] are counted in
+ * the first or last bin unless ClipOutliers is set, in which case they
+ * are ignored.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class HistogramAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>          Superclass;
+  typedef typename Superclass::PrecisionType        PrecisionType;
+  typedef typename Superclass::LabelType            LabelType;
+  typedef itk::VariableLengthVector<PrecisionType> RealPixelType;
+  typedef std::vector<itk::SizeValueType>           FrequencyContainerType;
+
+  /** Number of bins and bounds of each component (sizes must match the
+   * number of components of the image) */
+  void SetBounds(unsigned int nbBins, const RealPixelType& minimum, const RealPixelType& maximum)
+  {
+    m_NumberOfBins = std::max(nbBins, 1u);
+    m_Minimum      = minimum;
+    m_Maximum      = maximum;
+  }
+
+  void SetClipOutliers(bool flag)
+  {
+    m_ClipOutliers = flag;
+  }
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    if (m_Minimum.GetSize() != nbComponents || m_Maximum.GetSize() != nbComponents)
+    {
+      itkGenericExceptionMacro(<< "HistogramAccumulator: bounds are set for " << m_Minimum.GetSize() << " components, the image has " << nbComponents);
+    }
+    m_Scale.resize(nbComponents);
+    for (unsigned int j = 0; j < nbComponents; ++j)
+    {
+      const PrecisionType range = m_Maximum[j] - m_Minimum[j];
+      m_Scale[j]                = range > 0 ? m_NumberOfBins / range : 0;
+    }
+    m_ThreadFrequencies.assign(nbThreads, FrequencyContainerType(nbComponents * m_NumberOfBins, 0));
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType*, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    const long         last   = m_NumberOfBins - 1;
+    itk::SizeValueType* freq  = m_ThreadFrequencies[threadId].data();
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        if (m_ClipOutliers && (values[j] < m_Minimum[j] || values[j] > m_Maximum[j]))
+        {
+          continue;
+        }
+        const PrecisionType position = (values[j] - m_Minimum[j]) * m_Scale[j];
+        const long          bin      = position <= 0 ? 0 : std::min(static_cast<long>(position), last);
+        ++freq[j * m_NumberOfBins + bin];
+      }
+    }
+  }
+
+  void Synthetize() override
+  {
+    m_Frequencies.assign(this->m_NumberOfComponents * m_NumberOfBins, 0);
+    for (const auto& threadFrequencies : m_ThreadFrequencies)
+    {
+      std::transform(m_Frequencies.begin(), m_Frequencies.end(), threadFrequencies.begin(), m_Frequencies.begin(), std::plus<itk::SizeValueType>());
+    }
+  }
+
+  unsigned int GetNumberOfBins() const
+  {
+    return m_NumberOfBins;
+  }
+
+  /** Frequency of a bin of a component */
+  itk::SizeValueType GetFrequency(unsigned int component, unsigned int bin) const
+  {
+    return m_Frequencies[component * m_NumberOfBins + bin];
+  }
+
+  /** Quantile p (in [0, 1]) of a component, linearly interpolated in its bin */
+  PrecisionType Quantile(unsigned int component, double p) const
+  {
+    const itk::SizeValueType* freq  = m_Frequencies.data() + component * m_NumberOfBins;
+    const double              total = std::accumulate(freq, freq + m_NumberOfBins, 0.);
+    const PrecisionType       step  = (m_Maximum[component] - m_Minimum[component]) / m_NumberOfBins;
+    if (total == 0)
+    {
+      return m_Minimum[component];
+    }
+    const double target     = std::min(std::max(p, 0.), 1.) * total;
+    double       cumulative = 0;
+    for (unsigned int i = 0; i < m_NumberOfBins; ++i)
+    {
+      if (freq[i] > 0 && cumulative + freq[i] >= target)
+      {
+        return m_Minimum[component] + step * (i + (target - cumulative) / freq[i]);
+      }
+      cumulative += freq[i];
+    }
+    return m_Maximum[component];
+  }
+
+private:
+  unsigned int                        m_NumberOfBins = 256;
+  bool                                m_ClipOutliers = false;
+  RealPixelType                       m_Minimum;
+  RealPixelType                       m_Maximum;
+  std::vector<PrecisionType>          m_Scale;
+  std::vector<FrequencyContainerType> m_ThreadFrequencies;
+  FrequencyContainerType              m_Frequencies;
+};
+
+/** \class QuantileSketchAccumulator
+ * \brief Approximate quantiles of each component, in a single pass.
+ *
+ * Unlike HistogramAccumulator, the bounds do not need to be known before
+ * the pass, and the error does not depend on the distribution of the
+ * values: each thread fills one QuantileSketch per component, merged in
+ * Synthetize(). The normalized rank error of Quantile() is at most
+ * GetRankError(), set with SetRankError() (or SetK()), for a memory of
+ * about 3k values per component and per thread.
+ *
+ * If NoDataFlag is on, the values of a component equal to NoDataValue are
+ * not inserted in the sketch of this component, as in
+ * ListSampleToHistogramListGenerator: the other components of the pixel
+ * are still counted.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class QuantileSketchAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>   Superclass;
+  typedef typename Superclass::PrecisionType PrecisionType;
+  typedef typename Superclass::LabelType     LabelType;
+  typedef QuantileSketch<PrecisionType>      SketchType;
+
+  /** Parameter of the sketches (default 200) */
+  void SetK(unsigned int k)
+  {
+    m_K = k;
+  }
+  unsigned int GetK() const
+  {
+    return m_K;
+  }
+
+  /** Set the parameter of the sketches from the target normalized rank error */
+  void SetRankError(double rankError)
+  {
+    m_K = SketchType::ComputeParameter(rankError);
+  }
+  double GetRankError() const
+  {
+    return SketchType::ComputeRankError(m_K);
+  }
+
+  /** Ignore the values of each component equal to NoDataValue (off by
+   * default) */
+  void SetNoDataFlag(bool flag)
+  {
+    m_NoDataFlag = flag;
+  }
+  bool GetNoDataFlag() const
+  {
+    return m_NoDataFlag;
+  }
+
+  /** Value ignored if NoDataFlag is on (default 0) */
+  void SetNoDataValue(PrecisionType value)
+  {
+    m_NoDataValue = value;
+  }
+  PrecisionType GetNoDataValue() const
+  {
+    return m_NoDataValue;
+  }
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    m_ThreadSketches.assign(nbThreads, std::vector<SketchType>(nbComponents, SketchType(m_K)));
+    m_Sketches.assign(nbComponents, SketchType(m_K));
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType*, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp   = this->m_NumberOfComponents;
+    SketchType*        sketches = m_ThreadSketches[threadId].data();
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        if (!m_NoDataFlag || values[j] != m_NoDataValue)
+        {
+          sketches[j].Insert(values[j]);
+        }
+      }
+    }
+  }
+
+  void Synthetize() override
+  {
+    m_Sketches.assign(this->m_NumberOfComponents, SketchType(m_K));
+    for (auto& threadSketches : m_ThreadSketches)
+    {
+      for (unsigned int j = 0; j < this->m_NumberOfComponents; ++j)
+      {
+        m_Sketches[j].Merge(threadSketches[j]);
+        threadSketches[j].Clear();
+      }
+    }
+  }
+
+  /** Approximate quantile p (in [0, 1]) of a component */
+  PrecisionType Quantile(unsigned int component, double p) const
+  {
+    return m_Sketches[component].Quantile(p);
+  }
+
+  /** Merged sketch of a component, valid after Synthetize() */
+  const SketchType& GetSketch(unsigned int component) const
+  {
+    return m_Sketches[component];
+  }
+
+private:
+  unsigned int                         m_K           = 200;
+  bool                                 m_NoDataFlag  = false;
+  PrecisionType                        m_NoDataValue = 0;
+  std::vector<std::vector<SketchType>> m_ThreadSketches;
+  std::vector<SketchType>              m_Sketches;
+};
+
+/** \class LabelStatisticsAccumulator
+ * \brief Number of pixels, mean, minimum and maximum of the components for each label.
+ *
+ * Requires a label image on the filter.
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPrecision = double>
+class LabelStatisticsAccumulator : public ImageAccumulatorBase<TPrecision>
+{
+public:
+  typedef ImageAccumulatorBase<TPrecision>          Superclass;
+  typedef typename Superclass::PrecisionType        PrecisionType;
+  typedef typename Superclass::LabelType            LabelType;
+  typedef itk::VariableLengthVector<PrecisionType> RealPixelType;
+
+  /** Statistics of a label */
+  struct LabelStatistics
+  {
+    itk::SizeValueType Count = 0;
+    RealPixelType      Sum;
+    RealPixelType      Minimum;
+    RealPixelType      Maximum;
+    RealPixelType      Mean;
+  };
+  typedef std::map<LabelType, LabelStatistics> StatisticsMapType;
+
+  bool RequiresLabels() const override
+  {
+    return true;
+  }
+
+  void Reset(unsigned int nbThreads, unsigned int nbComponents) override
+  {
+    Superclass::Reset(nbThreads, nbComponents);
+    m_ThreadStatistics.assign(nbThreads, ThreadMapType());
+    m_Statistics.clear();
+  }
+
+  void Accumulate(const PrecisionType* values, const LabelType* labels, std::size_t nbPixels, itk::ThreadIdType threadId) override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    ThreadMapType&     stats  = m_ThreadStatistics[threadId];
+    LabelStatistics*   cur    = nullptr;
+    LabelType          curLabel{};
+    for (std::size_t i = 0; i < nbPixels; ++i, values += nbComp)
+    {
+      // Labels come by runs: only look up the map when the label changes
+      if (cur == nullptr || labels[i] != curLabel)
+      {
+        curLabel = labels[i];
+        cur      = &stats[curLabel];
+        if (cur->Count == 0)
+        {
+          Initialize(*cur, nbComp);
+        }
+      }
+      ++cur->Count;
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        cur->Sum[j] += values[j];
+        cur->Minimum[j] = std::min(cur->Minimum[j], values[j]);
+        cur->Maximum[j] = std::max(cur->Maximum[j], values[j]);
+      }
+    }
+  }
+
+  void Synthetize() override
+  {
+    const unsigned int nbComp = this->m_NumberOfComponents;
+    m_Statistics.clear();
+    for (auto& threadStats : m_ThreadStatistics)
+    {
+      for (const auto& entry : threadStats)
+      {
+        LabelStatistics& stats = m_Statistics[entry.first];
+        if (stats.Count == 0)
+        {
+          Initialize(stats, nbComp);
+        }
+        stats.Count += entry.second.Count;
+        for (unsigned int j = 0; j < nbComp; ++j)
+        {
+          stats.Sum[j] += entry.second.Sum[j];
+          stats.Minimum[j] = std::min(stats.Minimum[j], entry.second.Minimum[j]);
+          stats.Maximum[j] = std::max(stats.Maximum[j], entry.second.Maximum[j]);
+        }
+      }
+      threadStats.clear();
+    }
+    for (auto& entry : m_Statistics)
+    {
+      entry.second.Mean = entry.second.Sum / static_cast<PrecisionType>(entry.second.Count);
+    }
+  }
+
+  const StatisticsMapType& GetStatistics() const
+  {
+    return m_Statistics;
+  }
+
+private:
+  typedef std::unordered_map<LabelType, LabelStatistics> ThreadMapType;
+
+  static void Initialize(LabelStatistics& stats, unsigned int nbComp)
+  {
+    stats.Sum.SetSize(nbComp);
+    stats.Sum.Fill(0);
+    stats.Minimum.SetSize(nbComp);
+    stats.Minimum.Fill(std::numeric_limits<PrecisionType>::max());
+    stats.Maximum.SetSize(nbComp);
+    stats.Maximum.Fill(std::numeric_limits<PrecisionType>::lowest());
+  }
+
+  std::vector<ThreadMapType> m_ThreadStatistics;
+  StatisticsMapType          m_Statistics;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQuantileSketch_h
+#define otbQuantileSketch_h
+
+#include "itkIntTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class QuantileSketch
+ * \brief Mergeable approximate quantiles of a stream of values, in bounded memory.
+ *
+ * This is a KLL sketch (Karnin, Lang and Liberty, "Optimal Quantile
+ * Approximation in Streams", 2016). Values are inserted in the level 0
+ * compactor; when the sketch is full, the first compactor over its
+ * capacity is sorted and one value out of two (random offset) is
+ * promoted to the next level, where each value weights twice as much.
+ * Capacities decrease geometrically (factor 2/3) from the top level, so
+ * that the sketch never retains more than about 3k + log2(n) values,
+ * whatever the number n of inserted values.
+ *
+ * Two sketches built on separate parts of a stream (threads, streaming
+ * chunks) merge into a sketch of the whole stream with the same
+ * guarantees, in any order.
+ *
+ * The normalized rank error of Quantile() and Rank() is at most
+ * GetRankError() = 2.3 / k^0.97 (about 1.3% for k = 200, 0.1% for
+ * k = 2900) with 99% confidence, and is zero as long as no compaction
+ * happened (n < 3k roughly). Minimum and maximum are exact. The random
+ * generator has a fixed seed, so that results are reproducible.
+ *
+ * \sa QuantileSketchAccumulator
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TValue = double>
+class QuantileSketch
+{
+public:
+  typedef TValue ValueType;
+
+  explicit QuantileSketch(unsigned int k = 200) : m_K(std::max(k, 8u))
+  {
+    Clear();
+  }
+
+  /** Sketch parameter k giving a normalized rank error of at most rankError */
+  static unsigned int ComputeParameter(double rankError)
+  {
+    const double k = std::pow(2.296 / std::max(rankError, 1e-6), 1. / 0.9723);
+    return static_cast<unsigned int>(std::min(std::ceil(k), 1e8));
+  }
+
+  /** Normalized rank error (99% confidence) for the sketch parameter k */
+  static double ComputeRankError(unsigned int k)
+  {
+    return 2.296 / std::pow(static_cast<double>(k), 0.9723);
+  }
+
+  unsigned int GetK() const
+  {
+    return m_K;
+  }
+
+  double GetRankError() const
+  {
+    return ComputeRankError(m_K);
+  }
+
+  /** Remove all the values */
+  void Clear()
+  {
+    m_Compactors.clear();
+    m_Size        = 0;
+    m_MaxSize     = 0;
+    m_Count       = 0;
+    m_Minimum     = std::numeric_limits<ValueType>::max();
+    m_Maximum     = std::numeric_limits<ValueType>::lowest();
+    m_RandomState = 2463534242u;
+    Grow();
+  }
+
+  void Insert(ValueType value)
+  {
+    m_Compactors[0].push_back(value);
+    ++m_Count;
+    m_Minimum = std::min(m_Minimum, value);
+    m_Maximum = std::max(m_Maximum, value);
+    if (++m_Size >= m_MaxSize)
+    {
+      Compress();
+    }
+  }
+
+  /** Add the values of another sketch (with the same parameter k) */
+  void Merge(const QuantileSketch& other)
+  {
+    while (m_Compactors.size() < other.m_Compactors.size())
+    {
+      Grow();
+    }
+    for (std::size_t h = 0; h < other.m_Compactors.size(); ++h)
+    {
+      m_Compactors[h].insert(m_Compactors[h].end(), other.m_Compactors[h].begin(), other.m_Compactors[h].end());
+    }
+    m_Count += other.m_Count;
+    m_Minimum = std::min(m_Minimum, other.m_Minimum);
+    m_Maximum = std::max(m_Maximum, other.m_Maximum);
+    UpdateSize();
+    while (m_Size >= m_MaxSize)
+    {
+      Compress();
+    }
+  }
+
+  /** Number of inserted values */
+  itk::SizeValueType GetCount() const
+  {
+    return m_Count;
+  }
+
+  /** Number of values kept by the sketch */
+  std::size_t GetNumberOfRetainedValues() const
+  {
+    return m_Size;
+  }
+
+  ValueType GetMinimum() const
+  {
+    return m_Minimum;
+  }
+
+  ValueType GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+  /** Approximate fraction of the values lower than or equal to value */
+  double Rank(ValueType value) const
+  {
+    if (m_Count == 0)
+    {
+      return 0.;
+    }
+    itk::SizeValueType weight = 0;
+    for (std::size_t h = 0; h < m_Compactors.size(); ++h)
+    {
+      const auto n = std::count_if(m_Compactors[h].begin(), m_Compactors[h].end(), [value](ValueType v) { return v <= value; });
+      weight += static_cast<itk::SizeValueType>(n) << h;
+    }
+    return std::min(1., static_cast<double>(weight) / m_Count);
+  }
+
+  /** Approximate quantile p (in [0, 1]): the smallest retained value whose
+   * rank is at least p. Quantile(0) and Quantile(1) are the exact minimum
+   * and maximum. */
+  ValueType Quantile(double p) const
+  {
+    if (m_Count == 0)
+    {
+      return ValueType();
+    }
+    if (p <= 0.)
+    {
+      return m_Minimum;
+    }
+    if (p >= 1.)
+    {
+      return m_Maximum;
+    }
+
+    std::vector<std::pair<ValueType, itk::SizeValueType>> weighted;
+    weighted.reserve(m_Size);
+    itk::SizeValueType total = 0;
+    for (std::size_t h = 0; h < m_Compactors.size(); ++h)
+    {
+      for (const auto& v : m_Compactors[h])
+      {
+        weighted.emplace_back(v, itk::SizeValueType(1) << h);
+        total += itk::SizeValueType(1) << h;
+      }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    const double       target     = p * total;
+    itk::SizeValueType cumulative = 0;
+    for (const auto& entry : weighted)
+    {
+      cumulative += entry.second;
+      if (cumulative >= target)
+      {
+        return entry.first;
+      }
+    }
+    return m_Maximum;
+  }
+
+private:
+  /** Capacity of a level, decreasing geometrically from the top level */
+  std::size_t Capacity(std::size_t level) const
+  {
+    const std::size_t depth = m_Compactors.size() - level - 1;
+    return static_cast<std::size_t>(std::ceil(std::pow(2. / 3., static_cast<double>(depth)) * m_K)) + 1;
+  }
+
+  void Grow()
+  {
+    m_Compactors.emplace_back();
+    m_MaxSize = 0;
+    for (std::size_t h = 0; h < m_Compactors.size(); ++h)
+    {
+      m_MaxSize += Capacity(h);
+    }
+  }
+
+  void UpdateSize()
+  {
+    m_Size = 0;
+    for (const auto& compactor : m_Compactors)
+    {
+      m_Size += compactor.size();
+    }
+  }
+
+  /** Compact the first level over its capacity (and the following ones,
+   * until the sketch is under its maximum size) */
+  void Compress()
+  {
+    for (std::size_t h = 0; h < m_Compactors.size(); ++h)
+    {
+      if (m_Compactors[h].size() < Capacity(h))
+      {
+        continue;
+      }
+      if (h + 1 == m_Compactors.size())
+      {
+        Grow();
+      }
+
+      std::vector<ValueType>& compactor = m_Compactors[h];
+      std::vector<ValueType>& next      = m_Compactors[h + 1];
+      std::sort(compactor.begin(), compactor.end());
+
+      // An odd number of values leaves the largest one at this level
+      const std::size_t nbPairs = compactor.size() / 2;
+      const std::size_t offset  = NextRandomBit();
+      for (std::size_t i = 0; i < nbPairs; ++i)
+      {
+        next.push_back(compactor[2 * i + offset]);
+      }
+      compactor.erase(compactor.begin(), compactor.begin() + 2 * nbPairs);
+
+      UpdateSize();
+      if (m_Size < m_MaxSize)
+      {
+        break;
+      }
+    }
+  }
+
+  /** xorshift32 */
+  std::size_t NextRandomBit()
+  {
+    m_RandomState ^= m_RandomState << 13;
+    m_RandomState ^= m_RandomState >> 17;
+    m_RandomState ^= m_RandomState << 5;
+    return (m_RandomState >> 16) & 1u;
+  }
+
+  unsigned int                        m_K;
+  std::vector<std::vector<ValueType>> m_Compactors;
+  std::size_t                         m_Size;
+  std::size_t                         m_MaxSize;
+  itk::SizeValueType                  m_Count;
+  ValueType                           m_Minimum;
+  ValueType                           m_Maximum;
+  std::uint32_t                       m_RandomState;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMultiAccumulatorImageFilter_h
+#define otbStreamingMultiAccumulatorImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbImageAccumulators.h"
+#include "otbImage.h"
+#include "otbMacro.h"
+#include <memory>
+
+namespace otb
+{
+
+/** \class PersistentMultiAccumulatorImageFilter
+ * \brief Fills any set of accumulators in a single pass over a large image.
+ *
+ * Statistics are usually computed with one persistent filter per kind
+ * of statistic (min/max, covariance, histogram...), each one reading the
+ * whole input. This filter reads the input once and gives the relevant
+ * pixels to every accumulator registered with AddAccumulator() (see
+ * ImageAccumulatorBase): the pixels are converted and filtered only
+ * once, line by line, then each accumulator processes the line with its
+ * own per-thread state.
+ *
+ * Pixels with a non finite component are ignored if IgnoreInfiniteValues
+ * is on (default), and pixels whose components all equal
+ * UserIgnoredValue are ignored if IgnoreUserDefinedValue is on, as in
+ * PersistentStreamingStatisticsVectorImageFilter.
+ *
+ * An optional label image, set with SetLabelInput(), gives the label of
+ * each pixel to the accumulators which need it (per-label statistics).
+ *
+ * This filter persists its temporary data: the accumulators are filled
+ * with all the regions it is updated on until Reset() is called;
+ * Synthetize() computes their final results.
+ *
+ * \sa PersistentImageFilter
+ * \sa ImageAccumulatorBase
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage, class TLabelImage = otb::Image<unsigned int, TInputImage::ImageDimension>, class TPrecision = double>
+class ITK_EXPORT PersistentMultiAccumulatorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentMultiAccumulatorImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentMultiAccumulatorImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                      ImageType;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::PixelType  PixelType;
+  typedef TLabelImage                      LabelImageType;
+
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  /** Accumulators typedefs */
+  typedef TPrecision                                PrecisionType;
+  typedef ImageAccumulatorBase<PrecisionType>       AccumulatorType;
+  typedef std::shared_ptr<AccumulatorType>          AccumulatorPointerType;
+  typedef typename AccumulatorType::LabelType       LabelType;
+
+  /** Register an accumulator, to be filled by the next pass */
+  void AddAccumulator(AccumulatorPointerType accumulator)
+  {
+    m_Accumulators.push_back(accumulator);
+    this->Modified();
+  }
+
+  /** Unregister all the accumulators */
+  void ClearAccumulators()
+  {
+    m_Accumulators.clear();
+    this->Modified();
+  }
+
+  const std::vector<AccumulatorPointerType>& GetAccumulators() const
+  {
+    return m_Accumulators;
+  }
+
+  /** Optional label image */
+  void SetLabelInput(const LabelImageType* input);
+  const LabelImageType* GetLabelInput() const;
+
+  itkSetMacro(IgnoreInfiniteValues, bool);
+  itkGetMacro(IgnoreInfiniteValues, bool);
+
+  itkSetMacro(IgnoreUserDefinedValue, bool);
+  itkGetMacro(IgnoreUserDefinedValue, bool);
+
+  itkSetMacro(UserIgnoredValue, PrecisionType);
+  itkGetMacro(UserIgnoredValue, PrecisionType);
+
+  /** Number of pixels given to the accumulators, valid after Synthetize() */
+  itkGetMacro(NumberOfRelevantPixels, itk::SizeValueType);
+
+  /** Number of ignored pixels, valid after Synthetize() */
+  itkGetMacro(NumberOfIgnoredPixels, itk::SizeValueType);
+
+  /** The output image is not used */
+  void AllocateOutputs() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentMultiAccumulatorImageFilter();
+  ~PersistentMultiAccumulatorImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentMultiAccumulatorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  std::vector<AccumulatorPointerType> m_Accumulators;
+
+  bool          m_IgnoreInfiniteValues;
+  bool          m_IgnoreUserDefinedValue;
+  PrecisionType m_UserIgnoredValue;
+
+  std::vector<itk::SizeValueType> m_ThreadRelevantPixels;
+  std::vector<itk::SizeValueType> m_ThreadIgnoredPixels;
+  itk::SizeValueType              m_NumberOfRelevantPixels;
+  itk::SizeValueType              m_NumberOfIgnoredPixels;
+}; // end of class PersistentMultiAccumulatorImageFilter
+
+
+/** \class StreamingMultiAccumulatorImageFilter
+ * \brief This class streams the whole input image through the PersistentMultiAccumulatorImageFilter.
+ *
+ * \code
+ * typedef otb::StreamingMultiAccumulatorImageFilter<ImageType> AccumulatorFilterType;
+ * auto minMax  = std::make_shared<otb::MinMaxAccumulator<>>();
+ * auto moments = std::make_shared<otb::MomentsAccumulator<>>();
+ * AccumulatorFilterType::Pointer filter = AccumulatorFilterType::New();
+ * filter->SetInput(image);
+ * filter->AddAccumulator(minMax);
+ * filter->AddAccumulator(moments);
+ * filter->Update();
+ * std::cout << minMax->GetMinimum() << " " << moments->GetMean() << std::endl;
+ * \endcode
+ *
+ * \sa PersistentMultiAccumulatorImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage, class TLabelImage = otb::Image<unsigned int, TInputImage::ImageDimension>, class TPrecision = double>
+class ITK_EXPORT StreamingMultiAccumulatorImageFilter
+    : public PersistentFilterStreamingDecorator<PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingMultiAccumulatorImageFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingMultiAccumulatorImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef typename Superclass::FilterType                 AccumulatorFilterType;
+  typedef typename AccumulatorFilterType::AccumulatorPointerType AccumulatorPointerType;
+  typedef typename AccumulatorFilterType::PrecisionType   PrecisionType;
+  typedef TInputImage                                     InputImageType;
+  typedef TLabelImage                                     LabelImageType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetLabelInput(const LabelImageType* input)
+  {
+    this->GetFilter()->SetLabelInput(input);
+  }
+
+  void AddAccumulator(AccumulatorPointerType accumulator)
+  {
+    this->GetFilter()->AddAccumulator(accumulator);
+  }
+
+  otbSetObjectMemberMacro(Filter, IgnoreInfiniteValues, bool);
+  otbGetObjectMemberMacro(Filter, IgnoreInfiniteValues, bool);
+  otbSetObjectMemberMacro(Filter, IgnoreUserDefinedValue, bool);
+  otbGetObjectMemberMacro(Filter, IgnoreUserDefinedValue, bool);
+  otbSetObjectMemberMacro(Filter, UserIgnoredValue, PrecisionType);
+  otbGetObjectMemberMacro(Filter, UserIgnoredValue, PrecisionType);
+
+  itk::SizeValueType GetNumberOfRelevantPixels() const
+  {
+    return this->GetFilter()->GetNumberOfRelevantPixels();
+  }
+
+protected:
+  /** Constructor */
+  StreamingMultiAccumulatorImageFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingMultiAccumulatorImageFilter() override
+  {
+  }
+
+private:
+  StreamingMultiAccumulatorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingMultiAccumulatorImageFilter.hxx"
+#endif
+
+#endif
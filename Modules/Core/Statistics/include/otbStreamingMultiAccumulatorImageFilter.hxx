@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMultiAccumulatorImageFilter_hxx
+#define otbStreamingMultiAccumulatorImageFilter_hxx
+
+#include "otbStreamingMultiAccumulatorImageFilter.h"
+
+#include <cmath>
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::PersistentMultiAccumulatorImageFilter()
+  : m_IgnoreInfiniteValues(true),
+    m_IgnoreUserDefinedValue(false),
+    m_UserIgnoredValue(itk::NumericTraits<PrecisionType>::ZeroValue()),
+    m_NumberOfRelevantPixels(0),
+    m_NumberOfIgnoredPixels(0)
+{
+  this->DynamicMultiThreadingOff();
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::SetLabelInput(const LabelImageType* input)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<LabelImageType*>(input));
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+const typename PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::LabelImageType*
+PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::GetLabelInput() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const LabelImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::Reset()
+{
+  TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const unsigned int numberOfThreads   = this->GetNumberOfWorkUnits();
+  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+
+  for (auto& accumulator : m_Accumulators)
+  {
+    if (accumulator->RequiresLabels() && this->GetLabelInput() == nullptr)
+    {
+      itkExceptionMacro(<< "An accumulator requires a label image, which is not set");
+    }
+    accumulator->Reset(numberOfThreads, numberOfComponent);
+  }
+
+  m_ThreadRelevantPixels.assign(numberOfThreads, 0);
+  m_ThreadIgnoredPixels.assign(numberOfThreads, 0);
+  m_NumberOfRelevantPixels = 0;
+  m_NumberOfIgnoredPixels  = 0;
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::Synthetize()
+{
+  m_NumberOfRelevantPixels = 0;
+  m_NumberOfIgnoredPixels  = 0;
+  for (std::size_t threadId = 0; threadId < m_ThreadRelevantPixels.size(); ++threadId)
+  {
+    m_NumberOfRelevantPixels += m_ThreadRelevantPixels[threadId];
+    m_NumberOfIgnoredPixels += m_ThreadIgnoredPixels[threadId];
+  }
+
+  for (auto& accumulator : m_Accumulators)
+  {
+    accumulator->Synthetize();
+  }
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                                        itk::ThreadIdType threadId)
+{
+  typedef itk::DefaultConvertPixelTraits<PixelType> PixelTraitsType;
+
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize(1));
+
+  const TInputImage*    inputPtr = this->GetInput();
+  const LabelImageType* labelPtr = this->GetLabelInput();
+
+  const unsigned int nbComp = inputPtr->GetNumberOfComponentsPerPixel();
+  const std::size_t  width  = outputRegionForThread.GetSize(0);
+
+  // Relevant pixels of the current line, converted once for all the accumulators
+  std::vector<PrecisionType> values(width * nbComp);
+  std::vector<LabelType>     labels(labelPtr ? width : 0);
+
+  itk::ImageScanlineConstIterator<TInputImage>    it(inputPtr, outputRegionForThread);
+  itk::ImageScanlineConstIterator<LabelImageType> labelIt;
+  if (labelPtr)
+  {
+    labelIt = itk::ImageScanlineConstIterator<LabelImageType>(labelPtr, outputRegionForThread);
+  }
+
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    std::size_t    count = 0;
+    PrecisionType* dst   = values.data();
+    for (; !it.IsAtEndOfLine(); ++it)
+    {
+      const PixelType& pixel     = it.Get();
+      bool             isFinite  = true;
+      bool             isIgnored = m_IgnoreUserDefinedValue;
+      for (unsigned int j = 0; j < nbComp; ++j)
+      {
+        const PrecisionType value = static_cast<PrecisionType>(PixelTraitsType::GetNthComponent(j, pixel));
+        dst[j]                    = value;
+        isFinite                  = isFinite && std::isfinite(value);
+        isIgnored                 = isIgnored && (value == m_UserIgnoredValue);
+      }
+
+      const bool isRelevant = !((m_IgnoreInfiniteValues && !isFinite) || isIgnored);
+      if (isRelevant)
+      {
+        if (labelPtr)
+        {
+          labels[count] = static_cast<LabelType>(labelIt.Get());
+        }
+        ++count;
+        dst += nbComp;
+      }
+      if (labelPtr)
+      {
+        ++labelIt;
+      }
+    }
+
+    for (auto& accumulator : m_Accumulators)
+    {
+      accumulator->Accumulate(values.data(), labelPtr ? labels.data() : nullptr, count, threadId);
+    }
+    m_ThreadRelevantPixels[threadId] += count;
+    m_ThreadIgnoredPixels[threadId] += width - count;
+
+    if (labelPtr)
+    {
+      labelIt.NextLine();
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TLabelImage, class TPrecision>
+void PersistentMultiAccumulatorImageFilter<TInputImage, TLabelImage, TPrecision>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of accumulators: " << m_Accumulators.size() << std::endl;
+  os << indent << "IgnoreInfiniteValues: " << (m_IgnoreInfiniteValues ? "true" : "false") << std::endl;
+  os << indent << "IgnoreUserDefinedValue: " << (m_IgnoreUserDefinedValue ? "true" : "false") << std::endl;
+  os << indent << "UserIgnoredValue: " << m_UserIgnoredValue << std::endl;
+  os << indent << "Relevant pixels: " << m_NumberOfRelevantPixels << std::endl;
+  os << indent << "Ignored pixels: " << m_NumberOfIgnoredPixels << std::endl;
+}
+
+} // end namespace otb
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMacro.h"
+#include "otbQuantileSketch.h"
+#include "otbImageAccumulators.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int otbQuantileSketch(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::QuantileSketch<double>            SketchType;
+  typedef otb::QuantileSketchAccumulator<double> AccumulatorType;
+
+  const double       rankError = 0.005;
+  const unsigned int k         = SketchType::ComputeParameter(rankError);
+  otbControlConditionTestMacro(SketchType::ComputeRankError(k) > rankError, "Wrong sketch parameter");
+
+  // Few values: the sketch is exact
+  SketchType small(k);
+  for (int i = 100; i > 0; --i)
+  {
+    small.Insert(i);
+  }
+  otbControlConditionTestMacro(small.Quantile(0.5) != 50, "Wrong median of a small sketch");
+  otbControlConditionTestMacro(small.Quantile(0.) != 1 || small.Quantile(1.) != 100, "Wrong bounds of a small sketch");
+
+  // Skewed distribution split in several merged sketches, as with threads
+  const std::size_t                   nbValues = 1000000;
+  const unsigned int                  nbParts  = 5;
+  std::mt19937                        generator(42);
+  std::lognormal_distribution<double> distribution(0., 1.);
+  std::vector<double>                 values(nbValues);
+  std::vector<SketchType>             parts(nbParts, SketchType(k));
+  for (std::size_t i = 0; i < nbValues; ++i)
+  {
+    values[i] = distribution(generator);
+    parts[i % nbParts].Insert(values[i]);
+  }
+  SketchType sketch(k);
+  for (const auto& part : parts)
+  {
+    sketch.Merge(part);
+  }
+  std::sort(values.begin(), values.end());
+
+  std::cout << "Retained " << sketch.GetNumberOfRetainedValues() << " values out of " << sketch.GetCount() << std::endl;
+  otbControlConditionTestMacro(sketch.GetCount() != nbValues, "Wrong count");
+  otbControlConditionTestMacro(sketch.GetNumberOfRetainedValues() > 4 * k, "Sketch is too large");
+  otbControlConditionTestMacro(sketch.GetMinimum() != values.front() || sketch.GetMaximum() != values.back(), "Wrong bounds");
+
+  for (double p = 0.01; p < 1.; p += 0.01)
+  {
+    const double q    = sketch.Quantile(p);
+    const double rank = static_cast<double>(std::upper_bound(values.begin(), values.end(), q) - values.begin()) / nbValues;
+    otbControlConditionTestMacro(std::abs(rank - p) > rankError, "Rank error of quantile " << p << " is too large: " << std::abs(rank - p));
+    otbControlConditionTestMacro(std::abs(sketch.Rank(q) - rank) > rankError, "Rank error of value " << q << " is too large");
+  }
+
+  // Accumulator on two components, filled by two threads
+  AccumulatorType accumulator;
+  accumulator.SetRankError(rankError);
+  accumulator.Reset(2, 2);
+  std::vector<double> pixels;
+  for (std::size_t i = 0; i < nbValues; i += 10)
+  {
+    pixels.push_back(values[i]);
+    pixels.push_back(-values[i]);
+  }
+  const std::size_t half = pixels.size() / 4;
+  accumulator.Accumulate(pixels.data(), nullptr, half, 0);
+  accumulator.Accumulate(pixels.data() + 2 * half, nullptr, pixels.size() / 2 - half, 1);
+  accumulator.Synthetize();
+
+  const double median = values[nbValues / 2];
+  otbControlConditionTestMacro(accumulator.GetSketch(0).GetCount() != pixels.size() / 2, "Wrong accumulated count");
+  otbControlConditionTestMacro(std::abs(accumulator.GetSketch(0).Rank(median) - 0.5) > rankError, "Wrong accumulated median");
+  otbControlConditionTestMacro(std::abs(accumulator.GetSketch(1).Rank(-median) - 0.5) > rankError, "Wrong accumulated median of the second component");
+  otbControlConditionTestMacro(accumulator.Quantile(1, 0.) != -pixels[pixels.size() - 2], "Wrong accumulated minimum");
+
+  // Nodata values are ignored component by component
+  AccumulatorType noDataAccumulator;
+  noDataAccumulator.SetK(k);
+  noDataAccumulator.SetNoDataFlag(true);
+  noDataAccumulator.Reset(1, 2);
+  const double noDataPixels[] = {0., 1., 2., 0., 0., 0., 3., 4.};
+  noDataAccumulator.Accumulate(noDataPixels, nullptr, 4, 0);
+  noDataAccumulator.Synthetize();
+  otbControlConditionTestMacro(noDataAccumulator.GetSketch(0).GetCount() != 2 || noDataAccumulator.GetSketch(1).GetCount() != 2,
+                               "Nodata values are not ignored by component");
+  otbControlConditionTestMacro(noDataAccumulator.Quantile(0, 0.) != 2. || noDataAccumulator.Quantile(1, 0.) != 1., "Wrong minimum without nodata values");
+
+  return EXIT_SUCCESS;
+}
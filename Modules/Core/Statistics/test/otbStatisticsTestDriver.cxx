@@ -44,6 +44,8 @@ void RegisterTests()
   REGISTER_TEST(otbListSampleToBalancedListSampleFilter);
   REGISTER_TEST(otbStreamingStatisticsVectorImageFilter);
   REGISTER_TEST(otbStreamingMinMaxVectorImageFilter);
+  REGISTER_TEST(otbStreamingMultiAccumulatorImageFilter);
+  REGISTER_TEST(otbQuantileSketch);
   REGISTER_TEST(otbListSampleGenerator);
   REGISTER_TEST(otbImaginaryImageToComplexImageFilterTest);
   REGISTER_TEST(otbListSampleToHistogramListGenerator);
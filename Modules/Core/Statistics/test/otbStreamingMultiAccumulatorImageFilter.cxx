@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbStreamingMultiAccumulatorImageFilter.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbImageFileReader.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <cmath>
+#include <iostream>
+#include <map>
+
+namespace
+{
+bool IsClose(double a, double b)
+{
+  return std::abs(a - b) <= 1e-6 * std::max(1., std::max(std::abs(a), std::abs(b)));
+}
+}
+
+int otbStreamingMultiAccumulatorImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char* infname = argv[1];
+
+  typedef otb::VectorImage<double, 2>                                       ImageType;
+  typedef otb::Image<unsigned int, 2>                                       LabelImageType;
+  typedef otb::ImageFileReader<ImageType>                                   ReaderType;
+  typedef otb::StreamingMultiAccumulatorImageFilter<ImageType>              MultiAccumulatorFilterType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType>              StatisticsFilterType;
+  typedef otb::MinMaxAccumulator<>                                          MinMaxAccumulatorType;
+  typedef otb::MomentsAccumulator<>                                         MomentsAccumulatorType;
+  typedef otb::CovarianceAccumulator<>                                      CovarianceAccumulatorType;
+  typedef otb::HistogramAccumulator<>                                       HistogramAccumulatorType;
+  typedef otb::LabelStatisticsAccumulator<>                                 LabelStatisticsAccumulatorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+  reader->Update();
+  ImageType::Pointer image = reader->GetOutput();
+
+  // Labels: vertical stripes of 10 columns
+  LabelImageType::Pointer labels = LabelImageType::New();
+  labels->CopyInformation(image);
+  labels->SetRegions(image->GetLargestPossibleRegion());
+  labels->Allocate();
+  itk::ImageRegionIteratorWithIndex<LabelImageType> labelIt(labels, labels->GetLargestPossibleRegion());
+  for (labelIt.GoToBegin(); !labelIt.IsAtEnd(); ++labelIt)
+  {
+    labelIt.Set((labelIt.GetIndex()[0] / 10) % 3);
+  }
+
+  // Reference statistics
+  StatisticsFilterType::Pointer reference = StatisticsFilterType::New();
+  reference->SetInput(image);
+  reference->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  reference->Update();
+
+  // All the statistics in one pass
+  auto minMax     = std::make_shared<MinMaxAccumulatorType>();
+  auto moments    = std::make_shared<MomentsAccumulatorType>();
+  auto covariance = std::make_shared<CovarianceAccumulatorType>();
+  auto histogram  = std::make_shared<HistogramAccumulatorType>();
+  auto perLabel   = std::make_shared<LabelStatisticsAccumulatorType>();
+
+  const unsigned int nbBands = image->GetNumberOfComponentsPerPixel();
+  histogram->SetBounds(64, reference->GetMinimum(), reference->GetMaximum());
+
+  MultiAccumulatorFilterType::Pointer filter = MultiAccumulatorFilterType::New();
+  filter->SetInput(image);
+  filter->SetLabelInput(labels);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  filter->AddAccumulator(minMax);
+  filter->AddAccumulator(moments);
+  filter->AddAccumulator(covariance);
+  filter->AddAccumulator(histogram);
+  filter->AddAccumulator(perLabel);
+  filter->Update();
+
+  const itk::SizeValueType nbRelevant = reference->GetNbRelevantPixels()[0];
+  otbControlConditionTestMacro(filter->GetNumberOfRelevantPixels() != nbRelevant, "Wrong number of relevant pixels");
+  otbControlConditionTestMacro(moments->GetCount() != nbRelevant, "Wrong number of accumulated pixels");
+
+  for (unsigned int i = 0; i < nbBands; ++i)
+  {
+    otbControlConditionTestMacro(minMax->GetMinimum()[i] != reference->GetMinimum()[i], "Wrong minimum");
+    otbControlConditionTestMacro(minMax->GetMaximum()[i] != reference->GetMaximum()[i], "Wrong maximum");
+    otbControlConditionTestMacro(!IsClose(moments->GetMean()[i], reference->GetMean()[i]), "Wrong mean");
+    otbControlConditionTestMacro(!IsClose(moments->GetVariance()[i], reference->GetCovariance()(i, i)), "Wrong variance");
+    for (unsigned int j = 0; j < nbBands; ++j)
+    {
+      otbControlConditionTestMacro(!IsClose(covariance->GetCovariance()(i, j), reference->GetCovariance()(i, j)), "Wrong covariance");
+    }
+
+    itk::SizeValueType total = 0;
+    for (unsigned int bin = 0; bin < histogram->GetNumberOfBins(); ++bin)
+    {
+      total += histogram->GetFrequency(i, bin);
+    }
+    otbControlConditionTestMacro(total != nbRelevant, "Wrong histogram total frequency");
+    const double median = histogram->Quantile(i, 0.5);
+    otbControlConditionTestMacro(median < minMax->GetMinimum()[i] || median > minMax->GetMaximum()[i], "Median out of bounds");
+  }
+
+  // Per label statistics against a brute force computation
+  std::map<unsigned int, itk::SizeValueType> counts;
+  std::map<unsigned int, double>             sums;
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::PixelType& pixel = it.Get();
+    bool                        valid = true;
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      valid = valid && std::isfinite(pixel[i]);
+    }
+    if (valid)
+    {
+      const unsigned int label = labels->GetPixel(it.GetIndex());
+      ++counts[label];
+      sums[label] += pixel[0];
+    }
+  }
+
+  otbControlConditionTestMacro(perLabel->GetStatistics().size() != counts.size(), "Wrong number of labels");
+  for (const auto& entry : perLabel->GetStatistics())
+  {
+    otbControlConditionTestMacro(entry.second.Count != counts[entry.first], "Wrong label count");
+    otbControlConditionTestMacro(!IsClose(entry.second.Sum[0], sums[entry.first]), "Wrong label sum");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbMeasuredRAMStrippedStreamingManager_h
+#define otbMeasuredRAMStrippedStreamingManager_h
+
+#include "itkImageRegionSplitter.h"
+#include "otbStreamingManager.h"
+#include <cstdint>
+#include <vector>
+
+namespace otb
+{
+
+/** \class MeasuredRAMStrippedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image by strips,
+ *  according to the memory actually used while processing the first strips
+ *
+ * The first strips are computed from an estimation of the pipeline memory
+ * print, as in RAMDrivenStrippedStreamingManager. The resident memory of the
+ * process is then measured after each of the NumberOfMeasuredSplits first
+ * strips, and the height of the remaining strips is resized so that the
+ * measured footprint converges to the available RAM. The height can not go
+ * below MinimumScale or above MaximumScale times the estimated one.
+ *
+ * The growth of the GDAL block cache is subtracted from the measured
+ * footprint: the cache is bounded by its own setting (GDAL_CACHEMAX) and
+ * keeps growing until it is full, whatever the strip height.
+ *
+ * Strips are generated while streaming: GetNumberOfSplits() may change after
+ * a call to GetSplit(), and callers should query it again at each split. The
+ * splitter returned by GetSplitter() only knows about the estimated strips.
+ *
+ * When the memory of the process can not be measured, the estimated strips
+ * are kept.
+ *
+ * \sa RAMDrivenStrippedStreamingManager
+ * \sa ImageFileWriter
+ * \sa StreamingImageVirtualFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT MeasuredRAMStrippedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef MeasuredRAMStrippedStreamingManager Self;
+  typedef StreamingManager<TImage>            Superclass;
+  typedef itk::SmartPointer<Self>             Pointer;
+  typedef itk::SmartPointer<const Self>       ConstPointer;
+
+  typedef TImage                               ImageType;
+  typedef typename Superclass::RegionType      RegionType;
+  typedef typename Superclass::MemoryPrintType MemoryPrintType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(MeasuredRAMStrippedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+  itkGetConstMacro(Bias, double);
+
+  /** The number of strips after which the memory is measured (3 by default) */
+  itkSetMacro(NumberOfMeasuredSplits, unsigned int);
+  itkGetConstMacro(NumberOfMeasuredSplits, unsigned int);
+
+  /** Bounds of the strip height, relatively to the estimated one (0.25 and 4
+   * by default) */
+  itkSetMacro(MinimumScale, double);
+  itkGetConstMacro(MinimumScale, double);
+  itkSetMacro(MaximumScale, double);
+  itkGetConstMacro(MaximumScale, double);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject* input, const RegionType& region) override;
+
+  /** Number of strips already generated plus the number of strips needed to
+   * cover the rest of the region with the current strip height */
+  unsigned int GetNumberOfSplits() override;
+
+  /** Get the ith strip. The strip height may be updated from a measure of
+   * the memory before generating new strips */
+  RegionType GetSplit(unsigned int i) override;
+
+protected:
+  MeasuredRAMStrippedStreamingManager();
+  ~MeasuredRAMStrippedStreamingManager() override;
+
+  /** Measure the resident memory of the process and its peak, in bytes.
+   * Returns false if they are not available. */
+  virtual bool MeasureMemory(std::uint64_t& resident, std::uint64_t& peakResident);
+
+  /** Measure the memory used by the GDAL block cache, in bytes */
+  virtual std::uint64_t MeasureCacheMemory();
+
+  /** Update the strip height from a measure of the memory used to
+   * process the last generated strip */
+  void UpdateNumberOfLines();
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  unsigned int m_NumberOfMeasuredSplits;
+  double       m_MinimumScale;
+  double       m_MaximumScale;
+
+private:
+  MeasuredRAMStrippedStreamingManager(const MeasuredRAMStrippedStreamingManager&) = delete;
+  void operator=(const MeasuredRAMStrippedStreamingManager&) = delete;
+
+  /** Strips generated so far */
+  std::vector<RegionType> m_Splits;
+
+  /** First line not covered by the generated strips */
+  typename RegionType::IndexValueType m_NextLine;
+
+  /** Estimated and current strip heights */
+  unsigned long m_EstimatedNumberOfLines;
+  unsigned long m_NumberOfLines;
+
+  unsigned int    m_NumberOfMeasures;
+  MemoryPrintType m_AvailableRAMInBytes;
+  MemoryPrintType m_EstimatedMemoryPrint;
+
+  /** Memory of the process before streaming */
+  bool          m_MeasureAvailable;
+  std::uint64_t m_BaselineResident;
+  std::uint64_t m_BaselinePeakResident;
+  std::uint64_t m_BaselineCache;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbMeasuredRAMStrippedStreamingManager.hxx"
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbMeasuredRAMStrippedStreamingManager_hxx
+#define otbMeasuredRAMStrippedStreamingManager_hxx
+
+#include "otbMeasuredRAMStrippedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbSystem.h"
+#include "gdal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TImage>
+MeasuredRAMStrippedStreamingManager<TImage>::MeasuredRAMStrippedStreamingManager()
+  : m_AvailableRAMInMB(0),
+    m_Bias(1.0),
+    m_NumberOfMeasuredSplits(3),
+    m_MinimumScale(0.25),
+    m_MaximumScale(4.0),
+    m_NextLine(0),
+    m_EstimatedNumberOfLines(1),
+    m_NumberOfLines(1),
+    m_NumberOfMeasures(0),
+    m_AvailableRAMInBytes(0),
+    m_EstimatedMemoryPrint(0),
+    m_MeasureAvailable(false),
+    m_BaselineResident(0),
+    m_BaselinePeakResident(0),
+    m_BaselineCache(0)
+{
+}
+
+template <class TImage>
+MeasuredRAMStrippedStreamingManager<TImage>::~MeasuredRAMStrippedStreamingManager()
+{
+}
+
+template <class TImage>
+bool MeasuredRAMStrippedStreamingManager<TImage>::MeasureMemory(std::uint64_t& resident, std::uint64_t& peakResident)
+{
+  return System::GetProcessMemory(resident, peakResident);
+}
+
+template <class TImage>
+std::uint64_t MeasuredRAMStrippedStreamingManager<TImage>::MeasureCacheMemory()
+{
+  return static_cast<std::uint64_t>(GDALGetCacheUsed64());
+}
+
+template <class TImage>
+void MeasuredRAMStrippedStreamingManager<TImage>::PrepareStreaming(itk::DataObject* input, const RegionType& region)
+{
+  m_AvailableRAMInBytes  = this->GetActualAvailableRAMInBytes(m_AvailableRAMInMB);
+  m_EstimatedMemoryPrint = this->EstimatePipelineMemoryPrint(input, region, m_Bias);
+
+  unsigned long nbDivisions = otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(m_EstimatedMemoryPrint, m_AvailableRAMInBytes);
+  nbDivisions               = std::max(nbDivisions, 1UL);
+
+  otbLogMacro(Info, << "Estimated memory for full processing: " << m_EstimatedMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
+                    << "MB (avail.: " << m_AvailableRAMInBytes * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
+                    << " MB), initial image partitioning: " << nbDivisions << " blocks, to be adjusted from measured memory");
+
+  this->m_Splitter               = itk::ImageRegionSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+  this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+  this->m_Region                 = region;
+
+  const unsigned int  axis    = ImageDimension - 1;
+  const unsigned long nbLines = region.GetSize()[axis];
+  m_EstimatedNumberOfLines    = std::max((nbLines + this->m_ComputedNumberOfSplits - 1) / this->m_ComputedNumberOfSplits, 1UL);
+  m_NumberOfLines             = m_EstimatedNumberOfLines;
+
+  m_Splits.clear();
+  m_NextLine         = region.GetIndex()[axis];
+  m_NumberOfMeasures = 0;
+  m_MeasureAvailable = this->MeasureMemory(m_BaselineResident, m_BaselinePeakResident);
+  m_BaselineCache    = this->MeasureCacheMemory();
+}
+
+template <class TImage>
+unsigned int MeasuredRAMStrippedStreamingManager<TImage>::GetNumberOfSplits()
+{
+  const unsigned int                        axis      = ImageDimension - 1;
+  const typename RegionType::IndexValueType end       = this->m_Region.GetIndex()[axis] + this->m_Region.GetSize()[axis];
+  const unsigned long                       remaining = end - m_NextLine;
+  return static_cast<unsigned int>(m_Splits.size() + (remaining + m_NumberOfLines - 1) / m_NumberOfLines);
+}
+
+template <class TImage>
+typename MeasuredRAMStrippedStreamingManager<TImage>::RegionType MeasuredRAMStrippedStreamingManager<TImage>::GetSplit(unsigned int i)
+{
+  const unsigned int                        axis = ImageDimension - 1;
+  const typename RegionType::IndexValueType end  = this->m_Region.GetIndex()[axis] + this->m_Region.GetSize()[axis];
+
+  // The previous strip has just been processed when the next one is requested
+  if (i == m_Splits.size() && i > 0 && m_NumberOfMeasures < m_NumberOfMeasuredSplits)
+  {
+    this->UpdateNumberOfLines();
+  }
+
+  while (m_Splits.size() <= i && m_NextLine < end)
+  {
+    RegionType split = this->m_Region;
+    split.SetIndex(axis, m_NextLine);
+    split.SetSize(axis, std::min(m_NumberOfLines, static_cast<unsigned long>(end - m_NextLine)));
+    m_Splits.push_back(split);
+    m_NextLine += split.GetSize()[axis];
+  }
+
+  if (i >= m_Splits.size())
+  {
+    itkExceptionMacro(<< "Split " << i << " is out of the " << m_Splits.size() << " splits of region " << this->m_Region);
+  }
+  return m_Splits[i];
+}
+
+template <class TImage>
+void MeasuredRAMStrippedStreamingManager<TImage>::UpdateNumberOfLines()
+{
+  ++m_NumberOfMeasures;
+
+  std::uint64_t resident, peakResident;
+  if (!m_MeasureAvailable || !this->MeasureMemory(resident, peakResident))
+  {
+    return;
+  }
+
+  const unsigned int axis = ImageDimension - 1;
+
+  // The peak catches the temporary buffers released before the end of the
+  // strip, but it is the peak of all the strips processed so far
+  std::uint64_t current = resident;
+  unsigned long lines   = m_Splits.back().GetSize()[axis];
+  if (peakResident > m_BaselinePeakResident && peakResident > resident)
+  {
+    current = peakResident;
+    for (const auto& split : m_Splits)
+    {
+      lines = std::max(lines, static_cast<unsigned long>(split.GetSize()[axis]));
+    }
+  }
+
+  // The GDAL cache does not grow with the strip height
+  const std::uint64_t cache       = this->MeasureCacheMemory();
+  const std::uint64_t cacheGrowth = cache > m_BaselineCache ? cache - m_BaselineCache : 0;
+  if (current <= m_BaselineResident + cacheGrowth)
+  {
+    return;
+  }
+
+  const double measured     = static_cast<double>(current - m_BaselineResident - cacheGrowth);
+  const double estimated    = static_cast<double>(m_EstimatedMemoryPrint) * lines / this->m_Region.GetSize()[axis];
+  const double bytesPerLine = measured / lines;
+
+  const double minLines = std::max(std::floor(m_MinimumScale * m_EstimatedNumberOfLines), 1.);
+  const double maxLines = std::max(std::ceil(m_MaximumScale * m_EstimatedNumberOfLines), minLines);
+  const double newLines = std::floor(static_cast<double>(m_AvailableRAMInBytes) / bytesPerLine);
+  m_NumberOfLines       = static_cast<unsigned long>(std::min(std::max(newLines, minLines), maxLines));
+
+  otbLogMacro(Info, << "Measured memory for strips of " << lines << " lines: " << measured * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
+                    << " MB (estimated: " << estimated * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB, GDAL cache growth excluded: "
+                    << cacheGrowth * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB), next strips will be " << m_NumberOfLines
+                    << " lines high");
+}
+
+} // End namespace otb
+
+#endif
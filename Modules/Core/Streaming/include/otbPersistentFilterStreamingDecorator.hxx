@@ -22,6 +22,7 @@
 #define otbPersistentFilterStreamingDecorator_hxx
 
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbTrace.h"
 
 namespace otb
 {
@@ -38,8 +39,14 @@ PersistentFilterStreamingDecorator<TFilter>::PersistentFilterStreamingDecorator(
 template <class TFilter>
 void PersistentFilterStreamingDecorator<TFilter>::GenerateData(void)
 {
+  TraceSpan span("streaming", "PersistentFilterStreamingDecorator::Update");
+  span.AddArgument("filter", this->GetFilter()->GetNameOfClass());
+
   // Reset the filter before the generation.
-  this->GetFilter()->Reset();
+  {
+    TraceSpan resetSpan("streaming", "Reset");
+    this->GetFilter()->Reset();
+  }
 
   /*
   for (unsigned int idx = 0; idx < this->GetFilter()->GetNumberOfOutputs(); ++idx)
@@ -52,6 +59,7 @@ void PersistentFilterStreamingDecorator<TFilter>::GenerateData(void)
   this->GetStreamer()->Update();
 
   // Synthetize data after the streaming of the whole image.
+  TraceSpan synthetizeSpan("streaming", "Synthetize");
   this->GetFilter()->Synthetize();
 }
 
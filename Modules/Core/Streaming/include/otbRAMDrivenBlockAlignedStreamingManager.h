@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_h
+#define otbRAMDrivenBlockAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class RAMDrivenBlockAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  aligned on the blocks of the input and output files, according to a
+ *  user-defined available RAM
+ *
+ * The number of divisions is computed from the estimation of the
+ * pipeline memory print, as in RAMDrivenAdaptativeStreamingManager.
+ * The splits are then computed by ImageRegionBlockAlignedSplitter, from
+ * the TileHint of the images at the beginning of the pipeline which have
+ * the same largest possible region as the streamed image (other inputs
+ * do not share its pixel grid), and from the OutputBlockSize set by the
+ * writer. The decode amplification of the resulting splits is logged.
+ *
+ * \sa ImageRegionBlockAlignedSplitter
+ * \sa ImageFileWriter
+ * \sa StreamingImageVirtualFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT RAMDrivenBlockAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMDrivenBlockAlignedStreamingManager Self;
+  typedef StreamingManager<TImage>              Superclass;
+  typedef itk::SmartPointer<Self>               Pointer;
+  typedef itk::SmartPointer<const Self>         ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename Superclass::SizeType   SizeType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMDrivenBlockAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+  itkGetConstMacro(Bias, double);
+
+  /** The block size of the output file, 0 if unknown */
+  itkSetMacro(OutputBlockSize, SizeType);
+  itkGetConstReferenceMacro(OutputBlockSize, SizeType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject* input, const RegionType& region) override;
+
+protected:
+  RAMDrivenBlockAlignedStreamingManager();
+  ~RAMDrivenBlockAlignedStreamingManager() override;
+
+  /** Block sizes of the inputs of the pipeline sharing the pixel grid of
+   * the streamed image */
+  std::vector<SizeType> GetInputBlockSizes(itk::DataObject* input) const;
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  SizeType m_OutputBlockSize;
+
+private:
+  RAMDrivenBlockAlignedStreamingManager(const RAMDrivenBlockAlignedStreamingManager&) = delete;
+  void operator=(const RAMDrivenBlockAlignedStreamingManager&) = delete;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMDrivenBlockAlignedStreamingManager.hxx"
+#endif
+
+#endif
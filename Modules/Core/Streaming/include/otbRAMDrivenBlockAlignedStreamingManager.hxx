@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_hxx
+#define otbRAMDrivenBlockAlignedStreamingManager_hxx
+
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "otbImageCommons.h"
+#include "otbMacro.h"
+#include "otbMetaDataKey.h"
+#include "itkImageBase.h"
+#include "itkProcessObject.h"
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+namespace otb
+{
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::RAMDrivenBlockAlignedStreamingManager() : m_AvailableRAMInMB(0), m_Bias(1.0)
+{
+  m_OutputBlockSize.Fill(0);
+}
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::~RAMDrivenBlockAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+std::vector<typename RAMDrivenBlockAlignedStreamingManager<TImage>::SizeType>
+RAMDrivenBlockAlignedStreamingManager<TImage>::GetInputBlockSizes(itk::DataObject* input) const
+{
+  typedef itk::ImageBase<ImageDimension> ImageBaseType;
+
+  std::vector<SizeType> blockSizes;
+  const ImageBaseType*  image = dynamic_cast<ImageBaseType*>(input);
+  if (!image)
+  {
+    return blockSizes;
+  }
+
+  // Walk up the pipeline to the data objects without source, or produced
+  // by a source without input (readers)
+  std::set<itk::DataObject*>    visited;
+  std::vector<itk::DataObject*> toVisit(1, input);
+  while (!toVisit.empty())
+  {
+    itk::DataObject* data = toVisit.back();
+    toVisit.pop_back();
+    if (!visited.insert(data).second)
+    {
+      continue;
+    }
+
+    itk::ProcessObject* source = data->GetSource();
+    if (source && source->GetNumberOfInputs() > 0)
+    {
+      for (const auto& sourceInput : source->GetInputs())
+      {
+        if (sourceInput)
+        {
+          toVisit.push_back(sourceInput.GetPointer());
+        }
+      }
+      continue;
+    }
+
+    const ImageBaseType* leaf        = dynamic_cast<ImageBaseType*>(data);
+    const ImageCommons*  leafCommons = dynamic_cast<ImageCommons*>(data);
+    if (!leaf || !leafCommons || leaf->GetLargestPossibleRegion() != image->GetLargestPossibleRegion())
+    {
+      continue;
+    }
+
+    const auto& imd = leafCommons->GetImageMetadata();
+    if (imd.Has(MDNum::TileHintX) && imd.Has(MDNum::TileHintY))
+    {
+      SizeType blockSize;
+      blockSize.Fill(0);
+      blockSize[0] = imd[MDNum::TileHintX];
+      blockSize[1] = imd[MDNum::TileHintY];
+      if (std::find(blockSizes.begin(), blockSizes.end(), blockSize) == blockSizes.end())
+      {
+        blockSizes.push_back(blockSize);
+      }
+    }
+  }
+  return blockSizes;
+}
+
+template <class TImage>
+void RAMDrivenBlockAlignedStreamingManager<TImage>::PrepareStreaming(itk::DataObject* input, const RegionType& region)
+{
+  unsigned long nbDivisions = this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  typedef otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)> SplitterType;
+  typename SplitterType::Pointer splitter = SplitterType::New();
+  splitter->SetInputBlockSizes(this->GetInputBlockSizes(input));
+  splitter->SetOutputBlockSize(m_OutputBlockSize);
+
+  this->m_Splitter               = splitter;
+  this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+  this->m_Region                 = region;
+
+  std::ostringstream blocks;
+  for (const auto& blockSize : splitter->GetInputBlockSizes())
+  {
+    blocks << blockSize[0] << "x" << blockSize[1] << " ";
+  }
+  otbLogMacro(Info, << "Splits aligned on a " << splitter->GetAlignmentSize()[0] << "x" << splitter->GetAlignmentSize()[1] << " grid (input blocks: "
+                    << (blocks.str().empty() ? "unknown " : blocks.str()) << "output blocks: " << m_OutputBlockSize[0] << "x" << m_OutputBlockSize[1]
+                    << "), decode amplification: " << splitter->GetInputDecodeAmplification()
+                    << ", output write amplification: " << splitter->GetOutputWriteAmplification());
+}
+
+} // End namespace otb
+
+#endif
@@ -44,8 +44,10 @@ namespace otb
  *  A set of behaviors are available with the following methods :
  *  - SetNumberOfLinesStrippedStreaming : divide by strips, according to a number of lines
  *  - SetAutomaticStrippedStreaming : divide by strips, according to available RAM
+ *  - SetMeasuredStrippedStreaming : divide by strips, according to available RAM and measured memory
  *  - SetTileDimensionTiledStreaming : divide by tiles, according to a desired tile dimension
  *  - SetAutomaticTiledStreaming : divide by tiles, according to available RAM
+ *  - SetAutomaticBlockAlignedStreaming : divide on the blocks of the input files, according to available RAM
  *
  *  It is used in the PersistentFilterStreamingDecorator helper class to propose an easy
  *  way to stream an image through a persistent filter.
@@ -118,6 +120,12 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticStrippedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'stripped' and configure the number of MB
+   *   available. The first strips are computed from the estimated memory
+   *   consumption of the pipeline, the next ones are resized from the memory
+   *   actually used by the process (see MeasuredRAMStrippedStreamingManager) */
+  void SetMeasuredStrippedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /**  Set the streaming mode to 'tiled' and configure the dimension of the tiles
    *   in pixels for each dimension (square tiles will be generated) */
   void SetTileDimensionTiledStreaming(unsigned int tileDimension);
@@ -138,6 +146,14 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'aligned' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline, and the splits
+   *   are aligned on the blocks of the input files.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /** Override Update() from ProcessObject
    *  This filter does not produce an output */
   void Update() override;
@@ -29,10 +29,13 @@
 #include "otbNumberOfDivisionsTiledStreamingManager.h"
 #include "otbNumberOfLinesStrippedStreamingManager.h"
 #include "otbRAMDrivenStrippedStreamingManager.h"
+#include "otbMeasuredRAMStrippedStreamingManager.h"
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
 #include "otbUtils.h"
+#include "otbTrace.h"
 
 namespace otb
 {
@@ -97,6 +100,16 @@ void StreamingImageVirtualWriter<TInputImage>::SetAutomaticStrippedStreaming(uns
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void StreamingImageVirtualWriter<TInputImage>::SetMeasuredStrippedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef MeasuredRAMStrippedStreamingManager<TInputImage>  MeasuredRAMStrippedStreamingManagerType;
+  typename MeasuredRAMStrippedStreamingManagerType::Pointer streamingManager = MeasuredRAMStrippedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 template <class TInputImage>
 void StreamingImageVirtualWriter<TInputImage>::SetTileDimensionTiledStreaming(unsigned int tileDimension)
 {
@@ -127,6 +140,16 @@ void StreamingImageVirtualWriter<TInputImage>::SetAutomaticAdaptativeStreaming(u
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void StreamingImageVirtualWriter<TInputImage>::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage>  RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 template <class TInputImage>
 void StreamingImageVirtualWriter<TInputImage>::Update()
 {
@@ -213,10 +236,18 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
    * piece, and copy the results into the output image.
    */
   InputImageRegionType streamRegion;
+  PipelineTrace        pipelineTrace(inputPtr);
   for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    // Some streaming managers resize the next splits while streaming
+    m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
+
+    TraceSpan splitSpan("streaming", "Split");
+    splitSpan.AddArgument("division", m_CurrentDivision);
+    splitSpan.AddArgument("index", streamRegion.GetIndex());
+    splitSpan.AddArgument("size", streamRegion.GetSize());
     // inputPtr->ReleaseData();
     // inputPtr->SetRequestedRegion(streamRegion);
     // inputPtr->Update();
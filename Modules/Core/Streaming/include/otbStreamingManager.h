@@ -100,6 +100,14 @@ protected:
 
   virtual unsigned int EstimateOptimalNumberOfDivisions(itk::DataObject* input, const RegionType& region, MemoryPrintType availableRAMInMB, double bias = 1.0);
 
+  /** Estimate the memory print of the pipeline producing input, for the whole region */
+  MemoryPrintType EstimatePipelineMemoryPrint(itk::DataObject* input, const RegionType& region, double bias = 1.0);
+
+  /** Compute the available RAM in Bytes from an input value in MByte.
+   *  If the input value is 0, it uses the m_DefaultRAM value.
+   *  If m_DefaultRAM is also 0, it uses the configuration settings */
+  MemoryPrintType GetActualAvailableRAMInBytes(MemoryPrintType availableRAMInMB);
+
   /** The number of splits generated by the splitter */
   unsigned int m_ComputedNumberOfSplits;
 
@@ -114,11 +122,6 @@ private:
   StreamingManager(const StreamingManager&) = delete;
   void operator=(const StreamingManager&) = delete;
 
-  /** Compute the available RAM in Bytes from an input value in MByte.
-   *  If the input value is 0, it uses the m_DefaultRAM value.
-   *  If m_DefaultRAM is also 0, it uses the configuration settings */
-  MemoryPrintType GetActualAvailableRAMInBytes(MemoryPrintType availableRAMInMB);
-
   /** Default available RAM in MB */
   MemoryPrintType m_DefaultRAM;
 };
@@ -65,11 +65,9 @@ typename StreamingManager<TImage>::MemoryPrintType StreamingManager<TImage>::Get
 }
 
 template <class TImage>
-unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject* input, const RegionType& region, MemoryPrintType availableRAM,
-                                                                        double bias)
+typename StreamingManager<TImage>::MemoryPrintType StreamingManager<TImage>::EstimatePipelineMemoryPrint(itk::DataObject* input, const RegionType& region,
+                                                                                                         double bias)
 {
-  MemoryPrintType availableRAMInBytes = GetActualAvailableRAMInBytes(availableRAM);
-
   otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator;
   memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
 
@@ -145,6 +143,16 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
     pipelineMemoryPrint = memoryPrintCalculator->GetMemoryPrint();
   }
 
+  return pipelineMemoryPrint;
+}
+
+template <class TImage>
+unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject* input, const RegionType& region, MemoryPrintType availableRAM,
+                                                                        double bias)
+{
+  MemoryPrintType availableRAMInBytes = GetActualAvailableRAMInBytes(availableRAM);
+  MemoryPrintType pipelineMemoryPrint = this->EstimatePipelineMemoryPrint(input, region, bias);
+
   unsigned int optimalNumberOfDivisions = otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(pipelineMemoryPrint, availableRAMInBytes);
 
   otbLogMacro(Info, << "Estimated memory for full processing: " << pipelineMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbVectorImage.h"
+#include "otbMeasuredRAMStrippedStreamingManager.h"
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+typedef otb::VectorImage<unsigned short, 2> ImageType;
+
+/** Streaming manager reporting the memory set by the test instead of the
+ * one of the process */
+class FakeMeasuredRAMStrippedStreamingManager : public otb::MeasuredRAMStrippedStreamingManager<ImageType>
+{
+public:
+  typedef FakeMeasuredRAMStrippedStreamingManager Self;
+  typedef itk::SmartPointer<Self>                 Pointer;
+  itkNewMacro(Self);
+
+  bool          m_Available = true;
+  std::uint64_t m_Resident  = 100 << 20;
+  std::uint64_t m_Cache     = 0;
+
+protected:
+  bool MeasureMemory(std::uint64_t& resident, std::uint64_t& peakResident) override
+  {
+    resident     = m_Resident;
+    peakResident = m_Resident;
+    return m_Available;
+  }
+
+  std::uint64_t MeasureCacheMemory() override
+  {
+    return m_Cache;
+  }
+};
+
+/** Stream the region, the memory used by a strip being bytesPerLine per
+ * line plus cacheBytes of GDAL cache growth, and check that the strips
+ * cover the region. Returns the heights of the strips, empty on failure. */
+std::vector<unsigned long> Stream(FakeMeasuredRAMStrippedStreamingManager* manager, const ImageType::RegionType& region, double bytesPerLine,
+                                  std::uint64_t cacheBytes = 0)
+{
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(10);
+
+  const std::uint64_t baseline      = manager->m_Resident;
+  const std::uint64_t baselineCache = manager->m_Cache;
+  manager->PrepareStreaming(image, region);
+
+  std::vector<unsigned long> heights;
+  long                       nextLine = region.GetIndex(1);
+  for (unsigned int i = 0; i < manager->GetNumberOfSplits(); ++i)
+  {
+    const ImageType::RegionType split = manager->GetSplit(i);
+    if (split.GetIndex(0) != region.GetIndex(0) || split.GetSize(0) != region.GetSize(0) || split.GetIndex(1) != nextLine || split.GetSize(1) == 0)
+    {
+      std::cout << "Split " << i << " " << split << " does not follow the previous one" << std::endl;
+      return std::vector<unsigned long>();
+    }
+    nextLine += split.GetSize(1);
+    heights.push_back(split.GetSize(1));
+    // Memory used to process the split
+    manager->m_Cache    = baselineCache + cacheBytes;
+    manager->m_Resident = baseline + static_cast<std::uint64_t>(bytesPerLine * split.GetSize(1)) + cacheBytes;
+  }
+  manager->m_Resident = baseline;
+  manager->m_Cache    = baselineCache;
+
+  if (nextLine != static_cast<long>(region.GetIndex(1) + region.GetSize(1)))
+  {
+    std::cout << "The splits stop at line " << nextLine << std::endl;
+    return std::vector<unsigned long>();
+  }
+  return heights;
+}
+
+bool CheckHeights(const std::vector<unsigned long>& heights, unsigned int nbMeasures, double expected)
+{
+  if (heights.size() <= nbMeasures + 1)
+  {
+    std::cout << "Got only " << heights.size() << " splits" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 1; i < heights.size(); ++i)
+  {
+    // Strips are resized after each measure, the last one may be truncated
+    const bool checked = i > nbMeasures && i + 1 < heights.size();
+    if ((checked && std::abs(heights[i] - expected) > 1) || (i <= nbMeasures && heights[i] == 0))
+    {
+      std::cout << "Split " << i << " has " << heights[i] << " lines instead of " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int otbMeasuredRAMStrippedStreamingManager(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 10);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  const double availableRAM = 100. * 1024 * 1024;
+
+  FakeMeasuredRAMStrippedStreamingManager::Pointer manager = FakeMeasuredRAMStrippedStreamingManager::New();
+  manager->SetAvailableRAMInMB(100);
+
+  // Memory not available: the estimated strips are kept
+  manager->m_Available                      = false;
+  std::vector<unsigned long> heights        = Stream(manager, region, 0.);
+  const double               estimatedLines = heights.empty() ? 0 : heights[0];
+  if (!CheckHeights(heights, 0, estimatedLines))
+  {
+    return EXIT_FAILURE;
+  }
+  manager->m_Available = true;
+
+  // Twice the estimated memory: strips are halved
+  if (!CheckHeights(Stream(manager, region, 2 * availableRAM / estimatedLines), manager->GetNumberOfMeasuredSplits(), std::floor(estimatedLines / 2)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Growth of the GDAL cache is not accounted to the strips
+  if (!CheckHeights(Stream(manager, region, 2 * availableRAM / estimatedLines, 500 << 20), manager->GetNumberOfMeasuredSplits(),
+                    std::floor(estimatedLines / 2)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Much less than the estimated memory: strips are bounded
+  manager->SetNumberOfMeasuredSplits(1);
+  manager->SetMaximumScale(2.);
+  if (!CheckHeights(Stream(manager, region, availableRAM / estimatedLines / 100), 1, std::ceil(2 * estimatedLines)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
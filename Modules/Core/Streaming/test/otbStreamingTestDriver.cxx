@@ -24,6 +24,7 @@ void RegisterTests()
 {
   REGISTER_TEST(otbNumberOfLinesStrippedStreamingManager);
   REGISTER_TEST(otbRAMDrivenStrippedStreamingManager);
+  REGISTER_TEST(otbMeasuredRAMStrippedStreamingManager);
   REGISTER_TEST(otbTileDimensionTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenTiledStreamingManager);
   REGISTER_TEST(otbRAMDrivenAdaptativeStreamingManager);
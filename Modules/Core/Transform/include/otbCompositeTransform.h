@@ -114,6 +114,10 @@ public:
   /**  Method to transform a point. */
   SecondTransformOutputPointType TransformPoint(const FirstTransformInputPointType&) const override;
 
+  /** Transform the points by the first transformation, then by the second
+   * one, each of them processing all the points at once if it can */
+  void TransformPoints(const FirstTransformInputPointType* in, SecondTransformOutputPointType* out, std::size_t count) const override;
+
   /**  Method to transform a vector. */
   //  virtual OutputVectorType TransformVector(const InputVectorType &) const;
 
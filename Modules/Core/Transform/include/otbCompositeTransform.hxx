@@ -25,6 +25,7 @@
 
 #include "otbGenericMapProjection.h"
 #include "itkIdentityTransform.h"
+#include <vector>
 
 namespace otb
 {
@@ -55,6 +56,15 @@ CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensi
   return outputPoint;
 }
 
+template <class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(
+    const FirstTransformInputPointType* in, SecondTransformOutputPointType* out, std::size_t count) const
+{
+  std::vector<FirstTransformOutputPointType> geoPoints(count);
+  TransformPointArray(m_FirstTransform.GetPointer(), in, geoPoints.data(), count);
+  TransformPointArray(m_SecondTransform.GetPointer(), geoPoints.data(), out, count);
+}
+
 /*template<class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
   typename CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::OutputVectorType
   CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>
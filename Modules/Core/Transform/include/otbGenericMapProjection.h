@@ -83,6 +83,9 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /** Transform the points with a single call to the coordinate transformation */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t count) const override;
+
   bool IsProjectionDefined() const;
 
 protected:
@@ -23,6 +23,7 @@
 
 #include "otbGenericMapProjection.h"
 #include "otbMacro.h"
+#include <vector>
 
 namespace otb
 {
@@ -123,6 +124,36 @@ GenericMapProjection<TDirectionOfMapping, TScalarType, NInputDimensions, NOutput
   return outputPoint;
 }
 
+template <TransformDirection TDirectionOfMapping, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void GenericMapProjection<TDirectionOfMapping, TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* in,
+                                                                                                                  OutputPointType*      out,
+                                                                                                                  std::size_t           count) const
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  // Same axes in both directions: (x, y, z) or (lon, lat, h)
+  std::vector<double> x(count), y(count), z(count, 0.);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    x[i] = in[i][0];
+    y[i] = in[i][1];
+    if (InputPointType::PointDimension == 3)
+      z[i] = in[i][2];
+  }
+
+  m_MapProjection->Transform(count, x.data(), y.data(), z.data());
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out[i][0] = x[i];
+    out[i][1] = y[i];
+    if (OutputPointType::PointDimension == 3)
+      out[i][2] = z[i];
+  }
+}
 
 template <TransformDirection TDirectionOfMapping, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 bool GenericMapProjection<TDirectionOfMapping, TScalarType, NInputDimensions, NOutputDimensions>::IsProjectionDefined() const
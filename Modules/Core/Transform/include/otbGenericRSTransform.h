@@ -159,6 +159,11 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /** Transform count points at once: the map projections and the RPC
+   * models process arrays of coordinates in one call, which is much
+   * faster than transforming the points one by one. */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t count) const override;
+
   virtual void InstantiateTransform();
 
   // Get inverse methods
@@ -62,6 +62,9 @@ public:
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /** Transform the points with a single call to the RPC transformer */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t count) const override;
+
   RPCForwardTransform();
   ~RPCForwardTransform() = default;
 
@@ -22,6 +22,8 @@
 #define otbRPCInverseTransform_hxx
 
 #include "otbRPCInverseTransform.h"
+#include <stdexcept>
+#include <vector>
 
 namespace otb
 {
@@ -53,6 +55,33 @@ RPCInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t count) const
+{
+  if (count == 0)
+    return;
+
+  std::vector<double> x(count), y(count), z(count, 0.);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    x[i] = static_cast<double>(in[i][0]);
+    y[i] = static_cast<double>(in[i][1]);
+    if (NInputDimensions > 2)
+      z[i] = static_cast<double>(in[i][2]);
+  }
+
+  if (!this->m_Transformer->InverseTransform(x.data(), y.data(), z.data(), static_cast<int>(count)))
+    throw std::runtime_error("GDALRPCTransform was not able to process the InverseTransform.");
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out[i][0] = static_cast<TScalarType>(x[i]);
+    out[i][1] = static_cast<TScalarType>(y[i]);
+    if (NOutputDimensions > 2)
+      out[i][2] = static_cast<TScalarType>(z[i]);
+  }
+}
+
 /**
  * PrintSelf method
  */
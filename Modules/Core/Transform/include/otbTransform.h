@@ -23,6 +23,7 @@
 
 #include "itkTransform.h"
 #include "vnl/vnl_vector_fixed.h"
+#include <cstddef>
 
 
 namespace otb
@@ -106,6 +107,17 @@ public:
     return OutputPointType();
   }
 
+  /** Transform count points at once. The default implementation calls
+   * TransformPoint() on each point, transforms able to process arrays
+   * of coordinates in one call override it. */
+  virtual void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t count) const
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      out[i] = this->TransformPoint(in[i]);
+    }
+  }
+
   using Superclass::TransformVector;
   /**  Method to transform a vector. */
   OutputVectorType TransformVector(const InputVectorType&) const override
@@ -255,6 +267,26 @@ private:
   Transform(const Self&) = delete;
   void operator=(const Self&) = delete;
 };
+
+/** Transform count points with any itk::Transform: in one call when it
+ * is an otb::Transform, point by point otherwise */
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void TransformPointArray(const itk::Transform<TScalarType, NInputDimensions, NOutputDimensions>* transform,
+                         const itk::Point<TScalarType, NInputDimensions>* in, itk::Point<TScalarType, NOutputDimensions>* out, std::size_t count)
+{
+  typedef Transform<TScalarType, NInputDimensions, NOutputDimensions> OTBTransformType;
+  const OTBTransformType* otbTransform = dynamic_cast<const OTBTransformType*>(transform);
+  if (otbTransform != nullptr)
+  {
+    otbTransform->TransformPoints(in, out, count);
+    return;
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out[i] = transform->TransformPoint(in[i]);
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -182,7 +182,24 @@ int otbRPCTransformTest(int argc, char* argv[])
        success = false;
      }
   }
-  
+
+  // Batched transforms must give the same points as the point by point ones
+  PointsContainerType batchGeoPoints(pointsContainer.size());
+  PointsContainerType batchImagePoints(geo3dPointsContainer.size());
+  GenericRSTransform_img2wgs->TransformPoints(pointsContainer.data(), batchGeoPoints.data(), pointsContainer.size());
+  GenericRSTransform_wgs2img->TransformPoints(geo3dPointsContainer.data(), batchImagePoints.data(), geo3dPointsContainer.size());
+  for (std::size_t i = 0; i < pointsContainer.size() && i < geo3dPointsContainer.size(); ++i)
+  {
+    geo3dPoint = GenericRSTransform_img2wgs->TransformPoint(pointsContainer[i]);
+    imagePoint = GenericRSTransform_wgs2img->TransformPoint(geo3dPointsContainer[i]);
+    if (imgDistance->Evaluate(batchGeoPoints[i], geo3dPoint) > 1e-9 || imgDistance->Evaluate(batchImagePoints[i], imagePoint) > 1e-9)
+    {
+      std::cerr << "Batched and point by point transforms differ: " << batchGeoPoints[i] << " / " << geo3dPoint << ", " << batchImagePoints[i] << " / "
+                << imagePoint << std::endl;
+      success = false;
+    }
+  }
+
   if (success)
     return EXIT_SUCCESS;
   else
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbWrapperCommandLineBatchLauncher_h
+#define otbWrapperCommandLineBatchLauncher_h
+
+#include "otbWrapperApplication.h"
+
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class CommandLineBatchLauncher
+ *  \brief Run a stream of command lines in a single process.
+ *
+ * Each line of the stream is a job, written as the arguments of the
+ * command line launcher: the application name, optionally followed by
+ * module paths, then the parameters. Words are separated by spaces,
+ * and can be quoted with simple or double quotes. Empty lines and
+ * lines starting with '#' are ignored.
+ *
+ * The module paths of the jobs are registered by the batch launcher,
+ * once for each distinct path, and removed from the jobs. As the
+ * registration changes the environment of the process, a new path is
+ * registered only once the running jobs are over.
+ *
+ * Jobs are run by a CommandLineLauncher each, NumberOfJobs of them
+ * at the same time, and the available threads are shared among them.
+ * Jobs start as soon as their line is read, so that the stream can be
+ * fed on the fly (a named pipe for instance). The status and the
+ * duration of each job are reported on the standard output.
+ *
+ * Running jobs in one process saves the initializations done once per
+ * process: one instance of each application is kept during the batch,
+ * so that its plugin stays loaded, and GDAL drivers, DEM directories
+ * and geoid files are opened once. As the elevation settings are
+ * process wide, concurrent jobs should use the same ones.
+ *
+ * \ingroup OTBCommandLine
+ */
+
+class ITK_ABI_EXPORT CommandLineBatchLauncher : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef CommandLineBatchLauncher      Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Defining ::New() static method */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(CommandLineBatchLauncher, itk::Object);
+
+  /** Number of jobs run at the same time (1 by default) */
+  itkSetClampMacro(NumberOfJobs, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfJobs, unsigned int);
+
+  /** Results of the last run */
+  itkGetConstMacro(NumberOfSucceededJobs, unsigned int);
+  itkGetConstMacro(NumberOfFailedJobs, unsigned int);
+
+  /** Run the jobs read from a stream, until its end.
+   * Returns true if all the jobs succeeded.
+   */
+  bool Run(std::istream& is);
+
+  /** Run the jobs read from a file, "-" being the standard input */
+  bool Run(const std::string& filename);
+
+  /** Split a job line into words. Returns false if a quote is not
+   * closed.
+   */
+  static bool SplitJobLine(const std::string& line, std::vector<std::string>& words);
+
+protected:
+  /** Constructor */
+  CommandLineBatchLauncher();
+
+  /** Destructor */
+  ~CommandLineBatchLauncher() override;
+
+private:
+  CommandLineBatchLauncher(const CommandLineBatchLauncher&) = delete;
+  void operator=(const CommandLineBatchLauncher&) = delete;
+
+  struct JobType
+  {
+    unsigned int             Id;
+    unsigned int             Line;
+    std::vector<std::string> Words;
+  };
+
+  /** Register the module paths of a job that are not registered yet,
+   * and remove them from the job. Returns false if a path is invalid.
+   */
+  bool RegisterModulePaths(JobType& job);
+
+  /** Run the jobs of the queue until it is closed and empty */
+  void ProcessJobs();
+
+  /** Run one job, returns true if it succeeded */
+  bool RunJob(const JobType& job);
+
+  /** Keep an instance of the application during the batch */
+  void KeepApplication(const std::string& name);
+
+  /** Print a line of the report */
+  void Report(const std::string& message);
+
+  unsigned int m_NumberOfJobs;
+  unsigned int m_NumberOfSucceededJobs;
+  unsigned int m_NumberOfFailedJobs;
+
+  std::mutex              m_QueueMutex;
+  std::condition_variable m_QueueCondition;
+  std::condition_variable m_IdleCondition;
+  std::deque<JobType>     m_Queue;
+  unsigned int            m_NumberOfRunningJobs;
+  bool                    m_EndOfStream;
+
+  std::set<std::string> m_ModulePaths;
+
+  std::mutex                                  m_ApplicationsMutex;
+  std::map<std::string, Application::Pointer> m_Applications;
+
+  std::mutex m_ReportMutex;
+
+}; // end class
+
+} // end namespace Wrapper
+} // end namespace otb
+
+#endif // otbWrapperCommandLineBatchLauncher_h_
@@ -20,8 +20,11 @@
 
 
 #include "otbWrapperCommandLineLauncher.h"
+#include "otbWrapperCommandLineBatchLauncher.h"
 #include "otbConfigurationManager.h"
 #include "otb_tinyxml.h"
+#include <algorithm>
+#include <cstdlib>
 #include <vector>
 
 std::string CleanWord(const std::string& word)
@@ -41,6 +44,35 @@ std::string CleanWord(const std::string& word)
 void ShowUsage(char* argv[])
 {
   std::cerr << "Usage: " << argv[0] << " module_name [MODULEPATH] [arguments]" << std::endl;
+  std::cerr << "       " << argv[0] << " -batch [-jobs N] [job_file]" << std::endl;
+}
+
+int RunBatch(const std::vector<std::string>& vexp, char* argv[])
+{
+  unsigned int nbJobs   = 1;
+  std::string  filename = "-";
+  for (std::size_t i = 1; i < vexp.size(); ++i)
+  {
+    if (vexp[i] == "-jobs" && i + 1 < vexp.size())
+    {
+      nbJobs = static_cast<unsigned int>(std::max(1, std::atoi(vexp[++i].c_str())));
+    }
+    else if (i + 1 == vexp.size())
+    {
+      filename = vexp[i];
+    }
+    else
+    {
+      ShowUsage(argv);
+      return EXIT_FAILURE;
+    }
+  }
+
+  typedef otb::Wrapper::CommandLineBatchLauncher BatchLauncherType;
+  BatchLauncherType::Pointer                     launcher = BatchLauncherType::New();
+  launcher->SetNumberOfJobs(nbJobs);
+
+  return launcher->Run(filename) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 int main(int argc, char* argv[])
@@ -75,6 +107,11 @@ int main(int argc, char* argv[])
 
   otb::ConfigurationManager::InitOpenMPThreads();
 
+  if (vexp[0] == "-batch")
+  {
+    return RunBatch(vexp, argv);
+  }
+
   typedef otb::Wrapper::CommandLineLauncher LauncherType;
   LauncherType::Pointer                     launcher = LauncherType::New();
 
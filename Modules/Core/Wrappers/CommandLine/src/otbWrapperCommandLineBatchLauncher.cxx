@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperCommandLineBatchLauncher.h"
+#include "otbWrapperCommandLineLauncher.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "otbConfigurationManager.h"
+#include "otbStopwatch.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+CommandLineBatchLauncher::CommandLineBatchLauncher()
+  : m_NumberOfJobs(1), m_NumberOfSucceededJobs(0), m_NumberOfFailedJobs(0), m_NumberOfRunningJobs(0), m_EndOfStream(false)
+{
+}
+
+CommandLineBatchLauncher::~CommandLineBatchLauncher()
+{
+  m_Applications.clear();
+  ApplicationRegistry::CleanRegistry();
+}
+
+bool CommandLineBatchLauncher::SplitJobLine(const std::string& line, std::vector<std::string>& words)
+{
+  words.clear();
+
+  std::string word;
+  bool        inWord = false;
+  char        quote  = '\0';
+  for (char c : line)
+  {
+    if (quote != '\0')
+    {
+      if (c == quote)
+        quote = '\0';
+      else
+        word += c;
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote  = c;
+      inWord = true;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    {
+      if (inWord)
+        words.push_back(word);
+      word.clear();
+      inWord = false;
+    }
+    else if (c == '#' && !inWord && words.empty())
+    {
+      // Comment line
+      return true;
+    }
+    else
+    {
+      word += c;
+      inWord = true;
+    }
+  }
+
+  if (quote != '\0')
+  {
+    words.clear();
+    return false;
+  }
+  if (inWord)
+    words.push_back(word);
+  return true;
+}
+
+bool CommandLineBatchLauncher::Run(const std::string& filename)
+{
+  if (filename == "-")
+  {
+    return this->Run(std::cin);
+  }
+
+  std::ifstream ifs(filename);
+  if (!ifs)
+  {
+    std::cerr << "ERROR: Can not open the job file \"" << filename << "\"." << std::endl;
+    return false;
+  }
+  return this->Run(ifs);
+}
+
+bool CommandLineBatchLauncher::Run(std::istream& is)
+{
+  m_NumberOfSucceededJobs = 0;
+  m_NumberOfFailedJobs    = 0;
+  m_NumberOfRunningJobs   = 0;
+  m_EndOfStream           = false;
+  m_Queue.clear();
+
+  // Share the threads among the jobs
+  if (m_NumberOfJobs > 1)
+  {
+    const unsigned int nbThreads = std::max(1u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() / m_NumberOfJobs);
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(nbThreads);
+    ConfigurationManager::InitOpenMPThreads();
+  }
+
+  Stopwatch chrono = Stopwatch::StartNew();
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < m_NumberOfJobs; ++i)
+  {
+    workers.emplace_back(&Self::ProcessJobs, this);
+  }
+
+  std::string  line;
+  unsigned int lineNumber = 0;
+  unsigned int nbJobs     = 0;
+  while (std::getline(is, line))
+  {
+    ++lineNumber;
+    JobType job;
+    job.Line = lineNumber;
+    if (!SplitJobLine(line, job.Words))
+    {
+      std::ostringstream oss;
+      oss << "Line " << lineNumber << ": unbalanced quotes, skipped";
+      this->Report(oss.str());
+      std::lock_guard<std::mutex> lock(m_ReportMutex);
+      ++m_NumberOfFailedJobs;
+      continue;
+    }
+    if (job.Words.empty())
+    {
+      continue;
+    }
+    job.Id = ++nbJobs;
+
+    if (!this->RegisterModulePaths(job))
+    {
+      std::ostringstream oss;
+      oss << "Job " << job.Id << " (line " << lineNumber << "): " << job.Words[0] << " failed, invalid module path";
+      this->Report(oss.str());
+      std::lock_guard<std::mutex> lock(m_ReportMutex);
+      ++m_NumberOfFailedJobs;
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    m_Queue.push_back(job);
+    m_QueueCondition.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    m_EndOfStream = true;
+  }
+  m_QueueCondition.notify_all();
+
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+  chrono.Stop();
+
+  std::ostringstream oss;
+  oss << "Batch: " << m_NumberOfSucceededJobs << " job(s) succeeded, " << m_NumberOfFailedJobs << " failed in " << chrono.GetElapsedMilliseconds() / 1000.
+      << " s";
+  this->Report(oss.str());
+
+  return m_NumberOfFailedJobs == 0;
+}
+
+bool CommandLineBatchLauncher::RegisterModulePaths(JobType& job)
+{
+  // Module paths are the words between the application name and the
+  // first key, as parsed by CommandLineParser::GetPaths()
+  auto                     firstKey = job.Words.begin() + 1;
+  std::vector<std::string> newPaths;
+  for (; firstKey != job.Words.end() && !firstKey->empty() && (*firstKey)[0] != '-'; ++firstKey)
+  {
+    const std::string fullPath = itksys::SystemTools::CollapseFullPath(*firstKey);
+    if (!itksys::SystemTools::FileIsDirectory(fullPath))
+    {
+      std::cerr << "ERROR: Job " << job.Id << ": invalid module path: " << fullPath << std::endl;
+      return false;
+    }
+    if (m_ModulePaths.find(fullPath) == m_ModulePaths.end() && std::find(newPaths.begin(), newPaths.end(), fullPath) == newPaths.end())
+    {
+      newPaths.push_back(fullPath);
+    }
+  }
+  job.Words.erase(job.Words.begin() + 1, firstKey);
+
+  if (!newPaths.empty())
+  {
+    // AddApplicationPath() sets an environment variable: wait for the
+    // running jobs to be over, and keep the queue locked meanwhile, so
+    // that no job reads the environment at the same time.
+    std::unique_lock<std::mutex> lock(m_QueueMutex);
+    m_IdleCondition.wait(lock, [this] { return m_Queue.empty() && m_NumberOfRunningJobs == 0; });
+    for (const auto& path : newPaths)
+    {
+      ApplicationRegistry::AddApplicationPath(path);
+      m_ModulePaths.insert(path);
+    }
+  }
+  return true;
+}
+
+void CommandLineBatchLauncher::ProcessJobs()
+{
+  while (true)
+  {
+    JobType job;
+    {
+      std::unique_lock<std::mutex> lock(m_QueueMutex);
+      m_QueueCondition.wait(lock, [this] { return !m_Queue.empty() || m_EndOfStream; });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      job = std::move(m_Queue.front());
+      m_Queue.pop_front();
+      ++m_NumberOfRunningJobs;
+    }
+
+    Stopwatch  chrono  = Stopwatch::StartNew();
+    const bool success = this->RunJob(job);
+    chrono.Stop();
+
+    std::ostringstream oss;
+    oss << "Job " << job.Id << " (line " << job.Line << "): " << job.Words[0] << (success ? " succeeded" : " failed") << " in "
+        << chrono.GetElapsedMilliseconds() / 1000. << " s";
+    this->Report(oss.str());
+
+    {
+      std::lock_guard<std::mutex> lock(m_ReportMutex);
+      if (success)
+        ++m_NumberOfSucceededJobs;
+      else
+        ++m_NumberOfFailedJobs;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      --m_NumberOfRunningJobs;
+    }
+    m_IdleCondition.notify_all();
+  }
+}
+
+bool CommandLineBatchLauncher::RunJob(const JobType& job)
+{
+  try
+  {
+    CommandLineLauncher::Pointer launcher = CommandLineLauncher::New();
+    if (!launcher->Load(job.Words))
+    {
+      return false;
+    }
+    this->KeepApplication(job.Words[0]);
+    return launcher->ExecuteAndWriteOutput();
+  }
+  catch (std::exception& err)
+  {
+    std::cerr << "ERROR: Job " << job.Id << ": " << err.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "ERROR: Job " << job.Id << ": unknown exception" << std::endl;
+  }
+  return false;
+}
+
+void CommandLineBatchLauncher::KeepApplication(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(m_ApplicationsMutex);
+  if (m_Applications.find(name) == m_Applications.end())
+  {
+    m_Applications[name] = ApplicationRegistry::CreateApplication(name);
+  }
+}
+
+void CommandLineBatchLauncher::Report(const std::string& message)
+{
+  std::lock_guard<std::mutex> lock(m_ReportMutex);
+  std::cout << message << std::endl;
+}
+
+} // end namespace Wrapper
+} // end namespace otb
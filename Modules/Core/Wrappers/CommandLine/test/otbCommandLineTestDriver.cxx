@@ -22,6 +22,7 @@
 
 void RegisterTests()
 {
+  REGISTER_TEST(otbWrapperCommandLineBatchLauncherTest);
   REGISTER_TEST(otbWrapperCommandLineLauncherTest);
   REGISTER_TEST(otbWrapperCommandLineParserTest1);
   REGISTER_TEST(otbWrapperCommandLineParserTest2);
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperCommandLineBatchLauncher.h"
+#include <iostream>
+#include <sstream>
+
+
+int otbWrapperCommandLineBatchLauncherTest(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " module_path input_image output_prefix" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string path(argv[1]);
+  const std::string input(argv[2]);
+  const std::string prefix(argv[3]);
+
+  typedef otb::Wrapper::CommandLineBatchLauncher LauncherType;
+
+  std::vector<std::string> words;
+  if (!LauncherType::SplitJobLine("  App  -key 'a b' \"c'd\" e\"f g\"  ", words) || words.size() != 5 || words[2] != "a b" || words[3] != "c'd" ||
+      words[4] != "ef g")
+  {
+    std::cerr << "Wrong split of a quoted line" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!LauncherType::SplitJobLine("  # App -key value", words) || !words.empty())
+  {
+    std::cerr << "Wrong split of a comment line" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (LauncherType::SplitJobLine("App -key 'value", words))
+  {
+    std::cerr << "Unbalanced quotes not detected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Two valid jobs, a missing parameter, an invalid module path and a
+  // line with unbalanced quotes
+  std::ostringstream jobs;
+  jobs << "# DynamicConvert jobs\n";
+  jobs << "DynamicConvert " << path << " -in " << input << " -out " << prefix << "1.tif -outmin 15 -outmax 200\n";
+  jobs << "\n";
+  jobs << "DynamicConvert \"" << path << "\" -in \"" << input << "\" -out '" << prefix << "2.tif' uint8\n";
+  jobs << "DynamicConvert " << path << " -in " << input << "\n";
+  jobs << "DynamicConvert " << prefix << "_no_such_dir -in " << input << " -out " << prefix << "3.tif\n";
+  jobs << "DynamicConvert " << path << " -in \"" << input << "\n";
+
+  LauncherType::Pointer launcher = LauncherType::New();
+  launcher->SetNumberOfJobs(2);
+  std::istringstream is(jobs.str());
+  const bool success = launcher->Run(is);
+
+  if (success || launcher->GetNumberOfSucceededJobs() != 2 || launcher->GetNumberOfFailedJobs() != 3)
+  {
+    std::cerr << "Expected 2 succeeded and 3 failed jobs, got " << launcher->GetNumberOfSucceededJobs() << " and " << launcher->GetNumberOfFailedJobs()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
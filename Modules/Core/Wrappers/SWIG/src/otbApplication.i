@@ -498,6 +498,16 @@ public:
     img->SetBufferedRegion(bufferRegion);
     dynamic_cast<otb::ImageCommons*>(img)->SetImageMetadata(metadata);
     }
+
+  itk::ImageRegion<2> GetImageBufferedRegion_(std::string pkey)
+    {
+    ImageBaseType* img = $self->GetParameterOutputImage(pkey);
+    itk::ImageRegion<2> largest = img->GetLargestPossibleRegion();
+    itk::ImageRegion<2> buffered = img->GetBufferedRegion();
+    buffered.SetIndex(0, buffered.GetIndex(0) - largest.GetIndex(0));
+    buffered.SetIndex(1, buffered.GetIndex(1) - largest.GetIndex(1));
+    return buffered;
+    }
 } /* end of %extend */
 #endif /* OTB_SWIGNUMPY */
 
@@ -888,6 +898,45 @@ class ApplicationProxy(object):
       img = self.SetVectorImageFromNumpyArray(paramKey, pyImg["array"], index)
       self.SetupImageInformation(img, pyImg["origin"], pyImg["spacing"], pyImg["size"], pyImg["region"], pyImg["metadata"])
 
+    def IterateImageTiles(self, paramKey, ram=None, nbLinesPerTile=None):
+      """
+      Stream an output image parameter: this generator updates the pipeline
+      on one strip of lines at a time, and yields (region, array) pairs. The
+      array is a numpy view on the output buffer (no copy), with shape
+      (lines, columns, bands): it is only valid until the next iteration,
+      copy it to keep it. The region is relative to the image origin, as in
+      PropagateRequestedRegion.
+      The strips fit in ram megabytes (default: OTB_MAX_RAM_HINT, or 256),
+      unless nbLinesPerTile is given.
+      The application must have been executed (Execute()).
+      """
+      import math
+      import os
+      size = self.GetImageSize(paramKey)
+      width, height = size[0], size[1]
+      if nbLinesPerTile is None:
+        if ram is None:
+          ram = int(os.environ.get("OTB_MAX_RAM_HINT", 256))
+        full = itkRegion()
+        full.SetSize(size)
+        memory = self.PropagateRequestedRegion(paramKey, full)
+        nbTiles = max(1, int(math.ceil(memory / (ram * 1024. * 1024.))))
+        nbLinesPerTile = int(math.ceil(height / float(nbTiles)))
+      nbLinesPerTile = max(1, nbLinesPerTile)
+      for y in range(0, height, nbLinesPerTile):
+        region = itkRegion()
+        region.SetIndex(0, 0)
+        region.SetIndex(1, y)
+        region.SetSize(0, width)
+        region.SetSize(1, min(nbLinesPerTile, height - y))
+        self.PropagateRequestedRegion(paramKey, region)
+        array = self.GetVectorImageAsNumpyArray(paramKey)
+        # The buffer may be larger than the tile if it was already computed
+        buffered = self.GetImageBufferedRegion_(paramKey)
+        offsetX = region.GetIndex(0) - buffered.GetIndex(0)
+        offsetY = region.GetIndex(1) - buffered.GetIndex(1)
+        yield region, array[offsetY:offsetY + region.GetSize(1), offsetX:offsetX + region.GetSize(0), :]
+
     def ExportImage(self, paramKey):
       """
       Export an output image from an otbApplication into a python dictionary with the
@@ -957,6 +1006,7 @@ public:
 };
 
 %include "PyCommand.i"
+%include "otbPythonTileFilter.i"
 
 %extend itkMetaDataDictionary
 {
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if SWIGPYTHON
+
+class PythonTileFilter : public itkProcessObject
+{
+public:
+  static PythonTileFilter_Pointer New();
+  void SetCallable(PyObject *obj);
+  PyObject * GetCallable();
+  void SetInputImage(ImageBaseType * image);
+  ImageBaseType * GetOutputImage();
+  void SetNumberOfOutputBands(unsigned int nbBands);
+  unsigned int GetNumberOfOutputBands() const;
+  void SetRadius(unsigned int radius);
+  unsigned int GetRadius() const;
+protected:
+  PythonTileFilter();
+};
+DECLARE_REF_COUNT_CLASS( PythonTileFilter )
+
+#if OTB_SWIGNUMPY
+%pythoncode
+  {
+  def _MakeNumpyTileCallable(function, radius):
+    """
+    Callable given to PythonTileFilter: wraps its buffers in numpy arrays
+    and calls function on the input tile (padded by radius)
+    """
+    import numpy
+    def process(inBuffer, inBuffered, nbInBands, inRequested, outBuffer, outRegion, nbOutBands):
+      bx, by, bw, bh = inBuffered
+      rx, ry, rw, rh = inRequested
+      ox, oy, ow, oh = outRegion
+      tile = numpy.frombuffer(inBuffer, dtype=numpy.float32).reshape((bh, bw, nbInBands))
+      tile = tile[ry - by:ry - by + rh, rx - bx:rx - bx + rw, :]
+      # At the image borders, the margin is the nearest pixel value
+      padding = ((ry - oy + radius, oy + oh + radius - ry - rh),
+                 (rx - ox + radius, ox + ow + radius - rx - rw),
+                 (0, 0))
+      if any(before or after for before, after in padding):
+        tile = numpy.pad(tile, padding, mode='edge')
+      result = numpy.asarray(function(tile))
+      if result.ndim == 2:
+        result = result[:, :, numpy.newaxis]
+      out = numpy.frombuffer(outBuffer, dtype=numpy.float32).reshape((oh, ow, nbOutBands))
+      out[...] = result
+    return process
+
+  class NumpyTileFilter(object):
+    """
+    Processing stage calling a Python function on numpy tiles. It can be
+    inserted between two applications connected in memory, and keeps the
+    streaming of the downstream writer: the function is called on each
+    requested tile only.
+
+    The function takes the input tile, as a float32 array of shape
+    (lines + 2 * radius, columns + 2 * radius, bands), and returns the
+    output tile, of shape (lines, columns, nbBands). The input tile is a
+    read-only view on the pipeline buffer, valid during the call only. At
+    the image borders, the margin repeats the nearest pixels.
+
+    The stage must be kept alive while the downstream application runs:
+
+      app1.Execute()
+      ndvi = NumpyTileFilter(lambda t: (t[..., 3] - t[..., 2]) / (t[..., 3] + t[..., 2]), nbBands=1)
+      ndvi.SetInput(app1.GetParameterOutputImage("out"))
+      app2.SetParameterInputImage("in", ndvi.GetOutput())
+      app2.ExecuteAndWriteOutput()
+    """
+    def __init__(self, function, nbBands=0, radius=0):
+      """
+      nbBands is the number of output bands (0 for the number of input
+      bands) and radius the margin of the input tiles
+      """
+      self.filter = PythonTileFilter.New()
+      self.filter.SetNumberOfOutputBands(nbBands)
+      self.filter.SetRadius(radius)
+      self.filter.SetCallable(_MakeNumpyTileCallable(function, radius))
+
+    def SetInput(self, image):
+      """
+      Set the input image, for instance an output image parameter of an
+      application. Any pixel type is cast to float.
+      """
+      self.filter.SetInputImage(image)
+
+    def GetOutput(self):
+      """
+      Output image, to give to an input image parameter of an application
+      """
+      return self.filter.GetOutputImage()
+  }
+#endif /* OTB_SWIGNUMPY */
+
+#endif
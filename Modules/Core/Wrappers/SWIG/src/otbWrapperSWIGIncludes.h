@@ -41,6 +41,7 @@ typedef otb::Wrapper::ImageBaseType ImageBaseType;
 #include "otbPythonLogOutput.h"
 #include "otbLogger.h"
 #include "otbProgressReporterManager.h"
+#include "otbPythonTileFilter.h"
 
 typedef otb::Logger                           Logger;
 typedef otb::Logger::Pointer                  Logger_Pointer;
@@ -49,6 +50,8 @@ typedef otb::PythonLogOutput                  PythonLogOutput;
 typedef otb::PythonLogOutput::Pointer         PythonLogOutput_Pointer;
 typedef otb::ProgressReporterManager          ProgressReporterManager;
 typedef otb::ProgressReporterManager::Pointer ProgressReporterManager_Pointer;
+typedef otb::PythonTileFilter                 PythonTileFilter;
+typedef otb::PythonTileFilter::Pointer        PythonTileFilter_Pointer;
 #endif
 
 #endif
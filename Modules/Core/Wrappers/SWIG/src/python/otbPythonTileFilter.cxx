@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPythonTileFilter.h"
+
+namespace
+{
+// Wrapper to automatics obtain and release GIL
+// RAII idiom
+class PyGILStateEnsure
+{
+public:
+  PyGILStateEnsure() : m_GIL(PyGILState_Ensure())
+  {
+  }
+  ~PyGILStateEnsure()
+  {
+    PyGILState_Release(m_GIL);
+  }
+
+private:
+  PyGILState_STATE m_GIL;
+};
+
+PyObject* BuildRegion(const otb::PythonTileFilter::RegionType& region)
+{
+  return Py_BuildValue("(llkk)", static_cast<long>(region.GetIndex(0)), static_cast<long>(region.GetIndex(1)),
+                       static_cast<unsigned long>(region.GetSize(0)), static_cast<unsigned long>(region.GetSize(1)));
+}
+} // end anonymous namespace
+
+namespace otb
+{
+
+PythonTileFilter::PythonTileFilter() : m_Callable(nullptr), m_NumberOfOutputBands(0), m_Radius(0)
+{
+  m_InputCaster = Wrapper::InputImageParameter::New();
+}
+
+PythonTileFilter::~PythonTileFilter()
+{
+  this->SetCallable(nullptr);
+}
+
+void PythonTileFilter::SetCallable(PyObject* obj)
+{
+  if (obj != m_Callable)
+  {
+    PyGILStateEnsure gil;
+    if (m_Callable)
+    {
+      Py_DECREF(m_Callable);
+    }
+    m_Callable = obj;
+    if (m_Callable)
+    {
+      Py_INCREF(m_Callable);
+    }
+    this->Modified();
+  }
+}
+
+PyObject* PythonTileFilter::GetCallable()
+{
+  return m_Callable;
+}
+
+void PythonTileFilter::SetInputImage(Wrapper::ImageBaseType* image)
+{
+  m_InputCaster->SetImage(image);
+  this->SetInput(m_InputCaster->GetFloatVectorImage());
+}
+
+Wrapper::ImageBaseType* PythonTileFilter::GetOutputImage()
+{
+  return this->GetOutput();
+}
+
+void PythonTileFilter::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (m_NumberOfOutputBands > 0)
+  {
+    this->GetOutput()->SetNumberOfComponentsPerPixel(m_NumberOfOutputBands);
+  }
+}
+
+void PythonTileFilter::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  ImageType* input = const_cast<ImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+  RegionType requested = this->GetOutput()->GetRequestedRegion();
+  requested.PadByRadius(m_Radius);
+  requested.Crop(input->GetLargestPossibleRegion());
+  input->SetRequestedRegion(requested);
+}
+
+void PythonTileFilter::GenerateData()
+{
+  this->AllocateOutputs();
+
+  if (!PyCallable_Check(m_Callable))
+  {
+    itkExceptionMacro(<< "The callable is not a callable Python object, or it has not been set.");
+  }
+
+  const ImageType* input  = this->GetInput();
+  ImageType*       output = this->GetOutput();
+
+  const RegionType&  inputBuffer    = input->GetBufferedRegion();
+  const unsigned int nbInputBands   = input->GetNumberOfComponentsPerPixel();
+  const RegionType&  outputRegion   = output->GetBufferedRegion();
+  const unsigned int nbOutputBands  = output->GetNumberOfComponentsPerPixel();
+  const Py_ssize_t   inputByteSize  = inputBuffer.GetNumberOfPixels() * nbInputBands * sizeof(ImageType::InternalPixelType);
+  const Py_ssize_t   outputByteSize = outputRegion.GetNumberOfPixels() * nbOutputBands * sizeof(ImageType::InternalPixelType);
+  char*              inputValues    = reinterpret_cast<char*>(const_cast<ImageType::InternalPixelType*>(input->GetBufferPointer()));
+  char*              outputValues   = reinterpret_cast<char*>(output->GetBufferPointer());
+
+  PyGILStateEnsure gil;
+  PyObject* args = Py_BuildValue("(NNINNNI)", PyMemoryView_FromMemory(inputValues, inputByteSize, PyBUF_READ), BuildRegion(inputBuffer), nbInputBands,
+                                 BuildRegion(input->GetRequestedRegion()), PyMemoryView_FromMemory(outputValues, outputByteSize, PyBUF_WRITE),
+                                 BuildRegion(outputRegion), nbOutputBands);
+  PyObject* result = args ? PyObject_CallObject(m_Callable, args) : nullptr;
+  Py_XDECREF(args);
+
+  if (result)
+  {
+    Py_DECREF(result);
+  }
+  else
+  {
+    // Print the Python error, and raise an exception for the invoking Python code
+    PyErr_Print();
+    itkExceptionMacro(<< "There was an error executing the callable.");
+  }
+}
+
+} // end namespace otb
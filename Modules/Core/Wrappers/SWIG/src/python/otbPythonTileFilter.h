@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPythonTileFilter_h
+#define otbPythonTileFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbWrapperInputImageParameter.h"
+
+// The python header defines _POSIX_C_SOURCE without a preceding #undef
+#undef _POSIX_C_SOURCE
+// The python header defines _XOPEN_SOURCE without a preceding #undef
+#undef _XOPEN_SOURCE
+
+#include <Python.h>
+
+namespace otb
+{
+
+/** \class PythonTileFilter
+ *  \brief Filter computing each requested region with a Python callable.
+ *
+ * This filter can be inserted between two applications connected in
+ * memory: the downstream writer keeps streaming, and each requested
+ * region of the output is computed by calling the Python callable on the
+ * matching region of the input, padded by the radius. The input and
+ * output buffers are given to the callable as memoryviews, without copy.
+ *
+ * The callable is called with the following arguments:
+ * - the input buffer (read only) and its buffered region,
+ * - the number of input bands and the requested input region,
+ * - the output buffer (writable), the output region and the number of
+ *   output bands.
+ * Regions are (x, y, width, height) tuples, bands are interleaved.
+ * The memoryviews are only valid during the call.
+ *
+ * Input images of any pixel type are cast to float. The numpy interface
+ * (NumpyTileFilter in the otbApplication module) wraps this filter.
+ */
+class PythonTileFilter : public itk::ImageToImageFilter<Wrapper::FloatVectorImageType, Wrapper::FloatVectorImageType>
+{
+public:
+  /** Standard class typedefs. */
+  typedef PythonTileFilter                                                                       Self;
+  typedef itk::ImageToImageFilter<Wrapper::FloatVectorImageType, Wrapper::FloatVectorImageType> Superclass;
+  typedef itk::SmartPointer<Self>                                                                Pointer;
+  typedef itk::SmartPointer<const Self>                                                          ConstPointer;
+
+  itkTypeMacro(PythonTileFilter, itk::ImageToImageFilter);
+
+  itkNewMacro(PythonTileFilter);
+
+  typedef Wrapper::FloatVectorImageType ImageType;
+  typedef ImageType::RegionType         RegionType;
+
+  /** Set the Python callable processing the regions. The filter keeps a
+   * reference to it. */
+  void SetCallable(PyObject* obj);
+  PyObject* GetCallable();
+
+  /** Set the input image, of any pixel type */
+  void SetInputImage(Wrapper::ImageBaseType* image);
+
+  /** Output image, to give to an input image parameter */
+  Wrapper::ImageBaseType* GetOutputImage();
+
+  /** Number of output bands (0 for the number of input bands) */
+  itkSetMacro(NumberOfOutputBands, unsigned int);
+  itkGetMacro(NumberOfOutputBands, unsigned int);
+
+  /** Margin of the input regions, for neighborhood processing */
+  itkSetMacro(Radius, unsigned int);
+  itkGetMacro(Radius, unsigned int);
+
+protected:
+  PythonTileFilter();
+  ~PythonTileFilter() override;
+
+  void GenerateOutputInformation() override;
+  void GenerateInputRequestedRegion() override;
+  void GenerateData() override;
+
+private:
+  PythonTileFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  PyObject*    m_Callable;
+  unsigned int m_NumberOfOutputBands;
+  unsigned int m_Radius;
+
+  /** Casts the input image to float */
+  Wrapper::InputImageParameter::Pointer m_InputCaster;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+#-*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+#
+#  Example on streaming applications with numpy tiles
+#
+
+import numpy as np
+
+def test(otb, argv):
+  # Stream the output of an application by strips of 20 lines
+  app = otb.Registry.CreateApplication("ExtractROI")
+  app.SetParameterString("in", argv[1])
+  app.SetParameterOutputImagePixelType("out", otb.ImagePixelType_float)
+  app.Execute()
+
+  strips = []
+  for region, array in app.IterateImageTiles("out", nbLinesPerTile=20):
+    assert array.shape[0] == region.GetSize(1) and array.shape[1] == region.GetSize(0)
+    assert region.GetSize(1) <= 20
+    strips.append(array.copy())
+  streamed = np.concatenate(strips, axis=0)
+
+  app2 = otb.Registry.CreateApplication("ExtractROI")
+  app2.SetParameterString("in", argv[1])
+  app2.Execute()
+  full = app2.GetVectorImageAsNumpyArray("out").astype(np.float32)
+  assert streamed.shape == full.shape
+  assert np.array_equal(streamed, full)
+
+  # Numpy stage between two applications connected in memory: sum of the
+  # upper and lower neighbors, with a small RAM to stream the writer
+  stage = otb.NumpyTileFilter(lambda tile: tile[:-2, 1:-1, :] + tile[2:, 1:-1, :], radius=1)
+  stage.SetInput(app2.GetParameterOutputImage("out"))
+
+  writer = otb.Registry.CreateApplication("ExtractROI")
+  writer.SetParameterInputImage("in", stage.GetOutput())
+  writer.SetParameterString("out", argv[2])
+  writer.SetParameterOutputImagePixelType("out", otb.ImagePixelType_float)
+  writer.SetParameterInt("ram", 1)
+  writer.ExecuteAndWriteOutput()
+
+  reader = otb.Registry.CreateApplication("ExtractROI")
+  reader.SetParameterString("in", argv[2])
+  reader.Execute()
+  result = reader.GetVectorImageAsNumpyArray("out")
+
+  padded = np.pad(full, ((1, 1), (0, 0), (0, 0)), mode='edge')
+  expected = padded[:-2, :, :] + padded[2:, :, :]
+  assert np.allclose(result, expected)
@@ -23,7 +23,7 @@
 
 #include "otbVectorImageToImageListFilter.h"
 #include "otbImageListToVectorImageFilter.h"
-#include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbStreamingMultiAccumulatorImageFilter.h"
 #include "otbStreamingStatisticsImageFilter.h"
 #include "otbFunctorImageFilter.h"
 #include "itkStreamingImageFilter.h"
@@ -110,7 +110,7 @@ public:
 
   typedef otb::ImageListToVectorImageFilter<ImageListType, FloatVectorImageType> ImageListToVectorFilterType;
 
-  typedef otb::StreamingStatisticsVectorImageFilter<FloatVectorImageType> VectorStatsFilterType;
+  typedef otb::StreamingMultiAccumulatorImageFilter<FloatVectorImageType> VectorStatsFilterType;
 
   typedef otb::StreamingStatisticsImageFilter<FloatImageType> StatsFilterType;
 
@@ -523,7 +523,11 @@ private:
     }
     else
     {
+      // Only the extrema are needed: avoid the moments and covariance of
+      // the full statistics filter
+      auto                           minMax = std::make_shared<otb::MinMaxAccumulator<>>();
       VectorStatsFilterType::Pointer statFilter(VectorStatsFilterType::New());
+      statFilter->AddAccumulator(minMax);
       statFilter->SetIgnoreInfiniteValues(true);
       if (IsParameterEnabled("nodata"))
       {
@@ -533,8 +537,8 @@ private:
       statFilter->SetInput(inImage);
       AddProcess(statFilter->GetStreamer(), "Computing statistics");
       statFilter->Update();
-      min = statFilter->GetMinimum();
-      max = statFilter->GetMaximum();
+      min = minMax->GetMinimum();
+      max = minMax->GetMaximum();
       if (GetParameterInt("minmax.auto.global"))
       {
         float temp(min[0]);
@@ -143,6 +143,14 @@ private:
     AddParameter(ParameterType_Bool, "backmatching", "Use back-matching to filter matches");
     SetParameterDescription("backmatching", "If set to true, matches should be consistent in both ways.");
 
+    AddParameter(ParameterType_Float, "recall", "Recall of the nearest neighbor search");
+    SetParameterDescription("recall",
+                            "Ratio of the keypoints which should get their exact nearest neighbor. "
+                            "With 1, the search is exhaustive. Lower values use a faster approximate search in a k-d forest.");
+    SetMinimumParameterFloatValue("recall", 0.0);
+    SetMaximumParameterFloatValue("recall", 1.0);
+    SetDefaultParameterFloat("recall", 1.0);
+
     AddParameter(ParameterType_Choice, "mode", "Keypoints search mode");
 
     AddChoice("mode.full", "Extract and match all keypoints (no streaming)");
@@ -254,6 +262,8 @@ private:
       matchingFilter->SetUseBackMatching(GetParameterInt("backmatching"));
     }
 
+    matchingFilter->SetRecall(GetParameterFloat("recall"));
+
     try
     {
 
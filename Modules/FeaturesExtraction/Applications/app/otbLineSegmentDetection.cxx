@@ -89,6 +89,18 @@ private:
                             "By default, the input image amplitude is rescaled between [0,255]."
                             " Turn on this parameter to skip rescaling");
 
+    AddParameter(ParameterType_Int, "margin", "Overlap margin between tiles");
+    SetParameterDescription("margin",
+                            "Overlap margin in pixels around the tiles. When it is positive, the segments crossing the borders of the tiles are "
+                            "detected across them and merged, instead of being cut.");
+    SetDefaultParameterInt("margin", 0);
+    SetMinimumParameterIntValue("margin", 0);
+
+    AddParameter(ParameterType_Int, "tilesize", "Size of the tiles processed in parallel");
+    SetParameterDescription("tilesize", "Size in pixels of the tiles processed in parallel in each streamed region (0 to process the region at once).");
+    SetDefaultParameterInt("tilesize", 0);
+    SetMinimumParameterIntValue("tilesize", 0);
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -142,6 +154,8 @@ private:
 
     LSDFilterType::Pointer lsd = LSDFilterType::New();
     lsd->GetFilter()->SetInput(image);
+    lsd->GetFilter()->SetMargin(GetParameterInt("margin"));
+    lsd->GetFilter()->SetTileSize(GetParameterInt("tilesize"));
     lsd->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
 
     AddProcess(lsd->GetStreamer(), "Running Line Segment Detector");
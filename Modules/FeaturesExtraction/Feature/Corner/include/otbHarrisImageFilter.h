@@ -25,11 +25,48 @@
 #include "itkHessianRecursiveGaussianImageFilter.h"
 #include "otbHessianToScalarImageFilter.h"
 #include "otbMultiplyByScalarImageFilter.h"
+#include "itkUnaryFunctorImageFilter.h"
 #include "otbMath.h"
 
 namespace otb
 {
 
+namespace Functor
+{
+
+/** \class HarrisResponse
+ * \brief Harris measure of a smoothed Hessian, scaled by \f$\sigma_D^4\f$.
+ *
+ * This functor chains the HessianToScalar and MultiplyByScalar functors,
+ * with the same intermediate rounding, in a single pass.
+ *
+ * \ingroup OTBCorner
+ */
+template <class TInput, class TOutput>
+class HarrisResponse
+{
+public:
+  inline TOutput operator()(const TInput& hessian)
+  {
+    return m_Scale(m_Measure(hessian));
+  }
+
+  void SetAlpha(double alpha)
+  {
+    m_Measure.SetAlpha(alpha);
+  }
+
+  void SetCoef(double coef)
+  {
+    m_Scale.SetCoef(coef);
+  }
+
+private:
+  HessianToScalar<TInput, TOutput>   m_Measure;
+  MultiplyByScalar<TOutput, TOutput> m_Scale;
+};
+}
+
 /** \class HarrisImageFilter
    \brief This filter performs the computation of the Harris measure as followed.
 
@@ -47,6 +84,11 @@ L_y^2(\mathbf{x},\sigma_D) \end{array}\right] \f]
 The output of the detector is \f$[det(\mu) - \alpha trace^2(\mu)\f$.
 
 The interest points can then be extracted with a thresholding filter.
+
+The recursive Gaussian filters need the whole image: the filter requests
+the largest possible region of its input, and keeps the smoothed Hessian
+between the streamed regions of its output. The measure and its scaling
+are computed in a single pass.
  *
  *
  * \ingroup OTBCorner
@@ -86,6 +128,8 @@ public:
   typedef itk::RecursiveGaussianImageFilter<TensorType, TensorType>          GaussianFilterType;
   typedef otb::HessianToScalarImageFilter<TensorType, OutputImageType>       HessianToScalarFilterType;
   typedef otb::MultiplyByScalarImageFilter<OutputImageType, OutputImageType> MultiplyScalarFilterType;
+  typedef Functor::HarrisResponse<typename TensorType::PixelType, OutputPixelType>      ResponseFunctorType;
+  typedef itk::UnaryFunctorImageFilter<TensorType, OutputImageType, ResponseFunctorType> ResponseFilterType;
 
   itkSetMacro(SigmaD, double);
   itkGetConstReferenceMacro(SigmaD, double);
@@ -100,6 +144,8 @@ protected:
   {
   }
 
+  void GenerateInputRequestedRegion() override;
+
   void GenerateData() override;
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
@@ -112,11 +158,10 @@ private:
   double m_SigmaI;
   double m_Alpha;
 
-  typename HessianFilterType::Pointer         m_HessianFilter;
-  typename GaussianFilterType::Pointer        m_GaussianFilter0;
-  typename GaussianFilterType::Pointer        m_GaussianFilter1;
-  typename HessianToScalarFilterType::Pointer m_HessianToScalarFilter;
-  typename MultiplyScalarFilterType::Pointer  m_MultiplyScalarFilter;
+  typename HessianFilterType::Pointer  m_HessianFilter;
+  typename GaussianFilterType::Pointer m_GaussianFilter0;
+  typename GaussianFilterType::Pointer m_GaussianFilter1;
+  typename ResponseFilterType::Pointer m_ResponseFilter;
 };
 } // end namespace otb
 
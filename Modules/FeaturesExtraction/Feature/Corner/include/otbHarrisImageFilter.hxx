@@ -36,40 +36,70 @@ HarrisImageFilter<TInputImage, TOutputImage>::HarrisImageFilter()
   m_SigmaI = 1.0;
   m_Alpha  = 1.0;
 
-  m_HessianFilter         = HessianFilterType::New();
-  m_GaussianFilter0       = GaussianFilterType::New();
-  m_GaussianFilter1       = GaussianFilterType::New();
-  m_HessianToScalarFilter = HessianToScalarFilterType::New();
-  m_MultiplyScalarFilter  = MultiplyScalarFilterType::New();
-}
+  m_HessianFilter   = HessianFilterType::New();
+  m_GaussianFilter0 = GaussianFilterType::New();
+  m_GaussianFilter1 = GaussianFilterType::New();
+  m_ResponseFilter  = ResponseFilterType::New();
 
-template <class TInputImage, class TOutputImage>
-void HarrisImageFilter<TInputImage, TOutputImage>::GenerateData()
-{
-  m_HessianFilter->SetInput(this->GetInput());
-  m_HessianFilter->SetSigma(this->m_SigmaD);
+  // Fixed settings of the internal pipeline. Some setters always modify
+  // the filters, so they are not called again for each streamed region
   m_HessianFilter->SetNormalizeAcrossScale(false);
 
-  m_GaussianFilter0->SetInput(m_HessianFilter->GetOutput());
-  m_GaussianFilter0->SetSigma(this->m_SigmaI);
   m_GaussianFilter0->SetOrder(GaussianFilterType::ZeroOrder);
   m_GaussianFilter0->SetNormalizeAcrossScale(false);
 
-  m_GaussianFilter1->SetInput(m_GaussianFilter0->GetOutput());
-  m_GaussianFilter1->SetSigma(this->m_SigmaI);
   m_GaussianFilter1->SetOrder(GaussianFilterType::ZeroOrder);
   m_GaussianFilter1->SetNormalizeAcrossScale(false);
   m_GaussianFilter1->SetDirection(1);
+}
+
+template <class TInputImage, class TOutputImage>
+void HarrisImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
 
-  m_HessianToScalarFilter->SetInput(m_GaussianFilter1->GetOutput());
-  m_HessianToScalarFilter->SetAlpha(this->m_Alpha);
+  // The recursive Gaussian filters need the whole image: requesting it
+  // here avoids updating the input again from the internal pipeline
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void HarrisImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  m_HessianFilter->SetInput(this->GetInput());
+  // SetSigma() may modify the filters even with the same value, which
+  // would compute the smoothed Hessian again for each streamed region
+  if (m_HessianFilter->GetSigma() != this->m_SigmaD)
+  {
+    m_HessianFilter->SetSigma(this->m_SigmaD);
+  }
+
+  m_GaussianFilter0->SetInput(m_HessianFilter->GetOutput());
+  if (m_GaussianFilter0->GetSigma() != this->m_SigmaI)
+  {
+    m_GaussianFilter0->SetSigma(this->m_SigmaI);
+  }
+
+  m_GaussianFilter1->SetInput(m_GaussianFilter0->GetOutput());
+  if (m_GaussianFilter1->GetSigma() != this->m_SigmaI)
+  {
+    m_GaussianFilter1->SetSigma(this->m_SigmaI);
+  }
 
-  m_MultiplyScalarFilter->SetInput(m_HessianToScalarFilter->GetOutput());
-  m_MultiplyScalarFilter->SetCoef(std::pow(m_SigmaD, 4.0));
+  // The smoothed Hessian stays buffered while the regions of the output
+  // are computed, the measure and its scaling are fused
+  m_ResponseFilter->SetInput(m_GaussianFilter1->GetOutput());
+  m_ResponseFilter->GetFunctor().SetAlpha(this->m_Alpha);
+  m_ResponseFilter->GetFunctor().SetCoef(std::pow(m_SigmaD, 4.0));
+  m_ResponseFilter->Modified();
 
-  m_MultiplyScalarFilter->GraftOutput(this->GetOutput());
-  m_MultiplyScalarFilter->Update();
-  this->GraftOutput(m_MultiplyScalarFilter->GetOutput());
+  m_ResponseFilter->GraftOutput(this->GetOutput());
+  m_ResponseFilter->Update();
+  this->GraftOutput(m_ResponseFilter->GetOutput());
 }
 
 /**
@@ -33,6 +33,13 @@ namespace Functor
  *  \brief: This class implements a Savitzky-Golay interpolation
  *  fitting the upper or lower envelope of the series being interpolated.
  *
+ *  At each iteration, the weights of the dates on the wrong side of the
+ *  envelope are decreased. Each series starts again from the weights
+ *  that were set. The weights of the iterations are kept local, so the
+ *  functor can be shared by threads. The weight patterns are finite, so
+ *  their window fittings are reused from the cache of the Savitzky-Golay
+ *  functor.
+ *
  * \sa otbSavitzkyGolayInterpolationFunctor
  *
  * \ingroup OTBTimeSeries
@@ -54,6 +61,8 @@ public:
   /// Constructor
   EnvelopeSavitzkyGolayInterpolationFunctor() : m_Iterations(2), m_UpperEnvelope(true), m_DecreaseFactor(0.5)
   {
+    for (unsigned int i = 0; i < m_InitialWeightSeries.Size(); ++i)
+      m_InitialWeightSeries[i] = 1;
   }
   /// Destructor
   virtual ~EnvelopeSavitzkyGolayInterpolationFunctor()
@@ -62,8 +71,8 @@ public:
 
   inline void SetWeights(const TWeight weights)
   {
-    for (unsigned int i = 0; i < m_WeightSeries.Size(); ++i)
-      m_WeightSeries[i] = weights[i];
+    for (unsigned int i = 0; i < m_InitialWeightSeries.Size(); ++i)
+      m_InitialWeightSeries[i] = weights[i];
     m_SGFunctor.SetWeights(weights);
   }
 
@@ -93,29 +102,30 @@ public:
     m_Iterations = its;
   }
 
-  inline TSeries operator()(const TSeries& series)
+  inline TSeries operator()(const TSeries& series) const
   {
     TSeries outSeries = m_SGFunctor(series);
 
+    TWeight weightSeries = m_InitialWeightSeries;
+
     for (unsigned int i = 0; i < m_Iterations; ++i)
     {
       for (unsigned int j = 0; j < nbDates; ++j)
       {
         if (m_UpperEnvelope && outSeries[j] < series[j])
-          m_WeightSeries[j] = m_WeightSeries[j] * m_DecreaseFactor;
+          weightSeries[j] = weightSeries[j] * m_DecreaseFactor;
         if (!m_UpperEnvelope && outSeries[j] > series[j])
-          m_WeightSeries[j] = m_WeightSeries[j] * m_DecreaseFactor;
+          weightSeries[j] = weightSeries[j] * m_DecreaseFactor;
       }
 
-      m_SGFunctor.SetWeights(m_WeightSeries);
-      outSeries = m_SGFunctor(series);
+      outSeries = m_SGFunctor(series, weightSeries);
     }
 
     return outSeries;
   }
 
 private:
-  TWeight       m_WeightSeries;
+  TWeight       m_InitialWeightSeries;
   SGFunctorType m_SGFunctor;
   unsigned int  m_Iterations;
   bool          m_UpperEnvelope;
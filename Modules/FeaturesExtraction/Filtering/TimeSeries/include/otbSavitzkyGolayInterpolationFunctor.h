@@ -23,7 +23,10 @@
 
 #include "otbTimeSeries.h"
 #include "otbTimeSeriesLeastSquareFittingFunctor.h"
-
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace otb
 {
@@ -44,6 +47,12 @@ namespace Functor
  *  squares estimation can be set (the higher the weight, the lower the
  *  confidence in the value).
  *
+ *  The least squares functors of the windows only depend on the dates
+ *  and the weights: they are built when these are set, and cached by
+ *  window weights, so that fitting again with a weight pattern already
+ *  seen (as EnvelopeSavitzkyGolayInterpolationFunctor does for each
+ *  series) does not factorize the windows again.
+ *
  *  Savitzky, A.; Golay, M.J.E. (1964). "Smoothing and Differentiation of
  *  Data by Simplified Least Squares Procedures". Analytical Chemistry 36
  *  (8): 1627-1639. doi:10.1021/ac60214a047
@@ -73,8 +82,14 @@ public:
       TLSFunctorType;
 
   /// Constructor
-  SavitzkyGolayInterpolationFunctor()
+  SavitzkyGolayInterpolationFunctor() : m_Cache(std::make_shared<CacheType>())
   {
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      m_WeightSeries[i] = 1;
+      m_DoySeries[i]    = i;
+    }
+    this->UpdateWindows();
   }
   /// Destructor
   virtual ~SavitzkyGolayInterpolationFunctor()
@@ -85,15 +100,51 @@ public:
   {
     for (unsigned int i = 0; i < m_WeightSeries.Size(); ++i)
       m_WeightSeries[i] = weights[i];
+    this->UpdateWindows();
   }
 
   inline void SetDates(const TDates doy)
   {
     for (unsigned int i = 0; i < m_DoySeries.Size(); ++i)
       m_DoySeries[i]    = doy[i];
+    // The copies of this functor may still use the windows of the former dates
+    m_Cache = std::make_shared<CacheType>();
+    this->UpdateWindows();
   }
 
   inline TSeries operator()(const TSeries& series) const
+  {
+    return this->Interpolate(series, [this](unsigned int i) -> const std::shared_ptr<const TLSFunctorType>& { return m_Windows[i - Radius]; });
+  }
+
+  /** Interpolate the series with the given weights instead of the ones
+   * that were set. The functor is not modified, so that it can be
+   * called concurrently. */
+  inline TSeries operator()(const TSeries& series, const TWeight& weights) const
+  {
+    return this->Interpolate(series, [this, &weights](unsigned int i) { return this->GetWindow(i, weights); });
+  }
+
+private:
+  /// Window position followed by its weights
+  typedef std::vector<double> WindowKeyType;
+
+  /// The functors are shared by the copies of this functor
+  struct CacheType
+  {
+    std::mutex                                                       Mutex;
+    std::map<WindowKeyType, std::shared_ptr<const TLSFunctorType>> Windows;
+  };
+
+  enum
+  {
+    /// Maximum number of cached window functors
+    MaxCacheSize = 65536
+  };
+
+  /// Interpolate the series with the window functors given by getWindow
+  template <class TGetWindow>
+  TSeries Interpolate(const TSeries& series, TGetWindow getWindow) const
   {
     TSeries outSeries;
 
@@ -108,29 +159,66 @@ public:
     for (unsigned int i = firstSample; i <= lastSample; ++i)
     {
       InterpolatedSeriesType tmpInSeries;
-      InterpolatedDatesType  tmpDates;
-      InterpolatedWeightType tmpWeights;
 
       for (unsigned int j = 0; j <= 2 * Radius; ++j)
-      {
         tmpInSeries[j] = series[i + j - Radius];
-        tmpDates[j]    = m_DoySeries[i + j - Radius];
-        tmpWeights[j]  = m_WeightSeries[i + j - Radius];
-      }
-
-      TLSFunctorType f;
-      f.SetDates(tmpDates);
-      f.SetWeights(tmpWeights);
-      InterpolatedSeriesType tmpOutSeries = f(tmpInSeries);
-      outSeries[i]                        = tmpOutSeries[Radius];
+
+      // Only the value at the center of the window is needed
+      outSeries[i] = getWindow(i)->EstimateTimeFunction(tmpInSeries).GetValue(m_DoySeries[i]);
     }
 
     return outSeries;
   }
 
-private:
+  /** Get the least squares functor of the window centered on the date
+   * i for the given weights, from the cache when possible */
+  std::shared_ptr<const TLSFunctorType> GetWindow(unsigned int i, const TWeight& weights) const
+  {
+    WindowKeyType key(InterpolatedLength + 1);
+    key[0] = i;
+    for (unsigned int j = 0; j <= 2 * Radius; ++j)
+      key[j + 1] = weights[i + j - Radius];
+
+    std::lock_guard<std::mutex> lock(m_Cache->Mutex);
+    auto it = m_Cache->Windows.find(key);
+    if (it != m_Cache->Windows.end())
+      return it->second;
+
+    if (m_Cache->Windows.size() >= MaxCacheSize)
+      m_Cache->Windows.clear();
+
+    InterpolatedDatesType  tmpDates;
+    InterpolatedWeightType tmpWeights;
+    for (unsigned int j = 0; j <= 2 * Radius; ++j)
+    {
+      tmpDates[j]   = m_DoySeries[i + j - Radius];
+      tmpWeights[j] = weights[i + j - Radius];
+    }
+
+    std::shared_ptr<TLSFunctorType> f = std::make_shared<TLSFunctorType>();
+    f->SetDates(tmpDates);
+    f->SetWeights(tmpWeights);
+    m_Cache->Windows.insert(std::make_pair(key, f));
+    return f;
+  }
+
+  /// Get the least squares functors of the windows for the current weights
+  void UpdateWindows()
+  {
+    unsigned int firstSample = Radius;
+    unsigned int lastSample  = nbDates - Radius - 1;
+
+    m_Windows.resize(lastSample - firstSample + 1);
+    for (unsigned int i = firstSample; i <= lastSample; ++i)
+      m_Windows[i - firstSample] = this->GetWindow(i, m_WeightSeries);
+  }
+
   TWeight m_WeightSeries;
   TDates  m_DoySeries;
+  /// Functors of the windows, by position and weights
+  std::shared_ptr<CacheType> m_Cache;
+  /// Functors of the windows for the current weights
+  std::vector<std::shared_ptr<const TLSFunctorType>> m_Windows;
 };
 }
 } // namespace otb
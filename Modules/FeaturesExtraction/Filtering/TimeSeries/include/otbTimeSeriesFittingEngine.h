@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTimeSeriesFittingEngine_h
+#define otbTimeSeriesFittingEngine_h
+
+#include "otbTimeSeries.h"
+#include "vnl/algo/vnl_matrix_inverse.h"
+#include "vnl/vnl_transpose.h"
+#include "vnl/vnl_matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace otb
+{
+
+/** \class TimeSeriesFittingEngine
+ *  \brief Least squares fitting of many time series sharing their dates.
+ *
+ *  The fitted values of a series are a linear function of its values:
+ *  for a global fit (radius 0), \f$ \hat{y} = \Phi (A^T A)^{-1} A^T W y \f$
+ *  with \f$ A = W \Phi \f$ and \f$ W = diag(1 / \sigma_i) \f$, as in
+ *  TimeSeriesLeastSquareFittingFunctor. For a Savitzky-Golay filtering
+ *  (radius greater than 0), each row of the matrix is the value at the
+ *  center of the fit of a window of 2 * radius + 1 dates, and the dates
+ *  closer to the ends than the radius keep their value, as in
+ *  SavitzkyGolayInterpolationFunctor.
+ *
+ *  This matrix only depends on the dates and the weights: it is computed
+ *  once per distinct weight vector and cached, and a block of series is
+ *  fitted with a single matrix product instead of a factorization per
+ *  series. A date with an infinite weight is ignored by the fit (its
+ *  fitted value is interpolated), which is how masked dates are handled.
+ *  If there are not enough valid dates to fit a window, its center date
+ *  keeps its value. When the cache holds too many matrices (one per mask
+ *  pattern), it is emptied.
+ *
+ *  Fitting is thread safe.
+ *
+ * \sa TimeSeriesLeastSquareFittingFunctor
+ * \sa SavitzkyGolayInterpolationFunctor
+ * \sa TimeSeriesFittingImageFilter
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TTimeFunction = PolynomialTimeSeries<2>>
+class TimeSeriesFittingEngine
+{
+public:
+  typedef TTimeFunction       TimeFunctionType;
+  typedef std::vector<double> SeriesType;
+  typedef vnl_matrix<double>  MatrixType;
+
+  typedef std::shared_ptr<const MatrixType> MatrixPointerType;
+
+  TimeSeriesFittingEngine() : m_Radius(0), m_MaximumNumberOfCachedMatrices(256)
+  {
+  }
+
+  void SetDates(const SeriesType& dates)
+  {
+    m_Dates = dates;
+    this->ClearCache();
+  }
+
+  const SeriesType& GetDates() const
+  {
+    return m_Dates;
+  }
+
+  unsigned int GetNumberOfDates() const
+  {
+    return static_cast<unsigned int>(m_Dates.size());
+  }
+
+  /** Radius of the Savitzky-Golay window, 0 to fit all the dates */
+  void SetRadius(unsigned int radius)
+  {
+    m_Radius = radius;
+    this->ClearCache();
+  }
+
+  unsigned int GetRadius() const
+  {
+    return m_Radius;
+  }
+
+  void SetMaximumNumberOfCachedMatrices(std::size_t nb)
+  {
+    m_MaximumNumberOfCachedMatrices = std::max(nb, static_cast<std::size_t>(1));
+  }
+
+  std::size_t GetMaximumNumberOfCachedMatrices() const
+  {
+    return m_MaximumNumberOfCachedMatrices;
+  }
+
+  /** Fitting matrix for the given weights (one per date) */
+  MatrixPointerType GetFittingMatrix(const SeriesType& weights) const
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      typename CacheType::const_iterator it = m_Cache.find(weights);
+      if (it != m_Cache.end())
+        return it->second;
+    }
+
+    // Computed outside of the lock, other threads may do it concurrently
+    MatrixPointerType matrix = std::make_shared<const MatrixType>(this->ComputeFittingMatrix(weights));
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Cache.size() >= m_MaximumNumberOfCachedMatrices)
+      m_Cache.clear();
+    return m_Cache.insert(std::make_pair(weights, matrix)).first->second;
+  }
+
+  /** Fit nbSeries series with the given weights. The values are stored
+   * date by date: the value of series s at date i is
+   * values[i * nbSeries + s]. */
+  void Fit(const SeriesType& weights, const double* values, double* fitted, std::size_t nbSeries) const
+  {
+    const MatrixPointerType matrix  = this->GetFittingMatrix(weights);
+    const unsigned int      nbDates = this->GetNumberOfDates();
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      double* out = fitted + i * nbSeries;
+      std::fill(out, out + nbSeries, 0.);
+      for (unsigned int j = 0; j < nbDates; ++j)
+      {
+        const double h = (*matrix)(i, j);
+        if (h == 0.)
+        {
+          continue;
+        }
+        const double* in = values + j * nbSeries;
+        for (std::size_t s = 0; s < nbSeries; ++s)
+        {
+          out[s] += h * in[s];
+        }
+      }
+    }
+  }
+
+  /** Number of distinct weight vectors seen since the last change of
+   * the dates or the radius */
+  std::size_t GetNumberOfCachedMatrices() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Cache.size();
+  }
+
+  void ClearCache()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Cache.clear();
+  }
+
+private:
+  typedef std::map<SeriesType, MatrixPointerType> CacheType;
+
+  MatrixType ComputeFittingMatrix(const SeriesType& weights) const
+  {
+    const unsigned int nbDates = this->GetNumberOfDates();
+    MatrixType         matrix(nbDates, nbDates, 0.);
+
+    if (m_Radius == 0)
+    {
+      std::vector<unsigned int> targets(nbDates);
+      for (unsigned int i = 0; i < nbDates; ++i)
+        targets[i] = i;
+      this->FitWindow(weights, 0, nbDates, targets, matrix);
+      return matrix;
+    }
+
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      if (i < m_Radius || i + m_Radius >= nbDates)
+      {
+        matrix(i, i) = 1.;
+        continue;
+      }
+      this->FitWindow(weights, i - m_Radius, i + m_Radius + 1, std::vector<unsigned int>(1, i), matrix);
+    }
+    return matrix;
+  }
+
+  /** Fill the rows of the targets with the fit of the dates in [begin, end) */
+  void FitWindow(const SeriesType& weights, unsigned int begin, unsigned int end, const std::vector<unsigned int>& targets, MatrixType& matrix) const
+  {
+    TTimeFunction      estFunction;
+    const unsigned int nbCoefs = estFunction.GetCoefficients().Size();
+
+    std::vector<unsigned int> valid;
+    for (unsigned int j = begin; j < end; ++j)
+    {
+      if (std::isfinite(weights[j]) && weights[j] != 0.)
+        valid.push_back(j);
+    }
+
+    if (valid.size() < nbCoefs)
+    {
+      for (unsigned int i : targets)
+        matrix(i, i) = 1.;
+      return;
+    }
+
+    typename TTimeFunction::CoefficientsType tmpCoefs;
+    for (unsigned int k = 0; k < nbCoefs; ++k)
+      tmpCoefs[k] = 0.;
+
+    // Values of the basis functions
+    auto basis = [&](unsigned int k, double date) {
+      tmpCoefs[k] = 1.;
+      estFunction.SetCoefficients(tmpCoefs);
+      tmpCoefs[k] = 0.;
+      return estFunction.GetValue(date);
+    };
+
+    MatrixType A(valid.size(), nbCoefs);
+    for (unsigned int v = 0; v < valid.size(); ++v)
+    {
+      for (unsigned int k = 0; k < nbCoefs; ++k)
+        A.put(v, k, basis(k, m_Dates[valid[v]]) / weights[valid[v]]);
+    }
+
+    // (At * A)^-1*At
+    MatrixType atainv   = vnl_matrix_inverse<double>(vnl_transpose(A) * A);
+    MatrixType atainvat = atainv * vnl_transpose(A);
+
+    for (unsigned int i : targets)
+    {
+      std::vector<double> phi(nbCoefs);
+      for (unsigned int k = 0; k < nbCoefs; ++k)
+        phi[k] = basis(k, m_Dates[i]);
+
+      for (unsigned int v = 0; v < valid.size(); ++v)
+      {
+        double h = 0.;
+        for (unsigned int k = 0; k < nbCoefs; ++k)
+          h += phi[k] * atainvat(k, v);
+        matrix(i, valid[v]) = h / weights[valid[v]];
+      }
+    }
+  }
+
+  SeriesType   m_Dates;
+  unsigned int m_Radius;
+  std::size_t  m_MaximumNumberOfCachedMatrices;
+
+  mutable std::mutex m_Mutex;
+  mutable CacheType  m_Cache;
+};
+
+} // namespace otb
+
+#endif
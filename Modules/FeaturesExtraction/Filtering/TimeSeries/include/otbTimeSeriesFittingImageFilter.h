@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTimeSeriesFittingImageFilter_h
+#define otbTimeSeriesFittingImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbTimeSeriesFittingEngine.h"
+
+namespace otb
+{
+
+/** \class TimeSeriesFittingImageFilter
+ *  \brief Least squares or Savitzky-Golay fitting of the time series of an image cube.
+ *
+ * The input is a multi-date stack: the component date * NumberOfBands
+ * + band of a pixel is the value of the band at the date. Each band of
+ * each pixel is fitted with TimeSeriesFittingEngine: a global fit of the
+ * time function when the radius is 0, a Savitzky-Golay filtering
+ * otherwise.
+ *
+ * Dates can be masked per pixel, either by an optional mask image with
+ * one component per date (non-zero values are masked), or by a no-data
+ * value (a date is masked when one of its bands is no-data). The masked
+ * dates are ignored by the fit, and their fitted values fill the gaps.
+ *
+ * The pixels of a thread region are processed by blocks: the pixels of
+ * a block sharing the same mask pattern are fitted together with one
+ * matrix product, and the fitting matrices are cached by mask pattern
+ * across the blocks, the threads and the streamed regions.
+ *
+ * \sa TimeSeriesFittingEngine
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TInputImage, class TOutputImage, class TMaskImage = TInputImage, class TTimeFunction = PolynomialTimeSeries<2>>
+class ITK_EXPORT TimeSeriesFittingImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef TimeSeriesFittingImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(TimeSeriesFittingImageFilter, itk::ImageToImageFilter);
+
+  typedef TInputImage  InputImageType;
+  typedef TOutputImage OutputImageType;
+  typedef TMaskImage   MaskImageType;
+
+  typedef typename InputImageType::PixelType          InputPixelType;
+  typedef typename OutputImageType::PixelType         OutputPixelType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+
+  typedef TimeSeriesFittingEngine<TTimeFunction> EngineType;
+  typedef typename EngineType::SeriesType        SeriesType;
+
+  using Superclass::SetInput;
+
+  /** Optional mask of the dates */
+  void SetMaskImage(const MaskImageType* mask);
+  const MaskImageType* GetMaskImage() const;
+
+  /** Dates of the stack */
+  void SetDates(const SeriesType& dates);
+  const SeriesType& GetDates() const
+  {
+    return m_Engine.GetDates();
+  }
+
+  /** Weights of the dates (the higher the weight, the lower the
+   * confidence in the value), 1 by default */
+  void SetWeights(const SeriesType& weights);
+  const SeriesType& GetWeights() const
+  {
+    return m_Weights;
+  }
+
+  /** Radius of the Savitzky-Golay window, 0 for a global fit */
+  void SetRadius(unsigned int radius);
+  unsigned int GetRadius() const
+  {
+    return m_Engine.GetRadius();
+  }
+
+  /** Number of bands at each date */
+  itkSetMacro(NumberOfBands, unsigned int);
+  itkGetConstMacro(NumberOfBands, unsigned int);
+
+  itkSetMacro(NoDataValue, double);
+  itkGetConstMacro(NoDataValue, double);
+
+  itkSetMacro(NoDataValueAvailable, bool);
+  itkGetConstMacro(NoDataValueAvailable, bool);
+  itkBooleanMacro(NoDataValueAvailable);
+
+  /** The engine, to inspect the cached fitting matrices */
+  const EngineType& GetEngine() const
+  {
+    return m_Engine;
+  }
+
+protected:
+  TimeSeriesFittingImageFilter();
+  ~TimeSeriesFittingImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  TimeSeriesFittingImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  enum
+  {
+    /** Size in bytes of the buffer of the pixels read before fitting
+     * them, each work unit uses four buffers of this size */
+    BlockBufferSize = 1 << 20
+  };
+
+  EngineType   m_Engine;
+  SeriesType   m_Weights;
+  unsigned int m_NumberOfBands;
+  double       m_NoDataValue;
+  bool         m_NoDataValueAvailable;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbTimeSeriesFittingImageFilter.hxx"
+#endif
+
+#endif
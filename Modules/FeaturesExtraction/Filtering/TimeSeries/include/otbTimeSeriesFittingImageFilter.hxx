@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTimeSeriesFittingImageFilter_hxx
+#define otbTimeSeriesFittingImageFilter_hxx
+
+#include "otbTimeSeriesFittingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::TimeSeriesFittingImageFilter()
+  : m_NumberOfBands(1), m_NoDataValue(0.), m_NoDataValueAvailable(false)
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->DynamicMultiThreadingOn();
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::SetMaskImage(const MaskImageType* mask)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<MaskImageType*>(mask));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+const TMaskImage* TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::GetMaskImage() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const MaskImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::SetDates(const SeriesType& dates)
+{
+  m_Engine.SetDates(dates);
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::SetWeights(const SeriesType& weights)
+{
+  m_Weights = weights;
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::SetRadius(unsigned int radius)
+{
+  if (radius != m_Engine.GetRadius())
+  {
+    m_Engine.SetRadius(radius);
+    this->Modified();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const unsigned int nbDates      = m_Engine.GetNumberOfDates();
+  const unsigned int nbComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  if (nbDates == 0 || m_NumberOfBands == 0 || nbComponents != nbDates * m_NumberOfBands)
+  {
+    itkExceptionMacro(<< "The input has " << nbComponents << " components, expected " << nbDates << " dates of " << m_NumberOfBands << " bands");
+  }
+  if (!m_Weights.empty() && m_Weights.size() != nbDates)
+  {
+    itkExceptionMacro(<< "Got " << m_Weights.size() << " weights for " << nbDates << " dates");
+  }
+  if (this->GetMaskImage() != nullptr && this->GetMaskImage()->GetNumberOfComponentsPerPixel() != nbDates)
+  {
+    itkExceptionMacro(<< "The mask has " << this->GetMaskImage()->GetNumberOfComponentsPerPixel() << " components, expected one per date (" << nbDates
+                      << ")");
+  }
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(nbComponents);
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::DynamicThreadedGenerateData(
+    const OutputImageRegionType& outputRegionForThread)
+{
+  const InputImageType* input  = this->GetInput();
+  const MaskImageType*  mask   = this->GetMaskImage();
+  OutputImageType*      output = this->GetOutput();
+
+  const unsigned int nbDates      = m_Engine.GetNumberOfDates();
+  const unsigned int nbBands      = m_NumberOfBands;
+  const unsigned int nbComponents = nbDates * nbBands;
+  const SeriesType   weights      = m_Weights.empty() ? SeriesType(nbDates, 1.) : m_Weights;
+
+  itk::ImageRegionConstIterator<InputImageType> inputIt(input, outputRegionForThread);
+  itk::ImageRegionIterator<OutputImageType>     outputIt(output, outputRegionForThread);
+  itk::ImageRegionConstIterator<MaskImageType>  maskIt;
+  if (mask != nullptr)
+  {
+    maskIt = itk::ImageRegionConstIterator<MaskImageType>(mask, outputRegionForThread);
+  }
+
+  // Pixels of the block, by mask pattern
+  typedef std::map<std::vector<char>, std::vector<unsigned int>> GroupsType;
+
+  // The number of pixels of a block depends on the length of the series,
+  // so that the buffers of each work unit stay small
+  const unsigned int  blockSize = std::max<unsigned int>(1, BlockBufferSize / (sizeof(double) * nbComponents));
+  std::vector<double> values(static_cast<std::size_t>(blockSize) * nbComponents);
+  std::vector<double> fitted(values.size());
+  std::vector<double> series, fittedSeries;
+  std::vector<char>   masked(nbDates);
+  OutputPixelType     outPixel;
+  outPixel.SetSize(nbComponents);
+
+  while (!inputIt.IsAtEnd())
+  {
+    GroupsType   groups;
+    unsigned int nbPixels = 0;
+    for (; nbPixels < blockSize && !inputIt.IsAtEnd(); ++nbPixels, ++inputIt)
+    {
+      const InputPixelType& inPixel = inputIt.Get();
+      double*               pixel   = &values[static_cast<std::size_t>(nbPixels) * nbComponents];
+      for (unsigned int c = 0; c < nbComponents; ++c)
+      {
+        pixel[c] = static_cast<double>(inPixel[c]);
+      }
+
+      for (unsigned int date = 0; date < nbDates; ++date)
+      {
+        masked[date] = 0;
+        if (mask != nullptr && maskIt.Get()[date] != 0)
+        {
+          masked[date] = 1;
+        }
+        for (unsigned int band = 0; m_NoDataValueAvailable && band < nbBands; ++band)
+        {
+          const double value = pixel[date * nbBands + band];
+          if (value == m_NoDataValue || (std::isnan(value) && std::isnan(m_NoDataValue)))
+          {
+            masked[date] = 1;
+          }
+        }
+      }
+      if (mask != nullptr)
+      {
+        ++maskIt;
+      }
+      groups[masked].push_back(nbPixels);
+    }
+
+    // Fit all the bands of the pixels of a group at once
+    for (typename GroupsType::const_iterator it = groups.begin(); it != groups.end(); ++it)
+    {
+      const std::vector<unsigned int>& pixels   = it->second;
+      const std::size_t                nbSeries = pixels.size() * nbBands;
+
+      SeriesType groupWeights = weights;
+      for (unsigned int date = 0; date < nbDates; ++date)
+      {
+        if (it->first[date])
+        {
+          groupWeights[date] = std::numeric_limits<double>::infinity();
+        }
+      }
+
+      series.resize(nbSeries * nbDates);
+      fittedSeries.resize(series.size());
+      for (unsigned int date = 0; date < nbDates; ++date)
+      {
+        double* row = &series[date * nbSeries];
+        for (unsigned int p = 0; p < pixels.size(); ++p)
+        {
+          const double* pixel = &values[static_cast<std::size_t>(pixels[p]) * nbComponents + date * nbBands];
+          std::copy(pixel, pixel + nbBands, row + p * nbBands);
+        }
+      }
+
+      m_Engine.Fit(groupWeights, series.data(), fittedSeries.data(), nbSeries);
+
+      for (unsigned int date = 0; date < nbDates; ++date)
+      {
+        const double* row = &fittedSeries[date * nbSeries];
+        for (unsigned int p = 0; p < pixels.size(); ++p)
+        {
+          std::copy(row + p * nbBands, row + (p + 1) * nbBands, &fitted[static_cast<std::size_t>(pixels[p]) * nbComponents + date * nbBands]);
+        }
+      }
+    }
+
+    for (unsigned int p = 0; p < nbPixels; ++p, ++outputIt)
+    {
+      const double* pixel = &fitted[static_cast<std::size_t>(p) * nbComponents];
+      for (unsigned int c = 0; c < nbComponents; ++c)
+      {
+        outPixel[c] = static_cast<OutputInternalPixelType>(pixel[c]);
+      }
+      outputIt.Set(outPixel);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage, class TTimeFunction>
+void TimeSeriesFittingImageFilter<TInputImage, TOutputImage, TMaskImage, TTimeFunction>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of dates: " << m_Engine.GetNumberOfDates() << std::endl;
+  os << indent << "Number of bands: " << m_NumberOfBands << std::endl;
+  os << indent << "Radius: " << m_Engine.GetRadius() << std::endl;
+  os << indent << "No-data value: " << m_NoDataValue << (m_NoDataValueAvailable ? "" : " (not used)") << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -51,7 +51,11 @@ namespace Functor
   *  \f$ b = (\frac{ f(t_i) }{\sigma_i}) \f$
   *  \f$ A_{ij} = \frac{\Phi_{ij}}{\sigma_i} \f$
   *
+  *  As the dates and the weights are shared by all the series, the
+  *  matrix \f$ (A^T A)^{-1} A^T \f$ is computed once when they are
+  *  set, and each fit is a matrix product.
   *
+  * \sa TimeSeriesFittingEngine
  *
  * \ingroup OTBTimeSeries
   */
@@ -66,6 +70,9 @@ public:
   {
     for (unsigned int i = 0; i < m_WeightSeries.Size(); ++i)
       m_WeightSeries[i] = 1.0;
+    for (unsigned int i = 0; i < m_DoySeries.Size(); ++i)
+      m_DoySeries[i]    = 0;
+    this->UpdateProjection();
   }
   /// Destructor
   virtual ~TimeSeriesLeastSquareFittingFunctor()
@@ -85,12 +92,14 @@ public:
   {
     for (unsigned int i = 0; i < doy.Size(); ++i)
       m_DoySeries[i]    = doy[i];
+    this->UpdateProjection();
   }
 
   inline void SetWeights(const TWeightType& weights)
   {
     for (unsigned int i = 0; i < weights.Size(); ++i)
       m_WeightSeries[i] = weights[i];
+    this->UpdateProjection();
   }
 
   inline CoefficientsType GetCoefficients(const TSeriesType& series) const
@@ -105,10 +114,30 @@ public:
     unsigned int  nbCoefs = estFunction.GetCoefficients().Size();
 
     // b = A * c
-    vnl_matrix<double> A(nbDates, nbCoefs);
     vnl_matrix<double> b(nbDates, 1);
+    for (unsigned int i = 0; i < nbDates; ++i)
+      b.put(i, 0, series[i] / m_WeightSeries[i]);
 
-    // fill the matrices
+    // c = (At * A)^-1*At*b
+    vnl_matrix<double> c = m_Projection * b;
+
+    typename TTimeFunction::CoefficientsType tmpCoefs;
+    for (unsigned int j = 0; j < nbCoefs; ++j)
+      tmpCoefs[j]       = c.get(j, 0);
+    estFunction.SetCoefficients(tmpCoefs);
+
+    return estFunction;
+  }
+
+private:
+  /** Compute (At * A)^-1*At for the current dates and weights */
+  void UpdateProjection()
+  {
+    TTimeFunction estFunction;
+    unsigned int  nbDates = m_DoySeries.Size();
+    unsigned int  nbCoefs = estFunction.GetCoefficients().Size();
+
+    vnl_matrix<double> A(nbDates, nbCoefs);
 
     typename TTimeFunction::CoefficientsType tmpCoefs;
     for (unsigned int j = 0; j < nbCoefs; ++j)
@@ -116,7 +145,6 @@ public:
 
     for (unsigned int i = 0; i < nbDates; ++i)
     {
-      b.put(i, 0, series[i] / m_WeightSeries[i]);
       for (unsigned int j = 0; j < nbCoefs; ++j)
       {
         tmpCoefs[j] = 1.0;
@@ -125,24 +153,16 @@ public:
         tmpCoefs[j] = 0.0;
       }
     }
-    // solve the problem c = (At * A)^-1*At*b
 
     vnl_matrix<double> atainv = vnl_matrix_inverse<double>(vnl_transpose(A) * A);
-
-    vnl_matrix<double> atainvat = atainv * vnl_transpose(A);
-    vnl_matrix<double> c        = atainvat * b;
-
-    for (unsigned int j = 0; j < nbCoefs; ++j)
-      tmpCoefs[j]       = c.get(j, 0);
-    estFunction.SetCoefficients(tmpCoefs);
-
-    return estFunction;
+    m_Projection              = atainv * vnl_transpose(A);
   }
 
-private:
   ///
   TDateType   m_DoySeries;
   TWeightType m_WeightSeries;
+  /// (At * A)^-1*At
+  vnl_matrix<double> m_Projection;
 };
 }
 } // namespace otb
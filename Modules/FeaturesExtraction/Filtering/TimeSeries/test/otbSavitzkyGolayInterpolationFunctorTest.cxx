@@ -75,5 +75,16 @@ int otbSavitzkyGolayInterpolationFunctorTest(int itkNotUsed(argc), char* itkNotU
     return EXIT_FAILURE;
   }
 
+  // Fitting with given weights gives the same series as setting them
+  SeriesType unitWeights;
+  unitWeights.Fill(1.0);
+  FunctorType unitF;
+  unitF.SetDates(doySeries);
+  if (f(inSeries, unitWeights) != unitF(inSeries) || f(inSeries) != outSeries)
+  {
+    std::cout << "Fitting with given weights differs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbTimeSeriesFittingImageFilter.h"
+#include "otbSavitzkyGolayInterpolationFunctor.h"
+#include "itkVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include <cmath>
+#include <iostream>
+
+int otbTimeSeriesFittingImageFilterTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef double       PixelType;
+  typedef unsigned int DoYType;
+  const unsigned int   nbDates = 24;
+  const unsigned int   nbBands = 2;
+  const unsigned int   Radius  = 2;
+  typedef itk::FixedArray<PixelType, nbDates> SeriesType;
+  typedef itk::FixedArray<DoYType, nbDates>   DatesType;
+
+  typedef itk::VectorImage<PixelType, 2>                                                 ImageType;
+  typedef itk::VectorImage<unsigned char, 2>                                             MaskType;
+  typedef otb::TimeSeriesFittingImageFilter<ImageType, ImageType, MaskType>              FilterType;
+  typedef otb::Functor::SavitzkyGolayInterpolationFunctor<Radius, SeriesType, DatesType> SGFunctorType;
+
+  // Irregular dates and weights
+  DatesType              doySeries;
+  SeriesType             weightSeries;
+  FilterType::SeriesType dates(nbDates), weights(nbDates);
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    doySeries[i]    = 10 * i + (i % 3);
+    dates[i]        = doySeries[i];
+    weightSeries[i] = 1 + (i % 4);
+    weights[i]      = weightSeries[i];
+  }
+
+  // Stack of 2 bands with a cloud on the dates 5 and 6 of the top left
+  // corner, and on the date 12 of the first column
+  ImageType::RegionType region;
+  region.SetSize(0, 37);
+  region.SetSize(1, 29);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbDates * nbBands);
+  image->Allocate();
+  MaskType::Pointer mask = MaskType::New();
+  mask->SetRegions(region);
+  mask->SetNumberOfComponentsPerPixel(nbDates);
+  mask->Allocate();
+
+  itk::ImageRegionIterator<ImageType> imageIt(image, region);
+  itk::ImageRegionIterator<MaskType>  maskIt(mask, region);
+  for (; !imageIt.IsAtEnd(); ++imageIt, ++maskIt)
+  {
+    const ImageType::IndexType index = imageIt.GetIndex();
+    ImageType::PixelType       pixel(nbDates * nbBands);
+    MaskType::PixelType        maskPixel(nbDates);
+    maskPixel.Fill(0);
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      for (unsigned int b = 0; b < nbBands; ++b)
+      {
+        pixel[i * nbBands + b] = (b + 1) * 10 * std::cos(dates[i] / (20. + index[0])) + index[1] * 0.1;
+      }
+      const bool cloud = (index[0] < 10 && index[1] < 10 && (i == 5 || i == 6)) || (index[0] == 0 && i == 12);
+      if (cloud)
+      {
+        maskPixel[i]           = 1;
+        pixel[i * nbBands]     = 1000.;
+        pixel[i * nbBands + 1] = -1000.;
+      }
+    }
+    imageIt.Set(pixel);
+    maskIt.Set(maskPixel);
+  }
+
+  for (unsigned int radius : {0u, Radius})
+  {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetMaskImage(mask);
+    filter->SetDates(dates);
+    filter->SetWeights(weights);
+    filter->SetRadius(radius);
+    filter->SetNumberOfBands(nbBands);
+    filter->SetNumberOfWorkUnits(4);
+    filter->Update();
+
+    // One matrix per mask pattern
+    if (filter->GetEngine().GetNumberOfCachedMatrices() != 4)
+    {
+      std::cout << "Got " << filter->GetEngine().GetNumberOfCachedMatrices() << " fitting matrices instead of 4" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Compare with the functors, a mask being a huge weight
+    typedef otb::Functor::TimeSeriesLeastSquareFittingFunctor<SeriesType, otb::PolynomialTimeSeries<2>, DatesType> TLSFunctorType;
+
+    itk::ImageRegionIterator<ImageType> outIt(filter->GetOutput(), region);
+    for (imageIt.GoToBegin(), maskIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt, ++maskIt, ++outIt)
+    {
+      SeriesType pixelWeights = weightSeries;
+      for (unsigned int i = 0; i < nbDates; ++i)
+      {
+        if (maskIt.Get()[i])
+          pixelWeights[i] = 1e12;
+      }
+
+      for (unsigned int b = 0; b < nbBands; ++b)
+      {
+        SeriesType inSeries, outSeries;
+        for (unsigned int i = 0; i < nbDates; ++i)
+          inSeries[i] = imageIt.Get()[i * nbBands + b];
+
+        if (radius == 0)
+        {
+          TLSFunctorType f;
+          f.SetDates(doySeries);
+          f.SetWeights(pixelWeights);
+          outSeries = f(inSeries);
+        }
+        else
+        {
+          SGFunctorType f;
+          f.SetDates(doySeries);
+          f.SetWeights(pixelWeights);
+          outSeries = f(inSeries);
+        }
+
+        for (unsigned int i = 0; i < nbDates; ++i)
+        {
+          const double value = outIt.Get()[i * nbBands + b];
+          if (std::fabs(value - outSeries[i]) > 1e-6)
+          {
+            std::cout << "Radius " << radius << ", pixel " << imageIt.GetIndex() << ", band " << b << ", date " << i << ": " << value << " instead of "
+                      << outSeries[i] << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
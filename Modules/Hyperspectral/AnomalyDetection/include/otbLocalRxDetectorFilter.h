@@ -146,6 +146,95 @@ public:
 };
 
 } // end namespace functor
+
+/** \class LocalRxDetectorFilter
+ * \brief Computes the local Rx score of an hyperspectral image with running statistics
+ *
+ * This filter gives the same result as LocalRxDetectionFunctor used in a
+ * FunctorImageFilter, but avoids recomputing the local statistics from
+ * scratch for each pixel:
+ *  - the first and second order moments of the external and internal windows
+ *    are updated incrementally as the windows slide along a scanline: only the
+ *    columns entering and leaving the windows are accumulated, so the cost of
+ *    the statistics is linear with the radius instead of quadratic,
+ *  - the moments of the dual neighborhood are obtained by subtracting the
+ *    internal window moments from the external window moments,
+ *  - the Rx score is computed with a Cholesky solve of the covariance matrix
+ *    instead of a full inversion (a pseudo-inverse is only used when the
+ *    covariance matrix is singular),
+ *  - all work buffers are allocated once per thread.
+ *
+ * Pixels outside the image are handled as in ZeroFluxNeumannBoundaryCondition.
+ *
+ * \ingroup Streamed
+ * \ingroup Threaded
+ *
+ * \ingroup OTBAnomalyDetection
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT LocalRxDetectorFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef LocalRxDetectorFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LocalRxDetectorFilter, ImageToImageFilter);
+
+  /** Image typedefs */
+  typedef TInputImage                                  InputImageType;
+  typedef typename InputImageType::InternalPixelType   InputInternalPixelType;
+  typedef TOutputImage                                 OutputImageType;
+  typedef typename OutputImageType::PixelType          OutputPixelType;
+  typedef typename OutputImageType::RegionType         OutputImageRegionType;
+  typedef typename InputImageType::RegionType          InputImageRegionType;
+  typedef typename InputImageType::SizeType            SizeType;
+
+  /** Set/Get the internal radius */
+  void SetInternalRadius(const unsigned int internalRadiusX, const unsigned int internalRadiusY)
+  {
+    m_InternalRadius[0] = internalRadiusX;
+    m_InternalRadius[1] = internalRadiusY;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(InternalRadius, SizeType);
+
+  /** Set/Get the external radius */
+  void SetExternalRadius(const unsigned int externalRadiusX, const unsigned int externalRadiusY)
+  {
+    m_ExternalRadius[0] = externalRadiusX;
+    m_ExternalRadius[1] = externalRadiusY;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(ExternalRadius, SizeType);
+
+protected:
+  LocalRxDetectorFilter();
+  ~LocalRxDetectorFilter() override = default;
+
+  /** The input requested region is the output requested region padded by the external radius */
+  void GenerateInputRequestedRegion() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread) override;
+
+private:
+  LocalRxDetectorFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  SizeType m_InternalRadius;
+  SizeType m_ExternalRadius;
+};
+
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLocalRxDetectorFilter.hxx"
+#endif
+
 #endif
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLocalRxDetectorFilter_hxx
+#define otbLocalRxDetectorFilter_hxx
+
+#include "otbLocalRxDetectorFilter.h"
+
+#include "itkImageScanlineIterator.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+LocalRxDetectorFilter<TInputImage, TOutputImage>::LocalRxDetectorFilter()
+{
+  m_InternalRadius.Fill(1);
+  m_ExternalRadius.Fill(5);
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_ExternalRadius);
+
+  if (inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
+  {
+    input->SetRequestedRegion(inputRequestedRegion);
+  }
+  else
+  {
+    // Couldn't crop the region (requested region is outside the largest
+    // possible region).  Throw an exception.
+    input->SetRequestedRegion(inputRequestedRegion);
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(input);
+    throw e;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
+{
+  const InputImageType* input  = this->GetInput();
+  OutputImageType*      output = this->GetOutput();
+
+  const unsigned int nbBands = input->GetNumberOfComponentsPerPixel();
+
+  const InputImageRegionType&   bufferedRegion = input->GetBufferedRegion();
+  const InputInternalPixelType* buffer         = input->GetBufferPointer();
+  const long                    bufStartX      = bufferedRegion.GetIndex(0);
+  const long                    bufStartY      = bufferedRegion.GetIndex(1);
+  const long                    bufSizeX       = bufferedRegion.GetSize(0);
+  const long                    bufSizeY       = bufferedRegion.GetSize(1);
+
+  // The internal window can not be larger than the external one
+  const long extRadiusX = m_ExternalRadius[0];
+  const long extRadiusY = m_ExternalRadius[1];
+  const long intRadiusX = std::min(m_InternalRadius[0], m_ExternalRadius[0]);
+  const long intRadiusY = std::min(m_InternalRadius[1], m_ExternalRadius[1]);
+
+  const double nbSamples = (2 * extRadiusX + 1) * (2 * extRadiusY + 1) - (2 * intRadiusX + 1) * (2 * intRadiusY + 1);
+
+  // Pixels outside the buffered region are replaced by the nearest pixel
+  // (same behavior as ZeroFluxNeumannBoundaryCondition)
+  auto pixelAt = [&](long x, long y) {
+    x = std::min(std::max(x, bufStartX), bufStartX + bufSizeX - 1);
+    y = std::min(std::max(y, bufStartY), bufStartY + bufSizeY - 1);
+    return buffer + ((y - bufStartY) * bufSizeX + (x - bufStartX)) * nbBands;
+  };
+
+  // Work buffers. Only the upper triangle of the square matrices is used,
+  // except for the Cholesky factor which is stored in the lower triangle.
+  std::vector<double> shift(nbBands);
+  std::vector<double> centered(nbBands);
+  std::vector<double> extSum(nbBands);
+  std::vector<double> intSum(nbBands);
+  std::vector<double> extSqSum(nbBands * nbBands);
+  std::vector<double> intSqSum(nbBands * nbBands);
+  std::vector<double> diff(nbBands);
+  std::vector<double> solution(nbBands);
+  std::vector<double> cov(nbBands * nbBands);
+  std::vector<double> chol(nbBands * nbBands);
+
+  // Add (sign = 1) or remove (sign = -1) the moments of the pixels of
+  // column x, between rows y - radiusY and y + radiusY
+  auto accumulateColumn = [&](std::vector<double>& sum, std::vector<double>& sqSum, long x, long y, long radiusY, double sign) {
+    for (long row = y - radiusY; row <= y + radiusY; ++row)
+    {
+      const InputInternalPixelType* pixel = pixelAt(x, row);
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        centered[i] = static_cast<double>(pixel[i]) - shift[i];
+      }
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        const double vi    = sign * centered[i];
+        double*      sqRow = &sqSum[i * nbBands];
+        sum[i] += vi;
+        for (unsigned int j = i; j < nbBands; ++j)
+        {
+          sqRow[j] += vi * centered[j];
+        }
+      }
+    }
+  };
+
+  // Rx score of the center pixel, from the moments of the dual neighborhood
+  auto computeScore = [&](const InputInternalPixelType* center) -> double {
+    if (nbSamples < 2)
+    {
+      return 0.;
+    }
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      const double mean = (extSum[i] - intSum[i]) / nbSamples;
+      diff[i]           = static_cast<double>(center[i]) - shift[i] - mean;
+    }
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      const double meanI = (extSum[i] - intSum[i]) / nbSamples;
+      for (unsigned int j = i; j < nbBands; ++j)
+      {
+        const double meanJ     = (extSum[j] - intSum[j]) / nbSamples;
+        cov[i * nbBands + j] = (extSqSum[i * nbBands + j] - intSqSum[i * nbBands + j] - nbSamples * meanI * meanJ) / (nbSamples - 1);
+      }
+    }
+
+    // Cholesky factorization cov = L.L^T
+    bool positiveDefinite = true;
+    for (unsigned int j = 0; j < nbBands && positiveDefinite; ++j)
+    {
+      const double* rowJ = &chol[j * nbBands];
+      double        s    = cov[j * nbBands + j];
+      for (unsigned int k = 0; k < j; ++k)
+      {
+        s -= rowJ[k] * rowJ[k];
+      }
+      if (!(s > 0.))
+      {
+        positiveDefinite = false;
+        break;
+      }
+      const double ljj           = std::sqrt(s);
+      chol[j * nbBands + j] = ljj;
+      for (unsigned int i = j + 1; i < nbBands; ++i)
+      {
+        const double* rowI = &chol[i * nbBands];
+        double        t    = cov[j * nbBands + i];
+        for (unsigned int k = 0; k < j; ++k)
+        {
+          t -= rowI[k] * rowJ[k];
+        }
+        chol[i * nbBands + j] = t / ljj;
+      }
+    }
+
+    if (positiveDefinite)
+    {
+      // Forward substitution L.z = diff, the score is z^T.z
+      double score = 0.;
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        const double* rowI = &chol[i * nbBands];
+        double        z    = diff[i];
+        for (unsigned int k = 0; k < i; ++k)
+        {
+          z -= rowI[k] * solution[k];
+        }
+        solution[i] = z / rowI[i];
+        score += solution[i] * solution[i];
+      }
+      return score;
+    }
+
+    // Singular covariance matrix: use the pseudo-inverse, like
+    // LocalRxDetectionFunctor does
+    vnl_matrix<double> covMatrix(nbBands, nbBands);
+    vnl_vector<double> diffVector(diff.data(), nbBands);
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      for (unsigned int j = i; j < nbBands; ++j)
+      {
+        covMatrix(i, j) = covMatrix(j, i) = cov[i * nbBands + j];
+      }
+    }
+    vnl_svd<double> svd(covMatrix);
+    return dot_product(diffVector, svd.inverse() * diffVector);
+  };
+
+  itk::ImageScanlineIterator<OutputImageType> outIt(output, outputRegionForThread);
+  const long                                  startX = outputRegionForThread.GetIndex(0);
+
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    const long y = outIt.GetIndex()[1];
+
+    // Moments are computed relatively to the first pixel of the line, to
+    // limit the cancellation errors of the covariance computation
+    const InputInternalPixelType* first = pixelAt(startX, y);
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      shift[i] = static_cast<double>(first[i]);
+    }
+    std::fill(extSum.begin(), extSum.end(), 0.);
+    std::fill(intSum.begin(), intSum.end(), 0.);
+    std::fill(extSqSum.begin(), extSqSum.end(), 0.);
+    std::fill(intSqSum.begin(), intSqSum.end(), 0.);
+
+    for (long x = startX - extRadiusX; x <= startX + extRadiusX; ++x)
+    {
+      accumulateColumn(extSum, extSqSum, x, y, extRadiusY, 1.);
+    }
+    for (long x = startX - intRadiusX; x <= startX + intRadiusX; ++x)
+    {
+      accumulateColumn(intSum, intSqSum, x, y, intRadiusY, 1.);
+    }
+
+    for (long x = startX; !outIt.IsAtEndOfLine(); ++outIt, ++x)
+    {
+      if (x > startX)
+      {
+        // Slide the windows by one pixel
+        accumulateColumn(extSum, extSqSum, x + extRadiusX, y, extRadiusY, 1.);
+        accumulateColumn(extSum, extSqSum, x - extRadiusX - 1, y, extRadiusY, -1.);
+        accumulateColumn(intSum, intSqSum, x + intRadiusX, y, intRadiusY, 1.);
+        accumulateColumn(intSum, intSqSum, x - intRadiusX - 1, y, intRadiusY, -1.);
+      }
+      outIt.Set(static_cast<OutputPixelType>(computeScore(pixelAt(x, y))));
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
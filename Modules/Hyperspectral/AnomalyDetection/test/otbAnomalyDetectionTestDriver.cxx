@@ -23,4 +23,5 @@
 void RegisterTests()
 {
   REGISTER_TEST(LocalRXDetectorTest);
+  REGISTER_TEST(LocalRXDetectorFilterTest);
 }
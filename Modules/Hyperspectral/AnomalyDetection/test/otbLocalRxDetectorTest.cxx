@@ -23,6 +23,7 @@
 #include "otbLocalRxDetectorFilter.h"
 #include "itkRescaleIntensityImageFilter.h"
 #include "otbFunctorImageFilter.h"
+#include "itkImageRegionConstIterator.h"
 
 int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 {
@@ -72,3 +73,48 @@ int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int LocalRXDetectorFilterTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef double PixelType;
+  typedef otb::VectorImage<PixelType, 2> VectorImageType;
+  typedef otb::Image<PixelType, 2>       ImageType;
+  typedef otb::Functor::LocalRxDetectionFunctor<PixelType> LocalRxDetectorFunctorType;
+  typedef otb::LocalRxDetectorFilter<VectorImageType, ImageType> LocalRxDetectorFilterType;
+
+  typedef otb::ImageFileReader<VectorImageType> ReaderType;
+
+  const char*        filename       = argv[1];
+  const unsigned int externalRadius = atoi(argv[2]);
+  const unsigned int internalRadius = atoi(argv[3]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+
+  // Reference: statistics computed from scratch for each pixel
+  LocalRxDetectorFunctorType detectorFunctor;
+  detectorFunctor.SetInternalRadius(internalRadius, internalRadius);
+  auto referenceDetector = otb::NewFunctorFilter(detectorFunctor, {{externalRadius, externalRadius}});
+  referenceDetector->SetInputs(reader->GetOutput());
+  referenceDetector->Update();
+
+  LocalRxDetectorFilterType::Pointer rxDetector = LocalRxDetectorFilterType::New();
+  rxDetector->SetInput(reader->GetOutput());
+  rxDetector->SetInternalRadius(internalRadius, internalRadius);
+  rxDetector->SetExternalRadius(externalRadius, externalRadius);
+  rxDetector->Update();
+
+  itk::ImageRegionConstIterator<ImageType> refIt(referenceDetector->GetOutput(), referenceDetector->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> outIt(rxDetector->GetOutput(), rxDetector->GetOutput()->GetLargestPossibleRegion());
+
+  double maxRelativeError = 0.;
+  for (refIt.GoToBegin(), outIt.GoToBegin(); !refIt.IsAtEnd(); ++refIt, ++outIt)
+  {
+    const double error = std::abs(refIt.Get() - outIt.Get()) / std::max(std::abs(refIt.Get()), 1.);
+    maxRelativeError   = std::max(maxRelativeError, error);
+  }
+  std::cout << "Maximum relative error: " << maxRelativeError << std::endl;
+  otbControlConditionTestMacro(maxRelativeError > 1e-6, "LocalRxDetectorFilter output differs from LocalRxDetectionFunctor");
+
+  return EXIT_SUCCESS;
+}
@@ -22,7 +22,6 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbLocalRxDetectorFilter.h"
-#include "otbFunctorImageFilter.h"
 
 namespace otb
 {
@@ -105,18 +104,15 @@ private:
     auto inputImage = GetParameterDoubleVectorImage("in");
     inputImage->UpdateOutputInformation();
 
-    Functor::LocalRxDetectionFunctor<double> detectorFunctor;
-
     unsigned int externalRadius = GetParameterInt("er");
     unsigned int internalRadius = GetParameterInt("ir");
 
-    detectorFunctor.SetInternalRadius(internalRadius, internalRadius);
-
-    // Create a functorImageFilter with the localRx functor and the appropriate
-    // external radius.
-    auto localRxDetectionFilter = otb::NewFunctorFilter(detectorFunctor, {{externalRadius, externalRadius}});
-
-    localRxDetectionFilter->SetInputs(inputImage);
+    // The local statistics are updated incrementally as the neighborhood
+    // slides along the lines.
+    auto localRxDetectionFilter = LocalRxDetectorFilter<VectorImageType, ImageType>::New();
+    localRxDetectionFilter->SetInternalRadius(internalRadius, internalRadius);
+    localRxDetectionFilter->SetExternalRadius(externalRadius, externalRadius);
+    localRxDetectionFilter->SetInput(inputImage);
 
     SetParameterOutputImage("out", localRxDetectionFilter->GetOutput());
     RegisterPipeline();
@@ -73,6 +73,12 @@ public:
 
   OutputType operator()(const InputType& in) const;
 
+  /** Unmixes a run of nbPixels contiguous pixels at once (see
+   * FunctorImageFilter). The iterations are written as products of
+   * the whole block with the Gram matrix of the endmembers. */
+  template <class TIn, class TOut>
+  void ProcessBlock(const TIn* in, size_t nbPixels, size_t nbInComps, TOut* out, size_t nbOutComps) const;
+
 private:
   static bool IsNonNegative(PrecisionType val)
   {
@@ -84,6 +90,8 @@ private:
 
   MatrixType     m_U;
   SVDPointerType m_Svd; // SVD of U
+  MatrixType     m_PseudoInverseTranspose;
+  MatrixType     m_Gram; // U^T . U
   unsigned int   m_OutputSize;
   unsigned int   m_MaxIteration;
 };
@@ -22,7 +22,10 @@
 #define otbISRAUnmixingImageFilter_hxx
 
 #include "otbISRAUnmixingImageFilter.h"
+#include "otbBlockedMatrixProduct.h"
 #include <algorithm>
+#include <cassert>
+#include <vector>
 
 namespace otb
 {
@@ -47,6 +50,8 @@ void ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::SetEndmembersMatrix(const
   m_U          = U;
   m_OutputSize = m_U.cols();
   m_Svd.reset(new SVDType(m_U));
+  m_PseudoInverseTranspose = m_Svd->inverse().transpose();
+  m_Gram                   = m_U.transpose() * m_U;
 }
 
 
@@ -112,6 +117,54 @@ typename ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::OutputType ISRAUnmixi
   return out;
 }
 
+template <class TInput, class TOutput, class TPrecision>
+template <class TIn, class TOut>
+void ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::ProcessBlock(const TIn* in, size_t nbPixels, size_t nbInComps, TOut* out, size_t nbOutComps) const
+{
+  assert(nbInComps == m_U.rows() && nbOutComps == m_U.cols());
+
+  const size_t blockSize = std::min(nbPixels, BlockedMatrixProductPixelBlockSize);
+
+  std::vector<PrecisionType> pixels(blockSize * nbInComps);
+  std::vector<PrecisionType> abundances(blockSize * nbOutComps);
+  std::vector<PrecisionType> numerators(blockSize * nbOutComps);
+  std::vector<PrecisionType> denominators(blockSize * nbOutComps);
+
+  for (size_t first = 0; first < nbPixels; first += blockSize)
+  {
+    const size_t count = std::min(blockSize, nbPixels - first);
+
+    const TIn* inBlock = in + first * nbInComps;
+    for (size_t i = 0; i < count * nbInComps; ++i)
+    {
+      pixels[i] = static_cast<PrecisionType>(inBlock[i]);
+    }
+
+    // Initialize with Unconstrained Least Square solution
+    BlockedMatrixProduct(count, nbOutComps, nbInComps, pixels.data(), m_PseudoInverseTranspose.data_block(), abundances.data());
+
+    // Numerators p . U do not change along iterations
+    BlockedMatrixProduct(count, nbOutComps, nbInComps, pixels.data(), m_U.data_block(), numerators.data());
+
+    // Apply ISRA iterations, denominators being x . (U^T . U)
+    for (unsigned int it = 0; it < m_MaxIteration; ++it)
+    {
+      BlockedMatrixProduct(count, nbOutComps, nbOutComps, abundances.data(), m_Gram.data_block(), denominators.data());
+
+      for (size_t i = 0; i < count * nbOutComps; ++i)
+      {
+        abundances[i] *= (numerators[i] / denominators[i]);
+      }
+    }
+
+    TOut* outBlock = out + first * nbOutComps;
+    for (size_t i = 0; i < count * nbOutComps; ++i)
+    {
+      outBlock[i] = static_cast<TOut>(abundances[i]);
+    }
+  }
+}
+
 } // end namespace functor
 } // end namespace otb
 
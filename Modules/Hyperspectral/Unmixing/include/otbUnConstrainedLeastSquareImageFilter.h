@@ -60,6 +60,11 @@ public:
 
   OutputType operator()(const InputType& in) const;
 
+  /** Solves the system for a run of nbPixels contiguous pixels at once
+   * (see FunctorImageFilter) */
+  template <class TIn, class TOut>
+  void ProcessBlock(const TIn* in, size_t nbPixels, size_t nbInComps, TOut* out, size_t nbOutComps) const;
+
 private:
   typedef vnl_svd<PrecisionType>     SVDType;
   typedef std::shared_ptr<SVDType> SVDPointerType;
@@ -67,6 +72,7 @@ private:
   unsigned int   m_OutputSize;
   SVDPointerType m_Svd;
   MatrixType     m_Inv;
+  MatrixType     m_InvTranspose;
 };
 }
 
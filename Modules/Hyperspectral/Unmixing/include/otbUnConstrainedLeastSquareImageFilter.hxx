@@ -22,6 +22,8 @@
 #define otbUnConstrainedLeastSquareImageFilter_hxx
 
 #include "otbUnConstrainedLeastSquareImageFilter.h"
+#include "otbBlockedMatrixProduct.h"
+#include <cassert>
 
 namespace otb
 {
@@ -38,8 +40,9 @@ template <class TInput, class TOutput, class TPrecision>
 void UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::SetMatrix(const MatrixType& m)
 {
   m_Svd.reset(new SVDType(m));
-  m_Inv        = m_Svd->inverse();
-  m_OutputSize = m.cols();
+  m_Inv          = m_Svd->inverse();
+  m_InvTranspose = m_Inv.transpose();
+  m_OutputSize   = m.cols();
 }
 
 template <class TInput, class TOutput, class TPrecision>
@@ -63,6 +66,16 @@ operator()(const InputType& in) const
   return out;
 }
 
+template <class TInput, class TOutput, class TPrecision>
+template <class TIn, class TOut>
+void UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::ProcessBlock(const TIn* in, size_t nbPixels, size_t nbInComps, TOut* out,
+                                                                                size_t nbOutComps) const
+{
+  assert(nbInComps == m_InvTranspose.rows() && nbOutComps == m_InvTranspose.cols());
+
+  // Each output pixel is the row vector p . Inv^T
+  ApplyLinearOperatorToPixels(in, nbPixels, nbInComps, m_InvTranspose.data_block(), nbOutComps, out);
+}
 
 } // end namespace Functor
 } // end namespace otb
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbISRAUnmixingImageFilter.h"
+#include "otbUnConstrainedLeastSquareImageFilter.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+const unsigned int Dimension = 2;
+typedef double     PixelType;
+
+typedef otb::VectorImage<PixelType, Dimension> ImageType;
+typedef vnl_matrix<PixelType>                  MatrixType;
+
+/** Check that the filter output, computed by the block operator of the
+ * functor, matches the per-pixel operator */
+template <class TFilter>
+bool CheckBlockOperator(TFilter* filter, ImageType* image, const char* name)
+{
+  static_assert(TFilter::UseBlockOperator::value, "The block operator should be used");
+
+  filter->SetInput(image);
+  filter->Update();
+
+  const auto&                              functor = filter->GetFunctor();
+  itk::ImageRegionConstIterator<ImageType> inIt(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> outIt(filter->GetOutput(), image->GetLargestPossibleRegion());
+  for (; !inIt.IsAtEnd(); ++inIt, ++outIt)
+  {
+    const ImageType::PixelType expected = functor(inIt.Get());
+    const ImageType::PixelType actual   = outIt.Get();
+    if (expected.Size() != actual.Size())
+    {
+      std::cerr << name << ": block operator outputs " << actual.Size() << " bands instead of " << expected.Size() << std::endl;
+      return false;
+    }
+    for (unsigned int i = 0; i < expected.Size(); ++i)
+    {
+      if (std::abs(expected[i] - actual[i]) > 1e-9 * std::max(1., std::abs(expected[i])))
+      {
+        std::cerr << name << ": block operator and pixel operator differ at " << inIt.GetIndex() << ", band " << i << ": " << actual[i] << " instead of "
+                  << expected[i] << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int otbUnmixingBlockOperatorTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int nbBands      = 6;
+  const unsigned int nbEndmembers = 3;
+
+  MatrixType endmembers(nbBands, nbEndmembers);
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    for (unsigned int e = 0; e < nbEndmembers; ++e)
+    {
+      endmembers(b, e) = 0.1 + static_cast<PixelType>((3 * b + 7 * e) % 11) / 10.;
+    }
+  }
+
+  // Lines longer than a block of the matrix product, so that several
+  // blocks and a partial one are processed
+  ImageType::SizeType size;
+  size[0] = 150;
+  size[1] = 7;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  // Positive mixtures of the endmembers, with some noise
+  itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (unsigned int n = 0; !it.IsAtEnd(); ++it, ++n)
+  {
+    ImageType::PixelType pixel(nbBands);
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      pixel[b] = 0.01 * static_cast<PixelType>((n + 5 * b) % 13);
+      for (unsigned int e = 0; e < nbEndmembers; ++e)
+      {
+        pixel[b] += endmembers(b, e) * static_cast<PixelType>(1 + (n * (e + 2)) % 9);
+      }
+    }
+    it.Set(pixel);
+  }
+
+  typedef otb::ISRAUnmixingImageFilter<ImageType, ImageType, PixelType> ISRAFilterType;
+  ISRAFilterType::Pointer isra = ISRAFilterType::New();
+  isra->GetModifiableFunctor().SetEndmembersMatrix(endmembers);
+  isra->GetModifiableFunctor().SetMaxIteration(10);
+  if (!CheckBlockOperator(isra.GetPointer(), image, "ISRAUnmixingImageFilter"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::UnConstrainedLeastSquareImageFilter<ImageType, ImageType, PixelType> UCLSFilterType;
+  UCLSFilterType::Pointer ucls = UCLSFilterType::New();
+  ucls->GetModifiableFunctor().SetMatrix(endmembers);
+  if (!CheckBlockOperator(ucls.GetPointer(), image, "UnConstrainedLeastSquareImageFilter"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
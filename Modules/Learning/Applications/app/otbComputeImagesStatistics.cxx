@@ -22,7 +22,7 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbStatisticsXMLFileWriter.h"
-#include "otbStreamingStatisticsVectorImageFilter.h"
+#include "otbStreamingMultiAccumulatorImageFilter.h"
 #include <sstream>
 
 namespace otb
@@ -116,8 +116,10 @@ private:
 
   void DoExecute() override
   {
-    // Statistics estimator
-    typedef otb::StreamingStatisticsVectorImageFilter<FloatVectorImageType> StreamingStatisticsVImageFilterType;
+    // Statistics estimator: extrema and per band moments, in a single pass
+    typedef otb::StreamingMultiAccumulatorImageFilter<FloatVectorImageType> StreamingStatisticsVImageFilterType;
+    typedef otb::MinMaxAccumulator<>                                        MinMaxAccumulatorType;
+    typedef otb::MomentsAccumulator<>                                       MomentsAccumulatorType;
 
     // Samples
     typedef double                               ValueType;
@@ -163,7 +165,12 @@ private:
       }
 
       // Compute Statistics of each VectorImage
+      auto minMax  = std::make_shared<MinMaxAccumulatorType>();
+      auto moments = std::make_shared<MomentsAccumulatorType>();
+
       StreamingStatisticsVImageFilterType::Pointer statsEstimator = StreamingStatisticsVImageFilterType::New();
+      statsEstimator->AddAccumulator(minMax);
+      statsEstimator->AddAccumulator(moments);
       std::ostringstream                           processName;
       processName << "Processing Image (" << imageId + 1 << "/" << imageList->Size() << ")";
       AddProcess(statsEstimator->GetStreamer(), processName.str());
@@ -177,18 +184,18 @@ private:
       }
       statsEstimator->Update();
 
-      MeasurementType nbRelevantPixels = statsEstimator->GetNbRelevantPixels();
-      MeasurementType meanPerBand      = statsEstimator->GetMean();
-      MeasurementType minPerBand       = statsEstimator->GetMinimum();
-      MeasurementType maxPerBand       = statsEstimator->GetMaximum();
+      if (moments->GetCount() == 0)
+      {
+        itkExceptionMacro(<< "Statistics cannot be calculated with zero relevant pixels in image #" << imageId + 1);
+      }
 
       for (unsigned int itBand = 0; itBand < nbBands; itBand++)
       {
-        mean(itBand, imageId)      = meanPerBand[itBand];
-        min(itBand, imageId)       = minPerBand[itBand];
-        max(itBand, imageId)       = maxPerBand[itBand];
-        variance(itBand, imageId)  = (statsEstimator->GetCovariance())(itBand, itBand);
-        nbSamples(itBand, imageId) = nbRelevantPixels[itBand];
+        mean(itBand, imageId)      = moments->GetMean()[itBand];
+        min(itBand, imageId)       = minMax->GetMinimum()[itBand];
+        max(itBand, imageId)       = minMax->GetMaximum()[itBand];
+        variance(itBand, imageId)  = moments->GetVariance()[itBand];
+        nbSamples(itBand, imageId) = moments->GetCount();
       }
     }
 
@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatRandomForest_h
+#define otbFlatRandomForest_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class FlatRandomForest
+ * \brief Cache-friendly inference engine for forests of binary decision trees.
+ *
+ * The trees of a trained forest (OpenCV, Shark...) are copied into a
+ * single array of nodes, each tree being laid out in breadth-first
+ * order so that the two children of a node are adjacent. A node only
+ * stores its split feature, its threshold and the position of its left
+ * child: the traversal step is
+ * \code
+ * node = nodes[node].Child + !(x[nodes[node].Feature] <= nodes[node].Threshold);
+ * \endcode
+ * without any branch. Leaves loop on themselves, so every sample can be
+ * pushed down a tree for a fixed number of levels (the depth of the
+ * tree) regardless of where it ends.
+ *
+ * Samples are evaluated by blocks of `BlockSize`: each tree is walked
+ * level by level for the whole block, which keeps the upper levels of
+ * the tree in cache and gives the processor independent loads to
+ * overlap.
+ *
+ * Each leaf carries `GetNumberOfOutputs()` values which are summed
+ * over the trees (weighted by the tree weight). A classification
+ * forest voting for a single class uses one-hot leaves, so the sums
+ * are the vote counts; a forest whose leaves hold class distributions
+ * (Shark) sums the distributions; a regression forest uses a single
+ * output. Dividing by `GetTotalWeight()` gives the class
+ * probabilities or the regression value.
+ *
+ * Samples sent to the right child are the ones for which
+ * `x <= Threshold` is false, which includes NaN values as in OpenCV and
+ * Shark.
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TValue>
+class FlatRandomForest
+{
+public:
+  static_assert(std::is_floating_point<TValue>::value, "FlatRandomForest thresholds must be floating point values");
+
+  typedef TValue        ValueType;
+  typedef std::uint32_t IndexType;
+
+  /** Number of samples pushed together down each tree */
+  static constexpr std::size_t BlockSize = 64;
+
+  /** Node of a tree as described to AddTree().
+   * Internal nodes send the samples with `x[Feature] <= Threshold` to
+   * `Left` and the others to `Right`, both being positions in the node
+   * vector. Leaves have negative children and hold exactly
+   * GetNumberOfOutputs() values. */
+  struct TreeNode
+  {
+    long                Left      = -1;
+    long                Right     = -1;
+    unsigned int        Feature   = 0;
+    ValueType           Threshold = 0;
+    std::vector<double> Values;
+  };
+
+  /** Flattened node */
+  struct Node
+  {
+    ValueType Threshold;
+    IndexType Feature;
+    IndexType Child;
+  };
+
+  FlatRandomForest() = default;
+
+  /** Removes all the trees and sets the width of the leaf values */
+  void Clear(std::size_t nbOutputs = 1)
+  {
+    m_Nodes.clear();
+    m_LeafOffsets.clear();
+    m_Values.clear();
+    m_Roots.clear();
+    m_Depths.clear();
+    m_NumberOfOutputs  = nbOutputs;
+    m_NumberOfFeatures = 0;
+    m_TotalWeight      = 0.;
+  }
+
+  /** Appends a tree to the forest.
+   * \param tree nodes of the tree
+   * \param root position of the root in `tree`
+   * \param weight factor applied to the leaf values of the tree
+   * \throw std::invalid_argument if the tree is not a valid binary tree
+   */
+  void AddTree(const std::vector<TreeNode>& tree, std::size_t root = 0, double weight = 1.)
+  {
+    if (root >= tree.size())
+    {
+      throw std::invalid_argument("FlatRandomForest: root is outside the tree");
+    }
+
+    const std::size_t rootPos = m_Nodes.size();
+    std::size_t       depth   = 0;
+
+    // Breadth-first copy: (source node, flat position, level)
+    std::vector<std::pair<std::size_t, std::size_t>> queue;
+    std::vector<std::size_t>                         levels;
+    queue.emplace_back(root, rootPos);
+    levels.push_back(0);
+    m_Nodes.emplace_back();
+    m_LeafOffsets.push_back(0);
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+      if (head >= tree.size())
+      {
+        throw std::invalid_argument("FlatRandomForest: the tree has a cycle");
+      }
+
+      const TreeNode&   src   = tree[queue[head].first];
+      const std::size_t pos   = queue[head].second;
+      const std::size_t level = levels[head];
+      Node&             dst   = m_Nodes[pos];
+
+      if (src.Left < 0 || src.Right < 0)
+      {
+        if (src.Values.size() != m_NumberOfOutputs)
+        {
+          throw std::invalid_argument("FlatRandomForest: wrong number of leaf values");
+        }
+        // A NaN threshold always sends samples to Child + 1, which is the
+        // leaf itself (unsigned arithmetic wraps for the very first node).
+        dst.Threshold      = std::numeric_limits<ValueType>::quiet_NaN();
+        dst.Feature        = 0;
+        dst.Child          = static_cast<IndexType>(pos - 1);
+        m_LeafOffsets[pos] = static_cast<IndexType>(m_Values.size());
+        for (double v : src.Values)
+        {
+          m_Values.push_back(weight * v);
+        }
+        depth = std::max(depth, level);
+      }
+      else
+      {
+        if (static_cast<std::size_t>(src.Left) >= tree.size() || static_cast<std::size_t>(src.Right) >= tree.size())
+        {
+          throw std::invalid_argument("FlatRandomForest: child is outside the tree");
+        }
+        const std::size_t child = m_Nodes.size();
+        if (child + 2 > std::numeric_limits<IndexType>::max())
+        {
+          throw std::invalid_argument("FlatRandomForest: too many nodes");
+        }
+        dst.Threshold      = src.Threshold;
+        dst.Feature        = src.Feature;
+        dst.Child          = static_cast<IndexType>(child);
+        m_NumberOfFeatures = std::max(m_NumberOfFeatures, static_cast<std::size_t>(src.Feature) + 1);
+
+        // dst is invalidated by the insertions below
+        m_Nodes.resize(child + 2);
+        m_LeafOffsets.resize(child + 2, 0);
+        queue.emplace_back(static_cast<std::size_t>(src.Left), child);
+        queue.emplace_back(static_cast<std::size_t>(src.Right), child + 1);
+        levels.push_back(level + 1);
+        levels.push_back(level + 1);
+      }
+    }
+
+    m_Roots.push_back(static_cast<IndexType>(rootPos));
+    m_Depths.push_back(depth);
+    m_TotalWeight += weight;
+  }
+
+  /** Sums the leaf values reached by a set of samples.
+   * \param samples `nbSamples` rows of at least GetNumberOfFeatures()
+   * values, `stride` values apart
+   * \param sums output, `nbSamples` rows of GetNumberOfOutputs() values
+   */
+  void Accumulate(ValueType const* samples, std::size_t nbSamples, std::size_t stride, double* sums) const noexcept
+  {
+    std::fill(sums, sums + nbSamples * m_NumberOfOutputs, 0.);
+
+    IndexType pos[BlockSize];
+
+    for (std::size_t first = 0; first < nbSamples; first += BlockSize)
+    {
+      const std::size_t count     = std::min(BlockSize, nbSamples - first);
+      ValueType const*  block     = samples + first * stride;
+      double*           blockSums = sums + first * m_NumberOfOutputs;
+
+      for (std::size_t t = 0; t < m_Roots.size(); ++t)
+      {
+        std::fill(pos, pos + count, m_Roots[t]);
+
+        for (std::size_t level = 0; level < m_Depths[t]; ++level)
+        {
+          for (std::size_t s = 0; s < count; ++s)
+          {
+            const Node& node = m_Nodes[pos[s]];
+            pos[s]           = node.Child + static_cast<IndexType>(!(block[s * stride + node.Feature] <= node.Threshold));
+          }
+        }
+
+        for (std::size_t s = 0; s < count; ++s)
+        {
+          double const* values = m_Values.data() + m_LeafOffsets[pos[s]];
+          double*       out    = blockSums + s * m_NumberOfOutputs;
+          for (std::size_t k = 0; k < m_NumberOfOutputs; ++k)
+          {
+            out[k] += values[k];
+          }
+        }
+      }
+    }
+  }
+
+  /** Position of the largest of `n` values, the first one on ties */
+  static std::size_t ArgMax(double const* values, std::size_t n) noexcept
+  {
+    return static_cast<std::size_t>(std::max_element(values, values + n) - values);
+  }
+
+  /** Difference between the two largest of `n` values (the largest one if n < 2) */
+  static double Margin(double const* values, std::size_t n) noexcept
+  {
+    if (n < 2)
+    {
+      return n == 0 ? 0. : values[0];
+    }
+    double first  = -std::numeric_limits<double>::infinity();
+    double second = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (values[i] > first)
+      {
+        second = first;
+        first  = values[i];
+      }
+      else if (values[i] > second)
+      {
+        second = values[i];
+      }
+    }
+    return first - second;
+  }
+
+  bool IsEmpty() const noexcept
+  {
+    return m_Roots.empty();
+  }
+
+  std::size_t GetNumberOfTrees() const noexcept
+  {
+    return m_Roots.size();
+  }
+
+  std::size_t GetNumberOfNodes() const noexcept
+  {
+    return m_Nodes.size();
+  }
+
+  std::size_t GetNumberOfOutputs() const noexcept
+  {
+    return m_NumberOfOutputs;
+  }
+
+  /** Minimal length of the samples: largest split feature plus one */
+  std::size_t GetNumberOfFeatures() const noexcept
+  {
+    return m_NumberOfFeatures;
+  }
+
+  /** Sum of the weights of the trees */
+  double GetTotalWeight() const noexcept
+  {
+    return m_TotalWeight;
+  }
+
+  const std::vector<Node>& GetNodes() const noexcept
+  {
+    return m_Nodes;
+  }
+
+private:
+  std::vector<Node>        m_Nodes;
+  std::vector<IndexType>   m_LeafOffsets;
+  std::vector<double>      m_Values;
+  std::vector<IndexType>   m_Roots;
+  std::vector<std::size_t> m_Depths;
+  std::size_t              m_NumberOfOutputs  = 1;
+  std::size_t              m_NumberOfFeatures = 0;
+  double                   m_TotalWeight      = 0.;
+};
+
+template <class TValue>
+constexpr std::size_t FlatRandomForest<TValue>::BlockSize;
+
+} // end namespace otb
+
+#endif
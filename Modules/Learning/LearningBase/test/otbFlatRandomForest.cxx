@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbMacro.h"
+#include "otbFlatRandomForest.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace
+{
+typedef otb::FlatRandomForest<float> ForestType;
+typedef ForestType::TreeNode         TreeNodeType;
+
+const unsigned int NumberOfFeatures = 5;
+const unsigned int NumberOfClasses  = 4;
+
+// Random tree with nodes in depth-first order, as most libraries store them
+long GrowTree(std::vector<TreeNodeType>& tree, std::mt19937& gen, unsigned int depth)
+{
+  std::uniform_real_distribution<float> threshold(-1.f, 1.f);
+  std::uniform_int_distribution<int>    feature(0, NumberOfFeatures - 1);
+  std::uniform_int_distribution<int>    label(0, NumberOfClasses - 1);
+  std::bernoulli_distribution           isLeaf(0.25);
+
+  const long id = static_cast<long>(tree.size());
+  tree.emplace_back();
+  if (depth == 0 || isLeaf(gen))
+  {
+    tree[id].Values.assign(NumberOfClasses, 0.);
+    tree[id].Values[label(gen)] = 1.;
+    return id;
+  }
+  tree[id].Feature   = feature(gen);
+  tree[id].Threshold = threshold(gen);
+  const long left    = GrowTree(tree, gen, depth - 1);
+  const long right   = GrowTree(tree, gen, depth - 1);
+  tree[id].Left      = left;
+  tree[id].Right     = right;
+  return id;
+}
+
+// Reference walk, the way OpenCV and Shark evaluate a tree
+const std::vector<double>& Walk(const std::vector<TreeNodeType>& tree, const float* x)
+{
+  long id = 0;
+  while (tree[id].Left >= 0)
+  {
+    id = x[tree[id].Feature] <= tree[id].Threshold ? tree[id].Left : tree[id].Right;
+  }
+  return tree[id].Values;
+}
+}
+
+int otbFlatRandomForest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  std::mt19937 gen(42);
+
+  std::vector<std::vector<TreeNodeType>> trees(37);
+  ForestType                             forest;
+  forest.Clear(NumberOfClasses);
+  for (auto& tree : trees)
+  {
+    GrowTree(tree, gen, 9);
+    forest.AddTree(tree);
+  }
+
+  // A single leaf tree
+  trees.emplace_back(1);
+  trees.back()[0].Values.assign(NumberOfClasses, 0.);
+  trees.back()[0].Values[2] = 1.;
+  forest.AddTree(trees.back());
+
+  // Samples with a stride larger than the number of features, a few NaN
+  // and a count which is not a multiple of the block size
+  const std::size_t                     nbSamples = 3 * ForestType::BlockSize + 17;
+  const std::size_t                     stride    = NumberOfFeatures + 2;
+  std::uniform_real_distribution<float> value(-1.2f, 1.2f);
+  std::vector<float>                    samples(nbSamples * stride);
+  for (auto& v : samples)
+  {
+    v = value(gen);
+  }
+  for (std::size_t i = 0; i < nbSamples; i += 11)
+  {
+    samples[i * stride + i % NumberOfFeatures] = std::numeric_limits<float>::quiet_NaN();
+  }
+
+  std::vector<double> sums(nbSamples * NumberOfClasses);
+  forest.Accumulate(samples.data(), nbSamples, stride, sums.data());
+
+  otbControlConditionTestMacro(forest.GetNumberOfTrees() != trees.size(), "Wrong number of trees");
+  otbControlConditionTestMacro(forest.GetNumberOfFeatures() > NumberOfFeatures, "Wrong number of features");
+  otbControlConditionTestMacro(forest.GetTotalWeight() != trees.size(), "Wrong total weight");
+
+  for (std::size_t i = 0; i < nbSamples; ++i)
+  {
+    std::vector<double> votes(NumberOfClasses, 0.);
+    for (const auto& tree : trees)
+    {
+      const std::vector<double>& leaf = Walk(tree, &samples[i * stride]);
+      for (unsigned int k = 0; k < NumberOfClasses; ++k)
+      {
+        votes[k] += leaf[k];
+      }
+    }
+    for (unsigned int k = 0; k < NumberOfClasses; ++k)
+    {
+      if (votes[k] != sums[i * NumberOfClasses + k])
+      {
+        std::cerr << "Sample " << i << ", class " << k << ": expected " << votes[k] << " votes, got " << sums[i * NumberOfClasses + k] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Vote helpers
+  const double votes[] = {3., 7., 7., 1.};
+  otbControlConditionTestMacro(ForestType::ArgMax(votes, 4) != 1, "ArgMax must return the first maximum");
+  otbControlConditionTestMacro(ForestType::Margin(votes, 4) != 0., "Wrong margin on ties");
+  const double votes2[] = {1., 6., 2.};
+  otbControlConditionTestMacro(ForestType::Margin(votes2, 3) != 4., "Wrong margin");
+
+  // Invalid trees are rejected
+  std::vector<TreeNodeType> cycle(1);
+  cycle[0].Left  = 0;
+  cycle[0].Right = 0;
+  bool thrown    = false;
+  try
+  {
+    forest.AddTree(cycle);
+  }
+  catch (std::invalid_argument&)
+  {
+    thrown = true;
+  }
+  otbControlConditionTestMacro(!thrown, "A cyclic tree must be rejected");
+
+  return EXIT_SUCCESS;
+}
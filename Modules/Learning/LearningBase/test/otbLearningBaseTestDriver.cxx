@@ -25,6 +25,7 @@ void RegisterTests()
   REGISTER_TEST(otbDecisionTreeBuild);
   REGISTER_TEST(otbKMeansImageClassificationFilter);
   REGISTER_TEST(otbDecisionTreeWithRealValues);
+  REGISTER_TEST(otbFlatRandomForest);
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbSharkNormalizeLabels);
 #endif
@@ -71,6 +71,19 @@ public:
 
   virtual bool Compute(double deltaEnergy) = 0;
 
+  /** Methods to cancel random effects. Optimizers drawing random values
+   * reimplement them. */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+  virtual void InitializeSeed()
+  {
+  }
+
+  /** Clone the optimizer. The clone has its own state, so that clones
+   * can be used concurrently (see MarkovRandomFieldFilter::SetParallelSweep()). */
+  itkCloneMacro(Self);
+
 protected:
   MRFOptimizer() : m_NumberOfParameters(1), m_Parameters(1)
   {
@@ -78,6 +91,20 @@ protected:
   ~MRFOptimizer() override
   {
   }
+
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+
+    Self* rval = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    rval->m_NumberOfParameters = m_NumberOfParameters;
+    rval->m_Parameters         = m_Parameters;
+    return loPtr;
+  }
   unsigned int   m_NumberOfParameters;
   ParametersType m_Parameters;
 };
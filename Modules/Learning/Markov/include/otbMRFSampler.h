@@ -81,6 +81,20 @@ public:
 
   virtual int Compute(const InputImageNeighborhoodIterator& itData, const LabelledImageNeighborhoodIterator& itRegul) = 0;
 
+  /** Methods to cancel random effects. Samplers drawing random values
+   * reimplement them. */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+  virtual void InitializeSeed()
+  {
+  }
+
+  /** Clone the sampler. The clone shares the energies but has its own
+   * state, so that clones can be used concurrently (see
+   * MarkovRandomFieldFilter::SetParallelSweep()). */
+  itkCloneMacro(Self);
+
 protected:
   unsigned int m_NumberOfClasses;
   double       m_EnergyBefore;
@@ -104,6 +118,22 @@ protected:
   ~MRFSampler() override
   {
   }
+
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+
+    Self* rval = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    rval->SetNumberOfClasses(m_NumberOfClasses);
+    rval->m_Lambda               = m_Lambda;
+    rval->m_EnergyRegularization = m_EnergyRegularization;
+    rval->m_EnergyFidelity       = m_EnergyFidelity;
+    return loPtr;
+  }
 };
 }
 
@@ -140,11 +140,11 @@ public:
   }
 
   /** Methods to cancel random effects.*/
-  void InitializeSeed(int seed)
+  void InitializeSeed(int seed) override
   {
     m_Generator->SetSeed(seed);
   }
-  void InitializeSeed()
+  void InitializeSeed() override
   {
     m_Generator->SetSeed();
   }
@@ -164,6 +164,20 @@ protected:
       free(m_RepartitionFunction);
   }
 
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+
+    Self* rval = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    // The shared generator instance can not be drawn from concurrently
+    rval->m_Generator = RandomGeneratorType::New();
+    return loPtr;
+  }
+
 private:
   double*                      m_RepartitionFunction;
   double*                      m_Energy;
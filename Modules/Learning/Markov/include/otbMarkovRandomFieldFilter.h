@@ -69,6 +69,21 @@ namespace otb
  *   markovFilter->SetSampler(sampler);
  * \endcode
  *
+ * By default, sites are visited one by one in raster order and the whole
+ * image is processed in memory. Two options lift these limitations:
+ *
+ * - ParallelSweep: each iteration is split into phases where sites sharing
+ * the same index modulo (radius + 1) are updated concurrently. Such sites do
+ * not belong to each other's neighborhood, so the result does not depend on
+ * the number of threads for deterministic optimizers (ICM with MAP sampler).
+ * Each work unit uses its own clone of the sampler and of the optimizer.
+ * - Streaming: each requested region is processed on its own, padded by a
+ * halo (see SetHaloRadius()) which is optimized and then discarded. The
+ * number of iterations run on each tile is set by
+ * SetMaximumNumberOfIterations(), and the error tolerance is evaluated on
+ * each tile separately. Without training image, the random initial labels
+ * only depend on the pixel index so that overlapping halos agree.
+ *
  *
  * \ingroup Markov
  *
@@ -234,6 +249,30 @@ public:
   itkSetMacro(Lambda, double);
   itkGetMacro(Lambda, double);
 
+  /** Enable/Disable the parallel (multi-color checkerboard) sweep. It is
+   * disabled by default. */
+  itkSetMacro(ParallelSweep, bool);
+  itkGetMacro(ParallelSweep, bool);
+  itkBooleanMacro(ParallelSweep);
+
+  /** Enable/Disable the tiled streaming mode. It is disabled by default,
+   * in which case the whole image is requested. */
+  itkSetMacro(Streaming, bool);
+  itkGetMacro(Streaming, bool);
+  itkBooleanMacro(Streaming);
+
+  /** Set/Get the radius of the halo padding each tile in streaming mode.
+   * Labels at more than this distance of a tile border are not influenced by
+   * the truncation of the field. If 0 (default), the halo is a few
+   * neighborhood radii wide, which keeps the padding small compared to the
+   * tiles: labels close to the tile borders may then differ from an
+   * unstreamed run. To make ICM results independent of the tiling, set it
+   * to the dependency cone of the parallel sweep, that is the largest
+   * radius times the number of phases (product of radius + 1 along each
+   * axis) times MaximumNumberOfIterations. */
+  itkSetMacro(HaloRadius, unsigned int);
+  itkGetMacro(HaloRadius, unsigned int);
+
   /** Set the neighborhood radius */
   void SetNeighborhoodRadius(const NeighborhoodRadiusType&);
 
@@ -288,10 +327,12 @@ public:
   void InitializeSeed(int seed)
   {
     m_Generator->SetSeed(seed);
+    m_InitializationSeedDrawn = false;
   }
   void InitializeSeed()
   {
     m_Generator->SetSeed();
+    m_InitializationSeedDrawn = false;
   }
 
 protected:
@@ -318,6 +359,13 @@ protected:
   void EnlargeOutputRequestedRegion(itk::DataObject*) override;
   void GenerateOutputInformation() override;
 
+  /** Region actually optimized for a given output requested region: the
+   * requested region itself, padded by the halo in streaming mode. */
+  LabelledImageRegionType GetWorkRegion(const LabelledImageRegionType& outputRegion) const;
+
+  /** Halo radius in use, see SetHaloRadius() */
+  unsigned int GetEffectiveHaloRadius() const;
+
   MarkovRandomFieldFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
@@ -359,8 +407,25 @@ protected:
   OptimizerPointer            m_Optimizer;
   SamplerPointer              m_Sampler;
 
+  bool         m_ParallelSweep;
+  bool         m_Streaming;
+  unsigned int m_HaloRadius;
+
+  /** Seed of the index-based random initialization in streaming mode. It
+   * is drawn by the first GenerateData() call, and kept for the next
+   * tiles until the generator is seeded again. */
+  unsigned int m_InitializationSeed;
+  bool         m_InitializationSeedDrawn;
+
+  /** Samplers and optimizers used by each work unit in parallel sweep */
+  std::vector<SamplerPointer>   m_WorkUnitSamplers;
+  std::vector<OptimizerPointer> m_WorkUnitOptimizers;
+
   virtual void MinimizeOnce();
 
+  /** Parallel version of MinimizeOnce(), see SetParallelSweep() */
+  virtual void MinimizeOnceParallel();
+
 private:
 }; // class MarkovRandomFieldFilter
 
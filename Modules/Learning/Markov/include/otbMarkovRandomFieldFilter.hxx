@@ -22,6 +22,9 @@
 #ifndef otbMarkovRandomFieldFilter_hxx
 #define otbMarkovRandomFieldFilter_hxx
 #include "otbMarkovRandomFieldFilter.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
 
 namespace otb
 {
@@ -39,7 +42,12 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     m_NumberOfIterations(0),
     m_Lambda(1.0),
     m_ExternalClassificationSet(false),
-    m_StopCondition(MaximumNumberOfIterations)
+    m_StopCondition(MaximumNumberOfIterations),
+    m_ParallelSweep(false),
+    m_Streaming(false),
+    m_HaloRadius(0),
+    m_InitializationSeed(0),
+    m_InitializationSeedDrawn(false)
 {
   m_Generator = RandomGeneratorType::GetInstance();
   m_Generator->SetSeed();
@@ -101,6 +109,12 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::PrintSelf(std::ostr
   os << indent << " Number of iterations: " << m_NumberOfIterations << std::endl;
 
   os << indent << " Lambda: " << m_Lambda << std::endl;
+
+  os << indent << " Parallel sweep: " << m_ParallelSweep << std::endl;
+
+  os << indent << " Streaming: " << m_Streaming << std::endl;
+
+  os << indent << " Halo radius: " << m_HaloRadius << std::endl;
 } // end PrintSelf
 
 /**
@@ -110,10 +124,19 @@ template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateInputRequestedRegion()
 {
   // this filter requires the all of the input images
-  // to be at the size of the output requested region
+  // to be at the size of the output requested region, padded by the
+  // halo in streaming mode
   InputImagePointer  inputPtr  = const_cast<InputImageType*>(this->GetInput());
   OutputImagePointer outputPtr = this->GetOutput();
-  inputPtr->SetRequestedRegion(outputPtr->GetRequestedRegion());
+
+  const LabelledImageRegionType workRegion = this->GetWorkRegion(outputPtr->GetRequestedRegion());
+  inputPtr->SetRequestedRegion(workRegion);
+
+  if (m_ExternalClassificationSet)
+  {
+    TrainingImageType* trainingPtr = const_cast<TrainingImageType*>(this->GetTrainingInput());
+    trainingPtr->SetRequestedRegion(workRegion);
+  }
 }
 
 /**
@@ -122,6 +145,12 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateInputReques
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::EnlargeOutputRequestedRegion(itk::DataObject* output)
 {
+  // In streaming mode, each requested region is processed on its own
+  if (m_Streaming)
+  {
+    return;
+  }
+
   // this filter requires the all of the output image to be in
   // the buffer
   TClassifiedImage* imgData;
@@ -140,12 +169,56 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateOutputInfor
   output->SetLargestPossibleRegion(input->GetLargestPossibleRegion());
 }
 
+template <class TInputImage, class TClassifiedImage>
+typename MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::LabelledImageRegionType
+MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetWorkRegion(const LabelledImageRegionType& outputRegion) const
+{
+  LabelledImageRegionType workRegion = outputRegion;
+
+  if (m_Streaming)
+  {
+    workRegion.PadByRadius(this->GetEffectiveHaloRadius());
+    workRegion.Crop(this->GetOutput()->GetLargestPossibleRegion());
+  }
+  return workRegion;
+}
+
+template <class TInputImage, class TClassifiedImage>
+unsigned int MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetEffectiveHaloRadius() const
+{
+  if (m_HaloRadius > 0)
+  {
+    return m_HaloRadius;
+  }
+
+  // The whole dependency cone (one neighborhood radius per phase and per
+  // iteration) is usually wider than the tile itself: only a few radii
+  // are padded by default
+  const unsigned int defaultHaloInRadii = 4;
+
+  unsigned int maxRadius = 0;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    maxRadius = std::max(maxRadius, static_cast<unsigned int>(m_LabelledImageNeighborhoodRadius[i]));
+  }
+  return maxRadius * defaultHaloInRadii;
+}
+
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateData()
 {
 
   //   InputImageConstPointer inputImage = this->GetInput();
 
+  // Random initial labels of overlapping tiles have to agree, they are
+  // derived from the pixel index and this seed, drawn once for all the
+  // tiles
+  if (m_Streaming && !m_InitializationSeedDrawn)
+  {
+    m_InitializationSeed      = m_Generator->GetIntegerVariate();
+    m_InitializationSeedDrawn = true;
+  }
+
   // Allocate memory for the labelled images
   this->Allocate();
 
@@ -214,18 +287,19 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Allocate()
   // Set the output labelled and allocate the memory
   LabelledImagePointer outputPtr = this->GetOutput();
 
-  // Allocate the output buffer memory
-  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  // Allocate the output buffer memory, including the halo in streaming
+  // mode
+  outputPtr->SetBufferedRegion(this->GetWorkRegion(outputPtr->GetRequestedRegion()));
   outputPtr->Allocate();
 
   // Copy input data in the output buffer memory or
   // initialize to random values if not set
-  LabelledImageRegionIterator outImageIt(outputPtr, outputPtr->GetRequestedRegion());
+  LabelledImageRegionIterator outImageIt(outputPtr, outputPtr->GetBufferedRegion());
 
   if (m_ExternalClassificationSet)
   {
     typename TrainingImageType::ConstPointer trainingImage = this->GetTrainingInput();
-    LabelledImageRegionConstIterator         trainingImageIt(trainingImage, outputPtr->GetRequestedRegion());
+    LabelledImageRegionConstIterator         trainingImageIt(trainingImage, outputPtr->GetBufferedRegion());
 
     while (!outImageIt.IsAtEnd())
     {
@@ -236,6 +310,22 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Allocate()
       ++outImageIt;
     } // end while
   }
+  else if (m_Streaming) // set to random value depending on the index only
+  {
+    while (!outImageIt.IsAtEnd())
+    {
+      const LabelledImageIndexType index = outImageIt.GetIndex();
+
+      std::uint64_t hash = m_InitializationSeed;
+      for (unsigned int i = 0; i < ClassifiedImageDimension; ++i)
+      {
+        hash = (hash ^ static_cast<std::uint64_t>(index[i])) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+      }
+      outImageIt.Set(static_cast<LabelledImagePixelType>(hash % m_NumberOfClasses));
+      ++outImageIt;
+    } // end while
+  }
   else // set to random value
   {
     //       srand((unsigned)time(0));
@@ -258,7 +348,7 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
 
   m_ImageDeltaEnergy = 0.0;
 
-  InputImageSizeType inputImageSize = this->GetInput()->GetBufferedRegion().GetSize();
+  InputImageSizeType inputImageSize = this->GetOutput()->GetBufferedRegion().GetSize();
 
   //---------------------------------------------------------------------
   // Get the number of valid pixels in the output MRF image
@@ -300,6 +390,30 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
   m_Sampler->SetEnergyRegularization(m_EnergyRegularization);
   m_Sampler->SetEnergyFidelity(m_EnergyFidelity);
   m_Sampler->SetNumberOfClasses(m_NumberOfClasses);
+
+  m_WorkUnitSamplers.clear();
+  m_WorkUnitOptimizers.clear();
+
+  if (m_ParallelSweep)
+  {
+    // Seeds are drawn before cloning, since the constructors of random
+    // samplers and optimizers reseed the shared generator
+    const unsigned int nbWorkUnits = std::max(1u, this->GetNumberOfWorkUnits());
+    std::vector<int>   seeds(2 * nbWorkUnits + 1);
+    for (auto& seed : seeds)
+    {
+      seed = static_cast<int>(m_Generator->GetIntegerVariate() >> 1);
+    }
+
+    for (unsigned int i = 0; i < nbWorkUnits; ++i)
+    {
+      m_WorkUnitSamplers.push_back(m_Sampler->Clone());
+      m_WorkUnitOptimizers.push_back(m_Optimizer->Clone());
+      m_WorkUnitSamplers.back()->InitializeSeed(seeds[2 * i]);
+      m_WorkUnitOptimizers.back()->InitializeSeed(seeds[2 * i + 1]);
+    }
+    m_Generator->SetSeed(seeds.back());
+  }
 }
 
 /**
@@ -319,7 +433,14 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
   {
     otbMsgDevMacro(<< "Iteration No." << m_NumberOfIterations);
 
-    this->MinimizeOnce();
+    if (m_ParallelSweep)
+    {
+      this->MinimizeOnceParallel();
+    }
+    else
+    {
+      this->MinimizeOnce();
+    }
 
     otbMsgDevMacro(<< "m_ErrorCounter/m_TotalNumberOfPixelsInInputImage: " << m_ErrorCounter / ((double)(m_TotalNumberOfPixelsInInputImage)));
     otbMsgDevMacro(<< "m_ImageDeltaEnergy: " << m_ImageDeltaEnergy);
@@ -350,8 +471,8 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
 {
-  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetLargestPossibleRegion());
-  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetInput()->GetLargestPossibleRegion());
+  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetBufferedRegion());
+  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetOutput()->GetBufferedRegion());
   m_ErrorCounter = 0;
 
   for (labelledIterator.GoToBegin(), dataIterator.GoToBegin(); !labelledIterator.IsAtEnd(); ++labelledIterator, ++dataIterator)
@@ -371,6 +492,113 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
   }
 }
 
+/**
+*Apply the MRF image filter on the whole image once, with a parallel
+*multi-color checkerboard sweep
+*/
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnceParallel()
+{
+  const LabelledImageRegionType workRegion = this->GetOutput()->GetBufferedRegion();
+  const unsigned int            nbChunks   = m_WorkUnitSamplers.size();
+
+  // Sites sharing the same index modulo (radius + 1) along every axis are
+  // out of each other's neighborhood: they form one phase and can be
+  // updated concurrently. Phases are anchored on the largest possible
+  // region so that overlapping tiles agree in streaming mode.
+  const LabelledImageIndexType origin = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+  SizeType                     period;
+  unsigned int nbPhases = 1;
+  for (unsigned int i = 0; i < ClassifiedImageDimension; ++i)
+  {
+    period[i] = m_LabelledImageNeighborhoodRadius[i] + 1;
+    nbPhases *= period[i];
+  }
+
+  // Work units process bands of the region along the last axis
+  const unsigned int   lastAxis  = ClassifiedImageDimension - 1;
+  const IndexValueType bandStart = workRegion.GetIndex()[lastAxis];
+  const IndexValueType bandSize  = workRegion.GetSize()[lastAxis];
+
+  std::vector<int>    errorCounters(nbChunks, 0);
+  std::vector<double> deltaEnergies(nbChunks, 0.0);
+
+  unsigned int phase = 0;
+
+  auto minimizeChunk = [&](itk::SizeValueType chunk) {
+    const IndexValueType first = bandStart + (bandSize * static_cast<IndexValueType>(chunk)) / nbChunks;
+    const IndexValueType last  = bandStart + (bandSize * static_cast<IndexValueType>(chunk + 1)) / nbChunks;
+    if (last <= first)
+    {
+      return;
+    }
+    LabelledImageRegionType chunkRegion = workRegion;
+    chunkRegion.SetIndex(lastAxis, first);
+    chunkRegion.SetSize(lastAxis, last - first);
+
+    SamplerType*   sampler   = m_WorkUnitSamplers[chunk];
+    OptimizerType* optimizer = m_WorkUnitOptimizers[chunk];
+
+    // First site of the phase in the chunk along each axis
+    LabelledImageIndexType first;
+    unsigned int           axisPhases = phase;
+    for (unsigned int i = 0; i < ClassifiedImageDimension; ++i)
+    {
+      const IndexValueType residue = axisPhases % period[i];
+      const IndexValueType offset  = (chunkRegion.GetIndex()[i] - origin[i]) % static_cast<IndexValueType>(period[i]);
+      first[i] = chunkRegion.GetIndex()[i] + (residue - offset + static_cast<IndexValueType>(period[i])) % static_cast<IndexValueType>(period[i]);
+      axisPhases /= period[i];
+      if (first[i] >= chunkRegion.GetIndex()[i] + static_cast<IndexValueType>(chunkRegion.GetSize()[i]))
+      {
+        return;
+      }
+    }
+
+    LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), chunkRegion);
+    InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), chunkRegion);
+
+    // Visit the sites of the phase only, in raster order, by strides of
+    // one period along each axis
+    LabelledImageIndexType index = first;
+    while (true)
+    {
+      labelledIterator.SetLocation(index);
+      dataIterator.SetLocation(index);
+
+      sampler->Compute(dataIterator, labelledIterator);
+      if (optimizer->Compute(sampler->GetDeltaEnergy()))
+      {
+        labelledIterator.SetCenterPixel(sampler->GetValue());
+        ++errorCounters[chunk];
+        deltaEnergies[chunk] += sampler->GetDeltaEnergy();
+      }
+
+      unsigned int i = 0;
+      for (; i < ClassifiedImageDimension; ++i)
+      {
+        index[i] += static_cast<IndexValueType>(period[i]);
+        if (index[i] < chunkRegion.GetIndex()[i] + static_cast<IndexValueType>(chunkRegion.GetSize()[i]))
+        {
+          break;
+        }
+        index[i] = first[i];
+      }
+      if (i == ClassifiedImageDimension)
+      {
+        break;
+      }
+    }
+  };
+
+  for (phase = 0; phase < nbPhases; ++phase)
+  {
+    this->GetMultiThreader()->ParallelizeArray(0, nbChunks, minimizeChunk, nullptr);
+  }
+
+  m_ErrorCounter = std::accumulate(errorCounters.begin(), errorCounters.end(), 0);
+  m_ImageDeltaEnergy += std::accumulate(deltaEnergies.begin(), deltaEnergies.end(), 0.0);
+}
+
 } // namespace otb
 
 #endif
@@ -30,6 +30,11 @@
 #include "otbMRFEnergyGaussianClassification.h"
 #include "otbMRFOptimizerMetropolis.h"
 #include "otbMRFSamplerRandom.h"
+#include "otbMRFSamplerMAP.h"
+#include "otbMRFOptimizerICM.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
 
 int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -109,3 +114,120 @@ int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbMarkovRandomFieldFilterParallelStreaming(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<double, 2>        InputImageType;
+  typedef otb::Image<unsigned char, 2> LabelledImageType;
+
+  typedef otb::MarkovRandomFieldFilter<InputImageType, LabelledImageType>          MarkovRandomFieldFilterType;
+  typedef otb::MRFSamplerMAP<InputImageType, LabelledImageType>                    SamplerType;
+  typedef otb::MRFOptimizerICM                                                     OptimizerType;
+  typedef otb::MRFEnergyPotts<LabelledImageType, LabelledImageType>               EnergyRegularizationType;
+  typedef otb::MRFEnergyGaussianClassification<InputImageType, LabelledImageType> EnergyFidelityType;
+  typedef itk::StreamingImageFilter<LabelledImageType, LabelledImageType>         StreamingFilterType;
+
+  // Noisy synthetic image with 3 classes
+  InputImageType::Pointer    input = InputImageType::New();
+  InputImageType::RegionType region;
+  region.SetSize(0, 97);
+  region.SetSize(1, 113);
+  input->SetRegions(region);
+  input->Allocate();
+  for (itk::ImageRegionIterator<InputImageType> it(input, region); !it.IsAtEnd(); ++it)
+  {
+    const InputImageType::IndexType index = it.GetIndex();
+    const double                    mean  = 50.0 * ((index[0] / 20 + index[1] / 30) % 3);
+    it.Set(mean + 40.0 * std::sin(index[0] * 12.9898 + index[1] * 78.233));
+  }
+
+  EnergyFidelityType::Pointer energyFidelity = EnergyFidelityType::New();
+  energyFidelity->SetNumberOfParameters(6);
+  EnergyFidelityType::ParametersType parameters(6);
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    parameters[2 * c]     = 50.0 * c;
+    parameters[2 * c + 1] = 20.0;
+  }
+  energyFidelity->SetParameters(parameters);
+
+  auto makeFilter = [&](bool streaming, unsigned int nbWorkUnits, unsigned int haloRadius) {
+    MarkovRandomFieldFilterType::Pointer markovFilter = MarkovRandomFieldFilterType::New();
+    markovFilter->SetNumberOfClasses(3);
+    markovFilter->SetMaximumNumberOfIterations(5);
+    markovFilter->SetErrorTolerance(0.0);
+    markovFilter->SetLambda(2.0);
+    markovFilter->SetNeighborhoodRadius(1);
+    markovFilter->SetEnergyRegularization(EnergyRegularizationType::New());
+    markovFilter->SetEnergyFidelity(energyFidelity);
+    markovFilter->SetOptimizer(OptimizerType::New());
+    markovFilter->SetSampler(SamplerType::New());
+    markovFilter->ParallelSweepOn();
+    markovFilter->SetStreaming(streaming);
+    markovFilter->SetHaloRadius(haloRadius);
+    markovFilter->SetNumberOfWorkUnits(nbWorkUnits);
+    markovFilter->InitializeSeed(2);
+    markovFilter->SetInput(input);
+    return markovFilter;
+  };
+
+  auto update = [&](MarkovRandomFieldFilterType* markovFilter, unsigned int nbDivisions) {
+    StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+    streamer->SetNumberOfStreamDivisions(nbDivisions);
+    streamer->SetInput(markovFilter->GetOutput());
+    streamer->Update();
+
+    LabelledImageType::Pointer output = streamer->GetOutput();
+    output->DisconnectPipeline();
+    return output;
+  };
+
+  auto run = [&](bool streaming, unsigned int nbWorkUnits, unsigned int nbDivisions, unsigned int haloRadius = 0) {
+    MarkovRandomFieldFilterType::Pointer markovFilter = makeFilter(streaming, nbWorkUnits, haloRadius);
+    return update(markovFilter, nbDivisions);
+  };
+
+  auto differ = [&](LabelledImageType* image1, LabelledImageType* image2) {
+    itk::ImageRegionConstIterator<LabelledImageType> it1(image1, region);
+    itk::ImageRegionConstIterator<LabelledImageType> it2(image2, region);
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      if (it1.Get() != it2.Get())
+      {
+        std::cerr << "Labels differ at " << it1.GetIndex() << std::endl;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // ICM with MAP sampler does not depend on the number of work units...
+  LabelledImageType::Pointer singleUnit = run(false, 1, 1);
+  LabelledImageType::Pointer multiUnits = run(false, 4, 1);
+  if (differ(singleUnit, multiUnits))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // ... nor on the tiling with a halo covering the dependency cone of the
+  // 5 iterations: radius 1 x 4 phases x 5 iterations
+  LabelledImageType::Pointer wholeImage = run(true, 4, 1, 20);
+  LabelledImageType::Pointer tiles      = run(true, 4, 7, 20);
+  if (differ(wholeImage, tiles))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Running the same tiled pipeline again gives the same labels, with the
+  // default halo
+  MarkovRandomFieldFilterType::Pointer markovFilter = makeFilter(true, 4, 0);
+  LabelledImageType::Pointer           firstRun     = update(markovFilter, 7);
+  markovFilter->Modified();
+  LabelledImageType::Pointer secondRun = update(markovFilter, 7);
+  if (differ(firstRun, secondRun))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -28,10 +28,23 @@
 #include "otbMachineLearningModel.h"
 #include "itkVariableSizeMatrix.h"
 #include "otbCvRTreesWrapper.h"
+#include "otbFlatRandomForest.h"
 
 namespace otb
 {
 
+/** \class RandomForestsMachineLearningModel
+ * \brief OpenCV random forests
+ *
+ * Once trained or loaded, the OpenCV trees are copied into a
+ * FlatRandomForest which is used for prediction: samples are predicted
+ * by blocks in DoPredictBatch(), and the confidence, margin and class
+ * probabilities are derived from the vote counts. Class probabilities
+ * are only available (HasProbaIndex()) for a classifier whose trees
+ * could be flattened.
+ *
+ * \ingroup OTBSupervised
+ */
 template <class TInputValue, class TTargetValue>
 class ITK_EXPORT RandomForestsMachineLearningModel : public MachineLearningModel<TInputValue, TTargetValue>
 {
@@ -42,14 +55,17 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ConfidenceSampleType     ConfidenceSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   // Other
   typedef itk::VariableSizeMatrix<float> VariableImportanceMatrixType;
 
@@ -57,6 +73,9 @@ public:
   // opencv typedef
   typedef CvRTreesWrapper RFType;
 
+  /** Flattened forest used for prediction (OpenCV compares float values) */
+  typedef FlatRandomForest<float> FlatForestType;
+
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(RandomForestsMachineLearningModel, MachineLearningModel);
@@ -138,6 +157,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict a range of samples with the flattened forest */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -151,8 +174,20 @@ private:
   RandomForestsMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Copy the OpenCV trees into m_FlatForest, which is left empty (and
+   * OpenCV used for prediction) if the forest cannot be flattened */
+  void BuildFlatForest();
+
+  /** Decode the leaf sums of one sample accumulated by m_FlatForest */
+  TargetSampleType DecodeFlatForestSums(double const* sums, ConfidenceValueType* quality, ProbaSampleType* proba) const;
+
   cv::Ptr<CvRTreesWrapper> m_RFModel;
 
+  FlatForestType m_FlatForest;
+
+  /** Class label of each class index, empty in regression */
+  std::vector<double> m_ClassLabels;
+
   /** The depth of the tree. A low value will likely underfit and conversely a
    * high value will likely overfit. The optimal value can be obtained using cross
    * validation or other suitable methods. */
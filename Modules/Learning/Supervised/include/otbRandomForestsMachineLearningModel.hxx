@@ -25,6 +25,8 @@
 #include "itkMacro.h"
 #include "otbRandomForestsMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -105,6 +107,7 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_RFModel->setActiveVarCount(m_MaxNumberOfVariables);
   m_RFModel->setTermCriteria(cv::TermCriteria(m_TerminationCriteria, m_MaxNumberOfTrees, m_ForestAccuracy));
   m_RFModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+  BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -112,7 +115,22 @@ typename RandomForestsMachineLearningModel<TInputValue, TOutputValue>::TargetSam
 RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& value, ConfidenceValueType* quality,
                                                                         ProbaSampleType* proba) const
 {
-  // std::cout << "Enter predict" << std::endl;
+  if (!m_FlatForest.IsEmpty())
+  {
+    if (value.Size() < m_FlatForest.GetNumberOfFeatures())
+    {
+      itkExceptionMacro(<< "Sample has " << value.Size() << " features, the model needs " << m_FlatForest.GetNumberOfFeatures());
+    }
+    std::vector<float> sample(value.Size());
+    for (unsigned int i = 0; i < value.Size(); ++i)
+    {
+      sample[i] = static_cast<float>(value[i]);
+    }
+    std::vector<double> sums(m_FlatForest.GetNumberOfOutputs());
+    m_FlatForest.Accumulate(sample.data(), 1, sample.size(), sums.data());
+    return DecodeFlatForestSums(sums.data(), quality, proba);
+  }
+
   TargetSampleType target;
   // convert listsample to Mat
   cv::Mat sample;
@@ -131,12 +149,201 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
       (*quality) = m_RFModel->predict_confidence(sample);
   }
 
-  if (proba != nullptr && !this->m_ProbaIndex)
+  if (proba != nullptr)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
   return target[0];
 }
 
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                  const unsigned int& size, TargetListSampleType* targets,
+                                                                                  ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (m_FlatForest.IsEmpty())
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  const std::size_t nbFeatures = input->GetMeasurementVectorSize();
+  if (nbFeatures < m_FlatForest.GetNumberOfFeatures())
+  {
+    itkExceptionMacro(<< "Samples have " << nbFeatures << " features, the model needs " << m_FlatForest.GetNumberOfFeatures());
+  }
+
+  // Samples are copied by chunks in a contiguous float buffer
+  const std::size_t   chunkSize = 16 * FlatForestType::BlockSize;
+  const std::size_t   nbOutputs = m_FlatForest.GetNumberOfOutputs();
+  std::vector<float>  samples(std::min<std::size_t>(chunkSize, size) * nbFeatures);
+  std::vector<double> sums(std::min<std::size_t>(chunkSize, size) * nbOutputs);
+
+  for (unsigned int first = startIndex; first < startIndex + size; first += chunkSize)
+  {
+    const unsigned int count = std::min<unsigned int>(chunkSize, startIndex + size - first);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      const InputSampleType& value = input->GetMeasurementVector(first + i);
+      std::copy(&value[0], &value[0] + nbFeatures, samples.begin() + i * nbFeatures);
+    }
+
+    m_FlatForest.Accumulate(samples.data(), count, nbFeatures, sums.data());
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      ConfidenceValueType confidence = 0;
+      ProbaSampleType     prob;
+      targets->SetMeasurementVector(first + i, DecodeFlatForestSums(&sums[i * nbOutputs], quality ? &confidence : nullptr, proba ? &prob : nullptr));
+      if (quality != nullptr)
+      {
+        ConfidenceSampleType confidenceSample;
+        confidenceSample[0] = confidence;
+        quality->SetMeasurementVector(first + i, confidenceSample);
+      }
+      if (proba != nullptr)
+      {
+        proba->SetMeasurementVector(first + i, prob);
+      }
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+typename RandomForestsMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
+RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DecodeFlatForestSums(double const* sums, ConfidenceValueType* quality,
+                                                                                   ProbaSampleType* proba) const
+{
+  // Vote ratios are computed in float, as in CvRTreesWrapper
+  const float      nbTrees = static_cast<float>(m_FlatForest.GetTotalWeight());
+  TargetSampleType target;
+
+  // Confidence and probabilities are not defined in regression
+  if (m_ClassLabels.empty())
+  {
+    if (proba != nullptr)
+      itkExceptionMacro("Probability per class not available in regression mode !");
+    target[0] = static_cast<TOutputValue>(static_cast<float>(sums[0] / m_FlatForest.GetTotalWeight()));
+    return target;
+  }
+
+  const std::size_t nbClasses = m_ClassLabels.size();
+  target[0]                   = static_cast<TOutputValue>(m_ClassLabels[FlatForestType::ArgMax(sums, nbClasses)]);
+
+  if (quality != nullptr)
+  {
+    // Vote counts are integers, stored exactly in the sums
+    const double votes = m_ComputeMargin ? FlatForestType::Margin(sums, nbClasses) : *std::max_element(sums, sums + nbClasses);
+    (*quality)         = static_cast<float>(votes) / nbTrees;
+  }
+
+  if (proba != nullptr)
+  {
+    // Same scale as the Shark random forests
+    if (proba->Size() == 0)
+    {
+      proba->SetSize(nbClasses);
+    }
+    for (unsigned int k = 0; k < proba->Size(); ++k)
+    {
+      (*proba)[k] = k < nbClasses ? 1000. * sums[k] / m_FlatForest.GetTotalWeight() : 0.;
+    }
+  }
+
+  return target;
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::BuildFlatForest()
+{
+  m_FlatForest.Clear();
+  m_ClassLabels.clear();
+  // Class probabilities are only computed from the flat forest of a
+  // classifier
+  this->m_ProbaIndex = false;
+
+  if (!m_RFModel->isTrained())
+  {
+    return;
+  }
+
+  const std::vector<cv::ml::DTrees::Node>&  nodes  = m_RFModel->getNodes();
+  const std::vector<cv::ml::DTrees::Split>& splits = m_RFModel->getSplits();
+  const std::vector<int>&                   roots  = m_RFModel->getRoots();
+
+  // The class labels are only known through the leaves
+  if (m_RFModel->isClassifier())
+  {
+    for (const auto& node : nodes)
+    {
+      if (node.split < 0 && node.classIdx >= 0)
+      {
+        if (static_cast<std::size_t>(node.classIdx) >= m_ClassLabels.size())
+        {
+          m_ClassLabels.resize(node.classIdx + 1, 0.);
+        }
+        m_ClassLabels[node.classIdx] = node.value;
+      }
+    }
+    if (m_ClassLabels.empty())
+    {
+      return;
+    }
+  }
+
+  // All the trees share the OpenCV node vector
+  std::vector<typename FlatForestType::TreeNode> tree(nodes.size());
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+  {
+    const cv::ml::DTrees::Node&        node = nodes[i];
+    typename FlatForestType::TreeNode& dst  = tree[i];
+    if (node.split < 0)
+    {
+      if (m_ClassLabels.empty())
+      {
+        dst.Values.assign(1, node.value);
+      }
+      else
+      {
+        dst.Values.assign(m_ClassLabels.size(), 0.);
+        dst.Values[node.classIdx] = 1.;
+      }
+      continue;
+    }
+    // Input variables are always numerical (see Train()), and samples
+    // have no missing values: surrogate splits are not needed
+    const cv::ml::DTrees::Split& split = splits[node.split];
+    dst.Feature   = split.varIdx;
+    dst.Threshold = split.c;
+    dst.Left      = split.inversed ? node.right : node.left;
+    dst.Right     = split.inversed ? node.left : node.right;
+  }
+
+  m_FlatForest.Clear(m_ClassLabels.empty() ? 1 : m_ClassLabels.size());
+  try
+  {
+    for (int root : roots)
+    {
+      m_FlatForest.AddTree(tree, root);
+    }
+  }
+  catch (std::invalid_argument&)
+  {
+    m_FlatForest.Clear();
+    m_ClassLabels.clear();
+  }
+  this->m_ProbaIndex = !m_FlatForest.IsEmpty() && !m_ClassLabels.empty();
+}
+
 template <class TInputValue, class TOutputValue>
 void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -152,6 +359,7 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Load(const st
 {
   cv::FileStorage fs(filename, cv::FileStorage::READ);
   m_RFModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -565,6 +565,12 @@ int otbRandomForestsRegressionTests(int itkNotUsed(argc), char* itkNotUsed(argv)
   {
     status = EXIT_FAILURE;
   }
+  // Class probabilities are not defined in regression
+  if (regression->HasProbaIndex())
+  {
+    std::cout << "Failed : no class probabilities expected in regression !" << std::endl;
+    status = EXIT_FAILURE;
+  }
   std::cout << "Testing regression on a bilinear function" << std::endl;
   BilinearFunctionSampleGenerator<PrecisionType> bfsg(2.0, -1.0, 1.0);
   // increase number of training samples for bilinear function
@@ -217,7 +217,35 @@ int otbKNearestNeighborsMachineLearningModel(int argc, char* argv[])
 using RandomForestType = otb::RandomForestsMachineLearningModel<InputValueType, TargetValueType>;
 int otbRandomForestsMachineLearningModel(int argc, char* argv[])
 {
-  return otbGenericMachineLearningModel<RandomForestType>(argc, argv);
+  if (otbGenericMachineLearningModel<RandomForestType>(argc, argv) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A loaded classifier provides class probabilities, from the votes
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->Load(argv[2]);
+  if (!classifier->HasProbaIndex())
+  {
+    std::cout << "Class probabilities should be available" << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  otb::ReadDataFile(argv[1], samples, labels);
+  RandomForestType::ProbaSampleType proba;
+  classifier->Predict(samples->GetMeasurementVector(0), nullptr, &proba);
+  double sum = 0.;
+  for (unsigned int k = 0; k < proba.Size(); ++k)
+  {
+    sum += proba[k];
+  }
+  if (proba.Size() == 0 || std::abs(sum - 1000.) > 1e-6)
+  {
+    std::cout << "Class probabilities should sum to 1000, got " << sum << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
 }
 
 template <>
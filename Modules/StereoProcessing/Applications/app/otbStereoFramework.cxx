@@ -38,7 +38,7 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkCastImageFilter.h"
-#include "itkInverseDisplacementFieldImageFilter.h"
+#include "otbInverseDisplacementGridImageFilter.h"
 
 #include "itkRescaleIntensityImageFilter.h"
 #include "otbStreamingMinMaxImageFilter.h"
@@ -92,7 +92,7 @@ public:
 
   typedef itk::CastImageFilter<FloatVectorImageType, DisplacementFieldType> DisplacementFieldCastFilterType;
 
-  typedef itk::InverseDisplacementFieldImageFilter<DisplacementFieldType, DisplacementFieldType> InverseDisplacementFieldFilterType;
+  typedef otb::InverseDisplacementGridImageFilter<DisplacementFieldType, DisplacementFieldType> InverseDisplacementFieldFilterType;
 
 
   typedef otb::StreamingWarpImageFilter<FloatImageType, FloatImageType, DisplacementFieldType> ResampleFilterType;
@@ -418,10 +418,8 @@ private:
 
     AddParameter(ParameterType_Int, "stereorect.invgridssrate", "Sub-sampling rate for epipolar grid inversion");
     SetParameterDescription("stereorect.invgridssrate",
-                            "Grid inversion is an "
-                            "heavy process that implies spline regression on control points. To avoid"
-                            " eating to much memory, this parameter allows one to first sub-sample "
-                            "the field to invert.");
+                            "This parameter is deprecated and ignored: the epipolar grid is now "
+                            "inverted cell by cell with Newton iterations, without sub-sampling.");
     SetDefaultParameterInt("stereorect.invgridssrate", 10);
     SetMinimumParameterIntValue("stereorect.invgridssrate", 1);
     MandatoryOff("stereorect.invgridssrate");
@@ -753,10 +751,15 @@ private:
       leftInverseDisplacementFieldFilter->SetOutputOrigin(lorigin);
       leftInverseDisplacementFieldFilter->SetOutputSpacing(lspacing);
       leftInverseDisplacementFieldFilter->SetSize(lsize);
-      // change value
-      leftInverseDisplacementFieldFilter->SetSubsamplingFactor(this->GetParameterInt("stereorect.invgridssrate"));
       AddProcess(leftInverseDisplacementFieldFilter, "Inverting left displacement field ...");
       leftInverseDisplacementFieldFilter->Update();
+      otbAppLogINFO(<< "Left displacement field inverted, maximum residual: " << leftInverseDisplacementFieldFilter->GetMaximumResidual()
+                    << ", mean residual: " << leftInverseDisplacementFieldFilter->GetMeanResidual());
+      if (leftInverseDisplacementFieldFilter->GetNumberOfUnconvergedPoints() > 0)
+      {
+        otbAppLogWARNING(<< leftInverseDisplacementFieldFilter->GetNumberOfUnconvergedPoints()
+                         << " points of the inverse left displacement field did not converge");
+      }
       DisplacementFieldType::Pointer leftInverseDisplacement;
       leftInverseDisplacement = leftInverseDisplacementFieldFilter->GetOutput();
       leftInverseDisplacement->DisconnectPipeline();
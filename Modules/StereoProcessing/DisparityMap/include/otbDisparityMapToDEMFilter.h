@@ -26,6 +26,7 @@
 #include "itkImageRegionSplitter.h"
 #include "otbVectorImage.h"
 #include "otbImage.h"
+#include "otbDEMCellShards.h"
 
 namespace otb
 {
@@ -48,6 +49,11 @@ namespace otb
  *  The outputs are:
  *    - the DEM (GetDEMOutput)
  *
+ *  Each thread triangulates a split of the disparity map and bins the
+ *  elevations by row bands of the output (see DEMCellShards); the bands are
+ *  then fused in parallel, so that the temporary memory does not depend
+ *  on the number of threads.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa StereorectificationDisplacementFieldSource
  *  \sa SubPixelDisparityImageFilter
@@ -193,8 +199,8 @@ private:
   /** Number of splits used for input multithreading */
   unsigned int m_UsedInputSplits;
 
-  /** Temporary DEMs for mutlithreading */
-  std::vector<typename DEMImageType::Pointer> m_TempDEMRegions;
+  /** Triangulated elevations, binned by row bands of the output */
+  DEMCellShards<DEMPixelType> m_CellShards;
 
   /** Left sensor image transform */
   RSTransformType::Pointer m_LeftToGroundTransform;
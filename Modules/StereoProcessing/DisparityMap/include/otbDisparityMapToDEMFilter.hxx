@@ -24,6 +24,7 @@
 #include "otbDisparityMapToDEMFilter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -606,20 +607,8 @@ void DisparityMapToDEMFilter<TDisparityImage, TInputImage, TOutputDEMImage, TEpi
 
   if (m_UsedInputSplits <= static_cast<unsigned int>(this->GetNumberOfWorkUnits()))
   {
-    m_TempDEMRegions.clear();
-
-    for (unsigned int i = 0; i < m_UsedInputSplits; i++)
-    {
-      typename DEMImageType::Pointer tmpImg = TOutputDEMImage::New();
-      tmpImg->SetNumberOfComponentsPerPixel(1);
-      tmpImg->SetRegions(outputDEM->GetRequestedRegion());
-      tmpImg->Allocate();
-
-      typename DEMImageType::PixelType minElevation = static_cast<typename DEMImageType::PixelType>(m_ElevationMin);
-      tmpImg->FillBuffer(minElevation);
-
-      m_TempDEMRegions.push_back(tmpImg);
-    }
+    // Elevations are binned by row bands of the output, fused in AfterThreadedGenerateData()
+    m_CellShards.Initialize(outputDEM->GetRequestedRegion(), m_UsedInputSplits, this->GetNumberOfWorkUnits());
   }
   else
   {
@@ -643,14 +632,12 @@ void DisparityMapToDEMFilter<TDisparityImage, TInputImage, TOutputDEMImage, TEpi
 
   typename TEpipolarGridImage::RegionType gridRegion = leftGrid->GetLargestPossibleRegion();
 
-  TOutputDEMImage*                     tmpDEM                = nullptr;
   typename TOutputDEMImage::RegionType outputRequestedRegion = outputDEM->GetRequestedRegion();
 
   typename TDisparityImage::RegionType disparityRegion;
   if (static_cast<unsigned int>(threadId) < m_UsedInputSplits)
   {
     disparityRegion = m_InputSplitter->GetSplit(threadId, m_UsedInputSplits, horizDisp->GetRequestedRegion());
-    tmpDEM          = m_TempDEMRegions[threadId];
   }
   else
   {
@@ -861,11 +848,11 @@ void DisparityMapToDEMFilter<TDisparityImage, TInputImage, TOutputDEMImage, TEpi
       // Estimate local reference elevation (average, DEM or geoid) => NO NEED, ALREADY HAVE 3D RAYS
       // double localElevation = demHandler->GetHeightAboveEllipsoid(midPoint2D);
 
-      // Add point to its corresponding cell (keep maximum)
+      // Add point to the band of its corresponding cell (only elevations which may be kept)
       DEMPixelType cellHeight = static_cast<DEMPixelType>(midPoint3D[2]);
-      if (cellHeight > tmpDEM->GetPixel(cellIndex) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
+      if (cellHeight > static_cast<DEMPixelType>(m_ElevationMin) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
       {
-        tmpDEM->SetPixel(cellIndex, cellHeight);
+        m_CellShards.Add(threadId, cellIndex, cellHeight);
       }
     }
 
@@ -882,44 +869,30 @@ void DisparityMapToDEMFilter<TDisparityImage, TInputImage, TOutputDEMImage, TEpi
 {
   TOutputDEMImage* outputDEM = this->GetDEMOutput();
 
-  if (m_TempDEMRegions.size() < 1)
-  {
-    outputDEM->FillBuffer(m_ElevationMin);
-    return;
-  }
-
-  itk::ImageRegionIterator<DEMImageType> outputDEMIt(outputDEM, outputDEM->GetRequestedRegion());
-  itk::ImageRegionIterator<DEMImageType> firstDEMIt(m_TempDEMRegions[0], outputDEM->GetRequestedRegion());
-
-  outputDEMIt.GoToBegin();
-  firstDEMIt.GoToBegin();
-
-  // Copy first DEM
-  while (!outputDEMIt.IsAtEnd() && !firstDEMIt.IsAtEnd())
+  const RegionType& region = m_CellShards.GetRegion();
+  if (outputDEM->GetBufferedRegion() != region)
   {
-    outputDEMIt.Set(firstDEMIt.Get());
-    ++outputDEMIt;
-    ++firstDEMIt;
+    itkExceptionMacro(<< "The output buffered region " << outputDEM->GetBufferedRegion() << " differs from the processed region " << region);
   }
 
-  // Check DEMs from other threads and keep the maximum elevation
-  for (unsigned int i = 1; i < m_TempDEMRegions.size(); i++)
-  {
-    itk::ImageRegionIterator<DEMImageType> tmpDEMIt(m_TempDEMRegions[i], outputDEM->GetRequestedRegion());
+  DEMPixelType* dem = outputDEM->GetBufferPointer();
 
-    outputDEMIt.GoToBegin();
-    tmpDEMIt.GoToBegin();
+  // Each band of rows is fused by a single thread, directly in the output: keep the maximum elevation
+  auto fuseShard = [this, dem, &region](itk::SizeValueType shard) {
+    const RegionType         shardRegion = m_CellShards.GetShardRegion(shard);
+    const itk::SizeValueType begin       = (shardRegion.GetIndex(1) - region.GetIndex(1)) * region.GetSize(0);
+    std::fill(dem + begin, dem + begin + shardRegion.GetNumberOfPixels(), static_cast<DEMPixelType>(m_ElevationMin));
 
-    while (!outputDEMIt.IsAtEnd() && !tmpDEMIt.IsAtEnd())
-    {
-      if (tmpDEMIt.Get() > outputDEMIt.Get())
+    m_CellShards.VisitShard(shard, [dem](itk::SizeValueType cell, DEMPixelType cellHeight) {
+      if (cellHeight > dem[cell])
       {
-        outputDEMIt.Set(tmpDEMIt.Get());
+        dem[cell] = cellHeight;
       }
-      ++outputDEMIt;
-      ++tmpDEMIt;
-    }
-  }
+    });
+  };
+  this->GetMultiThreader()->ParallelizeArray(0, m_CellShards.GetNumberOfShards(), fuseShard, nullptr);
+
+  m_CellShards.Clear();
 }
 }
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDEMCellShards_h
+#define otbDEMCellShards_h
+
+#include "itkImageRegion.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+/** \class DEMCellShards
+ *  \brief Values projected onto the cells of a DEM region, binned by row bands.
+ *
+ *  DEM filters project input points in parallel onto arbitrary output
+ *  cells. Instead of one full size temporary DEM per thread, each
+ *  producer thread appends its (cell, value) pairs to the bin of the row
+ *  band (shard) of the cell. The shards can then be fused in parallel,
+ *  each one by a single thread, directly into the output buffer: the
+ *  memory only depends on the number of projected values, not on the
+ *  number of threads, and the fusion is not serial anymore.
+ *
+ *  VisitShard() gives the values of a shard by producer, then in
+ *  insertion order, so that the fusion does not depend on the
+ *  scheduling of the threads.
+ *
+ * \ingroup OTBStereo
+ */
+template <class TValue>
+class DEMCellShards
+{
+public:
+  typedef TValue                ValueType;
+  typedef itk::ImageRegion<2>   RegionType;
+  typedef RegionType::IndexType IndexType;
+
+  /** Value of a cell. The cell is the offset of its index in the region. */
+  struct CellValue
+  {
+    itk::SizeValueType Cell;
+    ValueType          Value;
+  };
+  typedef std::vector<CellValue> CellValueListType;
+
+  /** Clear the bins, for values on region from nbProducers threads,
+   *  binned into at most nbShards row bands */
+  void Initialize(const RegionType& region, unsigned int nbProducers, unsigned int nbShards)
+  {
+    m_Region            = region;
+    m_NumberOfShards    = static_cast<unsigned int>(std::max<itk::SizeValueType>(1, std::min<itk::SizeValueType>(nbShards, region.GetSize(1))));
+    m_NumberOfProducers = std::max(nbProducers, 1u);
+    m_Bins.clear();
+    m_Bins.resize(m_NumberOfProducers * m_NumberOfShards);
+  }
+
+  /** Release the memory of the bins */
+  void Clear()
+  {
+    std::vector<CellValueListType>().swap(m_Bins);
+  }
+
+  /** Add a value to a cell of the region (no check) */
+  void Add(unsigned int producer, const IndexType& cellIndex, ValueType value)
+  {
+    const itk::SizeValueType row   = cellIndex[1] - m_Region.GetIndex(1);
+    const itk::SizeValueType col   = cellIndex[0] - m_Region.GetIndex(0);
+    const unsigned int       shard = static_cast<unsigned int>(row * m_NumberOfShards / m_Region.GetSize(1));
+    m_Bins[producer * m_NumberOfShards + shard].push_back({row * m_Region.GetSize(0) + col, value});
+  }
+
+  unsigned int GetNumberOfShards() const
+  {
+    return m_NumberOfShards;
+  }
+
+  const RegionType& GetRegion() const
+  {
+    return m_Region;
+  }
+
+  /** Rows of the region covered by a shard */
+  RegionType GetShardRegion(unsigned int shard) const
+  {
+    const itk::SizeValueType height = m_Region.GetSize(1);
+    const itk::SizeValueType first  = (shard * height + m_NumberOfShards - 1) / m_NumberOfShards;
+    const itk::SizeValueType last   = ((shard + 1) * height + m_NumberOfShards - 1) / m_NumberOfShards;
+
+    RegionType shardRegion = m_Region;
+    shardRegion.SetIndex(1, m_Region.GetIndex(1) + first);
+    shardRegion.SetSize(1, last - first);
+    return shardRegion;
+  }
+
+  /** Call f(cell, value) on all the values of a shard, producer after producer */
+  template <class TFunction>
+  void VisitShard(unsigned int shard, TFunction f) const
+  {
+    for (unsigned int producer = 0; producer < m_NumberOfProducers; ++producer)
+    {
+      for (const auto& cellValue : m_Bins[producer * m_NumberOfShards + shard])
+      {
+        f(cellValue.Cell, cellValue.Value);
+      }
+    }
+  }
+
+private:
+  RegionType                     m_Region;
+  unsigned int                   m_NumberOfShards    = 1;
+  unsigned int                   m_NumberOfProducers = 1;
+  std::vector<CellValueListType> m_Bins;
+};
+
+} // end namespace otb
+
+#endif
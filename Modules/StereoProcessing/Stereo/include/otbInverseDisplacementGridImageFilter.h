@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbInverseDisplacementGridImageFilter_h
+#define otbInverseDisplacementGridImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class InverseDisplacementGridImageFilter
+ *  \brief Invert a smooth displacement grid, such as a stereo-rectification grid
+ *
+ *  The input grid D maps each of its nodes p to the point F(p) = p + D(p),
+ *  D being bilinearly interpolated between the nodes. For each point q of
+ *  the output grid, this filter looks for the point u such that F(u) = q,
+ *  and writes the inverse displacement u - q.
+ *
+ *  Unlike itk::InverseDisplacementFieldImageFilter, which fits a thin plate
+ *  spline on a sub-sampled set of control points, this filter exploits the
+ *  local monotonicity of the grid: each output point is found by a Newton
+ *  iteration on the bilinear cell model, seeded from the solution of the
+ *  previous point of the line (or from a global affine fit of the inverse
+ *  at the beginning of each line). It converges in a couple of iterations,
+ *  in memory proportional to the grid size. Points outside the grid are
+ *  found by extrapolating its border cells.
+ *
+ *  The residual |F(u) - q| of each point is measured, and GetMaximumResidual(),
+ *  GetMeanResidual() and GetNumberOfUnconvergedPoints() report it for all
+ *  the regions generated since the last update of the output information,
+ *  that is over all the streamed regions of the last run, in the unit of
+ *  the displacements. Points where Newton does not reach the tolerance
+ *  keep their best estimate.
+ *
+ *  The input grid is fully requested; the output can be streamed. The grid
+ *  is copied when the first region of a run is generated, and kept for the
+ *  next regions.
+ *  Directions of the input grid are expected to be the identity.
+ *
+ *  \ingroup Streamed
+ *  \ingroup Threaded
+ *
+ * \ingroup OTBStereo
+ */
+template <class TInputField, class TOutputField = TInputField>
+class ITK_EXPORT InverseDisplacementGridImageFilter : public itk::ImageToImageFilter<TInputField, TOutputField>
+{
+public:
+  /** Standard class typedef */
+  typedef InverseDisplacementGridImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputField, TOutputField> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(InverseDisplacementGridImageFilter, ImageToImageFilter);
+
+  /** Useful typedefs */
+  typedef TInputField                            InputFieldType;
+  typedef TOutputField                           OutputFieldType;
+  typedef typename OutputFieldType::RegionType   OutputRegionType;
+  typedef typename OutputFieldType::PixelType    OutputPixelType;
+  typedef typename OutputFieldType::SizeType     SizeType;
+  typedef typename OutputFieldType::PointType    PointType;
+  typedef typename OutputFieldType::SpacingType  SpacingType;
+
+  /** Geometry of the output grid */
+  itkSetMacro(OutputOrigin, PointType);
+  itkGetConstReferenceMacro(OutputOrigin, PointType);
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+
+  /** Maximum number of Newton iterations per point (default is 10) */
+  itkSetMacro(MaximumNumberOfIterations, unsigned int);
+  itkGetMacro(MaximumNumberOfIterations, unsigned int);
+
+  /** Residual under which a point is converged, in the unit of the
+   *  displacements (default is 1e-3) */
+  itkSetMacro(Tolerance, double);
+  itkGetMacro(Tolerance, double);
+
+  /** Residuals of the regions generated during the last run */
+  itkGetMacro(MaximumResidual, double);
+  itkGetMacro(MeanResidual, double);
+  itkGetMacro(NumberOfUnconvergedPoints, itk::SizeValueType);
+
+protected:
+  /** Constructor */
+  InverseDisplacementGridImageFilter();
+
+  /** Destructor */
+  ~InverseDisplacementGridImageFilter() override
+  {
+  }
+
+  /** Generate output information */
+  void GenerateOutputInformation() override;
+
+  /** Generate input requested region */
+  void GenerateInputRequestedRegion() override;
+
+  /** Start a new run: the grid is copied again and the residuals are
+   *  reset when its first region is generated */
+  void UpdateOutputInformation() override;
+
+  /** At the first region of a run, copy the input grid, compute the
+   *  initial guess and reset the residuals */
+  void BeforeThreadedGenerateData() override;
+
+  /** Threaded generate data */
+  void ThreadedGenerateData(const OutputRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Gather the residuals of the run */
+  void AfterThreadedGenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  InverseDisplacementGridImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Forward map F at the continuous index (x, y) of the input grid, and
+   *  its Jacobian (row major) with respect to the index */
+  void Forward(double x, double y, double f[2], double jacobian[4]) const;
+
+  /** Newton iterations from the index u towards F(u) = q. Returns the
+   *  final residual. */
+  double Solve(const double q[2], double u[2]) const;
+
+  /** Initial guess of the index of q, from the affine fit */
+  void Guess(const double q[2], double u[2]) const;
+
+  PointType   m_OutputOrigin;
+  SpacingType m_OutputSpacing;
+  SizeType    m_Size;
+
+  unsigned int m_MaximumNumberOfIterations;
+  double       m_Tolerance;
+
+  /** Input grid: displacements (interleaved), size, and index to
+   *  physical point affine map p = origin + M.u */
+  std::vector<double> m_Grid;
+  long                m_GridSize[2];
+  double              m_GridOrigin[2];
+  double              m_GridMatrix[4];
+
+  /** Affine fit of the inverse: u = A.q + b */
+  double m_GuessMatrix[4];
+  double m_GuessOffset[2];
+
+  /** Whether the next generated region is the first of a run */
+  bool m_NewRun;
+
+  /** Per thread residuals, accumulated over the regions of a run */
+  std::vector<double>             m_ThreadMaximumResidual;
+  std::vector<double>             m_ThreadSumResidual;
+  std::vector<itk::SizeValueType> m_ThreadUnconverged;
+  std::vector<itk::SizeValueType> m_ThreadCount;
+
+  double             m_MaximumResidual;
+  double             m_MeanResidual;
+  itk::SizeValueType m_NumberOfUnconvergedPoints;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbInverseDisplacementGridImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbInverseDisplacementGridImageFilter_hxx
+#define otbInverseDisplacementGridImageFilter_hxx
+
+#include "otbInverseDisplacementGridImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputField, class TOutputField>
+InverseDisplacementGridImageFilter<TInputField, TOutputField>::InverseDisplacementGridImageFilter()
+  : m_MaximumNumberOfIterations(10), m_Tolerance(1e-3), m_NewRun(true), m_MaximumResidual(0.), m_MeanResidual(0.), m_NumberOfUnconvergedPoints(0)
+{
+  m_OutputOrigin.Fill(0.);
+  m_OutputSpacing.Fill(1.);
+  m_Size.Fill(0);
+  this->DynamicMultiThreadingOff();
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  OutputFieldType* outputPtr = this->GetOutput();
+
+  OutputRegionType largest;
+  largest.SetSize(m_Size);
+  outputPtr->SetLargestPossibleRegion(largest);
+  outputPtr->SetOrigin(m_OutputOrigin);
+  outputPtr->SetSignedSpacing(m_OutputSpacing);
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // The solution of any output point may lie anywhere in the grid
+  InputFieldType* inputPtr = const_cast<InputFieldType*>(this->GetInput());
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::UpdateOutputInformation()
+{
+  Superclass::UpdateOutputInformation();
+
+  // Writers update the output information once, then stream the regions
+  m_NewRun = true;
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::BeforeThreadedGenerateData()
+{
+  const unsigned int numberOfThreads = this->GetNumberOfWorkUnits();
+  if (!m_NewRun)
+  {
+    // Next region of the run: the grid and the guess are already computed,
+    // and the residuals keep accumulating
+    if (m_ThreadCount.size() < numberOfThreads)
+    {
+      m_ThreadMaximumResidual.resize(numberOfThreads, 0.);
+      m_ThreadSumResidual.resize(numberOfThreads, 0.);
+      m_ThreadUnconverged.resize(numberOfThreads, 0);
+      m_ThreadCount.resize(numberOfThreads, 0);
+    }
+    return;
+  }
+
+  const InputFieldType* inputPtr = this->GetInput();
+
+  const typename InputFieldType::RegionType& region = inputPtr->GetLargestPossibleRegion();
+  if (region.GetSize(0) < 2 || region.GetSize(1) < 2)
+  {
+    itkExceptionMacro(<< "The displacement grid must have at least 2x2 nodes, got " << region.GetSize());
+  }
+  m_GridSize[0] = region.GetSize(0);
+  m_GridSize[1] = region.GetSize(1);
+
+  // Index to physical point map, relative to the first node
+  typename InputFieldType::IndexType index = region.GetIndex();
+  typename InputFieldType::PointType p0, px, py;
+  inputPtr->TransformIndexToPhysicalPoint(index, p0);
+  ++index[0];
+  inputPtr->TransformIndexToPhysicalPoint(index, px);
+  --index[0];
+  ++index[1];
+  inputPtr->TransformIndexToPhysicalPoint(index, py);
+  m_GridOrigin[0] = p0[0];
+  m_GridOrigin[1] = p0[1];
+  m_GridMatrix[0] = px[0] - p0[0];
+  m_GridMatrix[1] = py[0] - p0[0];
+  m_GridMatrix[2] = px[1] - p0[1];
+  m_GridMatrix[3] = py[1] - p0[1];
+
+  // Copy the displacements, and fit u = A.(F(u) - meanF) + meanU on the nodes
+  m_Grid.resize(2 * region.GetNumberOfPixels());
+  double meanF[2] = {0., 0.}, meanU[2] = {0., 0.};
+  std::size_t k = 0;
+  itk::ImageRegionConstIteratorWithIndex<InputFieldType> it(inputPtr, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, k += 2)
+  {
+    m_Grid[k]     = it.Get()[0];
+    m_Grid[k + 1] = it.Get()[1];
+
+    const double u[2] = {static_cast<double>(it.GetIndex()[0] - region.GetIndex(0)), static_cast<double>(it.GetIndex()[1] - region.GetIndex(1))};
+    meanU[0] += u[0];
+    meanU[1] += u[1];
+    meanF[0] += m_GridOrigin[0] + m_GridMatrix[0] * u[0] + m_GridMatrix[1] * u[1] + m_Grid[k];
+    meanF[1] += m_GridOrigin[1] + m_GridMatrix[2] * u[0] + m_GridMatrix[3] * u[1] + m_Grid[k + 1];
+  }
+  const double nbNodes = static_cast<double>(region.GetNumberOfPixels());
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    meanU[i] /= nbNodes;
+    meanF[i] /= nbNodes;
+  }
+
+  double ff[3] = {0., 0., 0.}; // Sxx, Sxy, Syy of the centered F
+  double uf[4] = {0., 0., 0., 0.};
+  k = 0;
+  for (long y = 0; y < m_GridSize[1]; ++y)
+  {
+    for (long x = 0; x < m_GridSize[0]; ++x, k += 2)
+    {
+      const double f[2] = {m_GridOrigin[0] + m_GridMatrix[0] * x + m_GridMatrix[1] * y + m_Grid[k] - meanF[0],
+                           m_GridOrigin[1] + m_GridMatrix[2] * x + m_GridMatrix[3] * y + m_Grid[k + 1] - meanF[1]};
+      const double u[2] = {x - meanU[0], y - meanU[1]};
+      ff[0] += f[0] * f[0];
+      ff[1] += f[0] * f[1];
+      ff[2] += f[1] * f[1];
+      uf[0] += u[0] * f[0];
+      uf[1] += u[0] * f[1];
+      uf[2] += u[1] * f[0];
+      uf[3] += u[1] * f[1];
+    }
+  }
+  const double det = ff[0] * ff[2] - ff[1] * ff[1];
+  if (!(std::abs(det) > 0.))
+  {
+    itkExceptionMacro(<< "The displacement grid is degenerated");
+  }
+  const double inv[3] = {ff[2] / det, -ff[1] / det, ff[0] / det};
+  m_GuessMatrix[0]    = uf[0] * inv[0] + uf[1] * inv[1];
+  m_GuessMatrix[1]    = uf[0] * inv[1] + uf[1] * inv[2];
+  m_GuessMatrix[2]    = uf[2] * inv[0] + uf[3] * inv[1];
+  m_GuessMatrix[3]    = uf[2] * inv[1] + uf[3] * inv[2];
+  m_GuessOffset[0]    = meanU[0] - m_GuessMatrix[0] * meanF[0] - m_GuessMatrix[1] * meanF[1];
+  m_GuessOffset[1]    = meanU[1] - m_GuessMatrix[2] * meanF[0] - m_GuessMatrix[3] * meanF[1];
+
+  m_ThreadMaximumResidual.assign(numberOfThreads, 0.);
+  m_ThreadSumResidual.assign(numberOfThreads, 0.);
+  m_ThreadUnconverged.assign(numberOfThreads, 0);
+  m_ThreadCount.assign(numberOfThreads, 0);
+  m_NewRun = false;
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::Forward(double x, double y, double f[2], double jacobian[4]) const
+{
+  // Cell of (x, y), border cells being extrapolated
+  const long   i  = std::min(std::max(static_cast<long>(std::floor(x)), 0L), m_GridSize[0] - 2);
+  const long   j  = std::min(std::max(static_cast<long>(std::floor(y)), 0L), m_GridSize[1] - 2);
+  const double fx = x - i;
+  const double fy = y - j;
+
+  const double* d00 = &m_Grid[2 * (j * m_GridSize[0] + i)];
+  const double* d10 = d00 + 2;
+  const double* d01 = d00 + 2 * m_GridSize[0];
+  const double* d11 = d01 + 2;
+
+  for (unsigned int c = 0; c < 2; ++c)
+  {
+    const double d = (1. - fy) * ((1. - fx) * d00[c] + fx * d10[c]) + fy * ((1. - fx) * d01[c] + fx * d11[c]);
+    f[c]           = m_GridOrigin[c] + m_GridMatrix[2 * c] * x + m_GridMatrix[2 * c + 1] * y + d;
+    jacobian[2 * c]     = m_GridMatrix[2 * c] + (1. - fy) * (d10[c] - d00[c]) + fy * (d11[c] - d01[c]);
+    jacobian[2 * c + 1] = m_GridMatrix[2 * c + 1] + (1. - fx) * (d01[c] - d00[c]) + fx * (d11[c] - d10[c]);
+  }
+}
+
+template <class TInputField, class TOutputField>
+double InverseDisplacementGridImageFilter<TInputField, TOutputField>::Solve(const double q[2], double u[2]) const
+{
+  double f[2], jacobian[4];
+  Forward(u[0], u[1], f, jacobian);
+  double residual = std::hypot(f[0] - q[0], f[1] - q[1]);
+
+  // Iterate well below the tolerance, since Newton converges quadratically
+  for (unsigned int iteration = 0; iteration < m_MaximumNumberOfIterations && residual > 1e-3 * m_Tolerance; ++iteration)
+  {
+    const double det = jacobian[0] * jacobian[3] - jacobian[1] * jacobian[2];
+    if (!(std::abs(det) > 0.))
+    {
+      break;
+    }
+    const double rx   = q[0] - f[0];
+    const double ry   = q[1] - f[1];
+    double       step = 1.;
+    const double du   = (jacobian[3] * rx - jacobian[1] * ry) / det;
+    const double dv   = (jacobian[0] * ry - jacobian[2] * rx) / det;
+
+    // Damped step: the bilinear model changes from one cell to another
+    double next[2], nextF[2], nextJacobian[4], nextResidual;
+    do
+    {
+      next[0] = u[0] + step * du;
+      next[1] = u[1] + step * dv;
+      Forward(next[0], next[1], nextF, nextJacobian);
+      nextResidual = std::hypot(nextF[0] - q[0], nextF[1] - q[1]);
+      step *= 0.5;
+    } while (nextResidual >= residual && step > 1e-3);
+
+    if (nextResidual >= residual)
+    {
+      break;
+    }
+    u[0]     = next[0];
+    u[1]     = next[1];
+    f[0]     = nextF[0];
+    f[1]     = nextF[1];
+    residual = nextResidual;
+    std::copy(nextJacobian, nextJacobian + 4, jacobian);
+  }
+  return residual;
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::Guess(const double q[2], double u[2]) const
+{
+  u[0] = m_GuessMatrix[0] * q[0] + m_GuessMatrix[1] * q[1] + m_GuessOffset[0];
+  u[1] = m_GuessMatrix[2] * q[0] + m_GuessMatrix[3] * q[1] + m_GuessOffset[1];
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::ThreadedGenerateData(const OutputRegionType& outputRegionForThread,
+                                                                                         itk::ThreadIdType       threadId)
+{
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize(1));
+
+  OutputFieldType* outputPtr = this->GetOutput();
+
+  // Step of the output points along a line
+  const double delta[2] = {m_OutputSpacing[0], 0.};
+
+  double maximum = 0., sum = 0.;
+  itk::SizeValueType unconverged = 0;
+
+  itk::ImageScanlineIterator<OutputFieldType> outIt(outputPtr, outputRegionForThread);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    PointType point;
+    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), point);
+    double q[2] = {point[0], point[1]};
+    double u[2];
+    Guess(q, u);
+
+    for (bool first = true; !outIt.IsAtEndOfLine(); ++outIt, first = false)
+    {
+      if (!first)
+      {
+        // Seed from the previous point, moved by the affine inverse
+        q[0] += delta[0];
+        q[1] += delta[1];
+        u[0] += m_GuessMatrix[0] * delta[0] + m_GuessMatrix[1] * delta[1];
+        u[1] += m_GuessMatrix[2] * delta[0] + m_GuessMatrix[3] * delta[1];
+      }
+
+      double residual = Solve(q, u);
+      if (residual > m_Tolerance && !first)
+      {
+        // Restart from the global guess, and keep the best solution
+        double restart[2];
+        Guess(q, restart);
+        const double restartResidual = Solve(q, restart);
+        if (restartResidual < residual)
+        {
+          u[0]     = restart[0];
+          u[1]     = restart[1];
+          residual = restartResidual;
+        }
+      }
+
+      maximum = std::max(maximum, residual);
+      sum += residual;
+      if (!(residual <= m_Tolerance))
+      {
+        ++unconverged;
+      }
+
+      OutputPixelType value = outIt.Get();
+      value[0]              = m_GridOrigin[0] + m_GridMatrix[0] * u[0] + m_GridMatrix[1] * u[1] - q[0];
+      value[1]              = m_GridOrigin[1] + m_GridMatrix[2] * u[0] + m_GridMatrix[3] * u[1] - q[1];
+      outIt.Set(value);
+    }
+    progress.CompletedPixel();
+  }
+
+  m_ThreadMaximumResidual[threadId] = std::max(m_ThreadMaximumResidual[threadId], maximum);
+  m_ThreadSumResidual[threadId] += sum;
+  m_ThreadUnconverged[threadId] += unconverged;
+  m_ThreadCount[threadId] += outputRegionForThread.GetNumberOfPixels();
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::AfterThreadedGenerateData()
+{
+  m_MaximumResidual           = 0.;
+  m_NumberOfUnconvergedPoints = 0;
+  double             sum      = 0.;
+  itk::SizeValueType count    = 0;
+  for (std::size_t threadId = 0; threadId < m_ThreadCount.size(); ++threadId)
+  {
+    m_MaximumResidual = std::max(m_MaximumResidual, m_ThreadMaximumResidual[threadId]);
+    m_NumberOfUnconvergedPoints += m_ThreadUnconverged[threadId];
+    sum += m_ThreadSumResidual[threadId];
+    count += m_ThreadCount[threadId];
+  }
+  m_MeanResidual = count > 0 ? sum / count : 0.;
+}
+
+template <class TInputField, class TOutputField>
+void InverseDisplacementGridImageFilter<TInputField, TOutputField>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Output origin: " << m_OutputOrigin << std::endl;
+  os << indent << "Output spacing: " << m_OutputSpacing << std::endl;
+  os << indent << "Size: " << m_Size << std::endl;
+  os << indent << "Maximum number of iterations: " << m_MaximumNumberOfIterations << std::endl;
+  os << indent << "Tolerance: " << m_Tolerance << std::endl;
+  os << indent << "Maximum residual: " << m_MaximumResidual << std::endl;
+  os << indent << "Mean residual: " << m_MeanResidual << std::endl;
+  os << indent << "Unconverged points: " << m_NumberOfUnconvergedPoints << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -29,6 +29,7 @@
 #include "otbImage.h"
 #include "itkImageRegionSplitter.h"
 #include "otbObjectList.h"
+#include "otbDEMCellShards.h"
 #include <string>
 
 namespace otb
@@ -70,6 +71,11 @@ enum CellFusionMode
  *  Origin, Spacing, Size, StartIndex, ProjectionRef
  *  thus DEMGridStep parameter is ignored in this case (replaced by Spacing)
  *
+ *  Each thread projects a split of the 3D maps and bins the points by row
+ *  bands of the output (see DEMCellShards); the bands are then fused in
+ *  parallel. The temporary memory only depends on the number of projected
+ *  points, not on the number of threads.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa MultiDisparityMapTo3DFilter
  *
@@ -268,10 +274,8 @@ private:
   /** DEM grid step (in meters) */
   double m_DEMGridStep;
 
-  /** Temporary DEMs for multithreading */
-  std::vector<typename OutputImageType::Pointer> m_TempDEMRegions;
-  /** Temporary accumulator for multithreading and mean calculus*/
-  std::vector<typename AccumulatorImageType::Pointer> m_TempDEMAccumulatorRegions;
+  /** Projected points, binned by row bands of the output */
+  DEMCellShards<DEMPixelType> m_CellShards;
 
 
   std::vector<unsigned int> m_NumberOfSplit; // number of split for each map
@@ -493,30 +493,14 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
       maximumRegionsNumber = regionsNumber;
   }
 
-  m_TempDEMRegions.clear();
-  m_TempDEMAccumulatorRegions.clear();
-  // m_ThreadProcessed.resize(maximumRegionsNumber);
-
-  for (unsigned int i = 0; i < maximumRegionsNumber; i++)
+  if (m_CellFusionMode < otb::CellFusionMode::MIN || m_CellFusionMode > otb::CellFusionMode::ACC)
   {
-    // m_ThreadProcessed[i] = 0;
-    typename TOutputDEMImage::Pointer tmpImg = TOutputDEMImage::New();
-    tmpImg->SetNumberOfComponentsPerPixel(1); // Two components for mean calculus ?
-    tmpImg->SetRegions(outputDEM->GetRequestedRegion());
-    tmpImg->Allocate();
-
-    tmpImg->FillBuffer(m_NoDataValue);
-    m_TempDEMRegions.push_back(tmpImg);
-
-    typename AccumulatorImageType::Pointer tmpImg2 = AccumulatorImageType::New();
-    tmpImg2->SetNumberOfComponentsPerPixel(1); // Two components for mean calculus ?
-    tmpImg2->SetRegions(outputDEM->GetRequestedRegion());
-    tmpImg2->Allocate();
-
-    tmpImg2->FillBuffer(0.);
-    m_TempDEMAccumulatorRegions.push_back(tmpImg2);
+    itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
   }
 
+  // Points are binned by row bands of the output, fused in AfterThreadedGenerateData()
+  m_CellShards.Initialize(outputDEM->GetRequestedRegion(), maximumRegionsNumber, this->GetNumberOfWorkUnits());
+
   if (!this->m_IsGeographic)
   {
     m_GroundTransform = RSTransform2DType::New();
@@ -555,8 +539,6 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
   InputInternalPixelType maxLat = std::max(regionLat1, regionLat2);
   */
 
-  TOutputDEMImage*                     tmpDEM                = nullptr;
-  AccumulatorImageType*                tmpAcc                = nullptr;
   typename TOutputDEMImage::RegionType outputRequestedRegion = outputPtr->GetRequestedRegion();
 
   typename T3DImage::RegionType splitRegion;
@@ -580,9 +562,6 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
       {
         splitRegion = m_MapSplitterList->GetNthElement(k)->GetSplit(threadId, m_NumberOfSplit[k], imgPtr->GetRequestedRegion());
 
-        tmpDEM = m_TempDEMRegions[threadId];
-        tmpAcc = m_TempDEMAccumulatorRegions[threadId];
-
         mapIt = itk::ImageRegionConstIterator<InputMapType>(imgPtr, splitRegion);
         mapIt.GoToBegin();
         itk::ImageRegionConstIterator<MaskImageType> maskIt;
@@ -649,57 +628,8 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
           **/
           if (outputRequestedRegion.IsInside(cellIndex))
           {
-            // std::cout<<"is inside "<<std::endl;
-            // Add point to its corresponding cell (keep maximum)
-            DEMPixelType cellHeight = static_cast<DEMPixelType>(position[2]);
-            // if (cellHeight > tmpDEM->GetPixel(cellIndex) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
-            //  {
-            // tmpDEM->SetPixel(cellIndex,tmpDEM->GetPixel(cellIndex)+1);
-
-            AccumulatorPixelType accPixel = tmpAcc->GetPixel(cellIndex);
-            tmpAcc->SetPixel(cellIndex, tmpAcc->GetPixel(cellIndex) + 1);
-
-            if (accPixel == 0)
-            {
-              tmpDEM->SetPixel(cellIndex, cellHeight);
-            }
-            else
-            {
-              DEMPixelType cellCurrentValue = tmpDEM->GetPixel(cellIndex);
-
-              switch (this->m_CellFusionMode)
-              {
-              case otb::CellFusionMode::MIN:
-              {
-                if (cellHeight < cellCurrentValue)
-                {
-                  tmpDEM->SetPixel(cellIndex, cellHeight);
-                }
-              }
-              break;
-              case otb::CellFusionMode::MAX:
-              {
-                if (cellHeight > cellCurrentValue)
-                {
-                  tmpDEM->SetPixel(cellIndex, cellHeight);
-                }
-              }
-              break;
-              case otb::CellFusionMode::MEAN:
-              {
-                tmpDEM->SetPixel(cellIndex, cellCurrentValue + cellHeight);
-              }
-              break;
-              case otb::CellFusionMode::ACC:
-              {
-              }
-              break;
-              default:
-
-                itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
-                break;
-              }
-            }
+            // Add point to the band of its corresponding cell
+            m_CellShards.Add(threadId, cellIndex, static_cast<DEMPixelType>(position[2]));
           }
 
           ++mapIt;
@@ -720,138 +650,69 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
 void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::AfterThreadedGenerateData()
 {
-
   TOutputDEMImage* outputDEM = this->GetOutput();
 
-  // check is that case can occur
-  if (m_TempDEMRegions.size() < 1)
+  const RegionType& region = m_CellShards.GetRegion();
+  if (outputDEM->GetBufferedRegion() != region)
   {
-    outputDEM->FillBuffer(m_NoDataValue);
-    return;
+    itkExceptionMacro(<< "The output buffered region " << outputDEM->GetBufferedRegion() << " differs from the processed region " << region);
   }
 
-  itk::ImageRegionIterator<OutputImageType>      outputDEMIt(outputDEM, outputDEM->GetRequestedRegion());
-  itk::ImageRegionIterator<OutputImageType>      firstDEMIt(m_TempDEMRegions[0], outputDEM->GetRequestedRegion());
-  itk::ImageRegionIterator<AccumulatorImageType> firstDEMAccIt(m_TempDEMAccumulatorRegions[0], outputDEM->GetRequestedRegion());
-  // we use the first accumulator as global accumulator over tmpAcc for mean calculus
+  DEMPixelType*                     dem = outputDEM->GetBufferPointer();
+  std::vector<AccumulatorPixelType> counts(region.GetNumberOfPixels(), 0);
 
-  outputDEMIt.GoToBegin();
-  firstDEMIt.GoToBegin();
-  firstDEMAccIt.GoToBegin();
-  // Copy first DEM
-
-  while (!outputDEMIt.IsAtEnd() && !firstDEMIt.IsAtEnd() && !firstDEMAccIt.IsAtEnd())
-  {
-
-    AccumulatorPixelType accPixel = firstDEMAccIt.Get();
-    // useless test tempDEm is initialized with NoDataValue
-    if (accPixel == 0)
-    {
-      outputDEMIt.Set(m_NoDataValue);
-    }
-    else
-    {
-
-      DEMPixelType pixelValue = firstDEMIt.Get();
-
-      outputDEMIt.Set(pixelValue);
-
-      if ((this->m_CellFusionMode == otb::CellFusionMode::MEAN) && (m_TempDEMRegions.size() == 1))
-      {
-        outputDEMIt.Set(firstDEMIt.Get() / static_cast<DEMPixelType>(accPixel));
-      }
-      if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
+  // Each band of rows is fused by a single thread, directly in the output
+  auto fuseShard = [this, dem, &counts, &region](itk::SizeValueType shard) {
+    m_CellShards.VisitShard(shard, [this, dem, &counts](itk::SizeValueType cell, DEMPixelType cellHeight) {
+      if (counts[cell]++ == 0)
       {
-        outputDEMIt.Set(static_cast<DEMPixelType>(accPixel));
+        dem[cell] = cellHeight;
+        return;
       }
-    }
-    ++outputDEMIt;
-    ++firstDEMIt;
-    ++firstDEMAccIt;
-  }
-
-  // Check DEMs from other threads and keep the maximum elevation
-  for (unsigned int i = 1; i < m_TempDEMRegions.size(); i++)
-  {
-
-    itk::ImageRegionIterator<OutputImageType>      tmpDEMIt(m_TempDEMRegions[i], outputDEM->GetRequestedRegion());
-    itk::ImageRegionIterator<AccumulatorImageType> tmpDEMAccIt(m_TempDEMAccumulatorRegions[i], outputDEM->GetRequestedRegion());
-
-    outputDEMIt.GoToBegin();
-    tmpDEMIt.GoToBegin();
-    tmpDEMAccIt.GoToBegin();
-    firstDEMAccIt.GoToBegin(); // Global Accumulator
-    while (!outputDEMIt.IsAtEnd() && !tmpDEMIt.IsAtEnd() && !tmpDEMAccIt.IsAtEnd() && !firstDEMAccIt.IsAtEnd())
-    {
-
-      // get the accumulator value
-      AccumulatorPixelType accPixel = tmpDEMAccIt.Get();
-      if (accPixel != 0)
+      switch (this->m_CellFusionMode)
       {
-
-        DEMPixelType cellCurrentValue = outputDEMIt.Get();
-        DEMPixelType cellHeight       = tmpDEMIt.Get();
-        switch (this->m_CellFusionMode)
+      case otb::CellFusionMode::MIN:
+        if (cellHeight < dem[cell])
         {
-        case otb::CellFusionMode::MIN:
-        {
-          if ((cellHeight < cellCurrentValue) || (cellCurrentValue == m_NoDataValue))
-          {
-            outputDEMIt.Set(cellHeight);
-          }
+          dem[cell] = cellHeight;
         }
         break;
-        case otb::CellFusionMode::MAX:
+      case otb::CellFusionMode::MAX:
+        if (cellHeight > dem[cell])
         {
-          if ((cellHeight > cellCurrentValue) || ((cellCurrentValue == m_NoDataValue)))
-          {
-            outputDEMIt.Set(cellHeight);
-          }
+          dem[cell] = cellHeight;
         }
         break;
-        case otb::CellFusionMode::MEAN:
-        {
-
-          outputDEMIt.Set(cellCurrentValue * static_cast<DEMPixelType>(cellCurrentValue != m_NoDataValue) + cellHeight);
-          firstDEMAccIt.Set(firstDEMAccIt.Get() + accPixel);
-        }
+      case otb::CellFusionMode::MEAN:
+        dem[cell] += cellHeight;
         break;
-        case otb::CellFusionMode::ACC:
-        {
-          firstDEMAccIt.Set(firstDEMAccIt.Get() + accPixel);
-        }
+      default:
         break;
-
-        default:
-          itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
-          break;
-        }
       }
+    });
 
-      if (i == (m_TempDEMRegions.size() - 1))
+    const RegionType         shardRegion = m_CellShards.GetShardRegion(shard);
+    const itk::SizeValueType begin       = (shardRegion.GetIndex(1) - region.GetIndex(1)) * region.GetSize(0);
+    const itk::SizeValueType end         = begin + shardRegion.GetNumberOfPixels();
+    for (itk::SizeValueType cell = begin; cell < end; ++cell)
+    {
+      if (counts[cell] == 0)
       {
-        if (this->m_CellFusionMode == otb::CellFusionMode::MEAN)
-        {
-          if (static_cast<DEMPixelType>(firstDEMAccIt.Get()) != 0)
-          {
-            outputDEMIt.Set(outputDEMIt.Get() / static_cast<DEMPixelType>(firstDEMAccIt.Get()));
-          }
-          else
-          {
-            outputDEMIt.Set(m_NoDataValue);
-          }
-        }
-        else if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
-        {
-          outputDEMIt.Set(static_cast<DEMPixelType>(firstDEMAccIt.Get()));
-        }
+        dem[cell] = m_NoDataValue;
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::MEAN)
+      {
+        dem[cell] /= static_cast<DEMPixelType>(counts[cell]);
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
+      {
+        dem[cell] = static_cast<DEMPixelType>(counts[cell]);
       }
-      ++outputDEMIt;
-      ++tmpDEMIt;
-      ++tmpDEMAccIt;
-      ++firstDEMAccIt;
     }
-  }
+  };
+  this->GetMultiThreader()->ParallelizeArray(0, m_CellShards.GetNumberOfShards(), fuseShard, nullptr);
+
+  m_CellShards.Clear();
 }
 }
 
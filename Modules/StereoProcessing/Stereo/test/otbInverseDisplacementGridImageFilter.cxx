@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2005-2024 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbInverseDisplacementGridImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include <cmath>
+#include <iostream>
+
+typedef itk::Vector<double, 2> DisplacementType;
+typedef otb::Image<DisplacementType> DisplacementFieldType;
+typedef otb::InverseDisplacementGridImageFilter<DisplacementFieldType> InverseFilterType;
+
+namespace
+{
+// Displacement grid of 80x70 nodes every 16 pixels, built from a function of the node position
+template <class TFunction>
+DisplacementFieldType::Pointer MakeGrid(TFunction f)
+{
+  DisplacementFieldType::Pointer grid = DisplacementFieldType::New();
+  DisplacementFieldType::SizeType size;
+  size[0] = 80;
+  size[1] = 70;
+  DisplacementFieldType::SpacingType spacing;
+  spacing.Fill(16.);
+  grid->SetRegions(size);
+  grid->SetSignedSpacing(spacing);
+  grid->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(grid, grid->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    DisplacementFieldType::PointType p;
+    grid->TransformIndexToPhysicalPoint(it.GetIndex(), p);
+    it.Set(f(p[0], p[1]));
+  }
+  return grid;
+}
+
+InverseFilterType::Pointer MakeInverse(DisplacementFieldType* grid)
+{
+  InverseFilterType::Pointer inverse = InverseFilterType::New();
+  inverse->SetInput(grid);
+  DisplacementFieldType::PointType origin;
+  origin.Fill(-40.);
+  DisplacementFieldType::SpacingType spacing;
+  spacing.Fill(10.);
+  DisplacementFieldType::SizeType size;
+  size[0] = 140;
+  size[1] = 120;
+  inverse->SetOutputOrigin(origin);
+  inverse->SetOutputSpacing(spacing);
+  inverse->SetSize(size);
+  return inverse;
+}
+}
+
+int otbInverseDisplacementGridImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Affine displacement: the bilinear grid model is exact, and so is its inverse
+  const double a[4] = {0.01, 0.02, -0.015, 0.005};
+  const double b[2] = {5., -7.};
+  DisplacementFieldType::Pointer affine = MakeGrid([&](double x, double y) {
+    DisplacementType d;
+    d[0] = a[0] * x + a[1] * y + b[0];
+    d[1] = a[2] * x + a[3] * y + b[1];
+    return d;
+  });
+
+  InverseFilterType::Pointer affineInverse = MakeInverse(affine);
+  affineInverse->Update();
+
+  const double det = (1. + a[0]) * (1. + a[3]) - a[1] * a[2];
+  itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> it(affineInverse->GetOutput(), affineInverse->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    DisplacementFieldType::PointType q;
+    affineInverse->GetOutput()->TransformIndexToPhysicalPoint(it.GetIndex(), q);
+    const double rx = q[0] - b[0];
+    const double ry = q[1] - b[1];
+    const double ux = ((1. + a[3]) * rx - a[1] * ry) / det;
+    const double uy = ((1. + a[0]) * ry - a[2] * rx) / det;
+    otbControlConditionTestMacro(std::abs(it.Get()[0] - (ux - q[0])) > 1e-6 || std::abs(it.Get()[1] - (uy - q[1])) > 1e-6,
+                                 "Wrong inverse displacement at " << it.GetIndex() << ": " << it.Get());
+  }
+
+  // Smooth non linear displacement: check the reported residuals
+  DisplacementFieldType::Pointer smooth = MakeGrid([](double x, double y) {
+    DisplacementType d;
+    d[0] = 0.02 * y + 3. * std::sin(x / 400.) + 5.;
+    d[1] = -0.02 * x + 2. * std::cos(y / 300.) - 7.;
+    return d;
+  });
+
+  InverseFilterType::Pointer smoothInverse = MakeInverse(smooth);
+  smoothInverse->SetTolerance(1e-4);
+  smoothInverse->Update();
+  std::cout << "Maximum residual: " << smoothInverse->GetMaximumResidual() << ", mean residual: " << smoothInverse->GetMeanResidual() << std::endl;
+  otbControlConditionTestMacro(smoothInverse->GetNumberOfUnconvergedPoints() != 0, "Unconverged points: " << smoothInverse->GetNumberOfUnconvergedPoints());
+  otbControlConditionTestMacro(smoothInverse->GetMaximumResidual() > 1e-4, "Residual is too large");
+
+  // The inverse on a sub-region (as when streaming) is the same
+  InverseFilterType::Pointer streamedInverse = MakeInverse(smooth);
+  streamedInverse->SetTolerance(1e-4);
+  DisplacementFieldType::RegionType subRegion;
+  subRegion.SetIndex(0, 30);
+  subRegion.SetIndex(1, 50);
+  subRegion.SetSize(0, 60);
+  subRegion.SetSize(1, 20);
+  streamedInverse->GetOutput()->SetRequestedRegion(subRegion);
+  streamedInverse->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> streamedIt(streamedInverse->GetOutput(), subRegion);
+  for (streamedIt.GoToBegin(); !streamedIt.IsAtEnd(); ++streamedIt)
+  {
+    const DisplacementType& full = smoothInverse->GetOutput()->GetPixel(streamedIt.GetIndex());
+    otbControlConditionTestMacro((streamedIt.Get() - full).GetNorm() > 1e-3, "Streamed inverse differs at " << streamedIt.GetIndex());
+  }
+
+  // The residuals are accumulated over all the streamed regions of a run
+  InverseFilterType::Pointer piecewiseInverse = MakeInverse(smooth);
+  piecewiseInverse->SetTolerance(1e-4);
+  typedef itk::StreamingImageFilter<DisplacementFieldType, DisplacementFieldType> StreamingFilterType;
+  StreamingFilterType::Pointer streaming = StreamingFilterType::New();
+  streaming->SetInput(piecewiseInverse->GetOutput());
+  streaming->SetNumberOfStreamDivisions(5);
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    streaming->Modified();
+    streaming->Update();
+    otbControlConditionTestMacro(std::abs(piecewiseInverse->GetMaximumResidual() - smoothInverse->GetMaximumResidual()) > 1e-9 * smoothInverse->GetMaximumResidual(),
+                                 "Maximum residual of the streamed run is " << piecewiseInverse->GetMaximumResidual());
+    otbControlConditionTestMacro(std::abs(piecewiseInverse->GetMeanResidual() - smoothInverse->GetMeanResidual()) > 1e-9 * smoothInverse->GetMeanResidual(),
+                                 "Mean residual of the streamed run is " << piecewiseInverse->GetMeanResidual());
+    otbControlConditionTestMacro(piecewiseInverse->GetNumberOfUnconvergedPoints() != smoothInverse->GetNumberOfUnconvergedPoints(),
+                                 "Unconverged points of the streamed run: " << piecewiseInverse->GetNumberOfUnconvergedPoints());
+  }
+
+  return EXIT_SUCCESS;
+}